@@ -1,4 +1,25 @@
 "C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" simple.vert -o simple.vert.spv
-"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" simple.frag -o simple.frag.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" --target-env=vulkan1.2 simple.frag -o simple.frag.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" --target-env=vulkan1.2 simple_pulling.vert -o simple_pulling.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" workload.comp -o workload.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" particle_init.comp -o particle_init.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" particle_dispatch.comp -o particle_dispatch.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" particle_emit.comp -o particle_emit.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" particle_simulate.comp -o particle_simulate.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" particle.vert -o particle.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" particle.frag -o particle.frag.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" meshlet_cull.comp -o meshlet_cull.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" hiz_build.comp -o hiz_build.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" occlusion_cull.comp -o occlusion_cull.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" --target-env=vulkan1.2 multiview.vert -o multiview.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" --target-env=vulkan1.2 multiview_pulling.vert -o multiview_pulling.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" lit.vert -o lit.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" --target-env=vulkan1.2 lit_pulling.vert -o lit_pulling.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" --target-env=vulkan1.2 lit.frag -o lit.frag.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" shadow.vert -o shadow.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" --target-env=vulkan1.2 shadow_pulling.vert -o shadow_pulling.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" light_cluster.comp -o light_cluster.comp.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" fullscreen.vert -o fullscreen.vert.spv
+"C:\VulkanSDK\1.3.296.0\Bin\glslc.exe" upscale.frag -o upscale.frag.spv
 
 pause
\ No newline at end of file
@@ -0,0 +1,144 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec3 faceColor;
+layout(location = 1) in vec2 faceUv;
+layout(location = 2) in vec3 worldPosition;
+
+layout(location = 0) out vec4 fragColor;
+
+struct Material {
+    vec4 baseColor;
+    uint textureIndex;
+};
+
+struct Light {
+    vec3 position;
+    float radius;
+    vec3 color;
+    float intensity;
+    vec3 direction;
+    float outerCutoff;
+    float innerCutoff;
+    uint type;
+    uint padding0;
+    uint padding1;
+};
+
+struct ClusterParameters {
+    mat4 view;
+    vec4 depth;
+    vec4 projection;
+    uvec4 grid;
+};
+
+const uint CASCADE_COUNT = 4;
+const uint MAX_LIGHTS_PER_CLUSTER = 128;
+const uint LIGHT_TYPE_SPOT = 1;
+
+layout(set = 0, binding = 0) uniform GlobalUbo {
+    mat4 projectionView;
+    mat4 lightProjectionView[CASCADE_COUNT];
+    vec4 lightDirection;
+    vec4 lightColor;
+    vec4 cameraPosition;
+} ubo;
+
+layout(set = 0, binding = 1) uniform sampler2DArrayShadow shadowMap;
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+layout(set = 1, binding = 1) readonly buffer MaterialBuffer {
+    Material materials[];
+};
+
+layout(set = 2, binding = 0) readonly buffer LightBuffer {
+    ClusterParameters parameters;
+    Light lights[];
+};
+
+layout(set = 2, binding = 1) readonly buffer ClusterBuffer {
+    uint clusterData[];
+};
+
+layout(push_constant) uniform Push {
+    mat4 transform;
+    uint materialIndex;
+} push;
+
+float sampleShadow(vec3 position) {
+    for (uint cascade = 0; cascade < CASCADE_COUNT; ++cascade) {
+        vec4 lightPosition = ubo.lightProjectionView[cascade] * vec4(position, 1.0);
+        vec3 coordinates = lightPosition.xyz / lightPosition.w;
+        vec2 shadowUv = coordinates.xy * 0.5 + 0.5;
+
+        if (any(lessThan(shadowUv, vec2(0.0))) || any(greaterThan(shadowUv, vec2(1.0))) || coordinates.z > 1.0) {
+            continue;
+        }
+
+        vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+        float visibility = 0.0;
+        for (int x = -1; x <= 1; ++x) {
+            for (int y = -1; y <= 1; ++y) {
+                visibility += texture(shadowMap, vec4(shadowUv + vec2(x, y) * texelSize, float(cascade), coordinates.z));
+            }
+        }
+
+        return visibility / 9.0;
+    }
+
+    return 1.0;
+}
+
+vec3 shadeLocalLights(vec3 position, vec3 normal) {
+    float near = parameters.depth.z;
+    float far = parameters.depth.w;
+    float viewDepth = near * far / (far - gl_FragCoord.z * (far - near));
+
+    uvec4 grid = parameters.grid;
+    uint slice = uint(clamp(log(viewDepth) * parameters.depth.x + parameters.depth.y, 0.0, float(grid.z - 1)));
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / parameters.projection.zw), grid.xy - 1);
+    uint cluster = (slice * grid.y + tile.y) * grid.x + tile.x;
+
+    uint lightCount = clusterData[cluster];
+    uint firstSlot = grid.x * grid.y * grid.z + cluster * MAX_LIGHTS_PER_CLUSTER;
+
+    vec3 lighting = vec3(0.0);
+    for (uint i = 0; i < lightCount; ++i) {
+        Light light = lights[clusterData[firstSlot + i]];
+
+        vec3 toLight = light.position - position;
+        float distance = length(toLight);
+        if (distance >= light.radius) {
+            continue;
+        }
+
+        vec3 direction = toLight / max(distance, 0.0001);
+        float attenuation = 1.0 - distance / light.radius;
+        attenuation *= attenuation;
+
+        if (light.type == LIGHT_TYPE_SPOT) {
+            attenuation *= smoothstep(light.outerCutoff, light.innerCutoff, dot(-direction, light.direction));
+        }
+
+        lighting += light.color * light.intensity * attenuation * max(dot(normal, direction), 0.0);
+    }
+
+    return lighting;
+}
+
+void main() {
+    Material material = materials[push.materialIndex];
+    vec4 textureColor = texture(textures[nonuniformEXT(material.textureIndex)], faceUv);
+
+    vec3 normal = normalize(cross(dFdx(worldPosition), dFdy(worldPosition)));
+    if (dot(normal, ubo.cameraPosition.xyz - worldPosition) < 0.0) {
+        normal = -normal;
+    }
+
+    float diffuse = max(dot(normal, -ubo.lightDirection.xyz), 0.0);
+    float shadow = diffuse > 0.0 ? sampleShadow(worldPosition) : 1.0;
+    vec3 lighting = ubo.lightColor.rgb * diffuse * shadow + ubo.lightColor.a + shadeLocalLights(worldPosition, normal);
+
+    fragColor = vec4(faceColor * lighting, 1.0) * material.baseColor * textureColor;
+}
\ No newline at end of file
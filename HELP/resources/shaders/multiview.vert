@@ -0,0 +1,24 @@
+#version 450
+#extension GL_EXT_multiview : require
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec2 uv;
+
+layout(location = 0) out vec3 faceColor;
+layout(location = 1) out vec2 faceUv;
+
+layout(set = 0, binding = 0) uniform ViewUbo {
+    mat4 projectionView[6];
+} ubo;
+
+layout(push_constant) uniform Push {
+    mat4 transform;
+    uint materialIndex;
+} push;
+
+void main() {
+    gl_Position = ubo.projectionView[gl_ViewIndex] * push.transform * vec4(position, 1.0);
+    faceColor = color;
+    faceUv = uv;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#version 450
+#extension GL_EXT_multiview : require
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference_uvec2 : require
+
+layout(location = 0) out vec3 faceColor;
+layout(location = 1) out vec2 faceUv;
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer VertexBuffer {
+    float data[];
+};
+
+layout(set = 0, binding = 0) uniform ViewUbo {
+    mat4 projectionView[6];
+} ubo;
+
+layout(push_constant) uniform Push {
+    mat4 transform;
+    uint materialIndex;
+    uvec2 vertexAddress;
+} push;
+
+const uint VERTEX_FLOATS = 8;
+
+void main() {
+    VertexBuffer vertices = VertexBuffer(push.vertexAddress);
+    uint base = uint(gl_VertexIndex) * VERTEX_FLOATS;
+
+    vec3 position = vec3(vertices.data[base], vertices.data[base + 1], vertices.data[base + 2]);
+    vec3 color = vec3(vertices.data[base + 3], vertices.data[base + 4], vertices.data[base + 5]);
+    vec2 uv = vec2(vertices.data[base + 6], vertices.data[base + 7]);
+
+    gl_Position = ubo.projectionView[gl_ViewIndex] * push.transform * vec4(position, 1.0);
+    faceColor = color;
+    faceUv = uv;
+}
\ No newline at end of file
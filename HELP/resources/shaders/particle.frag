@@ -0,0 +1,15 @@
+#version 450
+
+layout(location = 0) in vec4 particleColor;
+layout(location = 1) in vec2 particleUv;
+
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    float falloff = 1.0 - dot(particleUv, particleUv);
+    if (falloff <= 0.0) {
+        discard;
+    }
+
+    fragColor = vec4(particleColor.rgb, particleColor.a * falloff);
+}
\ No newline at end of file
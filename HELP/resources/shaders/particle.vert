@@ -0,0 +1,41 @@
+#version 450
+
+struct Particle {
+    vec4 positionLife;
+    vec4 velocityColor;
+};
+
+layout(location = 0) out vec4 particleColor;
+layout(location = 1) out vec2 particleUv;
+
+layout(set = 0, binding = 0) readonly buffer ParticleBuffer {
+    Particle particles[];
+};
+
+layout(set = 0, binding = 2) readonly buffer AliveListBuffer {
+    uint aliveList[];
+};
+
+layout(push_constant) uniform Push {
+    mat4 projectionView;
+    vec4 cameraRight;
+    vec4 cameraUp;
+    uint aliveOffset;
+} push;
+
+const vec2 corners[6] = vec2[](
+    vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+    vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0)
+);
+
+void main() {
+    Particle particle = particles[aliveList[push.aliveOffset + gl_InstanceIndex]];
+    vec2 corner = corners[gl_VertexIndex];
+
+    vec3 position = particle.positionLife.xyz + (push.cameraRight.xyz * corner.x + push.cameraUp.xyz * corner.y) * push.cameraRight.w;
+    gl_Position = push.projectionView * vec4(position, 1.0);
+
+    particleColor = unpackUnorm4x8(floatBitsToUint(particle.velocityColor.w));
+    particleColor.a *= clamp(particle.positionLife.w, 0.0, 1.0);
+    particleUv = corner;
+}
\ No newline at end of file
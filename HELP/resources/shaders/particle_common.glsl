@@ -0,0 +1,54 @@
+struct Particle {
+    vec4 positionLife;
+    vec4 velocityColor;
+};
+
+struct Emitter {
+    vec4 positionSpread;
+    vec4 velocityLifetime;
+    vec4 color;
+    uint firstParticle;
+    uint particleCount;
+    uint padding0;
+    uint padding1;
+};
+
+layout(set = 0, binding = 0) buffer ParticleBuffer {
+    Particle particles[];
+};
+
+layout(set = 0, binding = 1) buffer DeadListBuffer {
+    uint deadList[];
+};
+
+layout(set = 0, binding = 2) buffer AliveListBuffer {
+    uint aliveList[];
+};
+
+layout(set = 0, binding = 3) buffer CounterBuffer {
+    uint deadCount;
+    uint aliveCount[2];
+    uint emitCount;
+    uint dispatchX;
+    uint dispatchY;
+    uint dispatchZ;
+    uint padding;
+    uint vertexCount;
+    uint instanceCount;
+    uint firstVertex;
+    uint firstInstance;
+};
+
+layout(set = 0, binding = 4) readonly buffer EmitterBuffer {
+    Emitter emitters[];
+};
+
+layout(push_constant) uniform Push {
+    vec4 gravityDeltaTime;
+    uint maxParticles;
+    uint emitterCount;
+    uint requestedEmitCount;
+    uint seed;
+    uint current;
+    uint mode;
+} push;
@@ -0,0 +1,23 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference_uvec2 : require
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer VertexBuffer {
+    float data[];
+};
+
+layout(push_constant) uniform Push {
+    mat4 transform;
+    uvec2 vertexAddress;
+} push;
+
+const uint VERTEX_FLOATS = 8;
+
+void main() {
+    VertexBuffer vertices = VertexBuffer(push.vertexAddress);
+    uint base = uint(gl_VertexIndex) * VERTEX_FLOATS;
+
+    vec3 position = vec3(vertices.data[base], vertices.data[base + 1], vertices.data[base + 2]);
+
+    gl_Position = push.transform * vec4(position, 1.0);
+}
\ No newline at end of file
@@ -1,9 +1,30 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec3 faceColor;
+layout(location = 1) in vec2 faceUv;
 
 layout(location = 0) out vec4 fragColor;
 
+struct Material {
+    vec4 baseColor;
+    uint textureIndex;
+};
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+layout(set = 1, binding = 1) readonly buffer MaterialBuffer {
+    Material materials[];
+};
+
+layout(push_constant) uniform Push {
+    mat4 transform;
+    uint materialIndex;
+} push;
+
 void main() {
-    fragColor = vec4(faceColor, 1.0);
+    Material material = materials[push.materialIndex];
+    vec4 textureColor = texture(textures[nonuniformEXT(material.textureIndex)], faceUv);
+
+    fragColor = vec4(faceColor, 1.0) * material.baseColor * textureColor;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#version 450
+
+layout(location = 0) in vec2 uv;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 0, binding = 0) uniform sampler2D sceneColor;
+
+layout(push_constant) uniform Push {
+    vec2 uvScale;
+    vec2 texelSize;
+    vec2 minUv;
+    vec2 maxUv;
+} push;
+
+vec4 sampleScene(vec2 coordinates) {
+    return textureLod(sceneColor, clamp(coordinates, push.minUv, push.maxUv), 0.0);
+}
+
+vec4 sampleCatmullRom(vec2 coordinates) {
+    vec2 samplePosition = coordinates / push.texelSize;
+    vec2 center = floor(samplePosition - 0.5) + 0.5;
+    vec2 f = samplePosition - center;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    vec2 w12 = w1 + w2;
+    vec2 offset12 = w2 / w12;
+
+    vec2 position0 = (center - 1.0) * push.texelSize;
+    vec2 position3 = (center + 2.0) * push.texelSize;
+    vec2 position12 = (center + offset12) * push.texelSize;
+
+    vec4 result = vec4(0.0);
+    result += sampleScene(vec2(position0.x, position0.y)) * w0.x * w0.y;
+    result += sampleScene(vec2(position12.x, position0.y)) * w12.x * w0.y;
+    result += sampleScene(vec2(position3.x, position0.y)) * w3.x * w0.y;
+
+    result += sampleScene(vec2(position0.x, position12.y)) * w0.x * w12.y;
+    result += sampleScene(vec2(position12.x, position12.y)) * w12.x * w12.y;
+    result += sampleScene(vec2(position3.x, position12.y)) * w3.x * w12.y;
+
+    result += sampleScene(vec2(position0.x, position3.y)) * w0.x * w3.y;
+    result += sampleScene(vec2(position12.x, position3.y)) * w12.x * w3.y;
+    result += sampleScene(vec2(position3.x, position3.y)) * w3.x * w3.y;
+
+    return max(result, vec4(0.0));
+}
+
+void main() {
+    outColor = sampleCatmullRom(uv * push.uvScale);
+}
\ No newline at end of file
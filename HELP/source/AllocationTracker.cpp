@@ -0,0 +1,177 @@
+#include "AllocationTracker.h"
+
+namespace eng {
+	std::array<AllocationTracker::Counters, AllocationTracker::CATEGORY_COUNT> AllocationTracker::s_categories{};
+	AllocationTracker::Counters AllocationTracker::s_total{};
+
+	AllocationTracker::Statistics AllocationTracker::getStatistics() {
+		return getStatistics(AllocationCategory::Heap);
+	}
+
+	AllocationTracker::Statistics AllocationTracker::getStatistics(AllocationCategory category) {
+		return load(s_categories[static_cast<std::size_t>(category)]);
+	}
+
+	AllocationTracker::Statistics AllocationTracker::getTotalStatistics() {
+		return load(s_total);
+	}
+
+	void AllocationTracker::recordAllocation(AllocationCategory category, std::size_t size) {
+		add(s_categories[static_cast<std::size_t>(category)], size);
+		add(s_total, size);
+	}
+
+	void AllocationTracker::recordFree(AllocationCategory category, std::size_t size) {
+		remove(s_categories[static_cast<std::size_t>(category)], size);
+		remove(s_total, size);
+	}
+
+	void *AllocationTracker::allocate(std::size_t size) {
+		std::uint8_t *memory = static_cast<std::uint8_t *>(std::malloc(HEADER_SIZE + size));
+		if (memory == nullptr) {
+			throw std::bad_alloc();
+		}
+
+		*reinterpret_cast<std::size_t *>(memory) = size;
+		recordAllocation(AllocationCategory::Heap, size);
+
+		return memory + HEADER_SIZE;
+	}
+
+	void *AllocationTracker::allocate(std::size_t size, std::size_t alignment) {
+		std::uint8_t *memory = static_cast<std::uint8_t *>(std::malloc(sizeof(AlignedHeader) + alignment - 1 + size));
+		if (memory == nullptr) {
+			throw std::bad_alloc();
+		}
+
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory) + sizeof(AlignedHeader);
+		address = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+		AlignedHeader *header = reinterpret_cast<AlignedHeader *>(address) - 1;
+		header->memory = memory;
+		header->size = size;
+		recordAllocation(AllocationCategory::Heap, size);
+
+		return reinterpret_cast<void *>(address);
+	}
+
+	void AllocationTracker::deallocate(void *pointer) {
+		if (pointer == nullptr) {
+			return;
+		}
+
+		std::uint8_t *memory = static_cast<std::uint8_t *>(pointer) - HEADER_SIZE;
+		recordFree(AllocationCategory::Heap, *reinterpret_cast<std::size_t *>(memory));
+		std::free(memory);
+	}
+
+	void AllocationTracker::deallocateAligned(void *pointer) {
+		if (pointer == nullptr) {
+			return;
+		}
+
+		AlignedHeader *header = static_cast<AlignedHeader *>(pointer) - 1;
+		recordFree(AllocationCategory::Heap, header->size);
+		std::free(header->memory);
+	}
+
+	const char *AllocationTracker::getCategoryName(AllocationCategory category) {
+		switch (category) {
+		case AllocationCategory::Heap:
+			return "Heap";
+		case AllocationCategory::Instance:
+			return "Instance";
+		case AllocationCategory::Device:
+			return "Device";
+		case AllocationCategory::Swapchain:
+			return "Swapchain";
+		case AllocationCategory::Pipeline:
+			return "Pipelines";
+		case AllocationCategory::Descriptor:
+			return "Descriptors";
+		case AllocationCategory::Command:
+			return "Command pools";
+		case AllocationCategory::Resource:
+			return "Buffers and images";
+		case AllocationCategory::Synchronization:
+			return "Synchronization";
+		case AllocationCategory::Query:
+			return "Queries";
+		default:
+			return "Other";
+		}
+	}
+
+	void AllocationTracker::add(Counters &counters, std::size_t size) {
+		counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+		counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		std::uint64_t currentBytes = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		std::uint64_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+		while (currentBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed)) {
+		}
+	}
+
+	void AllocationTracker::remove(Counters &counters, std::size_t size) {
+		counters.deallocationCount.fetch_add(1, std::memory_order_relaxed);
+		counters.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	AllocationTracker::Statistics AllocationTracker::load(const Counters &counters) {
+		Statistics statistics{};
+		statistics.allocationCount = counters.allocationCount.load(std::memory_order_relaxed);
+		statistics.deallocationCount = counters.deallocationCount.load(std::memory_order_relaxed);
+		statistics.allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+		statistics.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+		statistics.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+		return statistics;
+	}
+}
+
+void *operator new(std::size_t size) {
+	return eng::AllocationTracker::allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+	return eng::AllocationTracker::allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+	eng::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+	eng::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+	eng::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+	eng::AllocationTracker::deallocate(pointer);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+	return eng::AllocationTracker::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+	return eng::AllocationTracker::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+	eng::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+	eng::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+	eng::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept {
+	eng::AllocationTracker::deallocateAligned(pointer);
+}
\ No newline at end of file
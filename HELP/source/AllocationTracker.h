@@ -0,0 +1,77 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <atomic>
+#include <array>
+#include <new>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+namespace eng {
+	enum class AllocationCategory : std::uint32_t {
+		Heap,
+		Instance,
+		Device,
+		Swapchain,
+		Pipeline,
+		Descriptor,
+		Command,
+		Resource,
+		Synchronization,
+		Query,
+		Count
+	};
+
+	class AllocationTracker {
+	public:
+		static constexpr std::size_t CATEGORY_COUNT = static_cast<std::size_t>(AllocationCategory::Count);
+
+		struct Statistics {
+			std::uint64_t allocationCount = 0;
+			std::uint64_t deallocationCount = 0;
+			std::uint64_t allocatedBytes = 0;
+			std::uint64_t currentBytes = 0;
+			std::uint64_t peakBytes = 0;
+		};
+
+		static Statistics getStatistics();
+		static Statistics getStatistics(AllocationCategory category);
+		static Statistics getTotalStatistics();
+
+		static void recordAllocation(AllocationCategory category, std::size_t size);
+		static void recordFree(AllocationCategory category, std::size_t size);
+
+		static void *allocate(std::size_t size);
+		static void *allocate(std::size_t size, std::size_t alignment);
+		static void deallocate(void *pointer);
+		static void deallocateAligned(void *pointer);
+
+		static const char *getCategoryName(AllocationCategory category);
+	private:
+		struct Counters {
+			std::atomic<std::uint64_t> allocationCount{ 0 };
+			std::atomic<std::uint64_t> deallocationCount{ 0 };
+			std::atomic<std::uint64_t> allocatedBytes{ 0 };
+			std::atomic<std::uint64_t> currentBytes{ 0 };
+			std::atomic<std::uint64_t> peakBytes{ 0 };
+		};
+
+		struct AlignedHeader {
+			void *memory;
+			std::size_t size;
+		};
+
+		static void add(Counters &counters, std::size_t size);
+		static void remove(Counters &counters, std::size_t size);
+		static Statistics load(const Counters &counters);
+
+		static std::array<Counters, CATEGORY_COUNT> s_categories;
+		static Counters s_total;
+
+		static constexpr std::size_t HEADER_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+		static_assert(HEADER_SIZE >= sizeof(std::size_t), "Allocation header is too small.");
+	};
+}
+
+#endif
\ No newline at end of file
@@ -1,27 +1,252 @@
 #include "Application.h"
 
 namespace eng {
+	struct GlobalUbo {
+		glm::mat4 projectionView{ 1.0f };
+		std::array<glm::mat4, ShadowMap::CASCADE_COUNT> lightProjectionView{};
+		glm::vec4 lightDirection{ 0.0f };
+		glm::vec4 lightColor{ 0.0f };
+		glm::vec4 cameraPosition{ 0.0f };
+	};
+
 	struct TransformPushConstantData {
 		glm::mat4 transform{ 1.0f };
+		std::uint32_t materialIndex = 0;
+		std::uint32_t padding = 0;
+		VkDeviceAddress vertexAddress = 0;
 	};
 
 	Application::Application() {
+		createSecurityCameras();
+		createShadowMap();
+		createClusteredLighting();
+		createDynamicResolution();
 		loadGameObjects();
+		createDescriptorSetLayout();
 		createPipelineLayout();
+		createUniformBuffers();
+		createDescriptorPool();
+		createDescriptorSets();
+		createParticleSystem();
 	}
 
 	Application::~Application() {
-		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, nullptr);
+		m_renderQueue.close();
+		if (m_renderThread.joinable()) {
+			m_renderThread.join();
+		}
+
+		m_dynamicResolution.reset();
+		m_clusteredLighting.reset();
+		m_shadowMap.reset();
+		m_viewRenderer.reset();
+		m_securityCameraTarget.reset();
+
+		for (std::size_t i = 0; i < m_uniformBuffers.size(); ++i) {
+			vkUnmapMemory(m_device.getDevice(), m_uniformBuffersMemory[i]);
+			vkDestroyBuffer(m_device.getDevice(), m_uniformBuffers[i], VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(m_uniformBuffersMemory[i]);
+		}
+
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
 	}
 
 	void Application::run() {
+		m_camera.setViewTarget({ -1.0f, -2.0f, -2.0f }, { 0.0f, 0.0f, 2.5f });
+
+		m_simulation.start();
+		m_renderThread = std::thread(&Application::renderLoop, this);
+
+		auto previousTime = std::chrono::high_resolution_clock::now();
 		while (!m_window.shouldClose()) {
 			m_window.update();
 
-			drawFrame();
+			auto currentTime = std::chrono::high_resolution_clock::now();
+			float frameTime = std::chrono::duration<float>(currentTime - previousTime).count();
+			previousTime = currentTime;
+
+			m_simulation.wait();
+			m_simulation.interpolate(m_renderTransforms);
+			m_simulation.advance(frameTime);
+
+			VkExtent2D extent = m_window.getExtent();
+			if (extent.width > 0 && extent.height > 0) {
+				m_camera.setPerspectiveProjection(glm::radians(50.0f), static_cast<float>(extent.width) / static_cast<float>(extent.height), 0.1f, 100.0f);
+			}
+
+			updateGameObjects();
+
+			auto waitStart = std::chrono::high_resolution_clock::now();
+			RenderFrame *frame = m_renderQueue.acquireWrite();
+			if (frame == nullptr) {
+				break;
+			}
+			auto waitEnd = std::chrono::high_resolution_clock::now();
+
+			frame->camera = m_camera;
+			frame->frameTime = frameTime;
+			cullGameObjects(*frame);
+			cullViews(*frame);
+			cullShadowCasters(*frame);
+			animateLights(*frame);
+
+			frame->gameTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - currentTime).count() - std::chrono::duration<float>(waitEnd - waitStart).count();
+			m_renderQueue.publish();
 		}
 
+		m_renderQueue.close();
+		m_renderThread.join();
+
+		m_simulation.stop();
+
 		vkDeviceWaitIdle(m_device.getDevice());
+
+		if (m_renderException) {
+			std::rethrow_exception(m_renderException);
+		}
+
+		MemoryReport::exportJson(MEMORY_REPORT_PATH, m_memoryReport.capture());
+	}
+
+	void Application::renderLoop() {
+		try {
+			auto previousTime = std::chrono::high_resolution_clock::now();
+			while (RenderFrame *frame = m_renderQueue.acquireRead()) {
+				auto startTime = std::chrono::high_resolution_clock::now();
+				drawFrame(*frame);
+				auto endTime = std::chrono::high_resolution_clock::now();
+
+				float frameTime = std::chrono::duration<float>(endTime - previousTime).count();
+				previousTime = endTime;
+
+				++m_frameStatistics.frameCount;
+				m_memoryReport.markFrame();
+				m_frameStatistics.elapsedTime += frameTime;
+				m_frameStatistics.gameTime += frame->gameTime;
+				m_frameStatistics.renderTime += std::chrono::duration<float>(endTime - startTime).count();
+
+				m_renderQueue.release();
+
+				if (m_frameStatistics.elapsedTime >= 1.0f) {
+					printFrameStatistics();
+					m_frameStatistics = {};
+					m_renderer.getFrameLimiter().resetStatistics();
+					m_frameStatistics.uploadedTextureBytes = m_textureStreamer.getUploadedBytes();
+				}
+
+				m_memoryLogTime += frameTime;
+				if (m_memoryLogTime >= MEMORY_LOG_INTERVAL) {
+					m_device.getMemoryBudget().printUsage();
+					MemoryReport::print(m_memoryReport.capture());
+					m_memoryLogTime = 0.0f;
+				}
+			}
+		} catch (...) {
+			m_renderException = std::current_exception();
+			m_renderQueue.close();
+		}
+	}
+
+	void Application::printFrameStatistics() {
+		const FrameStatistics &statistics = m_frameStatistics;
+		const FrameLimiter::Statistics pacing = m_renderer.getFrameLimiter().getStatistics();
+
+		std::cout << "Frame time: " << statistics.elapsedTime * 1000.0f / statistics.frameCount << " ms";
+		std::cout << " (game thread " << statistics.gameTime * 1000.0f / statistics.frameCount << " ms";
+		std::cout << ", render thread " << statistics.renderTime * 1000.0f / statistics.frameCount << " ms)";
+		std::cout << ", draw calls: " << statistics.drawCalls / statistics.frameCount;
+		std::cout << " (" << statistics.drawCalls / statistics.elapsedTime << "/s)";
+		std::cout << ", pipeline binds: " << statistics.pipelineBinds / statistics.frameCount;
+		std::cout << ", descriptor set binds: " << statistics.descriptorSetBinds / statistics.frameCount;
+		std::cout << ", geometry binds: " << statistics.geometryBinds / statistics.frameCount;
+		std::cout << ", push constants: " << statistics.pushConstantUpdates / statistics.frameCount;
+		std::cout << ", skipped binds: " << statistics.skippedBinds / statistics.frameCount;
+		std::cout << " (" << (m_geometryPool.isVertexPullingEnabled() ? "vertex pulling" : "vertex input") << ")";
+		std::cout << ", frame arena: " << m_renderer.getFrameAllocator().getStatistics().highWaterMark / 1024.0 << " KB";
+		std::cout << ", views: " << m_viewRenderer->getStatistics().viewCount << " (" << m_viewRenderer->getStatistics().draws << " draws)";
+		std::cout << ", shadow cascades: " << m_shadowMap->getStatistics().renderedCascades << " rendered, " << m_shadowMap->getStatistics().cachedCascades << " cached (" << m_shadowMap->getStatistics().draws << " draws)";
+		std::cout << ", lights: " << m_clusteredLighting->getLightCount() << " (" << (m_clusteredLighting->isGpuBinningEnabled() ? "GPU" : "CPU") << " binning)";
+		std::cout << ", present: " << Swapchain::getPresentModeName(m_renderer.getSwapchain().getPresentMode());
+		if (m_renderer.getFrameLimiter().getTargetFrameRate() > 0.0f) {
+			std::cout << " (limit " << m_renderer.getFrameLimiter().getTargetFrameRate() << " fps)";
+		}
+		std::cout << ", render graph rebuilds: " << m_renderer.getRenderGraphExecutor().getRebuildCount();
+		if (m_renderer.getLastRecreationTime() > 0.0) {
+			std::cout << ", swapchain recreation: " << m_renderer.getLastRecreationTime() << " ms (" << (m_device.isDynamicRenderingEnabled() ? "dynamic rendering" : "render passes") << ")";
+		}
+		std::cout << ", jitter: " << pacing.jitter << " ms, CPU: " << pacing.cpuUsage * 100.0 << "%";
+		std::cout << ", resolution: " << m_dynamicResolution->getRenderExtent().width << "x" << m_dynamicResolution->getRenderExtent().height << " (" << m_dynamicResolution->getController().getScale() * 100.0f << "%, GPU " << m_dynamicResolution->getController().getFilteredFrameTime() << " / " << m_dynamicResolution->getController().getTargetFrameTime() << " ms)";
+		std::cout << ", materials: " << m_bindlessResources.getMaterialCount();
+		std::cout << ", texture memory: " << m_textureStreamer.getResidentBytes() / (1024.0 * 1024.0) << " MB";
+		std::cout << ", streaming: " << (m_textureStreamer.getUploadedBytes() - statistics.uploadedTextureBytes) / (1024.0 * 1024.0) / statistics.elapsedTime << " MB/s\n";
+	}
+
+	void Application::createSecurityCameras() {
+		RenderTarget::Description description{};
+		description.extent = { SECURITY_CAMERA_RESOLUTION * 2, SECURITY_CAMERA_RESOLUTION * 2 };
+		description.format = VK_FORMAT_R8G8B8A8_UNORM;
+
+		m_securityCameraTarget = std::make_unique<RenderTarget>(m_device, description);
+		m_viewRenderer = std::make_unique<ViewRenderer>(m_device, m_renderer.getSwapchain(), m_bindlessResources, m_geometryPool, m_renderer.getSwapchain().MAX_FRAMES_IN_FLIGHT);
+
+		const std::array<glm::vec3, 4> positions{
+			glm::vec3{ -4.0f, -2.0f, -1.0f },
+			glm::vec3{ 4.0f, -2.0f, -1.0f },
+			glm::vec3{ -4.0f, -3.0f, 6.0f },
+			glm::vec3{ 4.0f, -3.0f, 6.0f }
+		};
+
+		for (std::uint32_t i = 0; i < positions.size(); ++i) {
+			VkRect2D region{};
+			region.offset = { static_cast<std::int32_t>(i % 2 * SECURITY_CAMERA_RESOLUTION), static_cast<std::int32_t>(i / 2 * SECURITY_CAMERA_RESOLUTION) };
+			region.extent = { SECURITY_CAMERA_RESOLUTION, SECURITY_CAMERA_RESOLUTION };
+
+			Camera camera{};
+			camera.setPerspectiveProjection(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+			camera.setViewTarget(positions[i], { 0.0f, 0.0f, 2.5f });
+
+			View view(*m_securityCameraTarget, region);
+			view.setCamera(camera);
+			m_viewRenderer->addView(view);
+		}
+
+		std::uint32_t texture = m_bindlessResources.addTexture(m_securityCameraTarget->getImageView(), m_securityCameraTarget->getSampler());
+		m_monitorMaterial = m_bindlessResources.addMaterial({ glm::vec4{ 1.0f }, texture });
+	}
+
+	void Application::createShadowMap() {
+		m_shadowMap = std::make_unique<ShadowMap>(m_device, m_renderer.getSwapchain(), m_geometryPool, ShadowMap::Settings{});
+		m_shadowMap->setLightDirection({ 0.4f, 1.0f, 0.3f });
+	}
+
+	void Application::createClusteredLighting() {
+		m_clusteredLighting = std::make_unique<ClusteredLighting>(m_device, MAX_LIGHTS, m_renderer.getSwapchain().MAX_FRAMES_IN_FLIGHT);
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> positionX{ -MATERIAL_GRID_SIZE * 0.2f, MATERIAL_GRID_SIZE * 0.2f };
+		std::uniform_real_distribution<float> positionZ{ 0.0f, MATERIAL_GRID_SIZE * 0.4f };
+		std::uniform_real_distribution<float> radius{ 1.0f, 2.5f };
+		std::uniform_real_distribution<float> channel{ 0.2f, 1.0f };
+
+		for (std::uint32_t i = 0; i < LIGHT_COUNT; ++i) {
+			const glm::vec3 position{ positionX(random), 0.8f, positionZ(random) };
+			const glm::vec3 color{ channel(random), channel(random), channel(random) };
+
+			if (i % 4 == 0) {
+				m_lights.push_back(ClusteredLighting::Light::createSpotLight(position, { 0.0f, 1.0f, 0.0f }, radius(random) * 1.5f, glm::radians(35.0f), glm::radians(25.0f), color, 2.0f));
+			} else {
+				m_lights.push_back(ClusteredLighting::Light::createPointLight(position, radius(random), color, 1.0f));
+			}
+		}
+	}
+
+	void Application::createDynamicResolution() {
+		ResolutionController::Settings settings{};
+		settings.targetFrameTime = TARGET_GPU_FRAME_TIME;
+
+		m_dynamicResolution = std::make_unique<DynamicResolution>(m_device, m_renderer.getSwapchain(), settings, m_renderer.getSwapchain().MAX_FRAMES_IN_FLIGHT);
 	}
 
 	void Application::loadGameObjects() {
@@ -69,70 +294,547 @@ namespace eng {
 			{ { .5f, .5f, -0.5f }, {.1f, .8f, .1f }}
 		};
 
-		std::shared_ptr<Model> model = std::make_shared<Model>(m_device, vertices);
+		for (std::size_t i = 0; i < vertices.size(); ++i) {
+			const glm::vec3 &position = vertices[i].position;
+
+			switch (i / 12) {
+			case 0:
+				vertices[i].uv = { position.z + 0.5f, position.y + 0.5f };
+				break;
+			case 1:
+				vertices[i].uv = { position.x + 0.5f, position.z + 0.5f };
+				break;
+			default:
+				vertices[i].uv = { position.x + 0.5f, position.y + 0.5f };
+				break;
+			}
+		}
+
+		Model::Builder builder{};
+		builder.vertices = vertices;
+		builder.generateLods(4, 0.5f, 0.05f);
+
+		std::shared_ptr<Model> model = std::make_shared<Model>(m_geometryPool, builder);
+
+		const std::uint32_t sphereSegments = 64;
+		const std::uint32_t sphereRings = 32;
+
+		Model::Builder sphereBuilder{};
+		for (std::uint32_t ring = 0; ring <= sphereRings; ++ring) {
+			float phi = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(sphereRings);
+			for (std::uint32_t segment = 0; segment <= sphereSegments; ++segment) {
+				float theta = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(sphereSegments);
+
+				glm::vec3 position{ std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) };
+				sphereBuilder.vertices.push_back({ position * 0.5f, { 1.0f, 1.0f, 1.0f }, { static_cast<float>(segment) / sphereSegments, static_cast<float>(ring) / sphereRings } });
+			}
+		}
+
+		for (std::uint32_t ring = 0; ring < sphereRings; ++ring) {
+			for (std::uint32_t segment = 0; segment < sphereSegments; ++segment) {
+				std::uint32_t a = ring * (sphereSegments + 1) + segment;
+				std::uint32_t b = a + sphereSegments + 1;
+
+				sphereBuilder.indices.insert(sphereBuilder.indices.end(), { a, b, a + 1, b, b + 1, a + 1 });
+			}
+		}
+		sphereBuilder.generateLods(4, 0.5f, 0.01f);
+
+		std::shared_ptr<Model> sphereModel = std::make_shared<Model>(m_geometryPool, sphereBuilder);
+
+		GameObject cube = GameObject::createGameObject();
+		cube.model = model;
+		cube.color = { 0.1f, 0.8f, 0.1f };
+		cube.transform.translation = { 0.0f, 0.0f, 2.5f };
+		cube.transform.scale = { 0.5f, 0.5f, 0.5f };
+		cube.transform.rotation = { 0.0f, 0.0f, 0.0f};
+
+		cube.texture = m_textureStreamer.load("resources/textures/checker.ktx2");
+		cube.material = m_bindlessResources.addMaterial({ glm::vec4{ 1.0f }, m_textureStreamer.getBindlessIndex(cube.texture) });
+		cube.sceneNode = m_sceneGraph.createNode(SceneGraph::INVALID_NODE, cube.transform);
+
+		GameObject satellite = GameObject::createGameObject();
+		satellite.model = sphereModel;
+		satellite.color = { 0.8f, 0.1f, 0.1f };
+		satellite.transform.translation = { 2.0f, 0.0f, 0.0f };
+		satellite.transform.scale = { 0.3f, 0.3f, 0.3f };
+		satellite.texture = cube.texture;
+		satellite.material = m_bindlessResources.addMaterial({ glm::vec4{ satellite.color, 1.0f }, m_textureStreamer.getBindlessIndex(satellite.texture) });
+		satellite.sceneNode = m_sceneGraph.createNode(cube.sceneNode, satellite.transform);
 
-		GameObject triangle = GameObject::createGameObject();
-		triangle.model = model;
-		triangle.color = { 0.1f, 0.8f, 0.1f };
-		triangle.transform.translation = { 0.0f, 0.0f, 0.5f };
-		triangle.transform.scale = { 0.5f, 0.5f, 0.5f };
-		triangle.transform.rotation = { 0.0f, 0.0f, 0.0f};
+		GameObject monitor = GameObject::createGameObject();
+		monitor.model = model;
+		monitor.color = { 1.0f, 1.0f, 1.0f };
+		monitor.transform.translation = { -2.5f, -1.0f, 5.0f };
+		monitor.transform.scale = { 1.6f, 1.6f, 0.05f };
+		monitor.material = m_monitorMaterial;
+		monitor.sceneNode = m_sceneGraph.createNode(SceneGraph::INVALID_NODE, monitor.transform);
 
-		m_gameObjects.push_back(std::move(triangle));
+		m_simulation.addBody(cube.transform, { 0.06f, 0.06f, 0.0f });
+		m_simulation.addBody(satellite.transform, { 0.0f, 0.0f, 0.0f });
+		m_simulation.addBody(monitor.transform, { 0.0f, 0.0f, 0.0f });
+
+		m_gameObjects.push_back(std::move(cube));
+		m_gameObjects.push_back(std::move(satellite));
+		m_gameObjects.push_back(std::move(monitor));
+
+		for (std::uint32_t x = 0; x < MATERIAL_GRID_SIZE; ++x) {
+			for (std::uint32_t z = 0; z < MATERIAL_GRID_SIZE; ++z) {
+				GameObject tile = GameObject::createGameObject();
+				tile.model = model;
+				tile.color = {
+					static_cast<float>(x) / MATERIAL_GRID_SIZE,
+					0.5f,
+					static_cast<float>(z) / MATERIAL_GRID_SIZE
+				};
+				tile.transform.translation = {
+					(static_cast<float>(x) - MATERIAL_GRID_SIZE * 0.5f) * 0.4f,
+					1.5f,
+					static_cast<float>(z) * 0.4f
+				};
+				tile.transform.scale = { 0.3f, 0.1f, 0.3f };
+				tile.material = m_bindlessResources.addMaterial({ glm::vec4{ tile.color, 1.0f } });
+				tile.sceneNode = m_sceneGraph.createNode(SceneGraph::INVALID_NODE, tile.transform);
+
+				m_simulation.addBody(tile.transform, { 0.0f, 0.0f, 0.0f });
+
+				m_gameObjects.push_back(std::move(tile));
+			}
+		}
+
+		m_geometryPool.flush();
+		m_sceneGraph.update();
+
+		for (std::size_t i = 0; i < m_gameObjects.size(); ++i) {
+			GameObject &gameObject = m_gameObjects[i];
+
+			BoundingBox box = gameObject.model->getBoundingBox().transform(m_sceneGraph.getWorldTransform(gameObject.sceneNode));
+			m_cullingProxies.push_back(m_boundingVolumeHierarchy.createProxy(box, static_cast<std::uint32_t>(i)));
+			m_previousTransforms.push_back(m_sceneGraph.getWorldTransform(gameObject.sceneNode));
+			m_dynamicObjects.push_back(false);
+
+			auto model = std::find(m_models.begin(), m_models.end(), gameObject.model);
+			m_objectModels.push_back(static_cast<std::uint32_t>(std::distance(m_models.begin(), model)));
+			if (model == m_models.end()) {
+				m_models.push_back(gameObject.model);
+			}
+		}
+	}
+
+	void Application::createDescriptorSetLayout() {
+		VkDescriptorSetLayoutBinding uboLayoutBinding{};
+		uboLayoutBinding.binding = 0;
+		uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		uboLayoutBinding.descriptorCount = 1;
+		uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		uboLayoutBinding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutBinding shadowMapLayoutBinding{};
+		shadowMapLayoutBinding.binding = 1;
+		shadowMapLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		shadowMapLayoutBinding.descriptorCount = 1;
+		shadowMapLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		shadowMapLayoutBinding.pImmutableSamplers = nullptr;
+
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{ uboLayoutBinding, shadowMapLayoutBinding };
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor set layout.");
+		}
 	}
 
 	void Application::createPipelineLayout() {
 		VkPushConstantRange pushConstantRange{};
-		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 		pushConstantRange.offset = 0;
 		pushConstantRange.size = sizeof(TransformPushConstantData);
 
+		std::array<VkDescriptorSetLayout, 3> descriptorSetLayouts{
+			m_descriptorSetLayout,
+			m_bindlessResources.getDescriptorSetLayout(),
+			m_clusteredLighting->getDescriptorSetLayout()
+		};
+
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
 		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 		pipelineLayoutCreateInfo.pNext = nullptr;
-		pipelineLayoutCreateInfo.setLayoutCount = 0;
-		pipelineLayoutCreateInfo.pSetLayouts = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
 		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
 		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
 
-		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create pipeline layout.");
 		}
 
-		m_pipeline = std::make_unique<Pipeline>(m_device, m_renderer.getSwapchain(), m_pipelineLayout);
+		Pipeline::Config config = Pipeline::getDefaultConfig();
+		config.vertexShaderPath = "resources/shaders/lit.vert.spv";
+		config.fragmentShaderPath = "resources/shaders/lit.frag.spv";
+		if (m_geometryPool.isVertexPullingEnabled()) {
+			config.vertexShaderPath = "resources/shaders/lit_pulling.vert.spv";
+			config.modelVertexInput = false;
+		}
+
+		m_pipeline = std::make_unique<Pipeline>(m_device, m_renderer.getSwapchain(), m_pipelineLayout, config);
 	}
 
-	void Application::drawFrame() {
+	void Application::createUniformBuffers() {
+		const std::size_t frameCount = static_cast<std::size_t>(m_renderer.getSwapchain().MAX_FRAMES_IN_FLIGHT);
+
+		m_uniformBuffers.resize(frameCount);
+		m_uniformBuffersMemory.resize(frameCount);
+		m_uniformBuffersMapped.resize(frameCount);
+
+		for (std::size_t i = 0; i < frameCount; ++i) {
+			m_device.createBuffer(
+				sizeof(GlobalUbo),
+				VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				m_uniformBuffers[i],
+				m_uniformBuffersMemory[i]
+			);
+
+			vkMapMemory(m_device.getDevice(), m_uniformBuffersMemory[i], 0, sizeof(GlobalUbo), 0, &m_uniformBuffersMapped[i]);
+		}
+	}
+
+	void Application::createDescriptorPool() {
+		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
+		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorPoolSizes[0].descriptorCount = static_cast<std::uint32_t>(m_uniformBuffers.size());
+		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorPoolSizes[1].descriptorCount = static_cast<std::uint32_t>(m_uniformBuffers.size());
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<std::uint32_t>(descriptorPoolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
+		descriptorPoolCreateInfo.maxSets = static_cast<std::uint32_t>(m_uniformBuffers.size());
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor pool.");
+		}
+	}
+
+	void Application::createDescriptorSets() {
+		std::vector<VkDescriptorSetLayout> layouts(m_uniformBuffers.size(), m_descriptorSetLayout);
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = static_cast<std::uint32_t>(layouts.size());
+		descriptorSetAllocateInfo.pSetLayouts = layouts.data();
+
+		m_descriptorSets.resize(layouts.size());
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, m_descriptorSets.data()) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate descriptor sets.");
+		}
+
+		for (std::size_t i = 0; i < m_descriptorSets.size(); ++i) {
+			VkDescriptorBufferInfo descriptorBufferInfo{};
+			descriptorBufferInfo.buffer = m_uniformBuffers[i];
+			descriptorBufferInfo.offset = 0;
+			descriptorBufferInfo.range = sizeof(GlobalUbo);
+
+			VkDescriptorImageInfo descriptorImageInfo{};
+			descriptorImageInfo.sampler = m_shadowMap->getSampler();
+			descriptorImageInfo.imageView = m_shadowMap->getImageView();
+			descriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+			std::array<VkWriteDescriptorSet, 2> writeDescriptorSets{};
+			writeDescriptorSets[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSets[0].pNext = nullptr;
+			writeDescriptorSets[0].dstSet = m_descriptorSets[i];
+			writeDescriptorSets[0].dstBinding = 0;
+			writeDescriptorSets[0].dstArrayElement = 0;
+			writeDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			writeDescriptorSets[0].descriptorCount = 1;
+			writeDescriptorSets[0].pBufferInfo = &descriptorBufferInfo;
+
+			writeDescriptorSets[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSets[1].pNext = nullptr;
+			writeDescriptorSets[1].dstSet = m_descriptorSets[i];
+			writeDescriptorSets[1].dstBinding = 1;
+			writeDescriptorSets[1].dstArrayElement = 0;
+			writeDescriptorSets[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			writeDescriptorSets[1].descriptorCount = 1;
+			writeDescriptorSets[1].pImageInfo = &descriptorImageInfo;
+
+			vkUpdateDescriptorSets(m_device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+		}
+	}
+
+	void Application::createParticleSystem() {
+		m_particleSystem = std::make_unique<ParticleSystem>(m_device, MAX_PARTICLES, m_renderer.getSwapchain().MAX_FRAMES_IN_FLIGHT);
+		m_particleSystem->createRenderPipeline(m_renderer.getSwapchain());
+
+		ParticleSystem::Emitter fountain{};
+		fountain.position = { 0.0f, 0.0f, 2.5f };
+		fountain.rate = 200000.0f;
+		fountain.velocity = { 0.0f, -3.0f, 0.0f };
+		fountain.spread = 1.0f;
+		fountain.color = { 1.0f, 0.5f, 0.1f, 0.8f };
+		fountain.lifetime = 2.0f;
+		m_particleSystem->addEmitter(fountain);
+	}
+
+	void Application::drawFrame(const RenderFrame &frame) {
 		VkCommandBuffer commandBuffer = m_renderer.beginFrame();
-		m_renderer.beginSwapchainRenderPass(commandBuffer);
+		if (commandBuffer == nullptr) {
+			return;
+		}
+
+		m_dynamicResolution->beginFrame(commandBuffer, m_renderer.getFrameIndex());
+		updateUniformBuffer(m_renderer.getFrameIndex(), frame);
+
+		for (const RenderFrame::TextureRequest &request : frame.textureRequests) {
+			m_textureStreamer.requestResolution(request.texture, request.pixelSize);
+		}
+
+		m_device.getMemoryBudget().update();
+		m_geometryPool.beginFrame();
+		m_textureStreamer.update(commandBuffer, m_renderer.getFrameIndex());
+		m_bindlessResources.flush(m_renderer.getFrameIndex());
 
-		renderGameObjects(commandBuffer);
+		buildRenderGraph(frame);
+		m_renderer.executeRenderGraph(m_renderGraph, commandBuffer);
 
-		m_renderer.endSwapchainRenderPass(commandBuffer);
+		m_dynamicResolution->endFrame(commandBuffer, m_renderer.getFrameIndex());
 		m_renderer.endFrame();
 	}
 
-	void Application::renderGameObjects(VkCommandBuffer commandBuffer) {
-		m_pipeline->bind(commandBuffer);
+	void Application::buildRenderGraph(const RenderFrame &frame) {
+		m_renderGraph.reset();
+
+		RenderGraph::ResourceHandle swapchainImage = m_renderer.importSwapchainImage(m_renderGraph);
+
+		RenderGraph::ImageDescription depthDescription{};
+		depthDescription.format = m_renderer.getSwapchain().getDepthFormat();
+		depthDescription.extent = m_renderer.getSwapchain().getExtent();
+		depthDescription.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		depthDescription.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		RenderGraph::ResourceHandle depthImage = m_renderGraph.createImage("depth", depthDescription);
+		RenderGraph::ResourceHandle sceneImage = m_dynamicResolution->importSceneImage(m_renderGraph, m_renderer.getSwapchain().getExtent());
+
+		VkClearValue colorClearValue{};
+		colorClearValue.color = { { 0.01f, 0.01f, 0.01f, 1.0f } };
+
+		VkClearValue depthClearValue{};
+		depthClearValue.depthStencil = { 1.0f, 0 };
+
+		ParticleSystem::GraphResources particles = m_particleSystem->importResources(m_renderGraph);
 
-		for (GameObject &gameObject : m_gameObjects) {
-			gameObject.transform.rotation.x = glm::mod(gameObject.transform.rotation.x + 0.001f, glm::two_pi<float>());
-			gameObject.transform.rotation.y = glm::mod(gameObject.transform.rotation.y + 0.001f, glm::two_pi<float>());
+		m_shadowMap->addPasses(m_renderGraph, frame.shadows, m_models);
+		m_viewRenderer->addPasses(m_renderGraph, frame.views, m_models, m_renderer.getFrameIndex());
+		m_clusteredLighting->addPasses(m_renderGraph, frame.lights, frame.camera, m_dynamicResolution->getRenderExtent(), m_renderer.getFrameIndex());
+		RenderGraph::ResourceHandle securityCameraImage = m_viewRenderer->getTargetImage(*m_securityCameraTarget);
+
+		m_renderGraph.addPass("particles", RenderGraph::PassType::Compute)
+			.write(particles.particles, RenderGraph::Access::StorageWrite)
+			.write(particles.aliveList, RenderGraph::Access::StorageWrite)
+			.write(particles.counters, RenderGraph::Access::StorageWrite)
+			.setExecute([this, &frame](VkCommandBuffer commandBuffer) {
+				m_particleSystem->update(commandBuffer, m_renderer.getFrameIndex(), frame.frameTime);
+			});
+
+		RenderGraph::PassBuilder forwardPass = m_renderGraph.addPass("forward", RenderGraph::PassType::Graphics);
+		forwardPass
+			.clear(sceneImage, RenderGraph::Access::ColorAttachment, colorClearValue)
+			.clear(depthImage, RenderGraph::Access::DepthAttachment, depthClearValue)
+			.read(particles.particles, RenderGraph::Access::StorageRead)
+			.read(particles.aliveList, RenderGraph::Access::StorageRead)
+			.read(particles.counters, RenderGraph::Access::IndirectBuffer)
+			.read(securityCameraImage, RenderGraph::Access::Sampled)
+			.read(m_clusteredLighting->getClusterBuffer(), RenderGraph::Access::StorageRead);
+
+		for (std::uint32_t cascade = 0; cascade < ShadowMap::CASCADE_COUNT; ++cascade) {
+			forwardPass.read(m_shadowMap->getCascadeImage(cascade), RenderGraph::Access::Sampled);
+		}
+
+		forwardPass.setExecute([this, &frame](VkCommandBuffer commandBuffer) {
+			m_dynamicResolution->setViewport(commandBuffer);
+			renderGameObjects(commandBuffer, frame);
+			m_particleSystem->draw(commandBuffer, frame.camera, m_renderer.getFrameIndex());
+		});
+
+		m_dynamicResolution->addUpscalePass(m_renderGraph, sceneImage, swapchainImage);
+	}
+
+	void Application::updateUniformBuffer(std::uint32_t frameIndex, const RenderFrame &frame) {
+		GlobalUbo ubo{};
+		ubo.projectionView = frame.camera.getProjectionView();
+		for (std::uint32_t cascade = 0; cascade < ShadowMap::CASCADE_COUNT; ++cascade) {
+			ubo.lightProjectionView[cascade] = frame.shadows.cascades[cascade].projectionView;
+		}
+		ubo.lightDirection = glm::vec4{ frame.shadows.lightDirection, 0.0f };
+		ubo.lightColor = glm::vec4{ 1.0f, 1.0f, 1.0f, AMBIENT_LIGHT };
+		ubo.cameraPosition = glm::vec4{ frame.camera.getPosition(), 1.0f };
+
+		std::memcpy(m_uniformBuffersMapped[frameIndex], &ubo, sizeof(ubo));
+	}
 
-			TransformPushConstantData transformPushConstantData;
-			transformPushConstantData.transform = gameObject.transform.getTransform();
+	void Application::updateGameObjects() {
+		for (std::size_t i = 0; i < m_gameObjects.size() && i < m_renderTransforms.size(); ++i) {
+			GameObject &gameObject = m_gameObjects[i];
+			if (m_simulation.isBodyStatic(static_cast<std::uint32_t>(i))) {
+				continue;
+			}
 
-			vkCmdPushConstants(
-				commandBuffer,
+			gameObject.transform = m_renderTransforms[i];
+			m_sceneGraph.setLocalTransform(gameObject.sceneNode, gameObject.transform);
+		}
+
+		m_sceneGraph.update(std::thread::hardware_concurrency());
+
+		for (std::size_t i = 0; i < m_gameObjects.size(); ++i) {
+			GameObject &gameObject = m_gameObjects[i];
+			const glm::mat4 &transform = m_sceneGraph.getWorldTransform(gameObject.sceneNode);
+
+			m_dynamicObjects[i] = transform != m_previousTransforms[i];
+			m_previousTransforms[i] = transform;
+
+			m_boundingVolumeHierarchy.moveProxy(m_cullingProxies[i], gameObject.model->getBoundingBox().transform(transform));
+		}
+	}
+
+	void Application::cullGameObjects(RenderFrame &frame) {
+		m_visibleObjects.clear();
+		m_boundingVolumeHierarchy.query(m_camera.getFrustum(), m_visibleObjects);
+
+		const float viewportHeight = static_cast<float>(m_window.getHeight());
+		for (std::uint32_t objectIndex : m_visibleObjects) {
+			GameObject &gameObject = m_gameObjects[objectIndex];
+			const glm::mat4 &transform = m_sceneGraph.getWorldTransform(gameObject.sceneNode);
+
+			BoundingSphere sphere = gameObject.model->getBoundingBox().transform(transform).getBoundingSphere();
+			float screenSize = m_camera.getScreenSize(sphere);
+			gameObject.lod = gameObject.model->selectLod(screenSize, gameObject.lod);
+
+			if (gameObject.texture != TextureStreamer::INVALID_TEXTURE) {
+				frame.textureRequests.push_back({ gameObject.texture, screenSize * viewportHeight });
+			}
+
+			RenderPacket packet{};
+			packet.model = m_objectModels[objectIndex];
+			packet.transformIndex = static_cast<std::uint32_t>(frame.transforms.size());
+			packet.material = gameObject.material;
+			packet.lod = gameObject.lod;
+			packet.sortKey = DrawList::encodeKey(0, 0, packet.material, packet.model, DrawList::quantizeDepth(glm::length(sphere.center - m_camera.getPosition()), DRAW_SORT_DISTANCE));
+
+			frame.transforms.push_back(transform);
+			frame.drawList.add(packet);
+		}
+
+		frame.drawList.sort(std::thread::hardware_concurrency());
+	}
+
+	void Application::cullViews(RenderFrame &frame) {
+		m_viewRenderer->cull(m_boundingVolumeHierarchy, frame.views);
+
+		for (const BoundingVolumeHierarchy::QueryResult &result : frame.views.visible) {
+			const GameObject &gameObject = m_gameObjects[result.userData];
+			if (gameObject.material == m_monitorMaterial) {
+				continue;
+			}
+
+			const glm::mat4 &transform = m_sceneGraph.getWorldTransform(gameObject.sceneNode);
+
+			RenderPacket packet{};
+			packet.model = m_objectModels[result.userData];
+			packet.material = gameObject.material;
+			packet.lod = gameObject.lod;
+
+			frame.views.add(result.mask, packet, transform, glm::vec3{ transform[3] }, DRAW_SORT_DISTANCE);
+		}
+
+		frame.views.sort(std::thread::hardware_concurrency());
+	}
+
+	void Application::cullShadowCasters(RenderFrame &frame) {
+		m_shadowMap->update(m_camera, m_boundingVolumeHierarchy, m_dynamicObjects, frame.shadows);
+
+		for (const BoundingVolumeHierarchy::QueryResult &result : frame.shadows.casters.visible) {
+			if (result.mask == 0) {
+				continue;
+			}
+
+			const GameObject &gameObject = m_gameObjects[result.userData];
+			const glm::mat4 &transform = m_sceneGraph.getWorldTransform(gameObject.sceneNode);
+
+			RenderPacket packet{};
+			packet.model = m_objectModels[result.userData];
+			packet.lod = gameObject.lod;
+
+			frame.shadows.casters.add(result.mask, packet, transform, glm::vec3{ transform[3] }, DRAW_SORT_DISTANCE);
+		}
+
+		frame.shadows.casters.sort(std::thread::hardware_concurrency());
+	}
+
+	void Application::animateLights(RenderFrame &frame) {
+		m_lightTime += frame.frameTime;
+
+		frame.lights.reserve(m_lights.size());
+		for (std::size_t i = 0; i < m_lights.size(); ++i) {
+			const float phase = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(m_lights.size());
+			const float angle = m_lightTime * (0.5f + static_cast<float>(i % 5) * 0.1f) + phase;
+
+			ClusteredLighting::Light light = m_lights[i];
+			light.position += glm::vec3{ std::cos(angle), 0.0f, std::sin(angle) } * 0.8f;
+			frame.lights.push_back(light);
+		}
+	}
+
+	void Application::renderGameObjects(VkCommandBuffer commandBuffer, const RenderFrame &frame) {
+		DrawRecorder recorder(commandBuffer);
+
+		std::array<VkDescriptorSet, 3> descriptorSets{
+			m_descriptorSets[m_renderer.getFrameIndex()],
+			m_bindlessResources.getDescriptorSet(m_renderer.getFrameIndex()),
+			m_clusteredLighting->getDescriptorSet(m_renderer.getFrameIndex())
+		};
+
+		for (const RenderPacket &packet : frame.drawList.getPackets()) {
+			m_pipeline->bind(recorder);
+			recorder.bindDescriptorSets(m_pipelineLayout, 0, static_cast<std::uint32_t>(descriptorSets.size()), descriptorSets.data());
+
+			if (m_geometryPool.isVertexPullingEnabled()) {
+				m_geometryPool.bindIndices(recorder);
+			} else {
+				m_geometryPool.bind(recorder);
+			}
+
+			TransformPushConstantData transformPushConstantData{};
+			transformPushConstantData.transform = frame.transforms[packet.transformIndex];
+			transformPushConstantData.materialIndex = packet.material;
+			transformPushConstantData.vertexAddress = m_geometryPool.getVertexBufferAddress();
+
+			recorder.pushConstants(
 				m_pipelineLayout,
-				VK_SHADER_STAGE_VERTEX_BIT,
+				VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
 				0,
 				sizeof(TransformPushConstantData),
 				&transformPushConstantData
 			);
 
-			gameObject.model->bind(commandBuffer);
-			gameObject.model->draw(commandBuffer);
+			m_models[packet.model]->draw(recorder, packet.lod);
 		}
+
+		const DrawRecorder::Statistics &statistics = recorder.getStatistics();
+		m_frameStatistics.drawCalls += statistics.draws;
+		m_frameStatistics.pipelineBinds += statistics.pipelineBinds;
+		m_frameStatistics.descriptorSetBinds += statistics.descriptorSetBinds;
+		m_frameStatistics.geometryBinds += statistics.indexBufferBinds;
+		m_frameStatistics.pushConstantUpdates += statistics.pushConstantUpdates;
+		m_frameStatistics.skippedBinds += statistics.skippedPipelineBinds + statistics.skippedDescriptorSetBinds + statistics.skippedVertexBufferBinds + statistics.skippedIndexBufferBinds + statistics.skippedPushConstantUpdates;
 	}
 }
\ No newline at end of file
@@ -11,12 +11,39 @@
 #include "Device.h"
 #include "Pipeline.h"
 #include "Model.h"
+#include "GeometryPool.h"
 #include "GameObject.h"
 #include "Renderer.h"
+#include "Camera.h"
+#include "Frustum.h"
+#include "BoundingVolumeHierarchy.h"
+#include "SceneGraph.h"
+#include "Simulation.h"
+#include "BindlessResources.h"
+#include "TextureStreamer.h"
+#include "ParticleSystem.h"
+#include "RenderQueue.h"
+#include "DrawList.h"
+#include "DrawRecorder.h"
+#include "MemoryReport.h"
+#include "RenderTarget.h"
+#include "View.h"
+#include "ViewRenderer.h"
+#include "ShadowMap.h"
+#include "ClusteredLighting.h"
+#include "DynamicResolution.h"
 
 #include <vector>
+#include <array>
+#include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include <exception>
+#include <algorithm>
+#include <random>
 
 namespace eng {
 	class Application {
@@ -26,18 +53,102 @@ namespace eng {
 
 		void run();
 	private:
+		void createSecurityCameras();
+		void createShadowMap();
+		void createClusteredLighting();
+		void createDynamicResolution();
 		void loadGameObjects();
+		void createDescriptorSetLayout();
 		void createPipelineLayout();
+		void createUniformBuffers();
+		void createDescriptorPool();
+		void createDescriptorSets();
+		void createParticleSystem();
 
-		void drawFrame();
-		void renderGameObjects(VkCommandBuffer commandBuffer);
+		void renderLoop();
+		void drawFrame(const RenderFrame &frame);
+		void buildRenderGraph(const RenderFrame &frame);
+		void updateUniformBuffer(std::uint32_t frameIndex, const RenderFrame &frame);
+		void updateGameObjects();
+		void cullGameObjects(RenderFrame &frame);
+		void cullViews(RenderFrame &frame);
+		void cullShadowCasters(RenderFrame &frame);
+		void animateLights(RenderFrame &frame);
+		void renderGameObjects(VkCommandBuffer commandBuffer, const RenderFrame &frame);
+		void printFrameStatistics();
 
+		struct FrameStatistics {
+			std::uint32_t frameCount = 0;
+			float elapsedTime = 0.0f;
+			float gameTime = 0.0f;
+			float renderTime = 0.0f;
+			std::uint64_t drawCalls = 0;
+			std::uint64_t pipelineBinds = 0;
+			std::uint64_t descriptorSetBinds = 0;
+			std::uint64_t geometryBinds = 0;
+			std::uint64_t pushConstantUpdates = 0;
+			std::uint64_t skippedBinds = 0;
+			VkDeviceSize uploadedTextureBytes = 0;
+		};
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
 		VkPipelineLayout m_pipelineLayout;
+		VkDescriptorPool m_descriptorPool;
+		std::vector<VkDescriptorSet> m_descriptorSets;
+
+		std::vector<VkBuffer> m_uniformBuffers;
+		std::vector<VkDeviceMemory> m_uniformBuffersMemory;
+		std::vector<void *> m_uniformBuffersMapped;
 
 		Window m_window{ 800, 600, "Vulkan Engine" };
 		Device m_device{ m_window };
+		BindlessResources m_bindlessResources{ m_device };
+		TextureStreamer m_textureStreamer{ m_device, m_bindlessResources };
+		GeometryPool m_geometryPool{ m_device, sizeof(Model::Vertex), MAX_GEOMETRY_VERTICES, MAX_GEOMETRY_INDICES };
 		std::unique_ptr<Pipeline> m_pipeline;
+		std::unique_ptr<ParticleSystem> m_particleSystem;
+		std::unique_ptr<RenderTarget> m_securityCameraTarget;
+		std::unique_ptr<ViewRenderer> m_viewRenderer;
+		std::unique_ptr<ShadowMap> m_shadowMap;
+		std::unique_ptr<ClusteredLighting> m_clusteredLighting;
+		std::vector<ClusteredLighting::Light> m_lights;
+		float m_lightTime = 0.0f;
+		std::unique_ptr<DynamicResolution> m_dynamicResolution;
+		std::uint32_t m_monitorMaterial = 0;
 		std::vector<GameObject> m_gameObjects;
+		std::vector<std::shared_ptr<Model>> m_models;
+		std::vector<std::uint32_t> m_objectModels;
+
+		Camera m_camera{};
+		SceneGraph m_sceneGraph{};
+		Simulation m_simulation{};
+		std::vector<TransformComponent> m_renderTransforms;
+		BoundingVolumeHierarchy m_boundingVolumeHierarchy{};
+		std::vector<std::int32_t> m_cullingProxies;
+		std::vector<glm::mat4> m_previousTransforms;
+		std::vector<bool> m_dynamicObjects;
+		std::vector<std::uint32_t> m_visibleObjects;
+		RenderGraph m_renderGraph{};
+		FrameStatistics m_frameStatistics{};
+		float m_memoryLogTime = 0.0f;
+		MemoryReport m_memoryReport{ &m_device.getMemoryBudget() };
+
+		RenderQueue m_renderQueue{};
+		std::thread m_renderThread;
+		std::exception_ptr m_renderException;
+
+		static constexpr std::uint32_t MATERIAL_GRID_SIZE = 64;
+		static constexpr std::uint32_t MAX_PARTICLES = 1 << 20;
+		static constexpr std::uint32_t MAX_GEOMETRY_VERTICES = 1 << 20;
+		static constexpr std::uint32_t MAX_GEOMETRY_INDICES = 1 << 22;
+		static constexpr float MEMORY_LOG_INTERVAL = 5.0f;
+		static constexpr const char *MEMORY_REPORT_PATH = "memory_report.json";
+		static constexpr float DRAW_SORT_DISTANCE = 100.0f;
+		static constexpr std::uint32_t SECURITY_CAMERA_RESOLUTION = 256;
+		static constexpr float AMBIENT_LIGHT = 0.2f;
+		static constexpr std::uint32_t LIGHT_COUNT = 512;
+		static constexpr std::uint32_t MAX_LIGHTS = 4096;
+		static constexpr float TARGET_GPU_FRAME_TIME = 1000.0f / 60.0f;
 
 		Renderer m_renderer{ m_window, m_device };
 	};
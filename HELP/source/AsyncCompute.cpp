@@ -0,0 +1,161 @@
+#include "AsyncCompute.h"
+
+namespace eng {
+	AsyncCompute::AsyncCompute(Device &device, std::uint32_t frameCount)
+		: m_device(device), m_frameCount(frameCount) {
+		createCommandBuffers();
+		createSyncObjects();
+	}
+
+	AsyncCompute::~AsyncCompute() {
+		vkWaitForFences(m_device.getDevice(), m_frameCount, m_inFlightFences.data(), VK_TRUE, UINT64_MAX);
+
+		for (std::uint32_t i = 0; i < m_frameCount; ++i) {
+			vkDestroySemaphore(m_device.getDevice(), m_finishedSemaphores[i], VulkanAllocator::get(AllocationCategory::Synchronization));
+			vkDestroyFence(m_device.getDevice(), m_inFlightFences[i], VulkanAllocator::get(AllocationCategory::Synchronization));
+		}
+
+		vkFreeCommandBuffers(m_device.getDevice(), m_device.getComputeCommandPool(), m_frameCount, m_commandBuffers.data());
+	}
+
+	VkCommandBuffer AsyncCompute::begin(std::uint32_t frame) {
+		vkWaitForFences(m_device.getDevice(), 1, &m_inFlightFences[frame], VK_TRUE, UINT64_MAX);
+		vkResetFences(m_device.getDevice(), 1, &m_inFlightFences[frame]);
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		commandBufferBeginInfo.pNext = nullptr;
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		commandBufferBeginInfo.pInheritanceInfo = nullptr;
+
+		if (vkBeginCommandBuffer(m_commandBuffers[frame], &commandBufferBeginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to begin compute command buffer.");
+		}
+
+		return m_commandBuffers[frame];
+	}
+
+	VkSemaphore AsyncCompute::submit(std::uint32_t frame, const std::vector<VkSemaphore> &waitSemaphores, const std::vector<VkPipelineStageFlags> &waitStages) {
+		if (vkEndCommandBuffer(m_commandBuffers[frame]) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to record compute command buffer.");
+		}
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.pNext = nullptr;
+		submitInfo.waitSemaphoreCount = static_cast<std::uint32_t>(waitSemaphores.size());
+		submitInfo.pWaitSemaphores = waitSemaphores.data();
+		submitInfo.pWaitDstStageMask = waitStages.data();
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &m_commandBuffers[frame];
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &m_finishedSemaphores[frame];
+
+		if (vkQueueSubmit(m_device.getComputeQueue(), 1, &submitInfo, m_inFlightFences[frame]) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to submit compute command buffer.");
+		}
+
+		return m_finishedSemaphores[frame];
+	}
+
+	void AsyncCompute::releaseBuffers(VkCommandBuffer commandBuffer, const std::vector<BufferTransfer> &transfers, Direction direction) const {
+		if (!requiresOwnershipTransfer() || transfers.empty()) {
+			return;
+		}
+
+		VkPipelineStageFlags srcStages = 0;
+		for (const BufferTransfer &transfer : transfers) {
+			srcStages |= transfer.srcStages;
+		}
+
+		std::vector<VkBufferMemoryBarrier> barriers = createOwnershipBarriers(transfers, direction, true);
+		vkCmdPipelineBarrier(commandBuffer, srcStages, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, static_cast<std::uint32_t>(barriers.size()), barriers.data(), 0, nullptr);
+	}
+
+	void AsyncCompute::acquireBuffers(VkCommandBuffer commandBuffer, const std::vector<BufferTransfer> &transfers, Direction direction) const {
+		if (!requiresOwnershipTransfer() || transfers.empty()) {
+			return;
+		}
+
+		VkPipelineStageFlags dstStages = 0;
+		for (const BufferTransfer &transfer : transfers) {
+			dstStages |= transfer.dstStages;
+		}
+
+		std::vector<VkBufferMemoryBarrier> barriers = createOwnershipBarriers(transfers, direction, false);
+		vkCmdPipelineBarrier(commandBuffer, dstStages, dstStages, 0, 0, nullptr, static_cast<std::uint32_t>(barriers.size()), barriers.data(), 0, nullptr);
+	}
+
+	bool AsyncCompute::requiresOwnershipTransfer() const {
+		return getGraphicsFamilyIndex() != getComputeFamilyIndex();
+	}
+
+	std::uint32_t AsyncCompute::getGraphicsFamilyIndex() const {
+		return m_device.getQueueFamilyIndices().graphicsFamilyIndex.value();
+	}
+
+	std::uint32_t AsyncCompute::getComputeFamilyIndex() const {
+		return m_device.getQueueFamilyIndices().computeFamilyIndex.value();
+	}
+
+	void AsyncCompute::createCommandBuffers() {
+		m_commandBuffers.resize(m_frameCount);
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferAllocateInfo.pNext = nullptr;
+		commandBufferAllocateInfo.commandPool = m_device.getComputeCommandPool();
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = m_frameCount;
+
+		if (vkAllocateCommandBuffers(m_device.getDevice(), &commandBufferAllocateInfo, m_commandBuffers.data()) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate compute command buffers.");
+		}
+	}
+
+	void AsyncCompute::createSyncObjects() {
+		m_finishedSemaphores.resize(m_frameCount);
+		m_inFlightFences.resize(m_frameCount);
+
+		VkSemaphoreCreateInfo semaphoreCreateInfo{};
+		semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphoreCreateInfo.pNext = nullptr;
+
+		VkFenceCreateInfo fenceCreateInfo{};
+		fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceCreateInfo.pNext = nullptr;
+		fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		for (std::uint32_t i = 0; i < m_frameCount; ++i) {
+			if (vkCreateSemaphore(m_device.getDevice(), &semaphoreCreateInfo, VulkanAllocator::get(AllocationCategory::Synchronization), &m_finishedSemaphores[i]) != VK_SUCCESS ||
+				vkCreateFence(m_device.getDevice(), &fenceCreateInfo, VulkanAllocator::get(AllocationCategory::Synchronization), &m_inFlightFences[i]) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create compute sync objects.");
+			}
+		}
+	}
+
+	std::vector<VkBufferMemoryBarrier> AsyncCompute::createOwnershipBarriers(const std::vector<BufferTransfer> &transfers, Direction direction, bool release) const {
+		const std::uint32_t srcFamilyIndex = direction == Direction::GraphicsToCompute ? getGraphicsFamilyIndex() : getComputeFamilyIndex();
+		const std::uint32_t dstFamilyIndex = direction == Direction::GraphicsToCompute ? getComputeFamilyIndex() : getGraphicsFamilyIndex();
+
+		std::vector<VkBufferMemoryBarrier> barriers;
+		barriers.reserve(transfers.size());
+
+		for (const BufferTransfer &transfer : transfers) {
+			VkBufferMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			barrier.pNext = nullptr;
+			barrier.srcAccessMask = release ? transfer.srcAccess : 0;
+			barrier.dstAccessMask = release ? 0 : transfer.dstAccess;
+			barrier.srcQueueFamilyIndex = srcFamilyIndex;
+			barrier.dstQueueFamilyIndex = dstFamilyIndex;
+			barrier.buffer = transfer.buffer;
+			barrier.offset = transfer.offset;
+			barrier.size = transfer.size;
+
+			barriers.push_back(barrier);
+		}
+
+		return barriers;
+	}
+}
\ No newline at end of file
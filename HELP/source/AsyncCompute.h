@@ -0,0 +1,60 @@
+#ifndef ASYNC_COMPUTE_H
+#define ASYNC_COMPUTE_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+namespace eng {
+	class AsyncCompute {
+	public:
+		enum class Direction {
+			GraphicsToCompute,
+			ComputeToGraphics
+		};
+
+		struct BufferTransfer {
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceSize offset = 0;
+			VkDeviceSize size = VK_WHOLE_SIZE;
+			VkPipelineStageFlags srcStages = 0;
+			VkAccessFlags srcAccess = 0;
+			VkPipelineStageFlags dstStages = 0;
+			VkAccessFlags dstAccess = 0;
+		};
+
+		AsyncCompute(Device &device, std::uint32_t frameCount);
+		~AsyncCompute();
+
+		AsyncCompute(const AsyncCompute &) = delete;
+		AsyncCompute &operator=(const AsyncCompute &) = delete;
+
+		VkCommandBuffer begin(std::uint32_t frame);
+		VkSemaphore submit(std::uint32_t frame, const std::vector<VkSemaphore> &waitSemaphores = {}, const std::vector<VkPipelineStageFlags> &waitStages = {});
+
+		void releaseBuffers(VkCommandBuffer commandBuffer, const std::vector<BufferTransfer> &transfers, Direction direction) const;
+		void acquireBuffers(VkCommandBuffer commandBuffer, const std::vector<BufferTransfer> &transfers, Direction direction) const;
+
+		bool requiresOwnershipTransfer() const;
+		std::uint32_t getGraphicsFamilyIndex() const;
+		std::uint32_t getComputeFamilyIndex() const;
+	private:
+		void createCommandBuffers();
+		void createSyncObjects();
+
+		std::vector<VkBufferMemoryBarrier> createOwnershipBarriers(const std::vector<BufferTransfer> &transfers, Direction direction, bool release) const;
+
+		Device &m_device;
+		std::uint32_t m_frameCount;
+
+		std::vector<VkCommandBuffer> m_commandBuffers;
+		std::vector<VkSemaphore> m_finishedSemaphores;
+		std::vector<VkFence> m_inFlightFences;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,3877 @@
+#include "Benchmark.h"
+
+namespace eng {
+	int Benchmark::run(const std::string &name) {
+		if (name == "culling") {
+			runFrustumCulling(1000000);
+		} else if (name == "lod") {
+			runLevelOfDetail(50000, 30);
+		} else if (name == "scenegraph") {
+			runSceneGraph(100, 6, 4);
+		} else if (name == "simulation") {
+			runSimulation(10000, 2000);
+		} else if (name == "rendergraph") {
+			runRenderGraph(1920, 1080);
+		} else if (name == "asynccompute") {
+			runAsyncCompute(1 << 18, 512, 20);
+		} else if (name == "particles") {
+			runParticles({ 1000000, 10000000 }, 60);
+		} else if (name == "deviceselection") {
+			runDeviceSelection(256, 64);
+		} else if (name == "geometrypool") {
+			runGeometryPool(10000, 50);
+		} else if (name == "meshlets") {
+			runMeshlets(4096, 50);
+		} else if (name == "occlusion") {
+			runOcclusion(4096, 60);
+		} else if (name == "renderthread") {
+			runRenderThread(200000, 120);
+		} else if (name == "drawkeys") {
+			runDrawKeys(1 << 20, 10000);
+		} else if (name == "framearena") {
+			runFrameArena(100000, 240);
+		} else if (name == "memory") {
+			runMemoryTracking(1000000, 10000);
+		} else if (name == "views") {
+			runViews(20000, 60);
+		} else if (name == "shadows") {
+			runShadows(20000, 16, 120);
+		} else if (name == "clusters") {
+			runClusters({ 16, 4096 }, 60);
+		} else if (name == "dynamicresolution") {
+			runDynamicResolution(240);
+		} else if (name == "presentation") {
+			runPresentation({ 0.0f, 45.0f, 120.0f }, 240);
+		} else {
+			printUsage();
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	void Benchmark::runFrustumCulling(std::size_t objectCount) {
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> position{ -500.0f, 500.0f };
+		std::uniform_real_distribution<float> size{ 0.25f, 2.0f };
+		std::uniform_real_distribution<float> offset{ -0.5f, 0.5f };
+
+		std::vector<BoundingBox> boxes(objectCount);
+		for (BoundingBox &box : boxes) {
+			glm::vec3 center{ position(random), position(random), position(random) };
+			glm::vec3 extents{ size(random), size(random), size(random) };
+			box = BoundingBox{ center - extents, center + extents };
+		}
+
+		Camera camera{};
+		camera.setPerspectiveProjection(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+		camera.setViewDirection({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f });
+		Frustum frustum = camera.getFrustum();
+
+		const int iterations = 10;
+		std::vector<std::uint32_t> visible;
+		visible.reserve(objectCount);
+
+		std::cout << "Frustum culling benchmark (" << objectCount << " objects)\n";
+
+		auto start = std::chrono::high_resolution_clock::now();
+		BoundingVolumeHierarchy hierarchy{};
+		std::vector<std::int32_t> proxies(objectCount);
+		for (std::size_t i = 0; i < objectCount; ++i) {
+			proxies[i] = hierarchy.createProxy(boxes[i], static_cast<std::uint32_t>(i));
+		}
+		std::cout << "\tBVH build: " << getMilliseconds(start) << " ms (height " << hierarchy.getHeight() << ")\n";
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			visible.clear();
+			hierarchy.query(frustum, visible);
+		}
+		std::cout << "\tBVH query: " << getMilliseconds(start) / iterations << " ms, " << visible.size() << " visible\n";
+
+		const std::size_t movingCount = objectCount / 100;
+		std::size_t reinsertions = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < movingCount; ++i) {
+			std::size_t index = random() % objectCount;
+			glm::vec3 delta{ offset(random), offset(random), offset(random) };
+			boxes[index].min += delta;
+			boxes[index].max += delta;
+			reinsertions += hierarchy.moveProxy(proxies[index], boxes[index]) ? 1 : 0;
+		}
+		std::cout << "\tBVH incremental update (" << movingCount << " moved, " << reinsertions << " reinserted): " << getMilliseconds(start) << " ms\n";
+
+		BoundingBoxArray boxArray{};
+		boxArray.reserve(objectCount);
+		for (const BoundingBox &box : boxes) {
+			boxArray.push_back(box);
+		}
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			visible.clear();
+			frustum.cullBoxesScalar(boxArray, visible);
+		}
+		std::cout << "\tLinear scalar plane tests: " << getMilliseconds(start) / iterations << " ms, " << visible.size() << " visible\n";
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			visible.clear();
+			frustum.cullBoxes(boxArray, visible);
+		}
+		std::cout << "\tLinear SIMD plane tests: " << getMilliseconds(start) / iterations << " ms, " << visible.size() << " visible\n";
+	}
+
+	void Benchmark::runLevelOfDetail(std::size_t objectCount, std::uint32_t frameCount) {
+		Model::Builder builder = createSphere(128, 64);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		builder.generateLods(5, 0.5f, 0.05f);
+		std::cout << "Level of detail benchmark (" << objectCount << " objects, " << frameCount << " frames)\n";
+		std::cout << "\tLOD generation: " << getMilliseconds(start) << " ms\n";
+
+		for (std::size_t i = 0; i < builder.lods.size(); ++i) {
+			const Model::Lod &lod = builder.lods[i];
+			std::cout << "\tLOD " << i << ": " << lod.indexCount / 3 << " triangles, error " << lod.error << ", min screen size " << lod.screenSize << '\n';
+		}
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> lateral{ -100.0f, 100.0f };
+		std::uniform_real_distribution<float> depth{ 5.0f, 2000.0f };
+
+		Camera camera{};
+		camera.setPerspectiveProjection(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 2500.0f);
+		camera.setViewDirection({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f });
+		Frustum frustum = camera.getFrustum();
+
+		BoundingBox localBox = BoundingBox::fromPoints(&builder.vertices[0].position, builder.vertices.size(), sizeof(Model::Vertex));
+
+		std::vector<BoundingBox> boxes(objectCount);
+		std::vector<glm::mat4> transforms(objectCount);
+		for (std::size_t i = 0; i < objectCount; ++i) {
+			glm::vec3 offset{ lateral(random), lateral(random), depth(random) };
+			boxes[i] = BoundingBox{ localBox.min + offset, localBox.max + offset };
+			transforms[i] = glm::mat4{ 1.0f };
+			transforms[i][3] = glm::vec4{ offset, 1.0f };
+		}
+
+		std::vector<std::uint32_t> lods(objectCount, 0);
+		std::uint64_t fullTriangles = 0;
+		std::uint64_t lodTriangles = 0;
+		std::size_t visibleCount = 0;
+
+		start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < objectCount; ++i) {
+			if (!frustum.intersects(boxes[i])) {
+				continue;
+			}
+
+			lods[i] = Model::selectLod(builder.lods, camera.getScreenSize(boxes[i].getBoundingSphere()), lods[i]);
+
+			fullTriangles += builder.lods[0].indexCount / 3;
+			lodTriangles += builder.lods[lods[i]].indexCount / 3;
+			++visibleCount;
+		}
+		double selectionTime = getMilliseconds(start);
+
+		std::cout << "\tVisible objects: " << visibleCount << '\n';
+		std::cout << "\tLOD selection: " << selectionTime << " ms\n";
+		std::cout << "\tTriangles without LOD: " << fullTriangles << '\n';
+		std::cout << "\tTriangles with LOD: " << lodTriangles << " (" << (fullTriangles > 0 ? 100.0 * lodTriangles / fullTriangles : 0.0) << "%)\n";
+
+		Window window{ 320, 240, "HELP level of detail" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+		BindlessResources bindlessResources{ device };
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), static_cast<std::uint32_t>(builder.vertices.size()), static_cast<std::uint32_t>(builder.indices.size()) };
+		std::vector<std::shared_ptr<Model>> models{ std::make_shared<Model>(geometryPool, builder) };
+		geometryPool.flush();
+
+		BoundingVolumeHierarchy boundingVolumeHierarchy{};
+		for (std::size_t i = 0; i < objectCount; ++i) {
+			boundingVolumeHierarchy.createProxy(boxes[i], static_cast<std::uint32_t>(i));
+		}
+
+		RenderTarget::Description description{};
+		description.extent = { 1280, 720 };
+		description.format = VK_FORMAT_R8G8B8A8_UNORM;
+
+		RenderTarget target{ device, description };
+		ViewRenderer viewRenderer{ device, swapchain, bindlessResources, geometryPool, 1 };
+
+		View view(target, { { 0, 0 }, description.extent });
+		view.setCamera(camera);
+		viewRenderer.addView(view);
+
+		RenderGraph graph{};
+		RenderGraphExecutor executor{ device };
+		FrameArena frameArena{ 64 * 1024 };
+		ViewBatch batch{};
+
+		auto measure = [&](bool useLods) {
+			const std::uint32_t warmupFrameCount = 2;
+
+			std::fill(lods.begin(), lods.end(), 0);
+
+			double frameTime = 0.0;
+			double submitTime = 0.0;
+			for (std::uint32_t frame = 0; frame < warmupFrameCount + frameCount; ++frame) {
+				auto frameStart = std::chrono::high_resolution_clock::now();
+				batch.clear();
+				viewRenderer.cull(boundingVolumeHierarchy, batch);
+				for (const BoundingVolumeHierarchy::QueryResult &visible : batch.visible) {
+					RenderPacket packet{};
+					if (useLods) {
+						lods[visible.userData] = models[0]->selectLod(camera.getScreenSize(boxes[visible.userData].getBoundingSphere()), lods[visible.userData]);
+						packet.lod = lods[visible.userData];
+					}
+					batch.add(visible.mask, packet, transforms[visible.userData], glm::vec3{ transforms[visible.userData][3] }, 2500.0f);
+				}
+				batch.sort();
+
+				frameArena.reset();
+				VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+				graph.reset();
+				viewRenderer.addPasses(graph, batch, models, 0);
+				executor.execute(graph, commandBuffer, frameArena);
+
+				auto submitStart = std::chrono::high_resolution_clock::now();
+				device.endSingleTimeCommands(commandBuffer);
+
+				if (frame < warmupFrameCount) {
+					continue;
+				}
+
+				submitTime += getMilliseconds(submitStart);
+				frameTime += getMilliseconds(frameStart);
+			}
+
+			executor.releaseResources();
+
+			return std::make_pair(frameTime / frameCount, submitTime / frameCount);
+		};
+
+		for (bool useLods : { false, true }) {
+			auto [frameTime, submitTime] = measure(useLods);
+			std::cout << "\tFrame time " << (useLods ? "with" : "without") << " LOD: " << frameTime << " ms (submit and wait " << submitTime << " ms)\n";
+		}
+	}
+
+	void Benchmark::runSceneGraph(std::size_t rootCount, std::uint32_t depth, std::uint32_t branching) {
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> offset{ -2.0f, 2.0f };
+
+		SceneGraph sceneGraph{};
+		std::vector<SceneGraph::NodeId> nodes;
+		std::vector<SceneGraph::NodeId> level;
+		std::vector<SceneGraph::NodeId> nextLevel;
+
+		for (std::size_t i = 0; i < rootCount; ++i) {
+			TransformComponent transform{};
+			transform.translation = { offset(random) * 100.0f, 0.0f, offset(random) * 100.0f };
+
+			level.assign(1, sceneGraph.createNode(SceneGraph::INVALID_NODE, transform));
+			nodes.push_back(level.front());
+
+			for (std::uint32_t d = 1; d < depth; ++d) {
+				nextLevel.clear();
+				for (SceneGraph::NodeId parent : level) {
+					for (std::uint32_t b = 0; b < branching; ++b) {
+						transform.translation = { offset(random), offset(random), offset(random) };
+						transform.scale = { 0.9f, 0.9f, 0.9f };
+
+						nextLevel.push_back(sceneGraph.createNode(parent, transform));
+						nodes.push_back(nextLevel.back());
+					}
+				}
+				level.swap(nextLevel);
+			}
+		}
+
+		std::size_t threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		std::cout << "Scene graph benchmark (" << sceneGraph.getNodeCount() << " nodes, " << rootCount << " roots, " << threadCount << " threads)\n";
+
+		auto start = std::chrono::high_resolution_clock::now();
+		sceneGraph.update();
+		std::cout << "\tInitial update: " << getMilliseconds(start) << " ms, " << sceneGraph.getLastUpdatedCount() << " updated\n";
+
+		start = std::chrono::high_resolution_clock::now();
+		sceneGraph.update();
+		std::cout << "\tClean update: " << getMilliseconds(start) << " ms, " << sceneGraph.getLastUpdatedCount() << " updated\n";
+
+		std::uniform_int_distribution<std::size_t> pick{ 0, nodes.size() - 1 };
+		const int iterations = 20;
+
+		for (std::size_t threads : { static_cast<std::size_t>(1), threadCount }) {
+			double time = 0.0;
+			std::size_t updated = 0;
+
+			for (int i = 0; i < iterations; ++i) {
+				for (std::size_t j = 0; j < nodes.size() / 100; ++j) {
+					SceneGraph::NodeId node = nodes[pick(random)];
+					TransformComponent transform = sceneGraph.getLocalTransform(node);
+					transform.rotation.y += 0.01f;
+					sceneGraph.setLocalTransform(node, transform);
+				}
+
+				start = std::chrono::high_resolution_clock::now();
+				sceneGraph.update(threads);
+				time += getMilliseconds(start);
+				updated += sceneGraph.getLastUpdatedCount();
+			}
+
+			std::cout << "\t1% nodes moved, " << threads << " threads: " << time / iterations << " ms, " << updated / iterations << " updated\n";
+
+			time = 0.0;
+			for (int i = 0; i < iterations; ++i) {
+				for (std::size_t j = 0; j < rootCount; ++j) {
+					TransformComponent transform = sceneGraph.getLocalTransform(nodes[j * (nodes.size() / rootCount)]);
+					transform.rotation.y += 0.01f;
+					sceneGraph.setLocalTransform(nodes[j * (nodes.size() / rootCount)], transform);
+				}
+
+				start = std::chrono::high_resolution_clock::now();
+				sceneGraph.update(threads);
+				time += getMilliseconds(start);
+			}
+
+			std::cout << "\tAll roots moved, " << threads << " threads: " << time / iterations << " ms, " << sceneGraph.getLastUpdatedCount() << " updated\n";
+		}
+	}
+
+	void Benchmark::runSimulation(std::size_t bodyCount, std::uint64_t tickCount) {
+		std::cout << "Fixed timestep simulation benchmark (" << bodyCount << " bodies, " << tickCount << " ticks)\n";
+
+		std::uint64_t checksums[] = {
+			runSimulationLoop(bodyCount, tickCount, false, false),
+			runSimulationLoop(bodyCount, tickCount, false, true),
+			runSimulationLoop(bodyCount, tickCount, true, false),
+			runSimulationLoop(bodyCount, tickCount, true, true)
+		};
+
+		bool deterministic = std::all_of(std::begin(checksums), std::end(checksums), [&](std::uint64_t checksum) { return checksum == checksums[0]; });
+		std::cout << "\tDeterministic: " << (deterministic ? "yes" : "no") << " (checksum " << std::hex << checksums[0] << std::dec << ")\n";
+	}
+
+	std::uint64_t Benchmark::runSimulationLoop(std::size_t bodyCount, std::uint64_t tickCount, bool threaded, bool variableFrameTime) {
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> position{ -50.0f, 50.0f };
+		std::uniform_real_distribution<float> velocity{ -2.0f, 2.0f };
+		std::uniform_real_distribution<float> frameTimes{ 0.002f, 0.04f };
+
+		Simulation simulation{};
+		SceneGraph sceneGraph{};
+		std::vector<SceneGraph::NodeId> nodes;
+
+		for (std::size_t i = 0; i < bodyCount; ++i) {
+			TransformComponent transform{};
+			transform.translation = { position(random), position(random), position(random) };
+
+			SceneGraph::NodeId parent = i % 8 == 0 ? SceneGraph::INVALID_NODE : nodes[i - i % 8];
+			nodes.push_back(sceneGraph.createNode(parent, transform));
+			simulation.addBody(transform, { velocity(random), velocity(random), velocity(random) });
+		}
+
+		simulation.recordChecksumAt(tickCount);
+		if (threaded) {
+			simulation.start();
+		}
+
+		std::vector<TransformComponent> transforms;
+		std::size_t threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		std::uint64_t frameCount = 0;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		while (simulation.getTick() < tickCount) {
+			float frameTime = variableFrameTime ? frameTimes(random) : simulation.getTimeStep();
+
+			simulation.wait();
+			simulation.interpolate(transforms);
+			simulation.advance(frameTime);
+
+			for (std::size_t i = 0; i < transforms.size(); ++i) {
+				sceneGraph.setLocalTransform(nodes[i], transforms[i]);
+			}
+			sceneGraph.update(threadCount);
+
+			++frameCount;
+		}
+		simulation.wait();
+
+		double time = getMilliseconds(start);
+		simulation.stop();
+
+		std::cout << '\t' << (threaded ? "Worker thread" : "Inline") << ", " << (variableFrameTime ? "variable" : "fixed") << " frame time: ";
+		std::cout << frameCount << " frames in " << time << " ms (" << frameCount * 1000.0 / time << " fps), checksum at tick " << tickCount << ' ' << std::hex << simulation.getRecordedChecksum() << std::dec << '\n';
+
+		return simulation.getRecordedChecksum();
+	}
+
+	void Benchmark::runRenderGraph(std::uint32_t width, std::uint32_t height) {
+		std::cout << "Render graph benchmark (" << width << "x" << height << " deferred frame)\n";
+
+		RenderGraph graph{};
+		buildDeferredFrame(graph, width, height);
+		graph.compile();
+		graph.assignMemory(estimateMemoryRequirements(graph));
+
+		for (std::uint32_t i = 0; i < graph.getPassCount(); ++i) {
+			const RenderGraph::Pass &pass = graph.getPass(i);
+			std::cout << '\t' << pass.name << (pass.culled ? " (culled)\n" : "\n");
+
+			for (const RenderGraph::Barrier &barrier : pass.culled ? FrameVector<RenderGraph::Barrier>{} : graph.getPassBarriers(i)) {
+				const RenderGraph::Resource &resource = graph.getResource(barrier.resource);
+				std::cout << "\t\tbarrier " << resource.name;
+				if (resource.image) {
+					std::cout << ": " << getLayoutName(barrier.before.layout) << " -> " << getLayoutName(barrier.after.layout);
+				}
+				std::cout << '\n';
+			}
+		}
+
+		for (const RenderGraph::Barrier &barrier : graph.getFinalBarriers()) {
+			const RenderGraph::Resource &resource = graph.getResource(barrier.resource);
+			std::cout << "\tfinal barrier " << resource.name << ": " << getLayoutName(barrier.before.layout) << " -> " << getLayoutName(barrier.after.layout) << '\n';
+		}
+
+		const FrameVector<RenderGraph::MemoryBlock> &blocks = graph.getMemoryBlocks();
+		for (std::size_t i = 0; i < blocks.size(); ++i) {
+			std::cout << "\tmemory block " << i << " (" << blocks[i].size / (1024.0 * 1024.0) << " MB):";
+			for (RenderGraph::ResourceHandle resource : blocks[i].resources) {
+				std::cout << ' ' << graph.getResource(resource).name;
+			}
+			std::cout << '\n';
+		}
+
+		std::cout << '\t';
+		graph.printStatistics();
+
+		std::string error;
+		bool valid = validateBarriers(graph, error);
+		std::cout << "\tBarrier validation: " << (valid ? "passed" : "failed (" + error + ")") << '\n';
+
+		const int iterations = 10000;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			buildDeferredFrame(graph, width, height);
+			graph.compile();
+			graph.assignMemory(estimateMemoryRequirements(graph));
+		}
+		double time = getMilliseconds(start);
+
+		std::cout << "\tBuild and compile: " << time * 1000.0 / iterations << " us per frame\n";
+	}
+
+	void Benchmark::buildDeferredFrame(RenderGraph &graph, std::uint32_t width, std::uint32_t height) {
+		graph.reset();
+
+		RenderGraph::ResourceState swapchainState{};
+		swapchainState.stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+		RenderGraph::ImageDescription description{};
+		description.format = VK_FORMAT_B8G8R8A8_SRGB;
+		description.extent = { width, height };
+		description.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		RenderGraph::ResourceHandle swapchain = graph.importImage("swapchain", VK_NULL_HANDLE, VK_NULL_HANDLE, description, swapchainState, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+		description.format = VK_FORMAT_D32_SFLOAT;
+		description.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		description.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+		RenderGraph::ResourceHandle depth = graph.createImage("depth", description);
+
+		description.format = VK_FORMAT_R8G8B8A8_UNORM;
+		description.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		description.aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+		RenderGraph::ResourceHandle albedo = graph.createImage("albedo", description);
+
+		description.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+		RenderGraph::ResourceHandle normal = graph.createImage("normal", description);
+		RenderGraph::ResourceHandle lighting = graph.createImage("lighting", description);
+
+		description.format = VK_FORMAT_R8_UNORM;
+		description.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		RenderGraph::ResourceHandle occlusion = graph.createImage("occlusion", description);
+
+		description.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+		description.extent = { width / 2, height / 2 };
+		RenderGraph::ResourceHandle bloomDown = graph.createImage("bloom down", description);
+		RenderGraph::ResourceHandle bloomUp = graph.createImage("bloom up", description);
+
+		description.format = VK_FORMAT_R8G8B8A8_UNORM;
+		description.extent = { width, height };
+		description.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		RenderGraph::ResourceHandle debugView = graph.createImage("debug view", description);
+
+		VkClearValue colorClearValue{};
+		VkClearValue depthClearValue{};
+		depthClearValue.depthStencil = { 1.0f, 0 };
+
+		graph.addPass("geometry", RenderGraph::PassType::Graphics)
+			.clear(albedo, RenderGraph::Access::ColorAttachment, colorClearValue)
+			.clear(normal, RenderGraph::Access::ColorAttachment, colorClearValue)
+			.clear(depth, RenderGraph::Access::DepthAttachment, depthClearValue);
+
+		graph.addPass("ambient occlusion", RenderGraph::PassType::Compute)
+			.read(depth, RenderGraph::Access::Sampled)
+			.read(normal, RenderGraph::Access::Sampled)
+			.write(occlusion, RenderGraph::Access::StorageWrite);
+
+		graph.addPass("lighting", RenderGraph::PassType::Graphics)
+			.read(albedo, RenderGraph::Access::Sampled)
+			.read(normal, RenderGraph::Access::Sampled)
+			.read(depth, RenderGraph::Access::Sampled)
+			.read(occlusion, RenderGraph::Access::Sampled)
+			.clear(lighting, RenderGraph::Access::ColorAttachment, colorClearValue);
+
+		graph.addPass("debug normals", RenderGraph::PassType::Graphics)
+			.read(normal, RenderGraph::Access::Sampled)
+			.clear(debugView, RenderGraph::Access::ColorAttachment, colorClearValue);
+
+		graph.addPass("bloom downsample", RenderGraph::PassType::Graphics)
+			.read(lighting, RenderGraph::Access::Sampled)
+			.clear(bloomDown, RenderGraph::Access::ColorAttachment, colorClearValue);
+
+		graph.addPass("bloom upsample", RenderGraph::PassType::Graphics)
+			.read(bloomDown, RenderGraph::Access::Sampled)
+			.clear(bloomUp, RenderGraph::Access::ColorAttachment, colorClearValue);
+
+		graph.addPass("tonemap", RenderGraph::PassType::Graphics)
+			.read(lighting, RenderGraph::Access::Sampled)
+			.read(bloomUp, RenderGraph::Access::Sampled)
+			.clear(swapchain, RenderGraph::Access::ColorAttachment, colorClearValue);
+	}
+
+	std::vector<VkMemoryRequirements> Benchmark::estimateMemoryRequirements(const RenderGraph &graph) {
+		std::vector<VkMemoryRequirements> memoryRequirements(graph.getResourceCount());
+
+		for (RenderGraph::ResourceHandle i = 0; i < graph.getResourceCount(); ++i) {
+			const RenderGraph::Resource &resource = graph.getResource(i);
+
+			VkDeviceSize size = resource.bufferDescription.size;
+			if (resource.image) {
+				VkDeviceSize bytesPerPixel = 4;
+				if (resource.imageDescription.format == VK_FORMAT_R16G16B16A16_SFLOAT) {
+					bytesPerPixel = 8;
+				} else if (resource.imageDescription.format == VK_FORMAT_R8_UNORM) {
+					bytesPerPixel = 1;
+				}
+
+				size = static_cast<VkDeviceSize>(resource.imageDescription.extent.width) * resource.imageDescription.extent.height * bytesPerPixel;
+			}
+
+			const VkDeviceSize alignment = 64 * 1024;
+			memoryRequirements[i].size = (size + alignment - 1) / alignment * alignment;
+			memoryRequirements[i].alignment = alignment;
+			memoryRequirements[i].memoryTypeBits = 1;
+		}
+
+		return memoryRequirements;
+	}
+
+	bool Benchmark::validateBarriers(const RenderGraph &graph, std::string &error) {
+		const std::uint32_t resourceCount = graph.getResourceCount();
+
+		std::vector<VkImageLayout> layouts(resourceCount, VK_IMAGE_LAYOUT_UNDEFINED);
+		std::vector<VkAccessFlags> pendingAccess(resourceCount, 0);
+		std::vector<VkPipelineStageFlags> visibleStages(resourceCount, 0);
+		std::vector<bool> written(resourceCount, false);
+
+		for (RenderGraph::ResourceHandle i = 0; i < resourceCount; ++i) {
+			if (graph.getResource(i).imported) {
+				layouts[i] = graph.getResource(i).initialState.layout;
+			}
+		}
+
+		auto applyBarriers = [&](const FrameVector<RenderGraph::Barrier> &barriers) {
+			for (const RenderGraph::Barrier &barrier : barriers) {
+				const RenderGraph::Resource &resource = graph.getResource(barrier.resource);
+				if (resource.image && barrier.before.layout != VK_IMAGE_LAYOUT_UNDEFINED && barrier.before.layout != layouts[barrier.resource]) {
+					error = std::string("barrier for ") + resource.name.c_str() + " starts from the wrong layout";
+					return false;
+				}
+
+				layouts[barrier.resource] = barrier.after.layout;
+				pendingAccess[barrier.resource] = 0;
+				visibleStages[barrier.resource] |= barrier.after.stages;
+			}
+
+			return true;
+		};
+
+		for (std::uint32_t i = 0; i < graph.getPassCount(); ++i) {
+			const RenderGraph::Pass &pass = graph.getPass(i);
+			if (pass.culled) {
+				continue;
+			}
+
+			if (!applyBarriers(graph.getPassBarriers(i))) {
+				return false;
+			}
+
+			for (const RenderGraph::Use &use : pass.uses) {
+				const RenderGraph::Resource &resource = graph.getResource(use.resource);
+				std::string name = std::string(resource.name.c_str()) + " in " + pass.name.c_str();
+
+				if (resource.image && layouts[use.resource] != use.state.layout) {
+					error = name + " is in the wrong layout";
+					return false;
+				}
+
+				if (pendingAccess[use.resource] != 0 && (RenderGraph::hasWriteAccess(pendingAccess[use.resource]) || RenderGraph::hasWriteAccess(use.state.access))) {
+					error = name + " has an unsynchronized hazard";
+					return false;
+				}
+
+				if (written[use.resource] && (use.state.stages & ~visibleStages[use.resource]) != 0) {
+					error = name + " reads writes that are not visible to its stages";
+					return false;
+				}
+			}
+
+			for (const RenderGraph::Use &use : pass.uses) {
+				pendingAccess[use.resource] |= use.state.access;
+				if (use.write) {
+					written[use.resource] = true;
+					visibleStages[use.resource] = 0;
+				}
+			}
+		}
+
+		if (!applyBarriers(graph.getFinalBarriers())) {
+			return false;
+		}
+
+		for (RenderGraph::ResourceHandle i = 0; i < resourceCount; ++i) {
+			const RenderGraph::Resource &resource = graph.getResource(i);
+			if (resource.imported && resource.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED && layouts[i] != resource.finalLayout) {
+				error = std::string(resource.name.c_str()) + " does not end in its final layout";
+				return false;
+			}
+		}
+
+		for (const RenderGraph::MemoryBlock &block : graph.getMemoryBlocks()) {
+			for (RenderGraph::ResourceHandle a : block.resources) {
+				for (RenderGraph::ResourceHandle b : block.resources) {
+					const RenderGraph::Resource &first = graph.getResource(a);
+					const RenderGraph::Resource &second = graph.getResource(b);
+					if (a != b && first.firstPass <= second.lastPass && second.firstPass <= first.lastPass) {
+						error = std::string(first.name.c_str()) + " and " + second.name.c_str() + " alias memory while both are alive";
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	const char *Benchmark::getLayoutName(VkImageLayout layout) {
+		switch (layout) {
+		case VK_IMAGE_LAYOUT_UNDEFINED:
+			return "undefined";
+		case VK_IMAGE_LAYOUT_GENERAL:
+			return "general";
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+			return "color attachment";
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+			return "depth attachment";
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+			return "depth read only";
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+			return "shader read only";
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+			return "transfer source";
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+			return "transfer destination";
+		case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+			return "present";
+		default:
+			return "other";
+		}
+	}
+
+	void Benchmark::runAsyncCompute(std::uint32_t elementCount, std::uint32_t iterations, std::uint32_t frameCount) {
+		std::cout << "Async compute benchmark (" << elementCount << " elements, " << iterations << " iterations, " << frameCount << " frames)\n";
+
+		Window window{ 320, 240, "HELP async compute" };
+		Device device{ window };
+		AsyncCompute asyncCompute{ device, 1 };
+
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{};
+		descriptorSetLayoutBinding.binding = 0;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorSetLayoutBinding.descriptorCount = 1;
+		descriptorSetLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.flags = 0;
+		descriptorSetLayoutCreateInfo.bindingCount = 1;
+		descriptorSetLayoutCreateInfo.pBindings = &descriptorSetLayoutBinding;
+
+		VkDescriptorSetLayout descriptorSetLayout;
+		if (vkCreateDescriptorSetLayout(device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor set layout.");
+		}
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = 2 * sizeof(std::uint32_t);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		VkPipelineLayout pipelineLayout;
+		if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create pipeline layout.");
+		}
+
+		std::unique_ptr<ComputePipeline> pipeline = std::make_unique<ComputePipeline>(device, "resources/shaders/workload.comp.spv", pipelineLayout);
+
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSize.descriptorCount = 2;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.flags = 0;
+		descriptorPoolCreateInfo.maxSets = 2;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+
+		VkDescriptorPool descriptorPool;
+		if (vkCreateDescriptorPool(device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor pool.");
+		}
+
+		const VkDeviceSize bufferSize = static_cast<VkDeviceSize>(elementCount) * sizeof(float);
+		VkBuffer buffers[2];
+		VkDeviceMemory bufferMemories[2];
+		VkDescriptorSet descriptorSets[2];
+		VkQueryPool queryPools[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+
+		for (std::uint32_t i = 0; i < 2; ++i) {
+			device.createBuffer(bufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffers[i], bufferMemories[i]);
+
+			VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+			descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			descriptorSetAllocateInfo.pNext = nullptr;
+			descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+			descriptorSetAllocateInfo.descriptorSetCount = 1;
+			descriptorSetAllocateInfo.pSetLayouts = &descriptorSetLayout;
+
+			if (vkAllocateDescriptorSets(device.getDevice(), &descriptorSetAllocateInfo, &descriptorSets[i]) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to allocate descriptor set.");
+			}
+
+			VkDescriptorBufferInfo descriptorBufferInfo{};
+			descriptorBufferInfo.buffer = buffers[i];
+			descriptorBufferInfo.offset = 0;
+			descriptorBufferInfo.range = bufferSize;
+
+			VkWriteDescriptorSet writeDescriptorSet{};
+			writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSet.pNext = nullptr;
+			writeDescriptorSet.dstSet = descriptorSets[i];
+			writeDescriptorSet.dstBinding = 0;
+			writeDescriptorSet.dstArrayElement = 0;
+			writeDescriptorSet.descriptorCount = 1;
+			writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+			vkUpdateDescriptorSets(device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+
+			if (device.hasTimestamps()) {
+				VkQueryPoolCreateInfo queryPoolCreateInfo{};
+				queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+				queryPoolCreateInfo.pNext = nullptr;
+				queryPoolCreateInfo.flags = 0;
+				queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+				queryPoolCreateInfo.queryCount = 2;
+
+				if (vkCreateQueryPool(device.getDevice(), &queryPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Query), &queryPools[i]) != VK_SUCCESS) {
+					throw std::runtime_error("Failed to create query pool.");
+				}
+			}
+		}
+
+		auto recordWorkload = [&](VkCommandBuffer commandBuffer, std::uint32_t workload) {
+			if (queryPools[workload] != VK_NULL_HANDLE) {
+				vkCmdResetQueryPool(commandBuffer, queryPools[workload], 0, 2);
+				vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPools[workload], 0);
+			}
+
+			std::uint32_t push[] = { elementCount, iterations };
+			pipeline->bind(commandBuffer);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSets[workload], 0, nullptr);
+			vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), push);
+			vkCmdDispatch(commandBuffer, (elementCount + 63) / 64, 1, 1);
+
+			if (queryPools[workload] != VK_NULL_HANDLE) {
+				vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPools[workload], 1);
+			}
+		};
+
+		auto submitGraphics = [&](VkCommandBuffer commandBuffer, VkSemaphore waitSemaphore, VkPipelineStageFlags waitStage) {
+			if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to record command buffer.");
+			}
+
+			VkSubmitInfo submitInfo{};
+			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submitInfo.pNext = nullptr;
+			submitInfo.waitSemaphoreCount = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+			submitInfo.pWaitSemaphores = &waitSemaphore;
+			submitInfo.pWaitDstStageMask = &waitStage;
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &commandBuffer;
+
+			if (vkQueueSubmit(device.getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to submit command buffer.");
+			}
+		};
+
+		AsyncCompute::BufferTransfer transfer{};
+		transfer.buffer = buffers[1];
+		transfer.srcStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		transfer.srcAccess = VK_ACCESS_SHADER_WRITE_BIT;
+		transfer.dstStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		transfer.dstAccess = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		bool ownedByCompute = false;
+		double overlap = 0.0;
+		double computeTime = 0.0;
+
+		auto runFrame = [&](bool async) {
+			VkCommandBuffer computeCommandBuffer = asyncCompute.begin(0);
+			if (ownedByCompute) {
+				asyncCompute.acquireBuffers(computeCommandBuffer, { transfer }, AsyncCompute::Direction::GraphicsToCompute);
+			}
+			recordWorkload(computeCommandBuffer, 1);
+			asyncCompute.releaseBuffers(computeCommandBuffer, { transfer }, AsyncCompute::Direction::ComputeToGraphics);
+			VkSemaphore computeFinished = asyncCompute.submit(0);
+
+			if (!async) {
+				vkQueueWaitIdle(device.getComputeQueue());
+			}
+
+			VkCommandBuffer graphicsCommandBuffer = device.beginSingleTimeCommands();
+			recordWorkload(graphicsCommandBuffer, 0);
+			submitGraphics(graphicsCommandBuffer, VK_NULL_HANDLE, 0);
+
+			VkCommandBuffer consumeCommandBuffer = device.beginSingleTimeCommands();
+			asyncCompute.acquireBuffers(consumeCommandBuffer, { transfer }, AsyncCompute::Direction::ComputeToGraphics);
+			asyncCompute.releaseBuffers(consumeCommandBuffer, { transfer }, AsyncCompute::Direction::GraphicsToCompute);
+			submitGraphics(consumeCommandBuffer, computeFinished, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+			ownedByCompute = true;
+
+			vkQueueWaitIdle(device.getGraphicsQueue());
+			vkQueueWaitIdle(device.getComputeQueue());
+
+			VkCommandBuffer commandBuffers[] = { graphicsCommandBuffer, consumeCommandBuffer };
+			vkFreeCommandBuffers(device.getDevice(), device.getCommandPool(), 2, commandBuffers);
+
+			if (device.hasTimestamps()) {
+				std::uint64_t graphicsTimestamps[2];
+				std::uint64_t computeTimestamps[2];
+				vkGetQueryPoolResults(device.getDevice(), queryPools[0], 0, 2, sizeof(graphicsTimestamps), graphicsTimestamps, sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+				vkGetQueryPoolResults(device.getDevice(), queryPools[1], 0, 2, sizeof(computeTimestamps), computeTimestamps, sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+				std::uint64_t overlapStart = std::max(graphicsTimestamps[0], computeTimestamps[0]);
+				std::uint64_t overlapEnd = std::min(graphicsTimestamps[1], computeTimestamps[1]);
+				if (overlapEnd > overlapStart) {
+					overlap += static_cast<double>(overlapEnd - overlapStart) * device.getTimestampPeriod() / 1000000.0;
+				}
+				computeTime += static_cast<double>(computeTimestamps[1] - computeTimestamps[0]) * device.getTimestampPeriod() / 1000000.0;
+			}
+		};
+
+		runFrame(false);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < frameCount; ++i) {
+			runFrame(false);
+		}
+		double serialTime = getMilliseconds(start) / frameCount;
+
+		overlap = 0.0;
+		computeTime = 0.0;
+
+		start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < frameCount; ++i) {
+			runFrame(true);
+		}
+		double asyncTime = getMilliseconds(start) / frameCount;
+
+		std::cout << "\tCompute queue: " << (device.hasAsyncComputeQueue() ? "separate" : "shared with graphics") << '\n';
+		std::cout << "\tOwnership transfers: " << (asyncCompute.requiresOwnershipTransfer() ? "yes" : "no (same queue family)") << '\n';
+		std::cout << "\tSerial: " << serialTime << " ms per frame\n";
+		std::cout << "\tAsync: " << asyncTime << " ms per frame (" << serialTime / asyncTime << "x)\n";
+		if (device.hasTimestamps()) {
+			std::cout << "\tGPU overlap: " << overlap / frameCount << " ms per frame (" << (computeTime > 0.0 ? overlap / computeTime * 100.0 : 0.0) << "% of compute workload)\n";
+		} else {
+			std::cout << "\tGPU overlap: timestamps unavailable\n";
+		}
+
+		vkDeviceWaitIdle(device.getDevice());
+
+		for (std::uint32_t i = 0; i < 2; ++i) {
+			if (queryPools[i] != VK_NULL_HANDLE) {
+				vkDestroyQueryPool(device.getDevice(), queryPools[i], VulkanAllocator::get(AllocationCategory::Query));
+			}
+			vkDestroyBuffer(device.getDevice(), buffers[i], VulkanAllocator::get(AllocationCategory::Resource));
+			device.freeMemory(bufferMemories[i]);
+		}
+
+		vkDestroyDescriptorPool(device.getDevice(), descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		pipeline.reset();
+		vkDestroyPipelineLayout(device.getDevice(), pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorSetLayout(device.getDevice(), descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+	}
+
+	void Benchmark::runParticles(const std::vector<std::uint32_t> &particleCounts, std::uint32_t frameCount) {
+		std::cout << "Particle benchmark (" << frameCount << " frames)\n";
+
+		Window window{ 320, 240, "HELP particles" };
+		Device device{ window };
+
+		const float deltaTime = 1.0f / 60.0f;
+
+		for (std::uint32_t particleCount : particleCounts) {
+			ParticleSystem particleSystem{ device, particleCount, 1 };
+
+			ParticleSystem::Emitter emitter{};
+			emitter.rate = static_cast<float>(particleCount) / deltaTime;
+			emitter.lifetime = 2.0f;
+			ParticleSystem::EmitterId emitterId = particleSystem.addEmitter(emitter);
+
+			auto runFrame = [&]() {
+				VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+				particleSystem.update(commandBuffer, 0, deltaTime);
+				device.endSingleTimeCommands(commandBuffer);
+			};
+
+			runFrame();
+			particleSystem.getEmitter(emitterId).rate = static_cast<float>(particleCount) / emitter.lifetime;
+			runFrame();
+
+			auto start = std::chrono::high_resolution_clock::now();
+			for (std::uint32_t i = 0; i < frameCount; ++i) {
+				runFrame();
+			}
+			double time = getMilliseconds(start) / frameCount;
+
+			std::uint32_t aliveCount = particleSystem.readAliveCount();
+
+			std::cout << '\t' << particleCount << " particles: " << time << " ms per frame, " << aliveCount << " alive, ";
+			std::cout << aliveCount / time << " particles per ms\n";
+		}
+	}
+
+	void Benchmark::runDeviceSelection(std::uint32_t bufferSizeMb, std::uint32_t fillCount) {
+		std::cout << "Device selection benchmark\n";
+
+		std::uint32_t failures = 0;
+		auto check = [&failures](const std::string &name, bool passed) {
+			std::cout << '\t' << name << ": " << (passed ? "passed" : "failed") << '\n';
+			failures += passed ? 0 : 1;
+		};
+		auto throws = [](const std::vector<PhysicalDeviceInfo> &devices, const std::string &selection) {
+			try {
+				DeviceSelector::select(devices, selection);
+			} catch (const std::runtime_error &) {
+				return true;
+			}
+			return false;
+		};
+
+		std::vector<PhysicalDeviceInfo> mixed{
+			createMockDevice(0, "llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU, 0, true, 0x10),
+			createMockDevice(1, "Intel(R) UHD Graphics 770", VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU, 2048, true, 0x20),
+			createMockDevice(2, "NVIDIA GeForce RTX 3060", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, 12288, true, 0x30)
+		};
+		check("discrete over integrated over CPU", DeviceSelector::select(mixed, "") == 2);
+
+		std::vector<PhysicalDeviceInfo> discrete{
+			createMockDevice(0, "AMD Radeon RX 6600", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, 8192, true, 0x40),
+			createMockDevice(1, "AMD Radeon RX 7900 XTX", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, 24576, true, 0x50)
+		};
+		check("larger VRAM among discrete GPUs", DeviceSelector::select(discrete, "") == 1);
+
+		std::vector<PhysicalDeviceInfo> features = discrete;
+		features[0].deviceLocalMemory = features[1].deviceLocalMemory;
+		features[0].asyncCompute = false;
+		check("async compute breaks VRAM ties", DeviceSelector::select(features, "") == 1);
+
+		std::vector<PhysicalDeviceInfo> unsuitable = mixed;
+		unsuitable[2].suitable = false;
+		check("unsuitable discrete GPU is skipped", DeviceSelector::select(unsuitable, "") == 1);
+
+		check("override by index", DeviceSelector::select(mixed, "0") == 0 && DeviceSelector::select(mixed, "index:1") == 1);
+		check("override by name", DeviceSelector::select(mixed, "intel") == 1 && DeviceSelector::select(mixed, "LLVMPIPE") == 0);
+		check("override by UUID", DeviceSelector::select(mixed, "uuid:" + DeviceSelector::formatUuid(mixed[1].uuid)) == 1
+			&& DeviceSelector::select(mixed, "uuid:1010") == 0);
+		check("override of an unsuitable device throws", throws(unsuitable, "nvidia"));
+		check("override without a match throws", throws(mixed, "index:7"));
+		check("no suitable device throws", throws({ createMockDevice(0, "Broken", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, 4096, false, 0x60) }, ""));
+
+		std::cout << "\tMock selection: " << (failures == 0 ? "all passed" : std::to_string(failures) + " failed") << '\n';
+
+		std::vector<std::unique_ptr<Window>> windows;
+		std::vector<std::unique_ptr<Device>> devices;
+
+		windows.push_back(std::make_unique<Window>(320, 240, "HELP device selection"));
+		devices.push_back(std::make_unique<Device>(*windows.back()));
+
+		const std::vector<PhysicalDeviceInfo> &infos = devices.front()->getPhysicalDeviceInfos();
+		for (const PhysicalDeviceInfo &info : infos) {
+			if (info.suitable && info.index != devices.front()->getPhysicalDeviceIndex()) {
+				windows.push_back(std::make_unique<Window>(320, 240, "HELP device selection " + std::to_string(info.index)));
+				devices.push_back(std::make_unique<Device>(*windows.back(), "index:" + std::to_string(info.index)));
+			}
+		}
+
+		const VkDeviceSize bufferSize = static_cast<VkDeviceSize>(bufferSizeMb) << 20;
+		std::vector<double> times(devices.size());
+		std::vector<std::thread> threads;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < devices.size(); ++i) {
+			threads.emplace_back([&, i]() {
+				Device &device = *devices[i];
+
+				VkBuffer buffer;
+				VkDeviceMemory bufferMemory;
+				device.createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, bufferMemory);
+
+				auto deviceStart = std::chrono::high_resolution_clock::now();
+				VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+				for (std::uint32_t fill = 0; fill < fillCount; ++fill) {
+					vkCmdFillBuffer(commandBuffer, buffer, 0, VK_WHOLE_SIZE, fill);
+				}
+				device.endSingleTimeCommands(commandBuffer);
+				times[i] = getMilliseconds(deviceStart);
+
+				vkDestroyBuffer(device.getDevice(), buffer, VulkanAllocator::get(AllocationCategory::Resource));
+				device.freeMemory(bufferMemory);
+			});
+		}
+
+		for (std::thread &thread : threads) {
+			thread.join();
+		}
+		double total = getMilliseconds(start);
+
+		for (std::size_t i = 0; i < devices.size(); ++i) {
+			const PhysicalDeviceInfo &info = infos[devices[i]->getPhysicalDeviceIndex()];
+			std::cout << "\t[" << info.index << "] " << info.name << ": " << fillCount << " fills of " << bufferSizeMb << " MB in " << times[i] << " ms\n";
+		}
+		std::cout << "\t" << devices.size() << " device(s) concurrently: " << total << " ms\n";
+	}
+
+	void Benchmark::runGeometryPool(std::uint32_t meshCount, std::uint32_t iterations) {
+		std::cout << "Geometry pool benchmark (" << meshCount << " unique meshes, " << iterations << " iterations)\n";
+
+		Window window{ 320, 240, "HELP geometry pool" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+		BindlessResources bindlessResources{ device };
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> scale{ 0.5f, 2.0f };
+
+		std::vector<Model::Builder> builders(meshCount);
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (std::uint32_t i = 0; i < meshCount; ++i) {
+			builders[i] = createSphere(6 + i % 11, 4 + i % 7);
+
+			glm::vec3 meshScale{ scale(random), scale(random), scale(random) };
+			for (Model::Vertex &vertex : builders[i].vertices) {
+				vertex.position *= meshScale;
+			}
+
+			vertexCount += static_cast<std::uint32_t>(builders[i].vertices.size());
+			indexCount += static_cast<std::uint32_t>(builders[i].indices.size());
+		}
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), vertexCount, indexCount };
+		std::vector<std::unique_ptr<Model>> models;
+		models.reserve(meshCount);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (const Model::Builder &builder : builders) {
+			models.push_back(std::make_unique<Model>(geometryPool, builder));
+		}
+		double allocateTime = getMilliseconds(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		geometryPool.flush();
+		double flushTime = getMilliseconds(start);
+
+		std::cout << "\tUpload: " << vertexCount << " vertices, " << indexCount << " indices, ";
+		std::cout << (static_cast<double>(vertexCount) * sizeof(Model::Vertex) + static_cast<double>(indexCount) * sizeof(std::uint32_t)) / (1024.0 * 1024.0) << " MB, ";
+		std::cout << allocateTime << " ms allocate + " << flushTime << " ms flush\n";
+
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{};
+		descriptorSetLayoutBinding.binding = 0;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorSetLayoutBinding.descriptorCount = 1;
+		descriptorSetLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = 1;
+		descriptorSetLayoutCreateInfo.pBindings = &descriptorSetLayoutBinding;
+
+		VkDescriptorSetLayout descriptorSetLayout;
+		if (vkCreateDescriptorSetLayout(device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor set layout.");
+		}
+
+		struct PushConstants {
+			glm::mat4 transform{ 1.0f };
+			std::uint32_t materialIndex = 0;
+			std::uint32_t padding = 0;
+			VkDeviceAddress vertexAddress = 0;
+		};
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstants);
+
+		std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts{ descriptorSetLayout, bindlessResources.getDescriptorSetLayout() };
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		VkPipelineLayout pipelineLayout;
+		if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create pipeline layout.");
+		}
+
+		VkBuffer uniformBuffer;
+		VkDeviceMemory uniformBufferMemory;
+		device.createBuffer(sizeof(glm::mat4), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uniformBuffer, uniformBufferMemory);
+
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorPoolSize.descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		VkDescriptorPool descriptorPool;
+		if (vkCreateDescriptorPool(device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &descriptorSetLayout;
+
+		VkDescriptorSet descriptorSet;
+		if (vkAllocateDescriptorSets(device.getDevice(), &descriptorSetAllocateInfo, &descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate descriptor sets.");
+		}
+
+		VkDescriptorBufferInfo descriptorBufferInfo{};
+		descriptorBufferInfo.buffer = uniformBuffer;
+		descriptorBufferInfo.offset = 0;
+		descriptorBufferInfo.range = sizeof(glm::mat4);
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.pNext = nullptr;
+		writeDescriptorSet.dstSet = descriptorSet;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.dstArrayElement = 0;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+		vkUpdateDescriptorSets(device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+
+		std::unique_ptr<Pipeline> vertexInputPipeline = std::make_unique<Pipeline>(device, swapchain, pipelineLayout);
+		std::unique_ptr<Pipeline> vertexPullingPipeline;
+		if (geometryPool.isVertexPullingEnabled()) {
+			Pipeline::Config config = Pipeline::getDefaultConfig();
+			config.vertexShaderPath = "resources/shaders/simple_pulling.vert.spv";
+			config.modelVertexInput = false;
+			vertexPullingPipeline = std::make_unique<Pipeline>(device, swapchain, pipelineLayout, config);
+		}
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferAllocateInfo.pNext = nullptr;
+		commandBufferAllocateInfo.commandPool = device.getCommandPool();
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		if (vkAllocateCommandBuffers(device.getDevice(), &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate command buffers.");
+		}
+
+		VkFormat colorAttachmentFormat = swapchain.getImageFormat();
+
+		VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo{};
+		inheritanceRenderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+		inheritanceRenderingInfo.pNext = nullptr;
+		inheritanceRenderingInfo.flags = 0;
+		inheritanceRenderingInfo.viewMask = 0;
+		inheritanceRenderingInfo.colorAttachmentCount = 1;
+		inheritanceRenderingInfo.pColorAttachmentFormats = &colorAttachmentFormat;
+		inheritanceRenderingInfo.depthAttachmentFormat = swapchain.getDepthFormat();
+		inheritanceRenderingInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+		inheritanceRenderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.pNext = device.isDynamicRenderingEnabled() ? &inheritanceRenderingInfo : nullptr;
+		inheritanceInfo.renderPass = device.isDynamicRenderingEnabled() ? VK_NULL_HANDLE : swapchain.getRenderPass();
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		commandBufferBeginInfo.pNext = nullptr;
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(swapchain.getExtent().width), static_cast<float>(swapchain.getExtent().height), 0.0f, 1.0f };
+		VkRect2D scissor{ { 0, 0 }, swapchain.getExtent() };
+
+		enum class Mode {
+			PerMeshBinds,
+			PooledVertexOffset,
+			VertexPulling
+		};
+
+		auto record = [&](Mode mode, std::uint64_t &binds) {
+			binds = 0;
+			vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+
+			Pipeline &pipeline = mode == Mode::VertexPulling ? *vertexPullingPipeline : *vertexInputPipeline;
+			pipeline.bind(commandBuffer);
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+			std::array<VkDescriptorSet, 2> descriptorSets{ descriptorSet, bindlessResources.getDescriptorSet(0) };
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, static_cast<std::uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+
+			if (mode == Mode::PooledVertexOffset) {
+				geometryPool.bind(commandBuffer);
+				binds += 2;
+			} else if (mode == Mode::VertexPulling) {
+				geometryPool.bindIndices(commandBuffer);
+				binds += 1;
+			}
+
+			PushConstants pushConstants{};
+			pushConstants.vertexAddress = geometryPool.getVertexBufferAddress();
+
+			for (const std::unique_ptr<Model> &model : models) {
+				vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
+
+				if (mode == Mode::PerMeshBinds) {
+					const GeometryPool::Allocation &allocation = model->getAllocation();
+					VkBuffer vertexBuffer = geometryPool.getVertexBuffer();
+					VkDeviceSize vertexOffset = allocation.firstVertex * geometryPool.getVertexStride();
+
+					vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &vertexOffset);
+					vkCmdBindIndexBuffer(commandBuffer, geometryPool.getIndexBuffer(), allocation.firstIndex * sizeof(std::uint32_t), VK_INDEX_TYPE_UINT32);
+					vkCmdDrawIndexed(commandBuffer, model->getLod(0).indexCount, 1, 0, 0, 0);
+					binds += 2;
+				} else {
+					model->draw(commandBuffer, 0);
+				}
+			}
+
+			vkEndCommandBuffer(commandBuffer);
+		};
+
+		auto measure = [&](const char *name, Mode mode) {
+			std::uint64_t binds = 0;
+			record(mode, binds);
+
+			auto recordStart = std::chrono::high_resolution_clock::now();
+			for (std::uint32_t i = 0; i < iterations; ++i) {
+				record(mode, binds);
+			}
+			double time = getMilliseconds(recordStart) / iterations;
+
+			std::cout << '\t' << name << ": " << binds << " buffer binds, " << models.size() << " draws, " << time << " ms record\n";
+		};
+
+		measure("Per-mesh binds", Mode::PerMeshBinds);
+		measure("Pooled, vertex offset", Mode::PooledVertexOffset);
+		if (vertexPullingPipeline) {
+			measure("Pooled, vertex pulling", Mode::VertexPulling);
+		} else {
+			std::cout << "\tPooled, vertex pulling: buffer device address unavailable\n";
+		}
+
+		vkFreeCommandBuffers(device.getDevice(), device.getCommandPool(), 1, &commandBuffer);
+		vertexPullingPipeline.reset();
+		vertexInputPipeline.reset();
+		vkDestroyDescriptorPool(device.getDevice(), descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyBuffer(device.getDevice(), uniformBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		device.freeMemory(uniformBufferMemory);
+		vkDestroyPipelineLayout(device.getDevice(), pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorSetLayout(device.getDevice(), descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+	}
+
+	void Benchmark::runMeshlets(std::uint32_t instanceCount, std::uint32_t iterations) {
+		std::cout << "Meshlet culling benchmark (" << instanceCount << " instances, " << iterations << " iterations)\n";
+
+		Window window{ 320, 240, "HELP meshlets" };
+		Device device{ window };
+
+		const std::uint32_t meshCount = 4;
+		std::vector<Model::Builder> builders(meshCount);
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (std::uint32_t i = 0; i < meshCount; ++i) {
+			builders[i] = createSphere(64 << (i % 2), 32 << (i / 2));
+
+			auto start = std::chrono::high_resolution_clock::now();
+			builders[i].generateMeshlets();
+			double buildTime = getMilliseconds(start);
+
+			std::uint32_t maxVertices = 0;
+			std::uint32_t maxTriangles = 0;
+			for (const Meshlet &meshlet : builders[i].meshlets) {
+				maxVertices = std::max(maxVertices, meshlet.vertexCount);
+				maxTriangles = std::max(maxTriangles, meshlet.indexCount / 3);
+			}
+
+			std::cout << "\tMesh " << i << ": " << builders[i].indices.size() / 3 << " triangles, " << builders[i].meshlets.size() << " meshlets ";
+			std::cout << "(max " << maxVertices << " vertices, " << maxTriangles << " triangles), " << buildTime << " ms build\n";
+
+			vertexCount += static_cast<std::uint32_t>(builders[i].vertices.size());
+			indexCount += static_cast<std::uint32_t>(builders[i].indices.size());
+		}
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), vertexCount, indexCount };
+		std::vector<std::unique_ptr<Model>> models;
+		for (const Model::Builder &builder : builders) {
+			models.push_back(std::make_unique<Model>(geometryPool, builder));
+		}
+		geometryPool.flush();
+
+		std::uint32_t meshletCount = 0;
+		std::uint32_t maxDraws = 0;
+		for (std::uint32_t i = 0; i < instanceCount; ++i) {
+			maxDraws += static_cast<std::uint32_t>(models[i % meshCount]->getMeshlets().size());
+		}
+		for (const std::unique_ptr<Model> &model : models) {
+			meshletCount += static_cast<std::uint32_t>(model->getMeshlets().size());
+		}
+
+		MeshletCuller meshletCuller{ device, meshletCount, instanceCount, maxDraws, 1 };
+		std::vector<MeshletCuller::MeshId> meshIds;
+		for (const std::unique_ptr<Model> &model : models) {
+			meshIds.push_back(meshletCuller.addMesh(*model));
+		}
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> position{ -60.0f, 60.0f };
+		std::uniform_real_distribution<float> scale{ 1.0f, 4.0f };
+
+		std::vector<MeshletCuller::Instance> instances(instanceCount);
+		std::vector<BoundingSphere> instanceBounds(instanceCount);
+		for (std::uint32_t i = 0; i < instanceCount; ++i) {
+			glm::vec3 translation{ position(random), position(random), position(random) };
+			float instanceScale = scale(random);
+
+			MeshletCuller::Instance &instance = instances[i];
+			instance.transform = glm::mat4{ instanceScale };
+			instance.transform[3] = glm::vec4{ translation, 1.0f };
+			instance.mesh = meshIds[i % meshCount];
+
+			BoundingSphere sphere = models[i % meshCount]->getBoundingBox().getBoundingSphere();
+			instanceBounds[i] = BoundingSphere{ translation + sphere.center * instanceScale, sphere.radius * instanceScale };
+		}
+		meshletCuller.setInstances(0, instances);
+
+		Camera camera{};
+		camera.setPerspectiveProjection(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+		camera.setViewDirection({ 0.0f, 0.0f, -70.0f }, { 0.0f, 0.0f, 1.0f });
+		Frustum frustum = camera.getFrustum();
+
+		std::uint64_t totalTriangles = 0;
+		std::uint64_t objectVisibleTriangles = 0;
+		std::uint32_t objectVisibleCount = 0;
+		for (std::uint32_t i = 0; i < instanceCount; ++i) {
+			std::uint64_t triangles = models[i % meshCount]->getLod(0).indexCount / 3;
+			totalTriangles += triangles;
+			if (frustum.intersects(instanceBounds[i])) {
+				objectVisibleTriangles += triangles;
+				++objectVisibleCount;
+			}
+		}
+
+		auto runCull = [&]() {
+			VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+			meshletCuller.cull(commandBuffer, 0, camera);
+			device.endSingleTimeCommands(commandBuffer);
+		};
+
+		runCull();
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < iterations; ++i) {
+			runCull();
+		}
+		double cullTime = getMilliseconds(start) / iterations;
+
+		MeshletCuller::Statistics statistics = meshletCuller.readStatistics(0);
+
+		std::cout << "\tScene: " << totalTriangles << " triangles, " << statistics.meshletCount << " meshlets\n";
+		std::cout << "\tObject frustum culling: " << objectVisibleCount << " objects, " << objectVisibleTriangles << " triangles submitted\n";
+		std::cout << "\tMeshlet culling: " << statistics.drawCount << " meshlets, " << statistics.visibleTriangleCount << " triangles submitted (";
+		std::cout << statistics.frustumCulledMeshletCount << " frustum culled, " << statistics.coneCulledMeshletCount << " cone culled), ";
+		std::cout << cullTime << " ms per cull submit\n";
+		if (statistics.visibleTriangleCount > 0) {
+			std::cout << "\tTriangle reduction over object culling: " << static_cast<double>(objectVisibleTriangles) / statistics.visibleTriangleCount << "x\n";
+		}
+		std::cout << "\tIndirect draws: " << (meshletCuller.isCompactionEnabled() ? "compacted with draw count" : "fixed slots") << '\n';
+	}
+
+	void Benchmark::runOcclusion(std::uint32_t objectCount, std::uint32_t frameCount) {
+		std::cout << "Occlusion culling benchmark (" << objectCount << " objects, " << frameCount << " frames)\n";
+
+		Window window{ 320, 240, "HELP occlusion" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+		BindlessResources bindlessResources{ device };
+
+		const VkExtent2D extent{ 1920, 1080 };
+
+		std::vector<Model::Builder> builders;
+
+		const std::uint32_t wallColumns = 12;
+		const std::uint32_t wallRows = 8;
+		for (std::uint32_t row = 0; row < wallRows; ++row) {
+			for (std::uint32_t column = 0; column < wallColumns; ++column) {
+				if ((column == 2 && row >= 5) || (column == 9 && row >= 4)) {
+					continue;
+				}
+
+				glm::vec3 min{ -36.0f + 6.0f * column, -24.0f + 6.0f * row, 0.0f };
+				builders.push_back(createBox(min, min + glm::vec3{ 6.0f, 6.0f, 1.0f }));
+			}
+		}
+		const std::uint32_t occluderCount = static_cast<std::uint32_t>(builders.size());
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+
+		Model::Builder sphere = createSphere(16, 12);
+		for (std::uint32_t i = occluderCount; i < objectCount; ++i) {
+			bool front = unit(random) < 0.15f;
+			glm::vec3 center = front
+				? glm::vec3{ -15.0f + 30.0f * unit(random), -8.0f + 16.0f * unit(random), -30.0f + 25.0f * unit(random) }
+				: glm::vec3{ -50.0f + 100.0f * unit(random), -30.0f + 60.0f * unit(random), 5.0f + 75.0f * unit(random) };
+			float radius = 0.5f + unit(random);
+			glm::vec3 color{ unit(random), unit(random), unit(random) };
+
+			Model::Builder builder = sphere;
+			for (Model::Vertex &vertex : builder.vertices) {
+				vertex.position = center + vertex.position * radius;
+				vertex.color = color;
+			}
+			builders.push_back(std::move(builder));
+		}
+
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (const Model::Builder &builder : builders) {
+			vertexCount += static_cast<std::uint32_t>(builder.vertices.size());
+			indexCount += static_cast<std::uint32_t>(builder.indices.size());
+		}
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), vertexCount, indexCount };
+		std::vector<std::unique_ptr<Model>> models;
+		models.reserve(builders.size());
+		for (const Model::Builder &builder : builders) {
+			models.push_back(std::make_unique<Model>(geometryPool, builder));
+		}
+		geometryPool.flush();
+
+		std::vector<OcclusionCuller::Object> objects(models.size());
+		for (std::size_t i = 0; i < models.size(); ++i) {
+			const GeometryPool::Allocation &allocation = models[i]->getAllocation();
+			const Model::Lod &lod = models[i]->getLod(0);
+
+			objects[i].bounds = models[i]->getBoundingBox().getBoundingSphere();
+			objects[i].indexCount = lod.indexCount;
+			objects[i].firstIndex = allocation.firstIndex + lod.firstIndex;
+			objects[i].vertexOffset = static_cast<std::int32_t>(allocation.firstVertex);
+		}
+
+		std::cout << "\tScene: " << occluderCount << " wall occluders, " << objects.size() - occluderCount << " spheres, " << indexCount / 3 << " triangles\n";
+
+		Camera camera{};
+		camera.setPerspectiveProjection(glm::radians(50.0f), static_cast<float>(extent.width) / static_cast<float>(extent.height), 0.1f, 200.0f);
+		camera.setViewDirection({ 0.0f, 0.0f, -40.0f }, { 0.0f, 0.0f, 1.0f });
+
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{};
+		descriptorSetLayoutBinding.binding = 0;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorSetLayoutBinding.descriptorCount = 1;
+		descriptorSetLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = 1;
+		descriptorSetLayoutCreateInfo.pBindings = &descriptorSetLayoutBinding;
+
+		VkDescriptorSetLayout descriptorSetLayout;
+		if (vkCreateDescriptorSetLayout(device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor set layout.");
+		}
+
+		struct PushConstants {
+			glm::mat4 transform{ 1.0f };
+			std::uint32_t materialIndex = 0;
+			std::uint32_t padding = 0;
+			VkDeviceAddress vertexAddress = 0;
+		};
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstants);
+
+		std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts{ descriptorSetLayout, bindlessResources.getDescriptorSetLayout() };
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		VkPipelineLayout pipelineLayout;
+		if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create pipeline layout.");
+		}
+
+		VkBuffer uniformBuffer;
+		VkDeviceMemory uniformBufferMemory;
+		device.createBuffer(sizeof(glm::mat4), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uniformBuffer, uniformBufferMemory);
+
+		glm::mat4 projectionView = camera.getProjectionView();
+		void *uniformData;
+		vkMapMemory(device.getDevice(), uniformBufferMemory, 0, sizeof(glm::mat4), 0, &uniformData);
+		std::memcpy(uniformData, &projectionView, sizeof(glm::mat4));
+		vkUnmapMemory(device.getDevice(), uniformBufferMemory);
+
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorPoolSize.descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		VkDescriptorPool descriptorPool;
+		if (vkCreateDescriptorPool(device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &descriptorSetLayout;
+
+		VkDescriptorSet descriptorSet;
+		if (vkAllocateDescriptorSets(device.getDevice(), &descriptorSetAllocateInfo, &descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate descriptor sets.");
+		}
+
+		VkDescriptorBufferInfo descriptorBufferInfo{};
+		descriptorBufferInfo.buffer = uniformBuffer;
+		descriptorBufferInfo.offset = 0;
+		descriptorBufferInfo.range = sizeof(glm::mat4);
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.pNext = nullptr;
+		writeDescriptorSet.dstSet = descriptorSet;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.dstArrayElement = 0;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+		vkUpdateDescriptorSets(device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+
+		std::unique_ptr<Pipeline> pipeline = std::make_unique<Pipeline>(device, swapchain, pipelineLayout);
+
+		VkQueryPool queryPool = VK_NULL_HANDLE;
+		if (device.hasTimestamps()) {
+			VkQueryPoolCreateInfo queryPoolCreateInfo{};
+			queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			queryPoolCreateInfo.pNext = nullptr;
+			queryPoolCreateInfo.flags = 0;
+			queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			queryPoolCreateInfo.queryCount = 2;
+
+			if (vkCreateQueryPool(device.getDevice(), &queryPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Query), &queryPool) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create query pool.");
+			}
+		}
+
+		HiZBuffer hiZBuffer{ device, extent, 1 };
+		OcclusionCuller occlusionCuller{ device, hiZBuffer, static_cast<std::uint32_t>(objects.size()), 1 };
+		occlusionCuller.setObjects(0, objects);
+
+		RenderGraph graph{};
+		RenderGraphExecutor executor{ device };
+
+		VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f };
+		VkRect2D scissor{ { 0, 0 }, extent };
+
+		auto drawScene = [&](VkCommandBuffer commandBuffer, OcclusionCuller::Phase phase) {
+			pipeline->bind(commandBuffer);
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+			std::array<VkDescriptorSet, 2> descriptorSets{ descriptorSet, bindlessResources.getDescriptorSet(0) };
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, static_cast<std::uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+
+			PushConstants pushConstants{};
+			vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
+
+			geometryPool.bind(commandBuffer);
+			occlusionCuller.draw(commandBuffer, 0, phase);
+		};
+
+		auto buildGraph = [&]() {
+			graph.reset();
+
+			RenderGraph::ImageDescription colorDescription{};
+			colorDescription.format = swapchain.getImageFormat();
+			colorDescription.extent = extent;
+			colorDescription.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+			colorDescription.aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+
+			RenderGraph::ImageDescription depthDescription{};
+			depthDescription.format = swapchain.getDepthFormat();
+			depthDescription.extent = extent;
+			depthDescription.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+			depthDescription.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+			RenderGraph::ResourceHandle color = graph.createImage("color", colorDescription);
+			RenderGraph::ResourceHandle depth = graph.createImage("depth", depthDescription);
+			graph.markOutput(color);
+
+			VkClearValue colorClearValue{};
+			colorClearValue.color = { { 0.01f, 0.01f, 0.01f, 1.0f } };
+
+			VkClearValue depthClearValue{};
+			depthClearValue.depthStencil = { 1.0f, 0 };
+
+			OcclusionCuller::GraphResources culling = occlusionCuller.importResources(graph, 0);
+
+			graph.addPass("early cull", RenderGraph::PassType::Compute)
+				.write(culling.draws, RenderGraph::Access::StorageWrite)
+				.write(culling.counters, RenderGraph::Access::StorageWrite)
+				.setExecute([&](VkCommandBuffer commandBuffer) {
+					occlusionCuller.cull(commandBuffer, 0, OcclusionCuller::Phase::Early, camera);
+				});
+
+			graph.addPass("early draw", RenderGraph::PassType::Graphics)
+				.clear(color, RenderGraph::Access::ColorAttachment, colorClearValue)
+				.clear(depth, RenderGraph::Access::DepthAttachment, depthClearValue)
+				.read(culling.draws, RenderGraph::Access::IndirectBuffer)
+				.read(culling.counters, RenderGraph::Access::IndirectBuffer)
+				.setExecute([&](VkCommandBuffer commandBuffer) {
+					drawScene(commandBuffer, OcclusionCuller::Phase::Early);
+				});
+
+			graph.addPass("hi-z", RenderGraph::PassType::Compute)
+				.read(depth, RenderGraph::Access::Sampled)
+				.setSideEffect()
+				.setExecute([&, depth](VkCommandBuffer commandBuffer) {
+					hiZBuffer.build(commandBuffer, 0, executor.getImageView(depth));
+				});
+
+			graph.addPass("late cull", RenderGraph::PassType::Compute)
+				.write(culling.draws, RenderGraph::Access::StorageWrite)
+				.write(culling.counters, RenderGraph::Access::StorageWrite)
+				.setExecute([&](VkCommandBuffer commandBuffer) {
+					occlusionCuller.cull(commandBuffer, 0, OcclusionCuller::Phase::Late, camera);
+				});
+
+			graph.addPass("late draw", RenderGraph::PassType::Graphics)
+				.write(color, RenderGraph::Access::ColorAttachment)
+				.write(depth, RenderGraph::Access::DepthAttachment)
+				.read(culling.draws, RenderGraph::Access::IndirectBuffer)
+				.read(culling.counters, RenderGraph::Access::IndirectBuffer)
+				.setExecute([&](VkCommandBuffer commandBuffer) {
+					drawScene(commandBuffer, OcclusionCuller::Phase::Late);
+				});
+
+			graph.addPass("hi-z history", RenderGraph::PassType::Compute)
+				.read(depth, RenderGraph::Access::Sampled)
+				.setSideEffect()
+				.setExecute([&, depth](VkCommandBuffer commandBuffer) {
+					hiZBuffer.build(commandBuffer, 0, executor.getImageView(depth));
+				});
+		};
+
+		FrameArena frameArena{ 64 * 1024 };
+
+		auto runFrame = [&]() {
+			frameArena.reset();
+
+			VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+			if (queryPool != VK_NULL_HANDLE) {
+				vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+				vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+			}
+
+			buildGraph();
+			executor.execute(graph, commandBuffer, frameArena);
+
+			if (queryPool != VK_NULL_HANDLE) {
+				vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+			}
+			device.endSingleTimeCommands(commandBuffer);
+
+			if (queryPool == VK_NULL_HANDLE) {
+				return 0.0;
+			}
+
+			std::uint64_t timestamps[2]{};
+			vkGetQueryPoolResults(device.getDevice(), queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+			return static_cast<double>(timestamps[1] - timestamps[0]) * device.getTimestampPeriod() / 1000000.0;
+		};
+
+		auto measure = [&](const char *name, bool occlusion) {
+			occlusionCuller.setOcclusionEnabled(occlusion);
+			runFrame();
+			runFrame();
+
+			double gpuTime = 0.0;
+			auto start = std::chrono::high_resolution_clock::now();
+			for (std::uint32_t i = 0; i < frameCount; ++i) {
+				gpuTime += runFrame();
+			}
+			double frameTime = getMilliseconds(start) / frameCount;
+			gpuTime /= frameCount;
+
+			OcclusionCuller::Statistics statistics = occlusionCuller.readStatistics(0);
+
+			std::cout << '\t' << name << ": " << statistics.earlyDrawCount << " early + " << statistics.lateDrawCount << " late draws (";
+			std::cout << statistics.frustumCulledCount << " frustum culled, " << statistics.occludedCount << " occluded), ";
+			if (queryPool != VK_NULL_HANDLE) {
+				std::cout << gpuTime << " ms GPU, ";
+			}
+			std::cout << frameTime << " ms per frame submit\n";
+
+			return queryPool != VK_NULL_HANDLE ? gpuTime : frameTime;
+		};
+
+		double baselineTime = measure("Frustum culling", false);
+		double occlusionTime = measure("Two-phase occlusion culling", true);
+
+		std::cout << "\tTime saved by occlusion culling: " << baselineTime - occlusionTime << " ms";
+		if (baselineTime > 0.0) {
+			std::cout << " (" << 100.0 * (baselineTime - occlusionTime) / baselineTime << "%)";
+		}
+		std::cout << (queryPool != VK_NULL_HANDLE ? " GPU\n" : " CPU wall clock, timestamps unavailable\n");
+		std::cout << "\tIndirect draws: " << (device.getCapabilities().isEnabled(Capability::DrawIndirectCount) ? "compacted with draw count" : "fixed slots") << '\n';
+
+		executor.releaseResources();
+		if (queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(device.getDevice(), queryPool, VulkanAllocator::get(AllocationCategory::Query));
+		}
+		pipeline.reset();
+		vkDestroyDescriptorPool(device.getDevice(), descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyBuffer(device.getDevice(), uniformBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		device.freeMemory(uniformBufferMemory);
+		vkDestroyPipelineLayout(device.getDevice(), pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorSetLayout(device.getDevice(), descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+	}
+
+	void Benchmark::runRenderThread(std::uint32_t objectCount, std::uint32_t frameCount) {
+		std::cout << "Render thread benchmark (" << objectCount << " objects, " << frameCount << " frames)\n";
+
+		Window window{ 320, 240, "HELP render thread" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+		BindlessResources bindlessResources{ device };
+
+		const std::uint32_t meshCount = 4;
+		std::vector<Model::Builder> builders(meshCount);
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (std::uint32_t i = 0; i < meshCount; ++i) {
+			builders[i] = createSphere(8 << i, 6 << i);
+			vertexCount += static_cast<std::uint32_t>(builders[i].vertices.size());
+			indexCount += static_cast<std::uint32_t>(builders[i].indices.size());
+		}
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), vertexCount, indexCount };
+		std::vector<std::unique_ptr<Model>> models;
+		for (const Model::Builder &builder : builders) {
+			models.push_back(std::make_unique<Model>(geometryPool, builder));
+		}
+		geometryPool.flush();
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> position{ -60.0f, 60.0f };
+		std::uniform_real_distribution<float> velocity{ -2.0f, 2.0f };
+
+		Simulation simulation{};
+		SceneGraph sceneGraph{};
+		std::vector<SceneGraph::NodeId> nodes;
+		for (std::uint32_t i = 0; i < objectCount; ++i) {
+			TransformComponent transform{};
+			transform.translation = { position(random), position(random), position(random) + 70.0f };
+
+			SceneGraph::NodeId parent = i % 8 == 0 ? SceneGraph::INVALID_NODE : nodes[i - i % 8];
+			if (parent != SceneGraph::INVALID_NODE) {
+				transform.translation = { position(random) * 0.05f, position(random) * 0.05f, position(random) * 0.05f };
+				transform.scale = glm::vec3{ 0.5f };
+			}
+
+			nodes.push_back(sceneGraph.createNode(parent, transform));
+			simulation.addBody(transform, { velocity(random), velocity(random), velocity(random) });
+		}
+
+		Camera camera{};
+		camera.setPerspectiveProjection(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+		camera.setViewDirection({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f });
+		Frustum frustum = camera.getFrustum();
+
+		std::vector<TransformComponent> transforms;
+		auto produce = [&](RenderFrame &frame) {
+			auto start = std::chrono::high_resolution_clock::now();
+
+			simulation.advance(simulation.getTimeStep());
+			simulation.interpolate(transforms);
+
+			for (std::size_t i = 0; i < transforms.size(); ++i) {
+				sceneGraph.setLocalTransform(nodes[i], transforms[i]);
+			}
+			sceneGraph.update();
+
+			frame.camera = camera;
+			frame.frameTime = simulation.getTimeStep();
+			for (std::uint32_t i = 0; i < objectCount; ++i) {
+				const std::uint32_t model = i % meshCount;
+				const glm::mat4 &transform = sceneGraph.getWorldTransform(nodes[i]);
+				if (!frustum.intersects(models[model]->getBoundingBox().transform(transform))) {
+					continue;
+				}
+
+				RenderPacket packet{};
+				packet.model = model;
+				packet.transformIndex = static_cast<std::uint32_t>(frame.transforms.size());
+				packet.sortKey = DrawList::encodeKey(0, 0, 0, model, 0);
+
+				frame.transforms.push_back(transform);
+				frame.drawList.add(packet);
+			}
+
+			frame.drawList.sort();
+
+			frame.gameTime = static_cast<float>(getMilliseconds(start) / 1000.0);
+		};
+
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{};
+		descriptorSetLayoutBinding.binding = 0;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorSetLayoutBinding.descriptorCount = 1;
+		descriptorSetLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = 1;
+		descriptorSetLayoutCreateInfo.pBindings = &descriptorSetLayoutBinding;
+
+		VkDescriptorSetLayout descriptorSetLayout;
+		if (vkCreateDescriptorSetLayout(device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor set layout.");
+		}
+
+		struct PushConstants {
+			glm::mat4 transform{ 1.0f };
+			std::uint32_t materialIndex = 0;
+			std::uint32_t padding = 0;
+			VkDeviceAddress vertexAddress = 0;
+		};
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstants);
+
+		std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts{ descriptorSetLayout, bindlessResources.getDescriptorSetLayout() };
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		VkPipelineLayout pipelineLayout;
+		if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create pipeline layout.");
+		}
+
+		VkBuffer uniformBuffer;
+		VkDeviceMemory uniformBufferMemory;
+		device.createBuffer(sizeof(glm::mat4), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uniformBuffer, uniformBufferMemory);
+
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorPoolSize.descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		VkDescriptorPool descriptorPool;
+		if (vkCreateDescriptorPool(device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &descriptorSetLayout;
+
+		VkDescriptorSet descriptorSet;
+		if (vkAllocateDescriptorSets(device.getDevice(), &descriptorSetAllocateInfo, &descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate descriptor sets.");
+		}
+
+		VkDescriptorBufferInfo descriptorBufferInfo{};
+		descriptorBufferInfo.buffer = uniformBuffer;
+		descriptorBufferInfo.offset = 0;
+		descriptorBufferInfo.range = sizeof(glm::mat4);
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.pNext = nullptr;
+		writeDescriptorSet.dstSet = descriptorSet;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.dstArrayElement = 0;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+		vkUpdateDescriptorSets(device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+
+		std::unique_ptr<Pipeline> pipeline = std::make_unique<Pipeline>(device, swapchain, pipelineLayout);
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferAllocateInfo.pNext = nullptr;
+		commandBufferAllocateInfo.commandPool = device.getCommandPool();
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		if (vkAllocateCommandBuffers(device.getDevice(), &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate command buffers.");
+		}
+
+		VkFormat colorAttachmentFormat = swapchain.getImageFormat();
+
+		VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo{};
+		inheritanceRenderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+		inheritanceRenderingInfo.pNext = nullptr;
+		inheritanceRenderingInfo.flags = 0;
+		inheritanceRenderingInfo.viewMask = 0;
+		inheritanceRenderingInfo.colorAttachmentCount = 1;
+		inheritanceRenderingInfo.pColorAttachmentFormats = &colorAttachmentFormat;
+		inheritanceRenderingInfo.depthAttachmentFormat = swapchain.getDepthFormat();
+		inheritanceRenderingInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+		inheritanceRenderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.pNext = device.isDynamicRenderingEnabled() ? &inheritanceRenderingInfo : nullptr;
+		inheritanceInfo.renderPass = device.isDynamicRenderingEnabled() ? VK_NULL_HANDLE : swapchain.getRenderPass();
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		commandBufferBeginInfo.pNext = nullptr;
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(swapchain.getExtent().width), static_cast<float>(swapchain.getExtent().height), 0.0f, 1.0f };
+		VkRect2D scissor{ { 0, 0 }, swapchain.getExtent() };
+
+		void *uniformData;
+		vkMapMemory(device.getDevice(), uniformBufferMemory, 0, sizeof(glm::mat4), 0, &uniformData);
+
+		auto consume = [&](const RenderFrame &frame) {
+			glm::mat4 projectionView = frame.camera.getProjectionView();
+			std::memcpy(uniformData, &projectionView, sizeof(glm::mat4));
+
+			vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+
+			pipeline->bind(commandBuffer);
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+			std::array<VkDescriptorSet, 2> descriptorSets{ descriptorSet, bindlessResources.getDescriptorSet(0) };
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, static_cast<std::uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+			geometryPool.bind(commandBuffer);
+
+			for (const RenderPacket &packet : frame.drawList.getPackets()) {
+				PushConstants pushConstants{};
+				pushConstants.transform = frame.transforms[packet.transformIndex];
+				pushConstants.materialIndex = packet.material;
+
+				vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
+				models[packet.model]->draw(commandBuffer, packet.lod);
+			}
+
+			vkEndCommandBuffer(commandBuffer);
+		};
+
+		RenderFrame serialFrame{};
+		produce(serialFrame);
+		consume(serialFrame);
+
+		double gameTime = 0.0;
+		double renderTime = 0.0;
+		std::size_t drawCount = 0;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < frameCount; ++i) {
+			serialFrame.clear();
+			produce(serialFrame);
+
+			auto renderStart = std::chrono::high_resolution_clock::now();
+			consume(serialFrame);
+			renderTime += getMilliseconds(renderStart);
+
+			gameTime += serialFrame.gameTime * 1000.0;
+			drawCount += serialFrame.drawList.size();
+		}
+		double serialTime = getMilliseconds(start) / frameCount;
+
+		std::cout << "\tScene: " << drawCount / frameCount << " visible of " << objectCount << " objects per frame\n";
+		std::cout << "\tSingle thread: " << serialTime << " ms per frame (game " << gameTime / frameCount << " ms + render " << renderTime / frameCount << " ms)\n";
+
+		RenderQueue renderQueue{};
+		std::thread renderThread([&]() {
+			while (RenderFrame *frame = renderQueue.acquireRead()) {
+				consume(*frame);
+				renderQueue.release();
+			}
+		});
+
+		start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < frameCount; ++i) {
+			RenderFrame *frame = renderQueue.acquireWrite();
+			produce(*frame);
+			renderQueue.publish();
+		}
+		renderQueue.close();
+		renderThread.join();
+		double threadedTime = getMilliseconds(start) / frameCount;
+
+		std::cout << "\tRender thread: " << threadedTime << " ms per frame (" << renderQueue.getProducerStallCount() << " game stalls, " << renderQueue.getConsumerStallCount() << " render stalls)\n";
+		std::cout << "\tSpeedup: " << serialTime / threadedTime << "x\n";
+
+		vkUnmapMemory(device.getDevice(), uniformBufferMemory);
+		vkFreeCommandBuffers(device.getDevice(), device.getCommandPool(), 1, &commandBuffer);
+		pipeline.reset();
+		vkDestroyDescriptorPool(device.getDevice(), descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyBuffer(device.getDevice(), uniformBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		device.freeMemory(uniformBufferMemory);
+		vkDestroyPipelineLayout(device.getDevice(), pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorSetLayout(device.getDevice(), descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+	}
+
+	void Benchmark::runDrawKeys(std::uint32_t packetCount, std::uint32_t drawCount) {
+		std::cout << "Draw key benchmark (" << packetCount << " packets, " << drawCount << " draws)\n";
+
+		std::mt19937 random{ 1234 };
+		std::uniform_int_distribution<std::uint32_t> pipelineIndex{ 0, 3 };
+		std::uniform_int_distribution<std::uint32_t> materialIndex{ 0, 4095 };
+		std::uniform_int_distribution<std::uint32_t> modelIndex{ 0, 255 };
+		std::uniform_real_distribution<float> distance{ 0.0f, 200.0f };
+
+		std::vector<RenderPacket> packets(packetCount);
+		for (std::uint32_t i = 0; i < packetCount; ++i) {
+			RenderPacket &packet = packets[i];
+			packet.model = modelIndex(random);
+			packet.material = materialIndex(random);
+			packet.transformIndex = i;
+			packet.sortKey = DrawList::encodeKey(0, pipelineIndex(random), packet.material, packet.model, DrawList::quantizeDepth(distance(random), 200.0f));
+		}
+
+		const std::uint32_t iterations = 10;
+		const std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+		double stdSortTime = 0.0;
+		std::vector<RenderPacket> reference;
+		for (std::uint32_t i = 0; i < iterations; ++i) {
+			reference = packets;
+
+			auto start = std::chrono::high_resolution_clock::now();
+			std::sort(reference.begin(), reference.end(), [](const RenderPacket &a, const RenderPacket &b) {
+				return a.sortKey < b.sortKey;
+			});
+			stdSortTime += getMilliseconds(start);
+		}
+
+		DrawList drawList{};
+		drawList.reserve(packetCount);
+
+		auto runRadixSort = [&](std::size_t threads) {
+			double time = 0.0;
+			for (std::uint32_t i = 0; i < iterations; ++i) {
+				drawList.clear();
+				for (const RenderPacket &packet : packets) {
+					drawList.add(packet);
+				}
+
+				auto start = std::chrono::high_resolution_clock::now();
+				drawList.sort(threads);
+				time += getMilliseconds(start);
+			}
+
+			const std::vector<RenderPacket> &sorted = drawList.getPackets();
+			for (std::size_t i = 0; i < sorted.size(); ++i) {
+				if (sorted[i].sortKey != reference[i].sortKey) {
+					throw std::runtime_error("Radix sorted draw keys differ from the reference order.");
+				}
+			}
+
+			return time / iterations;
+		};
+
+		double radixTime = runRadixSort(1);
+		double parallelRadixTime = runRadixSort(threadCount);
+
+		std::cout << "\tstd::sort: " << stdSortTime / iterations << " ms\n";
+		std::cout << "\tRadix sort: " << radixTime << " ms (" << drawList.getSortedDigitCount() << " digit passes, " << stdSortTime / iterations / radixTime << "x)\n";
+		std::cout << "\tRadix sort (" << threadCount << " threads): " << parallelRadixTime << " ms (" << stdSortTime / iterations / parallelRadixTime << "x)\n";
+
+		Window window{ 320, 240, "HELP draw keys" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+		BindlessResources bindlessResources{ device };
+
+		const std::uint32_t poolCount = 2;
+		const std::uint32_t meshCount = 64;
+		const std::uint32_t pipelineCount = 2;
+		const std::uint32_t materialCount = 64;
+
+		std::vector<Model::Builder> builders(meshCount);
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (std::uint32_t i = 0; i < meshCount; ++i) {
+			builders[i] = createSphere(8 + i % 8, 6 + i / 8);
+			vertexCount += static_cast<std::uint32_t>(builders[i].vertices.size());
+			indexCount += static_cast<std::uint32_t>(builders[i].indices.size());
+		}
+
+		std::vector<std::unique_ptr<GeometryPool>> geometryPools;
+		for (std::uint32_t i = 0; i < poolCount; ++i) {
+			geometryPools.push_back(std::make_unique<GeometryPool>(device, sizeof(Model::Vertex), vertexCount, indexCount));
+		}
+
+		std::vector<std::unique_ptr<Model>> models;
+		for (std::uint32_t i = 0; i < meshCount; ++i) {
+			models.push_back(std::make_unique<Model>(*geometryPools[i * poolCount / meshCount], builders[i]));
+		}
+		for (std::unique_ptr<GeometryPool> &geometryPool : geometryPools) {
+			geometryPool->flush();
+		}
+
+		struct PushConstants {
+			glm::mat4 transform{ 1.0f };
+			std::uint32_t materialIndex = 0;
+			std::uint32_t padding = 0;
+			VkDeviceAddress vertexAddress = 0;
+		};
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstants);
+
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{};
+		descriptorSetLayoutBinding.binding = 0;
+		descriptorSetLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorSetLayoutBinding.descriptorCount = 1;
+		descriptorSetLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = 1;
+		descriptorSetLayoutCreateInfo.pBindings = &descriptorSetLayoutBinding;
+
+		VkDescriptorSetLayout descriptorSetLayout;
+		if (vkCreateDescriptorSetLayout(device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor set layout.");
+		}
+
+		std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts{ descriptorSetLayout, bindlessResources.getDescriptorSetLayout() };
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		VkPipelineLayout pipelineLayout;
+		if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create pipeline layout.");
+		}
+
+		VkBuffer uniformBuffer;
+		VkDeviceMemory uniformBufferMemory;
+		device.createBuffer(sizeof(glm::mat4), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uniformBuffer, uniformBufferMemory);
+
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorPoolSize.descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		VkDescriptorPool descriptorPool;
+		if (vkCreateDescriptorPool(device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &descriptorSetLayout;
+
+		VkDescriptorSet descriptorSet;
+		if (vkAllocateDescriptorSets(device.getDevice(), &descriptorSetAllocateInfo, &descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate descriptor sets.");
+		}
+
+		VkDescriptorBufferInfo descriptorBufferInfo{};
+		descriptorBufferInfo.buffer = uniformBuffer;
+		descriptorBufferInfo.offset = 0;
+		descriptorBufferInfo.range = sizeof(glm::mat4);
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.pNext = nullptr;
+		writeDescriptorSet.dstSet = descriptorSet;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.dstArrayElement = 0;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+		vkUpdateDescriptorSets(device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+
+		Pipeline::Config twoSidedConfig = Pipeline::getDefaultConfig();
+		twoSidedConfig.cullMode = VK_CULL_MODE_NONE;
+
+		std::vector<std::unique_ptr<Pipeline>> pipelines;
+		pipelines.push_back(std::make_unique<Pipeline>(device, swapchain, pipelineLayout));
+		pipelines.push_back(std::make_unique<Pipeline>(device, swapchain, pipelineLayout, twoSidedConfig));
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferAllocateInfo.pNext = nullptr;
+		commandBufferAllocateInfo.commandPool = device.getCommandPool();
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		if (vkAllocateCommandBuffers(device.getDevice(), &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate command buffers.");
+		}
+
+		VkFormat colorAttachmentFormat = swapchain.getImageFormat();
+
+		VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo{};
+		inheritanceRenderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+		inheritanceRenderingInfo.pNext = nullptr;
+		inheritanceRenderingInfo.flags = 0;
+		inheritanceRenderingInfo.viewMask = 0;
+		inheritanceRenderingInfo.colorAttachmentCount = 1;
+		inheritanceRenderingInfo.pColorAttachmentFormats = &colorAttachmentFormat;
+		inheritanceRenderingInfo.depthAttachmentFormat = swapchain.getDepthFormat();
+		inheritanceRenderingInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+		inheritanceRenderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.pNext = device.isDynamicRenderingEnabled() ? &inheritanceRenderingInfo : nullptr;
+		inheritanceInfo.renderPass = device.isDynamicRenderingEnabled() ? VK_NULL_HANDLE : swapchain.getRenderPass();
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		commandBufferBeginInfo.pNext = nullptr;
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		std::uniform_int_distribution<std::uint32_t> drawPipeline{ 0, pipelineCount - 1 };
+		std::uniform_int_distribution<std::uint32_t> drawMaterial{ 0, materialCount - 1 };
+		std::uniform_int_distribution<std::uint32_t> drawModel{ 0, meshCount - 1 };
+		std::uniform_real_distribution<float> drawPosition{ -50.0f, 50.0f };
+
+		std::vector<glm::mat4> transforms(drawCount);
+		DrawList drawPackets{};
+		for (std::uint32_t i = 0; i < drawCount; ++i) {
+			transforms[i] = glm::mat4{ 1.0f };
+			transforms[i][3] = glm::vec4{ drawPosition(random), drawPosition(random), drawPosition(random), 1.0f };
+
+			RenderPacket packet{};
+			packet.model = drawModel(random);
+			packet.material = drawMaterial(random);
+			packet.transformIndex = i;
+			packet.sortKey = DrawList::encodeKey(0, drawPipeline(random), packet.material, packet.model, DrawList::quantizeDepth(glm::length(glm::vec3{ transforms[i][3] }), 100.0f));
+			drawPackets.add(packet);
+		}
+
+		std::vector<RenderPacket> unsortedPackets = drawPackets.getPackets();
+		drawPackets.sort();
+
+		auto record = [&](const std::vector<RenderPacket> &drawPacketList, double &time) {
+			std::array<VkDescriptorSet, 2> descriptorSets{ descriptorSet, bindlessResources.getDescriptorSet(0) };
+
+			vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+			DrawRecorder recorder(commandBuffer);
+
+			auto start = std::chrono::high_resolution_clock::now();
+			for (const RenderPacket &packet : drawPacketList) {
+				pipelines[DrawList::getPipeline(packet.sortKey)]->bind(recorder);
+				recorder.bindDescriptorSets(pipelineLayout, 0, static_cast<std::uint32_t>(descriptorSets.size()), descriptorSets.data());
+				geometryPools[packet.model * poolCount / meshCount]->bind(recorder);
+
+				PushConstants pushConstants{};
+				pushConstants.transform = transforms[packet.transformIndex];
+				pushConstants.materialIndex = packet.material;
+
+				recorder.pushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstants), &pushConstants);
+				models[packet.model]->draw(recorder, packet.lod);
+			}
+			time = getMilliseconds(start);
+
+			vkEndCommandBuffer(commandBuffer);
+			return recorder.getStatistics();
+		};
+
+		double unsortedTime = 0.0;
+		double sortedTime = 0.0;
+		DrawRecorder::Statistics unsortedStatistics = record(unsortedPackets, unsortedTime);
+		DrawRecorder::Statistics sortedStatistics = record(drawPackets.getPackets(), sortedTime);
+
+		printRecorderStatistics("Unsorted", unsortedStatistics, unsortedTime);
+		printRecorderStatistics("Sorted", sortedStatistics, sortedTime);
+
+		vkFreeCommandBuffers(device.getDevice(), device.getCommandPool(), 1, &commandBuffer);
+		pipelines.clear();
+		vkDestroyDescriptorPool(device.getDevice(), descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyBuffer(device.getDevice(), uniformBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		device.freeMemory(uniformBufferMemory);
+		vkDestroyPipelineLayout(device.getDevice(), pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorSetLayout(device.getDevice(), descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+	}
+
+	void Benchmark::runFrameArena(std::uint32_t objectCount, std::uint32_t frameCount) {
+		std::cout << "Frame arena benchmark (" << objectCount << " objects, " << frameCount << " frames)\n";
+
+		runFrameArenaLoop(objectCount, frameCount, false);
+		runFrameArenaLoop(objectCount, frameCount, true);
+
+		RenderGraph graph{};
+		buildDeferredFrame(graph, 1920, 1080);
+		graph.compile();
+		std::vector<VkMemoryRequirements> memoryRequirements = estimateMemoryRequirements(graph);
+		graph.assignMemory(memoryRequirements);
+
+		AllocationTracker::Statistics before = AllocationTracker::getStatistics();
+		for (std::uint32_t i = 0; i < frameCount; ++i) {
+			buildDeferredFrame(graph, 1920, 1080);
+			graph.compile();
+			graph.assignMemory(memoryRequirements);
+		}
+		AllocationTracker::Statistics after = AllocationTracker::getStatistics();
+
+		std::cout << "\tRender graph rebuild: " << static_cast<double>(after.allocationCount - before.allocationCount) / frameCount << " heap allocations per frame";
+		std::cout << " (arena high water " << graph.getArena().getHighWaterMark() / 1024.0 << " KB, " << graph.getArena().getOverflowCount() << " overflows)\n";
+	}
+
+	void Benchmark::runFrameArenaLoop(std::uint32_t objectCount, std::uint32_t frameCount, bool useArena) {
+		const std::uint32_t framesInFlight = 2;
+		const std::uint32_t warmupFrames = 8;
+		const std::uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+		const std::uint32_t objectsPerThread = (objectCount + threadCount - 1) / threadCount;
+
+		FrameAllocator frameAllocator{ framesInFlight, threadCount, 16 * 1024 };
+
+		std::vector<glm::vec4> spheres(objectCount);
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+		for (glm::vec4 &sphere : spheres) {
+			sphere = { position(random), position(random), position(random), 1.0f };
+		}
+
+		auto buildFrame = [&](std::uint32_t frame, std::uint32_t thread) {
+			FrameArena &arena = frameAllocator.getArena(frame % framesInFlight, thread);
+			arena.reset();
+
+			ArenaAllocator<std::uint32_t> visibleAllocator = useArena ? ArenaAllocator<std::uint32_t>(arena) : ArenaAllocator<std::uint32_t>();
+			ArenaAllocator<RenderPacket> packetAllocator = useArena ? ArenaAllocator<RenderPacket>(arena) : ArenaAllocator<RenderPacket>();
+			ArenaAllocator<glm::mat4> transformAllocator = useArena ? ArenaAllocator<glm::mat4>(arena) : ArenaAllocator<glm::mat4>();
+
+			const glm::vec3 eye{ std::sin(static_cast<float>(frame) * 0.01f) * 50.0f, 0.0f, 0.0f };
+			const std::uint32_t first = thread * objectsPerThread;
+			const std::uint32_t last = std::min(objectCount, first + objectsPerThread);
+
+			FrameVector<std::uint32_t> visible(visibleAllocator);
+			for (std::uint32_t i = first; i < last; ++i) {
+				if (spheres[i].x > eye.x - 60.0f && spheres[i].x < eye.x + 60.0f) {
+					visible.push_back(i);
+				}
+			}
+
+			FrameVector<RenderPacket> packets(packetAllocator);
+			FrameVector<glm::mat4> transforms(transformAllocator);
+			for (std::uint32_t index : visible) {
+				glm::mat4 transform{ 1.0f };
+				transform[3] = spheres[index];
+
+				RenderPacket packet{};
+				packet.model = index % 16;
+				packet.material = index % 64;
+				packet.transformIndex = static_cast<std::uint32_t>(transforms.size());
+				packet.sortKey = DrawList::encodeKey(0, 0, packet.material, packet.model, DrawList::quantizeDepth(glm::length(glm::vec3{ spheres[index] } - eye), 200.0f));
+
+				transforms.push_back(transform);
+				packets.push_back(packet);
+			}
+
+			std::sort(packets.begin(), packets.end(), [](const RenderPacket &a, const RenderPacket &b) {
+				return a.sortKey < b.sortKey;
+			});
+
+			return packets.size();
+		};
+
+		std::vector<std::uint64_t> drawCounts(threadCount, 0);
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+
+		std::atomic<std::uint32_t> warmedUp{ 0 };
+		std::atomic<bool> measuring{ false };
+
+		auto worker = [&](std::uint32_t thread) {
+			for (std::uint32_t frame = 0; frame < warmupFrames; ++frame) {
+				buildFrame(frame, thread);
+			}
+
+			warmedUp.fetch_add(1);
+			while (!measuring.load()) {
+				std::this_thread::yield();
+			}
+
+			for (std::uint32_t frame = warmupFrames; frame < warmupFrames + frameCount; ++frame) {
+				drawCounts[thread] += buildFrame(frame, thread);
+			}
+		};
+
+		for (std::uint32_t i = 0; i < threadCount; ++i) {
+			threads.emplace_back(worker, i);
+		}
+
+		while (warmedUp.load() < threadCount) {
+			std::this_thread::yield();
+		}
+
+		AllocationTracker::Statistics before = AllocationTracker::getStatistics();
+		auto start = std::chrono::high_resolution_clock::now();
+		measuring.store(true);
+
+		for (std::thread &thread : threads) {
+			thread.join();
+		}
+
+		double time = getMilliseconds(start) / frameCount;
+		AllocationTracker::Statistics after = AllocationTracker::getStatistics();
+
+		std::uint64_t drawCount = 0;
+		for (std::uint64_t count : drawCounts) {
+			drawCount += count;
+		}
+
+		FrameAllocator::Statistics statistics = frameAllocator.getStatistics();
+
+		std::cout << '\t' << (useArena ? "Frame arenas" : "Heap") << " (" << threadCount << " threads): " << time << " ms per frame, " << drawCount / frameCount << " draws";
+		std::cout << ", " << static_cast<double>(after.allocationCount - before.allocationCount) / frameCount << " heap allocations per frame";
+		std::cout << " (" << (after.allocatedBytes - before.allocatedBytes) / frameCount / 1024.0 << " KB)\n";
+		if (useArena) {
+			std::cout << "\t\tArena high water " << statistics.highWaterMark / 1024.0 << " KB, capacity " << statistics.capacity / 1024.0 << " KB over " << framesInFlight * threadCount << " arenas, " << statistics.overflowCount << " overflows\n";
+		}
+	}
+
+	void Benchmark::runMemoryTracking(std::uint32_t allocationCount, std::uint32_t objectCount) {
+		std::cout << "Memory tracking benchmark (" << allocationCount << " allocations, " << objectCount << " Vulkan objects)\n";
+
+		MemoryReport report{};
+
+		std::vector<void *> pointers(allocationCount);
+		std::mt19937 random{ 1234 };
+		std::uniform_int_distribution<std::size_t> size{ 16, 256 };
+		std::vector<std::size_t> sizes(allocationCount);
+		for (std::size_t &allocationSize : sizes) {
+			allocationSize = size(random);
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < allocationCount; ++i) {
+			pointers[i] = std::malloc(sizes[i]);
+		}
+		for (void *pointer : pointers) {
+			std::free(pointer);
+		}
+		double mallocTime = getMilliseconds(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < allocationCount; ++i) {
+			pointers[i] = ::operator new(sizes[i]);
+		}
+		for (void *pointer : pointers) {
+			::operator delete(pointer);
+		}
+		double trackedTime = getMilliseconds(start);
+
+		std::cout << "\tmalloc/free: " << mallocTime * 1000000.0 / allocationCount << " ns per allocation\n";
+		std::cout << "\tTracked operator new/delete: " << trackedTime * 1000000.0 / allocationCount << " ns per allocation\n";
+
+		Window window{ 320, 240, "HELP memory" };
+		Device device{ window };
+
+		double untrackedObjectTime = runVulkanObjectLoop(device, objectCount, nullptr);
+		AllocationTracker::Statistics before = AllocationTracker::getStatistics(AllocationCategory::Resource);
+		double trackedObjectTime = runVulkanObjectLoop(device, objectCount, VulkanAllocator::get(AllocationCategory::Resource));
+		AllocationTracker::Statistics after = AllocationTracker::getStatistics(AllocationCategory::Resource);
+
+		std::cout << "\tVulkan objects without callbacks: " << untrackedObjectTime * 1000.0 / objectCount << " us per create/destroy\n";
+		std::cout << "\tVulkan objects with callbacks: " << trackedObjectTime * 1000.0 / objectCount << " us per create/destroy";
+		std::cout << " (" << static_cast<double>(after.allocationCount - before.allocationCount) / objectCount << " driver allocations, ";
+		std::cout << static_cast<double>(after.allocatedBytes - before.allocatedBytes) / objectCount << " bytes per object)\n";
+
+		report.markFrame();
+		MemoryReport::Snapshot snapshot = report.capture();
+		MemoryReport::print(snapshot);
+		MemoryReport::exportJson("memory_report.json", snapshot);
+		std::cout << "\tWrote memory_report.json\n";
+	}
+
+	double Benchmark::runVulkanObjectLoop(Device &device, std::uint32_t objectCount, const VkAllocationCallbacks *allocator) {
+		VkBufferCreateInfo bufferCreateInfo{};
+		bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferCreateInfo.pNext = nullptr;
+		bufferCreateInfo.flags = 0;
+		bufferCreateInfo.size = 65536;
+		bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bufferCreateInfo.queueFamilyIndexCount = 0;
+		bufferCreateInfo.pQueueFamilyIndices = nullptr;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::uint32_t i = 0; i < objectCount; ++i) {
+			VkBuffer buffer;
+			if (vkCreateBuffer(device.getDevice(), &bufferCreateInfo, allocator, &buffer) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create buffer.");
+			}
+
+			vkDestroyBuffer(device.getDevice(), buffer, allocator);
+		}
+
+		return getMilliseconds(start);
+	}
+
+	void Benchmark::runViews(std::uint32_t objectCount, std::uint32_t frameCount) {
+		std::cout << "Multi-view benchmark (" << objectCount << " objects, " << frameCount << " frames per configuration)\n";
+
+		Window window{ 320, 240, "HELP views" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+		BindlessResources bindlessResources{ device };
+
+		const std::uint32_t meshCount = 4;
+		std::vector<Model::Builder> builders(meshCount);
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (std::uint32_t i = 0; i < meshCount; ++i) {
+			builders[i] = createSphere(8 << i, 6 << i);
+			vertexCount += static_cast<std::uint32_t>(builders[i].vertices.size());
+			indexCount += static_cast<std::uint32_t>(builders[i].indices.size());
+		}
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), vertexCount, indexCount };
+		std::vector<std::shared_ptr<Model>> models;
+		for (const Model::Builder &builder : builders) {
+			models.push_back(std::make_shared<Model>(geometryPool, builder));
+		}
+		geometryPool.flush();
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> position{ -50.0f, 50.0f };
+
+		BoundingVolumeHierarchy boundingVolumeHierarchy{};
+		std::vector<glm::mat4> transforms(objectCount);
+		for (std::uint32_t i = 0; i < objectCount; ++i) {
+			transforms[i] = glm::mat4{ 1.0f };
+			transforms[i][3] = glm::vec4{ position(random), position(random), position(random), 1.0f };
+			boundingVolumeHierarchy.createProxy(models[i % meshCount]->getBoundingBox().transform(transforms[i]), i);
+		}
+
+		struct Result {
+			double cullTime = 0.0;
+			double perViewCullTime = 0.0;
+			double recordTime = 0.0;
+			double submitTime = 0.0;
+			std::uint64_t draws = 0;
+		};
+
+		RenderGraph graph{};
+		RenderGraphExecutor executor{ device };
+		FrameArena frameArena{ 64 * 1024 };
+		ViewBatch batch{};
+		std::vector<std::uint32_t> perViewVisible;
+
+		auto measure = [&](ViewRenderer &viewRenderer) {
+			const std::uint32_t warmupFrameCount = 2;
+
+			Result result{};
+			for (std::uint32_t frame = 0; frame < warmupFrameCount + frameCount; ++frame) {
+				auto cullStart = std::chrono::high_resolution_clock::now();
+				batch.clear();
+				viewRenderer.cull(boundingVolumeHierarchy, batch);
+				for (const BoundingVolumeHierarchy::QueryResult &visible : batch.visible) {
+					RenderPacket packet{};
+					packet.model = visible.userData % meshCount;
+					batch.add(visible.mask, packet, transforms[visible.userData], glm::vec3{ transforms[visible.userData][3] }, 200.0f);
+				}
+				batch.sort();
+				double cullTime = getMilliseconds(cullStart);
+
+				auto perViewCullStart = std::chrono::high_resolution_clock::now();
+				for (std::uint32_t view = 0; view < viewRenderer.getViewCount(); ++view) {
+					for (std::uint32_t layer = 0; layer < viewRenderer.getView(view).getLayerCount(); ++layer) {
+						perViewVisible.clear();
+						boundingVolumeHierarchy.query(viewRenderer.getView(view).getCamera(layer).getFrustum(), perViewVisible);
+					}
+				}
+				double perViewCullTime = getMilliseconds(perViewCullStart);
+
+				auto recordStart = std::chrono::high_resolution_clock::now();
+				frameArena.reset();
+				VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+				graph.reset();
+				viewRenderer.addPasses(graph, batch, models, 0);
+				executor.execute(graph, commandBuffer, frameArena);
+				double recordTime = getMilliseconds(recordStart);
+
+				auto submitStart = std::chrono::high_resolution_clock::now();
+				device.endSingleTimeCommands(commandBuffer);
+				double submitTime = getMilliseconds(submitStart);
+
+				if (frame < warmupFrameCount) {
+					continue;
+				}
+
+				result.cullTime += cullTime;
+				result.perViewCullTime += perViewCullTime;
+				result.recordTime += recordTime;
+				result.submitTime += submitTime;
+				result.draws += viewRenderer.getStatistics().draws;
+			}
+
+			result.cullTime /= frameCount;
+			result.perViewCullTime /= frameCount;
+			result.recordTime /= frameCount;
+			result.submitTime /= frameCount;
+			result.draws /= frameCount;
+
+			executor.releaseResources();
+
+			return result;
+		};
+
+		auto print = [](const std::string &name, const Result &result) {
+			std::cout << '\t' << name << ": " << result.cullTime + result.recordTime + result.submitTime << " ms per frame (";
+			std::cout << "shared cull " << result.cullTime << " ms vs " << result.perViewCullTime << " ms per-view queries, ";
+			std::cout << "record " << result.recordTime << " ms, ";
+			std::cout << "submit and wait " << result.submitTime << " ms), ";
+			std::cout << result.draws << " draws\n";
+		};
+
+		const std::uint32_t atlasSize = 2048;
+		const float orbitRadius = 80.0f;
+
+		for (std::uint32_t viewCount = 1; viewCount <= ViewRenderer::MAX_VIEWS; viewCount *= 2) {
+			const std::uint32_t columns = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<float>(viewCount))));
+			const std::uint32_t tileSize = atlasSize / columns;
+
+			RenderTarget::Description description{};
+			description.extent = { atlasSize, atlasSize };
+			description.format = VK_FORMAT_R8G8B8A8_UNORM;
+
+			RenderTarget target{ device, description };
+			ViewRenderer viewRenderer{ device, swapchain, bindlessResources, geometryPool, 1 };
+
+			for (std::uint32_t i = 0; i < viewCount; ++i) {
+				VkRect2D region{};
+				region.offset = { static_cast<std::int32_t>(i % columns * tileSize), static_cast<std::int32_t>(i / columns * tileSize) };
+				region.extent = { tileSize, tileSize };
+
+				const float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(viewCount);
+
+				Camera camera{};
+				camera.setPerspectiveProjection(glm::radians(60.0f), 1.0f, 0.1f, 200.0f);
+				camera.setViewTarget({ std::cos(angle) * orbitRadius, -20.0f, std::sin(angle) * orbitRadius }, { 0.0f, 0.0f, 0.0f });
+
+				View view(target, region);
+				view.setCamera(camera);
+				viewRenderer.addView(view);
+			}
+
+			print(std::to_string(viewCount) + (viewCount == 1 ? " view" : " views"), measure(viewRenderer));
+		}
+
+		if (!device.isMultiviewEnabled()) {
+			std::cout << "\tMultiview not supported, cube map comparison skipped\n";
+			return;
+		}
+
+		const std::array<glm::vec3, View::MAX_LAYERS> directions{
+			glm::vec3{ 1.0f, 0.0f, 0.0f },
+			glm::vec3{ -1.0f, 0.0f, 0.0f },
+			glm::vec3{ 0.0f, 1.0f, 0.0f },
+			glm::vec3{ 0.0f, -1.0f, 0.0f },
+			glm::vec3{ 0.0f, 0.0f, 1.0f },
+			glm::vec3{ 0.0f, 0.0f, -1.0f }
+		};
+
+		std::array<Camera, View::MAX_LAYERS> faceCameras{};
+		for (std::size_t i = 0; i < faceCameras.size(); ++i) {
+			const glm::vec3 up = directions[i].y != 0.0f ? glm::vec3{ 0.0f, 0.0f, 1.0f } : glm::vec3{ 0.0f, -1.0f, 0.0f };
+
+			faceCameras[i].setPerspectiveProjection(glm::half_pi<float>(), 1.0f, 0.1f, 200.0f);
+			faceCameras[i].setViewDirection({ 0.0f, 0.0f, 0.0f }, directions[i], up);
+		}
+
+		const std::uint32_t faceSize = 512;
+		const VkRect2D faceRegion{ { 0, 0 }, { faceSize, faceSize } };
+
+		{
+			RenderTarget::Description description{};
+			description.extent = { faceSize, faceSize };
+			description.format = VK_FORMAT_R8G8B8A8_UNORM;
+			description.layerCount = View::MAX_LAYERS;
+
+			RenderTarget target{ device, description };
+			ViewRenderer viewRenderer{ device, swapchain, bindlessResources, geometryPool, 1 };
+
+			View view(target, faceRegion, View::MAX_LAYERS);
+			for (std::uint32_t layer = 0; layer < View::MAX_LAYERS; ++layer) {
+				view.setCamera(faceCameras[layer], layer);
+			}
+			viewRenderer.addView(view);
+
+			print("Cube map, multiview", measure(viewRenderer));
+		}
+
+		{
+			RenderTarget::Description description{};
+			description.extent = { faceSize, faceSize };
+			description.format = VK_FORMAT_R8G8B8A8_UNORM;
+
+			std::vector<std::unique_ptr<RenderTarget>> targets;
+			ViewRenderer viewRenderer{ device, swapchain, bindlessResources, geometryPool, 1 };
+
+			for (std::uint32_t face = 0; face < View::MAX_LAYERS; ++face) {
+				targets.push_back(std::make_unique<RenderTarget>(device, description));
+
+				View view(*targets.back(), faceRegion);
+				view.setCamera(faceCameras[face]);
+				viewRenderer.addView(view);
+			}
+
+			print("Cube map, six passes", measure(viewRenderer));
+		}
+	}
+
+	void Benchmark::printRecorderStatistics(const std::string &name, const DrawRecorder::Statistics &statistics, double time) {
+		std::cout << "\t" << name << ": " << statistics.draws << " draws recorded in " << time << " ms\n";
+		std::cout << "\t\tPipeline binds: " << statistics.pipelineBinds << " issued, " << statistics.skippedPipelineBinds << " skipped\n";
+		std::cout << "\t\tDescriptor set binds: " << statistics.descriptorSetBinds << " issued, " << statistics.skippedDescriptorSetBinds << " skipped\n";
+		std::cout << "\t\tVertex buffer binds: " << statistics.vertexBufferBinds << " issued, " << statistics.skippedVertexBufferBinds << " skipped\n";
+		std::cout << "\t\tIndex buffer binds: " << statistics.indexBufferBinds << " issued, " << statistics.skippedIndexBufferBinds << " skipped\n";
+		std::cout << "\t\tPush constant updates: " << statistics.pushConstantUpdates << " issued, " << statistics.skippedPushConstantUpdates << " skipped\n";
+	}
+
+	PhysicalDeviceInfo Benchmark::createMockDevice(std::uint32_t index, const std::string &name, VkPhysicalDeviceType type, VkDeviceSize memoryMb, bool suitable, std::uint8_t uuidByte) {
+		PhysicalDeviceInfo device{};
+		device.index = index;
+		device.name = name;
+		device.type = type;
+		device.uuid.fill(uuidByte);
+		device.deviceLocalMemory = memoryMb << 20;
+		device.suitable = suitable;
+		device.asyncCompute = suitable;
+		device.dynamicRendering = suitable;
+		device.memoryBudget = suitable;
+		return device;
+	}
+
+	void Benchmark::runShadows(std::uint32_t objectCount, std::uint32_t dynamicCount, std::uint32_t frameCount) {
+		std::cout << "Shadow benchmark (" << objectCount << " objects, " << dynamicCount << " moving, " << frameCount << " frames per configuration)\n";
+
+		Window window{ 320, 240, "HELP shadows" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+
+		std::vector<Model::Builder> builders{
+			createBox({ -100.0f, 0.0f, -100.0f }, { 100.0f, 1.0f, 100.0f }),
+			createBox({ -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f }),
+			createSphere(16, 12)
+		};
+
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (const Model::Builder &builder : builders) {
+			vertexCount += static_cast<std::uint32_t>(builder.vertices.size());
+			indexCount += static_cast<std::uint32_t>(builder.indices.size());
+		}
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), vertexCount, indexCount };
+		std::vector<std::shared_ptr<Model>> models;
+		for (const Model::Builder &builder : builders) {
+			models.push_back(std::make_shared<Model>(geometryPool, builder));
+		}
+		geometryPool.flush();
+
+		std::mt19937 random{ 1234 };
+		std::uniform_real_distribution<float> position{ -90.0f, 90.0f };
+		std::uniform_real_distribution<float> height{ 0.5f, 4.0f };
+
+		std::vector<glm::mat4> transforms(objectCount + 1, glm::mat4{ 1.0f });
+		std::vector<std::uint32_t> objectModels(objectCount + 1, 0);
+		for (std::uint32_t i = 1; i <= objectCount; ++i) {
+			const float scale = height(random);
+			transforms[i] = glm::mat4{ scale };
+			transforms[i][3] = glm::vec4{ position(random), -0.5f * scale, position(random), 1.0f };
+			objectModels[i] = 1 + i % 2;
+		}
+
+		std::vector<bool> dynamicObjects(transforms.size(), false);
+		for (std::uint32_t i = 1; i <= dynamicCount && i <= objectCount; ++i) {
+			dynamicObjects[i] = true;
+		}
+
+		auto moveObjects = [&](std::uint32_t frame) {
+			for (std::uint32_t i = 1; i <= dynamicCount && i <= objectCount; ++i) {
+				const float angle = 0.02f * static_cast<float>(frame) + glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(dynamicCount);
+				transforms[i][3] = glm::vec4{ std::cos(angle) * 6.0f, -1.0f, 10.0f + std::sin(angle) * 6.0f, 1.0f };
+			}
+		};
+
+		moveObjects(0);
+
+		BoundingVolumeHierarchy boundingVolumeHierarchy{};
+		std::vector<std::int32_t> proxies(transforms.size());
+		for (std::uint32_t i = 0; i < transforms.size(); ++i) {
+			proxies[i] = boundingVolumeHierarchy.createProxy(models[objectModels[i]]->getBoundingBox().transform(transforms[i]), i);
+		}
+
+		VkQueryPool queryPool = VK_NULL_HANDLE;
+		if (device.hasTimestamps()) {
+			VkQueryPoolCreateInfo queryPoolCreateInfo{};
+			queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			queryPoolCreateInfo.pNext = nullptr;
+			queryPoolCreateInfo.flags = 0;
+			queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			queryPoolCreateInfo.queryCount = 2;
+
+			if (vkCreateQueryPool(device.getDevice(), &queryPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Query), &queryPool) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create query pool.");
+			}
+		}
+
+		struct Result {
+			double cullTime = 0.0;
+			double gpuTime = 0.0;
+			double submitTime = 0.0;
+			double renderedCascades = 0.0;
+			double draws = 0.0;
+		};
+
+		RenderGraph graph{};
+		RenderGraphExecutor executor{ device };
+		FrameArena frameArena{ 64 * 1024 };
+		ShadowFrame shadowFrame{};
+
+		auto measure = [&](bool caching) {
+			const std::uint32_t warmupFrameCount = 2;
+
+			ShadowMap shadowMap{ device, swapchain, geometryPool, ShadowMap::Settings{} };
+			shadowMap.setLightDirection({ 0.4f, 1.0f, 0.3f });
+			shadowMap.setCachingEnabled(caching);
+
+			Result result{};
+			for (std::uint32_t frame = 0; frame < warmupFrameCount + frameCount; ++frame) {
+				moveObjects(frame);
+				for (std::uint32_t i = 1; i <= dynamicCount && i <= objectCount; ++i) {
+					boundingVolumeHierarchy.moveProxy(proxies[i], models[objectModels[i]]->getBoundingBox().transform(transforms[i]));
+				}
+
+				Camera camera{};
+				camera.setPerspectiveProjection(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+				camera.setViewTarget({ 0.0f, -8.0f, -20.0f + 0.05f * static_cast<float>(frame) }, { 0.0f, 0.0f, 20.0f });
+
+				auto cullStart = std::chrono::high_resolution_clock::now();
+				shadowFrame.clear();
+				shadowMap.update(camera, boundingVolumeHierarchy, dynamicObjects, shadowFrame);
+				for (const BoundingVolumeHierarchy::QueryResult &visible : shadowFrame.casters.visible) {
+					if (visible.mask == 0) {
+						continue;
+					}
+
+					RenderPacket packet{};
+					packet.model = objectModels[visible.userData];
+					shadowFrame.casters.add(visible.mask, packet, transforms[visible.userData], glm::vec3{ transforms[visible.userData][3] }, 200.0f);
+				}
+				shadowFrame.casters.sort();
+				double cullTime = getMilliseconds(cullStart);
+
+				frameArena.reset();
+				VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+				if (queryPool != VK_NULL_HANDLE) {
+					vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+					vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+				}
+
+				graph.reset();
+				shadowMap.addPasses(graph, shadowFrame, models);
+				executor.execute(graph, commandBuffer, frameArena);
+
+				if (queryPool != VK_NULL_HANDLE) {
+					vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+				}
+
+				auto submitStart = std::chrono::high_resolution_clock::now();
+				device.endSingleTimeCommands(commandBuffer);
+				double submitTime = getMilliseconds(submitStart);
+
+				if (frame < warmupFrameCount) {
+					continue;
+				}
+
+				if (queryPool != VK_NULL_HANDLE) {
+					std::uint64_t timestamps[2]{};
+					vkGetQueryPoolResults(device.getDevice(), queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+					result.gpuTime += static_cast<double>(timestamps[1] - timestamps[0]) * device.getTimestampPeriod() / 1000000.0;
+				}
+
+				result.cullTime += cullTime;
+				result.submitTime += submitTime;
+				result.renderedCascades += shadowMap.getStatistics().renderedCascades;
+				result.draws += static_cast<double>(shadowMap.getStatistics().draws);
+			}
+
+			result.cullTime /= frameCount;
+			result.gpuTime /= frameCount;
+			result.submitTime /= frameCount;
+			result.renderedCascades /= frameCount;
+			result.draws /= frameCount;
+
+			executor.releaseResources();
+
+			std::cout << '\t' << (caching ? "Cached static cascades" : "Every cascade every frame") << ": ";
+			std::cout << result.renderedCascades << " of " << ShadowMap::CASCADE_COUNT << " cascades rendered, ";
+			std::cout << result.draws << " draws, ";
+			if (queryPool != VK_NULL_HANDLE) {
+				std::cout << result.gpuTime << " ms GPU, ";
+			}
+			std::cout << "cull " << result.cullTime << " ms, submit and wait " << result.submitTime << " ms per frame\n";
+
+			return queryPool != VK_NULL_HANDLE ? result.gpuTime : result.submitTime;
+		};
+
+		double uncachedTime = measure(false);
+		double cachedTime = measure(true);
+
+		std::cout << "\tShadow time saved by caching: " << uncachedTime - cachedTime << " ms";
+		if (uncachedTime > 0.0) {
+			std::cout << " (" << 100.0 * (uncachedTime - cachedTime) / uncachedTime << "%)";
+		}
+		std::cout << (queryPool != VK_NULL_HANDLE ? " GPU\n" : " CPU wall clock, timestamps unavailable\n");
+
+		if (queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(device.getDevice(), queryPool, VulkanAllocator::get(AllocationCategory::Query));
+		}
+	}
+
+	void Benchmark::runClusters(const std::vector<std::uint32_t> &lightCounts, std::uint32_t frameCount) {
+		std::cout << "Clustered lighting benchmark (" << ClusteredLighting::CLUSTER_COUNT_X << "x" << ClusteredLighting::CLUSTER_COUNT_Y << "x" << ClusteredLighting::CLUSTER_COUNT_Z << " clusters, " << frameCount << " frames per configuration)\n";
+
+		Window window{ 320, 240, "HELP clusters" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+		BindlessResources bindlessResources{ device };
+
+		if (!device.hasTimestamps()) {
+			std::cout << "\tTimestamps not supported, GPU times unavailable\n";
+		}
+
+		std::vector<Model::Builder> builders{
+			createBox({ -40.0f, 0.0f, -40.0f }, { 40.0f, 1.0f, 40.0f }),
+			createSphere(16, 12)
+		};
+
+		std::uint32_t vertexCount = 0;
+		std::uint32_t indexCount = 0;
+		for (const Model::Builder &builder : builders) {
+			vertexCount += static_cast<std::uint32_t>(builder.vertices.size());
+			indexCount += static_cast<std::uint32_t>(builder.indices.size());
+		}
+
+		GeometryPool geometryPool{ device, sizeof(Model::Vertex), vertexCount, indexCount };
+		std::vector<std::shared_ptr<Model>> models;
+		for (const Model::Builder &builder : builders) {
+			models.push_back(std::make_shared<Model>(geometryPool, builder));
+		}
+		geometryPool.flush();
+
+		const std::int32_t gridSize = 24;
+		std::vector<glm::mat4> transforms{ glm::mat4{ 1.0f } };
+		for (std::int32_t x = 0; x < gridSize; ++x) {
+			for (std::int32_t z = 0; z < gridSize; ++z) {
+				glm::mat4 transform{ 1.0f };
+				transform[3] = glm::vec4{ (static_cast<float>(x) - gridSize * 0.5f) * 3.0f, -1.0f, (static_cast<float>(z) - gridSize * 0.5f) * 3.0f, 1.0f };
+				transforms.push_back(transform);
+			}
+		}
+
+		RenderTarget::Description targetDescription{};
+		targetDescription.extent = { 1280, 720 };
+		targetDescription.format = VK_FORMAT_R8G8B8A8_UNORM;
+		RenderTarget target{ device, targetDescription };
+
+		Camera camera{};
+		camera.setPerspectiveProjection(glm::radians(60.0f), 1280.0f / 720.0f, 0.1f, 100.0f);
+		camera.setViewTarget({ 0.0f, -15.0f, -45.0f }, { 0.0f, 0.0f, 0.0f });
+
+		ShadowMap::Settings shadowSettings{};
+		shadowSettings.resolution = 256;
+		ShadowMap shadowMap{ device, swapchain, geometryPool, shadowSettings };
+		ShadowFrame shadowFrame{};
+
+		const std::uint32_t maxLights = *std::max_element(lightCounts.begin(), lightCounts.end());
+		ClusteredLighting clusteredLighting{ device, maxLights, 1 };
+
+		struct GlobalUbo {
+			glm::mat4 projectionView{ 1.0f };
+			std::array<glm::mat4, ShadowMap::CASCADE_COUNT> lightProjectionView{};
+			glm::vec4 lightDirection{ 0.0f };
+			glm::vec4 lightColor{ 0.0f };
+			glm::vec4 cameraPosition{ 0.0f };
+		};
+
+		struct PushConstantData {
+			glm::mat4 transform{ 1.0f };
+			std::uint32_t materialIndex = 0;
+			std::uint32_t padding = 0;
+			VkDeviceAddress vertexAddress = 0;
+		};
+
+		GlobalUbo ubo{};
+		ubo.projectionView = camera.getProjectionView();
+		ubo.lightColor = glm::vec4{ 0.0f, 0.0f, 0.0f, 0.05f };
+		ubo.cameraPosition = glm::vec4{ camera.getPosition(), 1.0f };
+
+		VkBuffer uniformBuffer;
+		VkDeviceMemory uniformBufferMemory;
+		device.createBuffer(
+			sizeof(GlobalUbo),
+			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			uniformBuffer,
+			uniformBufferMemory
+		);
+
+		void *uniformData;
+		vkMapMemory(device.getDevice(), uniformBufferMemory, 0, sizeof(GlobalUbo), 0, &uniformData);
+		std::memcpy(uniformData, &ubo, sizeof(GlobalUbo));
+		vkUnmapMemory(device.getDevice(), uniformBufferMemory);
+
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+		bindings[0].binding = 0;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		bindings[0].descriptorCount = 1;
+		bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		bindings[0].pImmutableSamplers = nullptr;
+		bindings[1].binding = 1;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		bindings[1].descriptorCount = 1;
+		bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		bindings[1].pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		VkDescriptorSetLayout descriptorSetLayout;
+		if (vkCreateDescriptorSetLayout(device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor set layout.");
+		}
+
+		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
+		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorPoolSizes[0].descriptorCount = 1;
+		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorPoolSizes[1].descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<std::uint32_t>(descriptorPoolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		VkDescriptorPool descriptorPool;
+		if (vkCreateDescriptorPool(device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &descriptorSetLayout;
+
+		VkDescriptorSet descriptorSet;
+		if (vkAllocateDescriptorSets(device.getDevice(), &descriptorSetAllocateInfo, &descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate descriptor set.");
+		}
+
+		VkDescriptorBufferInfo descriptorBufferInfo{ uniformBuffer, 0, sizeof(GlobalUbo) };
+
+		VkDescriptorImageInfo descriptorImageInfo{};
+		descriptorImageInfo.sampler = shadowMap.getSampler();
+		descriptorImageInfo.imageView = shadowMap.getImageView();
+		descriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		std::array<VkWriteDescriptorSet, 2> writeDescriptorSets{};
+		for (std::uint32_t i = 0; i < writeDescriptorSets.size(); ++i) {
+			writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSets[i].pNext = nullptr;
+			writeDescriptorSets[i].dstSet = descriptorSet;
+			writeDescriptorSets[i].dstBinding = i;
+			writeDescriptorSets[i].dstArrayElement = 0;
+			writeDescriptorSets[i].descriptorType = bindings[i].descriptorType;
+			writeDescriptorSets[i].descriptorCount = 1;
+		}
+		writeDescriptorSets[0].pBufferInfo = &descriptorBufferInfo;
+		writeDescriptorSets[1].pImageInfo = &descriptorImageInfo;
+
+		vkUpdateDescriptorSets(device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstantData);
+
+		std::array<VkDescriptorSetLayout, 3> descriptorSetLayouts{
+			descriptorSetLayout,
+			bindlessResources.getDescriptorSetLayout(),
+			clusteredLighting.getDescriptorSetLayout()
+		};
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		VkPipelineLayout pipelineLayout;
+		if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create pipeline layout.");
+		}
+
+		Pipeline::Config config = Pipeline::getDefaultConfig();
+		config.vertexShaderPath = "resources/shaders/lit.vert.spv";
+		config.fragmentShaderPath = "resources/shaders/lit.frag.spv";
+		config.colorFormat = target.getFormat();
+		if (geometryPool.isVertexPullingEnabled()) {
+			config.vertexShaderPath = "resources/shaders/lit_pulling.vert.spv";
+			config.modelVertexInput = false;
+		}
+
+		std::unique_ptr<Pipeline> pipeline = std::make_unique<Pipeline>(device, swapchain, pipelineLayout, config);
+
+		VkQueryPool queryPool = VK_NULL_HANDLE;
+		if (device.hasTimestamps()) {
+			VkQueryPoolCreateInfo queryPoolCreateInfo{};
+			queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			queryPoolCreateInfo.pNext = nullptr;
+			queryPoolCreateInfo.flags = 0;
+			queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			queryPoolCreateInfo.queryCount = 3;
+
+			if (vkCreateQueryPool(device.getDevice(), &queryPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Query), &queryPool) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create query pool.");
+			}
+		}
+
+		auto drawScene = [&](VkCommandBuffer commandBuffer) {
+			if (queryPool != VK_NULL_HANDLE) {
+				vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+			}
+
+			const VkExtent2D extent = target.getExtent();
+
+			VkViewport viewport{};
+			viewport.x = 0.0f;
+			viewport.y = 0.0f;
+			viewport.width = static_cast<float>(extent.width);
+			viewport.height = static_cast<float>(extent.height);
+			viewport.minDepth = 0.0f;
+			viewport.maxDepth = 1.0f;
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+			VkRect2D scissor{ { 0, 0 }, extent };
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+			std::array<VkDescriptorSet, 3> descriptorSets{
+				descriptorSet,
+				bindlessResources.getDescriptorSet(0),
+				clusteredLighting.getDescriptorSet(0)
+			};
+
+			DrawRecorder recorder(commandBuffer);
+			for (std::size_t i = 0; i < transforms.size(); ++i) {
+				pipeline->bind(recorder);
+				recorder.bindDescriptorSets(pipelineLayout, 0, static_cast<std::uint32_t>(descriptorSets.size()), descriptorSets.data());
+
+				if (geometryPool.isVertexPullingEnabled()) {
+					geometryPool.bindIndices(recorder);
+				} else {
+					geometryPool.bind(recorder);
+				}
+
+				PushConstantData pushConstantData{};
+				pushConstantData.transform = transforms[i];
+				pushConstantData.materialIndex = BindlessResources::DEFAULT_MATERIAL;
+				pushConstantData.vertexAddress = geometryPool.getVertexBufferAddress();
+
+				recorder.pushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstantData), &pushConstantData);
+				models[i == 0 ? 0 : 1]->draw(recorder, 0);
+			}
+		};
+
+		struct Result {
+			double binTime = 0.0;
+			double shadeTime = 0.0;
+			double buildTime = 0.0;
+			double submitTime = 0.0;
+		};
+
+		RenderGraph graph{};
+		RenderGraphExecutor executor{ device };
+		FrameArena frameArena{ 64 * 1024 };
+
+		RenderGraph::ImageDescription depthDescription{};
+		depthDescription.format = swapchain.getDepthFormat();
+		depthDescription.extent = target.getExtent();
+		depthDescription.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		depthDescription.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		VkClearValue colorClearValue{};
+		colorClearValue.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+		VkClearValue depthClearValue{};
+		depthClearValue.depthStencil = { 1.0f, 0 };
+
+		auto measure = [&](const std::vector<ClusteredLighting::Light> &lights, bool gpuBinning) {
+			const std::uint32_t warmupFrameCount = 2;
+
+			clusteredLighting.setGpuBinning(gpuBinning);
+
+			Result result{};
+			for (std::uint32_t frame = 0; frame < warmupFrameCount + frameCount; ++frame) {
+				frameArena.reset();
+				VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+				if (queryPool != VK_NULL_HANDLE) {
+					vkCmdResetQueryPool(commandBuffer, queryPool, 0, 3);
+					vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+				}
+
+				graph.reset();
+				shadowMap.addPasses(graph, shadowFrame, models);
+
+				auto buildStart = std::chrono::high_resolution_clock::now();
+				clusteredLighting.addPasses(graph, lights, camera, target.getExtent(), 0);
+				double buildTime = getMilliseconds(buildStart);
+
+				RenderGraph::ResourceHandle colorImage = target.import(graph, "cluster target");
+				RenderGraph::ResourceHandle depthImage = graph.createImage("cluster depth", depthDescription);
+
+				RenderGraph::PassBuilder shadePass = graph.addPass("clustered shading", RenderGraph::PassType::Graphics);
+				shadePass
+					.clear(colorImage, RenderGraph::Access::ColorAttachment, colorClearValue)
+					.clear(depthImage, RenderGraph::Access::DepthAttachment, depthClearValue)
+					.read(clusteredLighting.getClusterBuffer(), RenderGraph::Access::StorageRead);
+
+				for (std::uint32_t cascade = 0; cascade < ShadowMap::CASCADE_COUNT; ++cascade) {
+					shadePass.read(shadowMap.getCascadeImage(cascade), RenderGraph::Access::Sampled);
+				}
+
+				shadePass.setExecute([&drawScene](VkCommandBuffer commandBuffer) {
+					drawScene(commandBuffer);
+				});
+
+				executor.execute(graph, commandBuffer, frameArena);
+
+				if (queryPool != VK_NULL_HANDLE) {
+					vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 2);
+				}
+
+				auto submitStart = std::chrono::high_resolution_clock::now();
+				device.endSingleTimeCommands(commandBuffer);
+				double submitTime = getMilliseconds(submitStart);
+
+				if (frame < warmupFrameCount) {
+					continue;
+				}
+
+				if (queryPool != VK_NULL_HANDLE) {
+					std::uint64_t timestamps[3]{};
+					vkGetQueryPoolResults(device.getDevice(), queryPool, 0, 3, sizeof(timestamps), timestamps, sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+					result.binTime += static_cast<double>(timestamps[1] - timestamps[0]) * device.getTimestampPeriod() / 1000000.0;
+					result.shadeTime += static_cast<double>(timestamps[2] - timestamps[1]) * device.getTimestampPeriod() / 1000000.0;
+				}
+
+				result.buildTime += buildTime;
+				result.submitTime += submitTime;
+			}
+
+			result.binTime /= frameCount;
+			result.shadeTime /= frameCount;
+			result.buildTime /= frameCount;
+			result.submitTime /= frameCount;
+
+			return result;
+		};
+
+		for (std::uint32_t lightCount : lightCounts) {
+			std::mt19937 random{ 1234 };
+			std::uniform_real_distribution<float> position{ -36.0f, 36.0f };
+			std::uniform_real_distribution<float> height{ -3.0f, -0.5f };
+			std::uniform_real_distribution<float> radius{ 2.0f, 5.0f };
+			std::uniform_real_distribution<float> channel{ 0.2f, 1.0f };
+
+			std::vector<ClusteredLighting::Light> lights;
+			for (std::uint32_t i = 0; i < lightCount; ++i) {
+				const glm::vec3 lightPosition{ position(random), height(random), position(random) };
+				const glm::vec3 color{ channel(random), channel(random), channel(random) };
+
+				if (i % 4 == 0) {
+					lights.push_back(ClusteredLighting::Light::createSpotLight(lightPosition, { 0.0f, 1.0f, 0.0f }, radius(random) * 1.5f, glm::radians(35.0f), glm::radians(25.0f), color, 2.0f));
+				} else {
+					lights.push_back(ClusteredLighting::Light::createPointLight(lightPosition, radius(random), color, 1.0f));
+				}
+			}
+
+			Result gpuResult = measure(lights, true);
+			std::vector<std::uint32_t> gpuClusters = clusteredLighting.readClusters();
+
+			std::vector<std::uint32_t> cpuClusters(ClusteredLighting::CLUSTER_DATA_COUNT);
+			ClusteredLighting::buildClusters(lights, ClusteredLighting::computeParameters(camera, target.getExtent(), lightCount), cpuClusters.data());
+
+			std::uint32_t mismatchedClusters = 0;
+			std::uint32_t occupiedClusters = 0;
+			std::uint32_t maxClusterLights = 0;
+			std::uint64_t lightReferences = 0;
+			for (std::uint32_t cluster = 0; cluster < ClusteredLighting::CLUSTER_COUNT; ++cluster) {
+				const std::uint32_t count = gpuClusters[cluster];
+				const std::uint32_t firstSlot = ClusteredLighting::CLUSTER_COUNT + cluster * ClusteredLighting::MAX_LIGHTS_PER_CLUSTER;
+
+				if (count != cpuClusters[cluster] || !std::equal(gpuClusters.begin() + firstSlot, gpuClusters.begin() + firstSlot + std::min(count, ClusteredLighting::MAX_LIGHTS_PER_CLUSTER), cpuClusters.begin() + firstSlot)) {
+					++mismatchedClusters;
+				}
+
+				occupiedClusters += count > 0 ? 1 : 0;
+				maxClusterLights = std::max(maxClusterLights, count);
+				lightReferences += count;
+			}
+
+			Result cpuResult = measure(lights, false);
+
+			std::cout << '\t' << lightCount << " lights: ";
+			std::cout << occupiedClusters << " of " << ClusteredLighting::CLUSTER_COUNT << " clusters lit, ";
+			std::cout << static_cast<double>(lightReferences) / std::max(occupiedClusters, 1u) << " lights per lit cluster (max " << maxClusterLights << "), ";
+			std::cout << mismatchedClusters << " clusters differ from the CPU builder\n";
+
+			std::cout << "\t\tGPU binning: ";
+			if (queryPool != VK_NULL_HANDLE) {
+				std::cout << "bin " << gpuResult.binTime << " ms, shade " << gpuResult.shadeTime << " ms GPU, ";
+			}
+			std::cout << "submit and wait " << gpuResult.submitTime << " ms per frame\n";
+
+			std::cout << "\t\tCPU binning: build " << cpuResult.buildTime << " ms, ";
+			if (queryPool != VK_NULL_HANDLE) {
+				std::cout << "upload " << cpuResult.binTime << " ms, shade " << cpuResult.shadeTime << " ms GPU, ";
+			}
+			std::cout << "submit and wait " << cpuResult.submitTime << " ms per frame\n";
+		}
+
+		executor.releaseResources();
+
+		if (queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(device.getDevice(), queryPool, VulkanAllocator::get(AllocationCategory::Query));
+		}
+
+		pipeline.reset();
+		vkDestroyPipelineLayout(device.getDevice(), pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(device.getDevice(), descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(device.getDevice(), descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyBuffer(device.getDevice(), uniformBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		device.freeMemory(uniformBufferMemory);
+	}
+
+	void Benchmark::runDynamicResolution(std::uint32_t frameCount) {
+		std::cout << "Dynamic resolution benchmark (" << frameCount << " frames per configuration)\n";
+
+		const ResolutionController::Settings settings{};
+		const std::uint32_t latency = Swapchain::MAX_FRAMES_IN_FLIGHT;
+		const std::array<float, 3> loads{ 0.9f, 1.8f, 0.7f };
+		const std::array<const char *, 3> phaseNames{ "nominal", "heavy", "light" };
+
+		auto simulate = [&](bool dynamic) {
+			struct Phase {
+				double gpuTime = 0.0;
+				double scale = 0.0;
+				std::uint32_t missedFrames = 0;
+				std::uint32_t settleFrames = 0;
+			};
+
+			std::mt19937 random{ 1234 };
+			std::uniform_real_distribution<float> noise{ 0.96f, 1.04f };
+
+			ResolutionController controller{ settings };
+			std::vector<std::pair<float, float>> pending;
+			std::array<Phase, 3> phases{};
+			std::array<bool, 3> settled{};
+
+			for (std::uint32_t frame = 0; frame < frameCount * 3; ++frame) {
+				const std::uint32_t phase = frame / frameCount;
+				const float scale = dynamic ? controller.getScale() : settings.maxScale;
+				const float gpuTime = (2.0f + 14.0f * loads[phase] * scale * scale) * noise(random);
+
+				pending.push_back({ gpuTime, scale });
+				if (pending.size() > latency) {
+					controller.update(pending.front().first, pending.front().second);
+					pending.erase(pending.begin());
+				}
+
+				const bool missed = gpuTime > settings.targetFrameTime;
+				phases[phase].gpuTime += gpuTime;
+				phases[phase].scale += scale;
+				phases[phase].missedFrames += missed ? 1 : 0;
+
+				if (!settled[phase]) {
+					if (missed) {
+						phases[phase].settleFrames = frame % frameCount + 1;
+					} else if (frame % frameCount >= phases[phase].settleFrames + 10) {
+						settled[phase] = true;
+					}
+				}
+			}
+
+			for (std::uint32_t phase = 0; phase < phases.size(); ++phase) {
+				std::cout << "\t\t" << phaseNames[phase] << " load: " << phases[phase].gpuTime / frameCount << " ms, ";
+				std::cout << phases[phase].scale / frameCount * 100.0 << "% scale, ";
+				std::cout << phases[phase].missedFrames << " of " << frameCount << " frames over " << settings.targetFrameTime << " ms";
+				if (dynamic) {
+					std::cout << ", settled after " << phases[phase].settleFrames << " frames";
+				}
+				std::cout << '\n';
+			}
+
+			return controller.getHistory();
+		};
+
+		std::cout << "\tSimulated GPU load (" << latency << " frames of readback latency):\n";
+		std::cout << "\t\tFixed resolution:\n";
+		simulate(false);
+		std::cout << "\t\tDynamic resolution:\n";
+		std::vector<ResolutionController::Sample> history = simulate(true);
+
+		if (!history.empty()) {
+			auto range = std::minmax_element(history.begin(), history.end(), [](const ResolutionController::Sample &a, const ResolutionController::Sample &b) {
+				return a.scale < b.scale;
+			});
+			std::cout << "\t\tLast " << history.size() << " samples: scale " << range.first->scale * 100.0f << "% to " << range.second->scale * 100.0f << "%, filtered GPU time " << history.back().filteredFrameTime << " ms\n";
+		}
+
+		Window window{ 320, 240, "HELP dynamic resolution" };
+		Device device{ window };
+		Swapchain swapchain{ device, window.getExtent() };
+
+		if (!device.hasTimestamps()) {
+			std::cout << "\tTimestamps not supported, GPU times unavailable\n";
+		}
+
+		const VkExtent2D outputExtent{ 1920, 1080 };
+
+		RenderTarget::Description outputDescription{};
+		outputDescription.extent = outputExtent;
+		outputDescription.format = swapchain.getImageFormat();
+		RenderTarget output{ device, outputDescription };
+
+		VkQueryPool queryPool = VK_NULL_HANDLE;
+		if (device.hasTimestamps()) {
+			VkQueryPoolCreateInfo queryPoolCreateInfo{};
+			queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			queryPoolCreateInfo.pNext = nullptr;
+			queryPoolCreateInfo.flags = 0;
+			queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			queryPoolCreateInfo.queryCount = 2;
+
+			if (vkCreateQueryPool(device.getDevice(), &queryPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Query), &queryPool) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create query pool.");
+			}
+		}
+
+		RenderGraph graph{};
+		RenderGraphExecutor executor{ device };
+		FrameArena frameArena{ 64 * 1024 };
+
+		VkClearValue colorClearValue{};
+		colorClearValue.color = { { 0.2f, 0.4f, 0.6f, 1.0f } };
+
+		auto measure = [&](DynamicResolution &dynamicResolution, bool upscale) {
+			const std::uint32_t warmupFrameCount = 2;
+
+			double gpuTime = 0.0;
+			for (std::uint32_t frame = 0; frame < warmupFrameCount + frameCount; ++frame) {
+				frameArena.reset();
+				VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+				if (queryPool != VK_NULL_HANDLE) {
+					vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+					vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+				}
+
+				graph.reset();
+				RenderGraph::ResourceHandle sceneImage = dynamicResolution.importSceneImage(graph, outputExtent);
+				RenderGraph::ResourceHandle outputImage = output.import(graph, "output");
+
+				graph.addPass("scene", RenderGraph::PassType::Graphics)
+					.clear(sceneImage, RenderGraph::Access::ColorAttachment, colorClearValue)
+					.setExecute([&dynamicResolution](VkCommandBuffer commandBuffer) {
+						dynamicResolution.setViewport(commandBuffer);
+					});
+
+				if (upscale) {
+					dynamicResolution.addUpscalePass(graph, sceneImage, outputImage);
+				} else {
+					graph.addPass("output", RenderGraph::PassType::Graphics)
+						.clear(outputImage, RenderGraph::Access::ColorAttachment, colorClearValue)
+						.setExecute([](VkCommandBuffer) {});
+				}
+
+				executor.execute(graph, commandBuffer, frameArena);
+
+				if (queryPool != VK_NULL_HANDLE) {
+					vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+				}
+
+				device.endSingleTimeCommands(commandBuffer);
+
+				if (frame < warmupFrameCount || queryPool == VK_NULL_HANDLE) {
+					continue;
+				}
+
+				std::uint64_t timestamps[2]{};
+				vkGetQueryPoolResults(device.getDevice(), queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+				gpuTime += static_cast<double>(timestamps[1] - timestamps[0]) * device.getTimestampPeriod() / 1000000.0;
+			}
+
+			return gpuTime / frameCount;
+		};
+
+		std::cout << "\tCatmull-Rom upscale to " << outputExtent.width << "x" << outputExtent.height << ":\n";
+
+		double baselineTime = 0.0;
+		for (float scale : { 1.0f, 0.75f, 0.5f }) {
+			ResolutionController::Settings fixedSettings{};
+			fixedSettings.minScale = scale;
+			fixedSettings.maxScale = scale;
+
+			DynamicResolution dynamicResolution{ device, swapchain, fixedSettings, 1 };
+			if (scale == 1.0f) {
+				baselineTime = measure(dynamicResolution, false);
+			}
+
+			const double upscaleTime = measure(dynamicResolution, true);
+			const VkExtent2D renderExtent = dynamicResolution.getRenderExtent();
+
+			std::cout << "\t\t" << renderExtent.width << "x" << renderExtent.height << " (" << scale * 100.0f << "%): ";
+			if (queryPool != VK_NULL_HANDLE) {
+				std::cout << "upscale " << upscaleTime - baselineTime << " ms GPU\n";
+			} else {
+				std::cout << "GPU time unavailable\n";
+			}
+
+			vkDeviceWaitIdle(device.getDevice());
+			executor.releaseResources();
+		}
+
+		if (queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(device.getDevice(), queryPool, VulkanAllocator::get(AllocationCategory::Query));
+		}
+	}
+
+	void Benchmark::runPresentation(const std::vector<float> &frameRates, std::uint32_t frameCount) {
+		std::cout << "Presentation benchmark (" << frameCount << " frames per configuration)\n";
+
+		Window window{ 640, 480, "HELP presentation" };
+		Device device{ window };
+		Renderer renderer{ window, device };
+
+		std::cout << "\tPresent wait: " << (device.isPresentWaitEnabled() ? "enabled" : "unavailable") << '\n';
+
+		RenderGraph graph{};
+
+		VkClearValue clearValue{};
+		clearValue.color = { { 0.1f, 0.1f, 0.1f, 1.0f } };
+
+		auto renderFrame = [&]() {
+			window.update();
+
+			VkCommandBuffer commandBuffer = renderer.beginFrame();
+			if (commandBuffer == nullptr) {
+				return;
+			}
+
+			graph.reset();
+			RenderGraph::ResourceHandle swapchainImage = renderer.importSwapchainImage(graph);
+
+			graph.addPass("clear", RenderGraph::PassType::Graphics)
+				.clear(swapchainImage, RenderGraph::Access::ColorAttachment, clearValue)
+				.setExecute([](VkCommandBuffer) {});
+
+			renderer.executeRenderGraph(graph, commandBuffer);
+			renderer.endFrame();
+		};
+
+		const std::array<VkPresentModeKHR, 4> presentModes{
+			VK_PRESENT_MODE_FIFO_KHR,
+			VK_PRESENT_MODE_FIFO_RELAXED_KHR,
+			VK_PRESENT_MODE_MAILBOX_KHR,
+			VK_PRESENT_MODE_IMMEDIATE_KHR
+		};
+
+		for (VkPresentModeKHR presentMode : presentModes) {
+			std::cout << '\t' << Swapchain::getPresentModeName(presentMode) << ":\n";
+
+			if (!renderer.getSwapchain().isPresentModeSupported(presentMode)) {
+				std::cout << "\t\tunsupported\n";
+				continue;
+			}
+
+			renderer.setPresentMode(presentMode);
+
+			for (float frameRate : frameRates) {
+				const std::uint32_t warmupFrameCount = 10;
+
+				renderer.setFrameRateLimit(frameRate);
+				for (std::uint32_t frame = 0; frame < warmupFrameCount; ++frame) {
+					renderFrame();
+				}
+
+				renderer.getFrameLimiter().resetStatistics();
+				for (std::uint32_t frame = 0; frame < frameCount; ++frame) {
+					renderFrame();
+				}
+
+				const FrameLimiter::Statistics statistics = renderer.getFrameLimiter().getStatistics();
+				const std::uint32_t measuredFrames = std::max(statistics.frameCount, 1u);
+
+				std::cout << "\t\t";
+				if (frameRate > 0.0f) {
+					std::cout << frameRate << " fps limit: ";
+				} else {
+					std::cout << "unlimited: ";
+				}
+				std::cout << statistics.averageFrameTime << " ms (" << (statistics.averageFrameTime > 0.0 ? 1000.0 / statistics.averageFrameTime : 0.0) << " fps), ";
+				std::cout << "jitter " << statistics.jitter << " ms, max " << statistics.maxFrameTime << " ms, ";
+				std::cout << "sleep " << statistics.sleepTime / measuredFrames << " ms, spin " << statistics.spinTime / measuredFrames << " ms per frame, ";
+				std::cout << "CPU " << statistics.cpuUsage * 100.0 << "%\n";
+			}
+		}
+
+		vkDeviceWaitIdle(device.getDevice());
+	}
+
+	Model::Builder Benchmark::createSphere(std::uint32_t segments, std::uint32_t rings) {
+		Model::Builder builder{};
+
+		for (std::uint32_t ring = 0; ring <= rings; ++ring) {
+			float phi = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(rings);
+			for (std::uint32_t segment = 0; segment <= segments; ++segment) {
+				float theta = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(segments);
+
+				glm::vec3 position{ std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) };
+				builder.vertices.push_back({ position, { 0.8f, 0.8f, 0.8f } });
+			}
+		}
+
+		for (std::uint32_t ring = 0; ring < rings; ++ring) {
+			for (std::uint32_t segment = 0; segment < segments; ++segment) {
+				std::uint32_t a = ring * (segments + 1) + segment;
+				std::uint32_t b = a + segments + 1;
+
+				builder.indices.insert(builder.indices.end(), { a, b, a + 1, b, b + 1, a + 1 });
+			}
+		}
+
+		return builder;
+	}
+
+	Model::Builder Benchmark::createBox(const glm::vec3 &min, const glm::vec3 &max) {
+		Model::Builder builder{};
+
+		const glm::vec3 center = (min + max) * 0.5f;
+		const glm::vec3 halfExtent = (max - min) * 0.5f;
+
+		const std::array<std::array<glm::vec3, 3>, 6> faces{ {
+			{ glm::vec3{ 1.0f, 0.0f, 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }, glm::vec3{ 0.0f, 0.0f, 1.0f } },
+			{ glm::vec3{ -1.0f, 0.0f, 0.0f }, glm::vec3{ 0.0f, 0.0f, 1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f } },
+			{ glm::vec3{ 0.0f, 1.0f, 0.0f }, glm::vec3{ 0.0f, 0.0f, 1.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f } },
+			{ glm::vec3{ 0.0f, -1.0f, 0.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f }, glm::vec3{ 0.0f, 0.0f, 1.0f } },
+			{ glm::vec3{ 0.0f, 0.0f, 1.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f } },
+			{ glm::vec3{ 0.0f, 0.0f, -1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f } }
+		} };
+
+		for (const std::array<glm::vec3, 3> &face : faces) {
+			const glm::vec3 &normal = face[0];
+			const glm::vec3 &u = face[1];
+			const glm::vec3 &v = face[2];
+
+			std::uint32_t first = static_cast<std::uint32_t>(builder.vertices.size());
+			for (glm::vec2 corner : { glm::vec2{ -1.0f, -1.0f }, glm::vec2{ 1.0f, -1.0f }, glm::vec2{ 1.0f, 1.0f }, glm::vec2{ -1.0f, 1.0f } }) {
+				glm::vec3 position = center + (normal + corner.x * u + corner.y * v) * halfExtent;
+				builder.vertices.push_back({ position, { 0.5f, 0.5f, 0.55f } });
+			}
+
+			builder.indices.insert(builder.indices.end(), { first, first + 2, first + 1, first, first + 3, first + 2 });
+		}
+
+		return builder;
+	}
+
+	void Benchmark::printUsage() {
+		std::cout << "Usage: HELP --benchmark <name>\n";
+		std::cout << "Benchmarks:\n";
+		std::cout << "\tculling\n";
+		std::cout << "\tlod\n";
+		std::cout << "\tscenegraph\n";
+		std::cout << "\tsimulation\n";
+		std::cout << "\trendergraph\n";
+		std::cout << "\tasynccompute\n";
+		std::cout << "\tparticles\n";
+		std::cout << "\tdeviceselection\n";
+		std::cout << "\tgeometrypool\n";
+		std::cout << "\tmeshlets\n";
+		std::cout << "\tocclusion\n";
+		std::cout << "\trenderthread\n";
+		std::cout << "\tdrawkeys\n";
+		std::cout << "\tframearena\n";
+		std::cout << "\tmemory\n";
+		std::cout << "\tviews\n";
+		std::cout << "\tshadows\n";
+		std::cout << "\tclusters\n";
+		std::cout << "\tdynamicresolution\n";
+		std::cout << "\tpresentation\n";
+	}
+
+	double Benchmark::getMilliseconds(const std::chrono::high_resolution_clock::time_point &start) {
+		std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+		return duration.count();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include "Camera.h"
+#include "Frustum.h"
+#include "BoundingVolume.h"
+#include "BoundingVolumeHierarchy.h"
+#include "Model.h"
+#include "SceneGraph.h"
+#include "Simulation.h"
+#include "RenderGraph.h"
+#include "Window.h"
+#include "Device.h"
+#include "AsyncCompute.h"
+#include "ComputePipeline.h"
+#include "ParticleSystem.h"
+#include "DeviceSelector.h"
+#include "GeometryPool.h"
+#include "Pipeline.h"
+#include "Swapchain.h"
+#include "BindlessResources.h"
+#include "MeshletCuller.h"
+#include "HiZBuffer.h"
+#include "OcclusionCuller.h"
+#include "RenderGraphExecutor.h"
+#include "RenderQueue.h"
+#include "DrawList.h"
+#include "DrawRecorder.h"
+#include "FrameArena.h"
+#include "FrameAllocator.h"
+#include "AllocationTracker.h"
+#include "VulkanAllocator.h"
+#include "MemoryReport.h"
+#include "RenderTarget.h"
+#include "View.h"
+#include "ViewRenderer.h"
+#include "ShadowMap.h"
+#include "ClusteredLighting.h"
+#include "DynamicResolution.h"
+#include "ResolutionController.h"
+#include "Renderer.h"
+#include "FrameLimiter.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+namespace eng {
+	class Benchmark {
+	public:
+		static int run(const std::string &name);
+	private:
+		static void runFrustumCulling(std::size_t objectCount);
+		static void runLevelOfDetail(std::size_t objectCount, std::uint32_t frameCount);
+		static void runSceneGraph(std::size_t rootCount, std::uint32_t depth, std::uint32_t branching);
+		static void runSimulation(std::size_t bodyCount, std::uint64_t tickCount);
+		static std::uint64_t runSimulationLoop(std::size_t bodyCount, std::uint64_t tickCount, bool threaded, bool variableFrameTime);
+		static void runRenderGraph(std::uint32_t width, std::uint32_t height);
+		static void runAsyncCompute(std::uint32_t elementCount, std::uint32_t iterations, std::uint32_t frameCount);
+		static void runParticles(const std::vector<std::uint32_t> &particleCounts, std::uint32_t frameCount);
+		static void runDeviceSelection(std::uint32_t bufferSizeMb, std::uint32_t fillCount);
+		static void runGeometryPool(std::uint32_t meshCount, std::uint32_t iterations);
+		static void runMeshlets(std::uint32_t instanceCount, std::uint32_t iterations);
+		static void runOcclusion(std::uint32_t objectCount, std::uint32_t frameCount);
+		static void runRenderThread(std::uint32_t objectCount, std::uint32_t frameCount);
+		static void runDrawKeys(std::uint32_t packetCount, std::uint32_t drawCount);
+		static void runFrameArena(std::uint32_t objectCount, std::uint32_t frameCount);
+		static void runFrameArenaLoop(std::uint32_t objectCount, std::uint32_t frameCount, bool useArena);
+		static void runMemoryTracking(std::uint32_t allocationCount, std::uint32_t objectCount);
+		static double runVulkanObjectLoop(Device &device, std::uint32_t objectCount, const VkAllocationCallbacks *allocator);
+		static void runViews(std::uint32_t objectCount, std::uint32_t frameCount);
+		static void runShadows(std::uint32_t objectCount, std::uint32_t dynamicCount, std::uint32_t frameCount);
+		static void runClusters(const std::vector<std::uint32_t> &lightCounts, std::uint32_t frameCount);
+		static void runDynamicResolution(std::uint32_t frameCount);
+		static void runPresentation(const std::vector<float> &frameRates, std::uint32_t frameCount);
+		static void printRecorderStatistics(const std::string &name, const DrawRecorder::Statistics &statistics, double time);
+
+		static void buildDeferredFrame(RenderGraph &graph, std::uint32_t width, std::uint32_t height);
+		static std::vector<VkMemoryRequirements> estimateMemoryRequirements(const RenderGraph &graph);
+		static bool validateBarriers(const RenderGraph &graph, std::string &error);
+		static const char *getLayoutName(VkImageLayout layout);
+
+		static PhysicalDeviceInfo createMockDevice(std::uint32_t index, const std::string &name, VkPhysicalDeviceType type, VkDeviceSize memoryMb, bool suitable, std::uint8_t uuidByte);
+		static Model::Builder createSphere(std::uint32_t segments, std::uint32_t rings);
+		static Model::Builder createBox(const glm::vec3 &min, const glm::vec3 &max);
+
+		static void printUsage();
+		static double getMilliseconds(const std::chrono::high_resolution_clock::time_point &start);
+	};
+}
+
+#endif
\ No newline at end of file
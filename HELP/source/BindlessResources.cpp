@@ -0,0 +1,279 @@
+#include "BindlessResources.h"
+
+namespace eng {
+	BindlessResources::BindlessResources(Device &device, std::uint32_t maxTextures, std::uint32_t maxMaterials)
+		: m_device(device), m_maxMaterials(maxMaterials) {
+		VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties = m_device.getDescriptorIndexingProperties();
+		m_maxTextures = std::min({
+			maxTextures,
+			descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages / Swapchain::MAX_FRAMES_IN_FLIGHT,
+			descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages
+		});
+		m_freeTextures.resize(m_maxTextures, false);
+
+		createDescriptorSetLayout();
+		createDescriptorPool();
+		createDescriptorSets();
+		createMaterialBuffers();
+		createDefaultResources();
+	}
+
+	BindlessResources::~BindlessResources() {
+		m_defaultTexture.reset();
+
+		for (std::size_t i = 0; i < m_materialBuffers.size(); ++i) {
+			vkUnmapMemory(m_device.getDevice(), m_materialBuffersMemory[i]);
+			vkDestroyBuffer(m_device.getDevice(), m_materialBuffers[i], VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(m_materialBuffersMemory[i]);
+		}
+
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+	}
+
+	std::uint32_t BindlessResources::addTexture(const Texture &texture) {
+		return addTexture(texture.getImageView(), texture.getSampler());
+	}
+
+	std::uint32_t BindlessResources::addTexture(VkImageView imageView, VkSampler sampler) {
+		std::uint32_t textureIndex;
+		if (!m_freeTextureIndices.empty()) {
+			textureIndex = m_freeTextureIndices.back();
+			m_freeTextureIndices.pop_back();
+			m_freeTextures[textureIndex] = false;
+		} else if (m_textureCount < m_maxTextures) {
+			textureIndex = m_textureCount++;
+		} else {
+			throw std::runtime_error("Failed to add texture, bindless texture table is full.");
+		}
+
+		writeTexture(textureIndex, imageView, sampler);
+
+		return textureIndex;
+	}
+
+	void BindlessResources::removeTexture(std::uint32_t textureIndex) {
+		if (textureIndex == DEFAULT_TEXTURE) {
+			throw std::runtime_error("Failed to remove the default texture.");
+		}
+
+		if (textureIndex >= m_textureCount || m_freeTextures[textureIndex]) {
+			throw std::runtime_error("Failed to remove an unknown texture index.");
+		}
+
+		writeTexture(textureIndex, m_defaultTexture->getImageView(), m_defaultTexture->getSampler());
+
+		m_freeTextureIndices.push_back(textureIndex);
+		m_freeTextures[textureIndex] = true;
+	}
+
+	void BindlessResources::replaceTexture(std::uint32_t oldTextureIndex, std::uint32_t newTextureIndex) {
+		for (std::uint32_t i = 0; i < m_materials.size(); ++i) {
+			if (m_materials[i].textureIndex == oldTextureIndex) {
+				Material material = m_materials[i];
+				material.textureIndex = newTextureIndex;
+				setMaterial(i, material);
+			}
+		}
+	}
+
+	std::uint32_t BindlessResources::addMaterial(const Material &material) {
+		if (m_materials.size() == m_maxMaterials) {
+			throw std::runtime_error("Failed to add material, material buffer is full.");
+		}
+
+		m_materials.emplace_back();
+		setMaterial(static_cast<std::uint32_t>(m_materials.size() - 1), material);
+
+		return static_cast<std::uint32_t>(m_materials.size() - 1);
+	}
+
+	void BindlessResources::setMaterial(std::uint32_t materialIndex, const Material &material) {
+		if (material.textureIndex >= std::max(m_textureCount, 1u) || m_freeTextures[material.textureIndex]) {
+			throw std::runtime_error("Failed to set material with an unknown texture index.");
+		}
+
+		m_materials[materialIndex] = material;
+
+		for (DirtyRange &dirtyRange : m_dirtyMaterials) {
+			if (dirtyRange.begin == dirtyRange.end) {
+				dirtyRange = { materialIndex, materialIndex + 1 };
+			} else {
+				dirtyRange.begin = std::min(dirtyRange.begin, materialIndex);
+				dirtyRange.end = std::max(dirtyRange.end, materialIndex + 1);
+			}
+		}
+	}
+
+	void BindlessResources::flush(std::uint32_t frameIndex) {
+		DirtyRange &dirtyRange = m_dirtyMaterials[frameIndex];
+		if (dirtyRange.begin == dirtyRange.end) {
+			return;
+		}
+
+		std::memcpy(
+			m_materialBuffersMapped[frameIndex] + dirtyRange.begin,
+			m_materials.data() + dirtyRange.begin,
+			sizeof(Material) * (dirtyRange.end - dirtyRange.begin)
+		);
+
+		dirtyRange = {};
+	}
+
+	VkDescriptorSetLayout BindlessResources::getDescriptorSetLayout() const {
+		return m_descriptorSetLayout;
+	}
+
+	VkDescriptorSet BindlessResources::getDescriptorSet(std::uint32_t frameIndex) const {
+		return m_descriptorSets[frameIndex];
+	}
+
+	const Texture &BindlessResources::getDefaultTexture() const {
+		return *m_defaultTexture;
+	}
+
+	std::uint32_t BindlessResources::getTextureCount() const {
+		return m_textureCount - static_cast<std::uint32_t>(m_freeTextureIndices.size());
+	}
+
+	std::uint32_t BindlessResources::getMaterialCount() const {
+		return static_cast<std::uint32_t>(m_materials.size());
+	}
+
+	void BindlessResources::createDescriptorSetLayout() {
+		std::array<VkDescriptorSetLayoutBinding, 2> descriptorSetLayoutBindings{};
+		descriptorSetLayoutBindings[0].binding = TEXTURE_BINDING;
+		descriptorSetLayoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorSetLayoutBindings[0].descriptorCount = m_maxTextures;
+		descriptorSetLayoutBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		descriptorSetLayoutBindings[0].pImmutableSamplers = nullptr;
+
+		descriptorSetLayoutBindings[1].binding = MATERIAL_BINDING;
+		descriptorSetLayoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorSetLayoutBindings[1].descriptorCount = 1;
+		descriptorSetLayoutBindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		descriptorSetLayoutBindings[1].pImmutableSamplers = nullptr;
+
+		std::array<VkDescriptorBindingFlags, 2> descriptorBindingFlags{
+			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+		};
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo descriptorSetLayoutBindingFlagsCreateInfo{};
+		descriptorSetLayoutBindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		descriptorSetLayoutBindingFlagsCreateInfo.pNext = nullptr;
+		descriptorSetLayoutBindingFlagsCreateInfo.bindingCount = static_cast<std::uint32_t>(descriptorBindingFlags.size());
+		descriptorSetLayoutBindingFlagsCreateInfo.pBindingFlags = descriptorBindingFlags.data();
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = &descriptorSetLayoutBindingFlagsCreateInfo;
+		descriptorSetLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(descriptorSetLayoutBindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = descriptorSetLayoutBindings.data();
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create bindless descriptor set layout.");
+		}
+	}
+
+	void BindlessResources::createDescriptorPool() {
+		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
+		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorPoolSizes[0].descriptorCount = m_maxTextures * Swapchain::MAX_FRAMES_IN_FLIGHT;
+		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSizes[1].descriptorCount = Swapchain::MAX_FRAMES_IN_FLIGHT;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<std::uint32_t>(descriptorPoolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
+		descriptorPoolCreateInfo.maxSets = Swapchain::MAX_FRAMES_IN_FLIGHT;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create bindless descriptor pool.");
+		}
+	}
+
+	void BindlessResources::createDescriptorSets() {
+		std::array<VkDescriptorSetLayout, Swapchain::MAX_FRAMES_IN_FLIGHT> layouts;
+		layouts.fill(m_descriptorSetLayout);
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = static_cast<std::uint32_t>(layouts.size());
+		descriptorSetAllocateInfo.pSetLayouts = layouts.data();
+
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, m_descriptorSets.data()) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate bindless descriptor sets.");
+		}
+	}
+
+	void BindlessResources::createMaterialBuffers() {
+		VkDeviceSize materialBufferSize = sizeof(Material) * m_maxMaterials;
+
+		for (std::size_t i = 0; i < m_materialBuffers.size(); ++i) {
+			m_device.createBuffer(
+				materialBufferSize,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				m_materialBuffers[i],
+				m_materialBuffersMemory[i]
+			);
+
+			void *data;
+			vkMapMemory(m_device.getDevice(), m_materialBuffersMemory[i], 0, materialBufferSize, 0, &data);
+			m_materialBuffersMapped[i] = static_cast<Material *>(data);
+
+			VkDescriptorBufferInfo descriptorBufferInfo{};
+			descriptorBufferInfo.buffer = m_materialBuffers[i];
+			descriptorBufferInfo.offset = 0;
+			descriptorBufferInfo.range = VK_WHOLE_SIZE;
+
+			VkWriteDescriptorSet writeDescriptorSet{};
+			writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSet.pNext = nullptr;
+			writeDescriptorSet.dstSet = m_descriptorSets[i];
+			writeDescriptorSet.dstBinding = MATERIAL_BINDING;
+			writeDescriptorSet.dstArrayElement = 0;
+			writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writeDescriptorSet.descriptorCount = 1;
+			writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+			vkUpdateDescriptorSets(m_device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+		}
+	}
+
+	void BindlessResources::createDefaultResources() {
+		const std::uint32_t white = 0xffffffff;
+
+		m_defaultTexture = std::make_unique<Texture>(m_device, 1, 1, VK_FORMAT_R8G8B8A8_UNORM, &white, sizeof(white));
+		addTexture(*m_defaultTexture);
+		addMaterial(Material{});
+	}
+
+	void BindlessResources::writeTexture(std::uint32_t textureIndex, VkImageView imageView, VkSampler sampler) {
+		VkDescriptorImageInfo descriptorImageInfo{};
+		descriptorImageInfo.sampler = sampler;
+		descriptorImageInfo.imageView = imageView;
+		descriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		std::array<VkWriteDescriptorSet, Swapchain::MAX_FRAMES_IN_FLIGHT> writeDescriptorSets{};
+		for (std::size_t i = 0; i < writeDescriptorSets.size(); ++i) {
+			writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSets[i].pNext = nullptr;
+			writeDescriptorSets[i].dstSet = m_descriptorSets[i];
+			writeDescriptorSets[i].dstBinding = TEXTURE_BINDING;
+			writeDescriptorSets[i].dstArrayElement = textureIndex;
+			writeDescriptorSets[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			writeDescriptorSets[i].descriptorCount = 1;
+			writeDescriptorSets[i].pImageInfo = &descriptorImageInfo;
+		}
+
+		vkUpdateDescriptorSets(m_device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+}
\ No newline at end of file
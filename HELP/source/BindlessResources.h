@@ -0,0 +1,90 @@
+#ifndef BINDLESS_RESOURCES_H
+#define BINDLESS_RESOURCES_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Device.h"
+#include "Swapchain.h"
+#include "Texture.h"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class BindlessResources {
+	public:
+		struct Material {
+			glm::vec4 baseColor{ 1.0f, 1.0f, 1.0f, 1.0f };
+			std::uint32_t textureIndex = 0;
+			std::uint32_t padding[3]{};
+		};
+
+		BindlessResources(Device &device, std::uint32_t maxTextures = 4096, std::uint32_t maxMaterials = 16384);
+		~BindlessResources();
+
+		BindlessResources(const BindlessResources &) = delete;
+		BindlessResources &operator=(const BindlessResources &) = delete;
+
+		std::uint32_t addTexture(const Texture &texture);
+		std::uint32_t addTexture(VkImageView imageView, VkSampler sampler);
+		void removeTexture(std::uint32_t textureIndex);
+		void replaceTexture(std::uint32_t oldTextureIndex, std::uint32_t newTextureIndex);
+
+		std::uint32_t addMaterial(const Material &material);
+		void setMaterial(std::uint32_t materialIndex, const Material &material);
+		void flush(std::uint32_t frameIndex);
+
+		VkDescriptorSetLayout getDescriptorSetLayout() const;
+		VkDescriptorSet getDescriptorSet(std::uint32_t frameIndex) const;
+		const Texture &getDefaultTexture() const;
+		std::uint32_t getTextureCount() const;
+		std::uint32_t getMaterialCount() const;
+
+		static constexpr std::uint32_t TEXTURE_BINDING = 0;
+		static constexpr std::uint32_t MATERIAL_BINDING = 1;
+		static constexpr std::uint32_t DEFAULT_TEXTURE = 0;
+		static constexpr std::uint32_t DEFAULT_MATERIAL = 0;
+	private:
+		struct DirtyRange {
+			std::uint32_t begin = 0;
+			std::uint32_t end = 0;
+		};
+
+		void createDescriptorSetLayout();
+		void createDescriptorPool();
+		void createDescriptorSets();
+		void createMaterialBuffers();
+		void createDefaultResources();
+		void writeTexture(std::uint32_t textureIndex, VkImageView imageView, VkSampler sampler);
+
+		Device &m_device;
+
+		std::uint32_t m_maxTextures;
+		std::uint32_t m_maxMaterials;
+		std::uint32_t m_textureCount = 0;
+		std::vector<std::uint32_t> m_freeTextureIndices;
+		std::vector<bool> m_freeTextures;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool;
+		std::array<VkDescriptorSet, Swapchain::MAX_FRAMES_IN_FLIGHT> m_descriptorSets;
+
+		std::vector<Material> m_materials;
+		std::array<VkBuffer, Swapchain::MAX_FRAMES_IN_FLIGHT> m_materialBuffers;
+		std::array<VkDeviceMemory, Swapchain::MAX_FRAMES_IN_FLIGHT> m_materialBuffersMemory;
+		std::array<Material *, Swapchain::MAX_FRAMES_IN_FLIGHT> m_materialBuffersMapped;
+		std::array<DirtyRange, Swapchain::MAX_FRAMES_IN_FLIGHT> m_dirtyMaterials;
+
+		std::unique_ptr<Texture> m_defaultTexture;
+	};
+}
+
+#endif
\ No newline at end of file
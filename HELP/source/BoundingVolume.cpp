@@ -0,0 +1,106 @@
+#include "BoundingVolume.h"
+
+namespace eng {
+	BoundingBox BoundingBox::fromPoints(const glm::vec3 *points, std::size_t count, std::size_t stride) {
+		BoundingBox box{};
+
+		const unsigned char *bytes = reinterpret_cast<const unsigned char *>(points);
+		for (std::size_t i = 0; i < count; ++i) {
+			box.expand(*reinterpret_cast<const glm::vec3 *>(bytes + i * stride));
+		}
+
+		return box;
+	}
+
+	void BoundingBox::expand(const glm::vec3 &point) {
+		min = glm::min(min, point);
+		max = glm::max(max, point);
+	}
+
+	void BoundingBox::expand(const BoundingBox &box) {
+		min = glm::min(min, box.min);
+		max = glm::max(max, box.max);
+	}
+
+	void BoundingBox::inflate(float margin) {
+		min -= glm::vec3{ margin };
+		max += glm::vec3{ margin };
+	}
+
+	bool BoundingBox::isValid() const {
+		return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+	}
+
+	bool BoundingBox::contains(const BoundingBox &box) const {
+		return min.x <= box.min.x && min.y <= box.min.y && min.z <= box.min.z &&
+			max.x >= box.max.x && max.y >= box.max.y && max.z >= box.max.z;
+	}
+
+	float BoundingBox::getSurfaceArea() const {
+		glm::vec3 size = max - min;
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	glm::vec3 BoundingBox::getCenter() const {
+		return (min + max) * 0.5f;
+	}
+
+	glm::vec3 BoundingBox::getExtents() const {
+		return (max - min) * 0.5f;
+	}
+
+	BoundingBox BoundingBox::transform(const glm::mat4 &matrix) const {
+		glm::vec3 center = glm::vec3{ matrix * glm::vec4{ getCenter(), 1.0f } };
+		glm::vec3 extents = getExtents();
+
+		glm::vec3 transformedExtents{
+			std::abs(matrix[0][0]) * extents.x + std::abs(matrix[1][0]) * extents.y + std::abs(matrix[2][0]) * extents.z,
+			std::abs(matrix[0][1]) * extents.x + std::abs(matrix[1][1]) * extents.y + std::abs(matrix[2][1]) * extents.z,
+			std::abs(matrix[0][2]) * extents.x + std::abs(matrix[1][2]) * extents.y + std::abs(matrix[2][2]) * extents.z
+		};
+
+		return BoundingBox{ center - transformedExtents, center + transformedExtents };
+	}
+
+	BoundingSphere BoundingBox::getBoundingSphere() const {
+		return BoundingSphere{ getCenter(), glm::length(getExtents()) };
+	}
+
+	BoundingBox BoundingBox::merge(const BoundingBox &a, const BoundingBox &b) {
+		return BoundingBox{ glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+
+	void BoundingBoxArray::reserve(std::size_t count) {
+		centerX.reserve(count);
+		centerY.reserve(count);
+		centerZ.reserve(count);
+		extentX.reserve(count);
+		extentY.reserve(count);
+		extentZ.reserve(count);
+	}
+
+	void BoundingBoxArray::clear() {
+		centerX.clear();
+		centerY.clear();
+		centerZ.clear();
+		extentX.clear();
+		extentY.clear();
+		extentZ.clear();
+	}
+
+	void BoundingBoxArray::push_back(const BoundingBox &box) {
+		glm::vec3 center = box.getCenter();
+		glm::vec3 extents = box.getExtents();
+
+		centerX.push_back(center.x);
+		centerY.push_back(center.y);
+		centerZ.push_back(center.z);
+		extentX.push_back(extents.x);
+		extentY.push_back(extents.y);
+		extentZ.push_back(extents.z);
+	}
+
+	std::size_t BoundingBoxArray::size() const {
+		return centerX.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef BOUNDING_VOLUME_H
+#define BOUNDING_VOLUME_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace eng {
+	struct BoundingSphere {
+		glm::vec3 center{ 0.0f };
+		float radius = 0.0f;
+	};
+
+	struct BoundingBox {
+		glm::vec3 min{ std::numeric_limits<float>::max() };
+		glm::vec3 max{ -std::numeric_limits<float>::max() };
+
+		static BoundingBox fromPoints(const glm::vec3 *points, std::size_t count, std::size_t stride);
+
+		void expand(const glm::vec3 &point);
+		void expand(const BoundingBox &box);
+		void inflate(float margin);
+
+		bool isValid() const;
+		bool contains(const BoundingBox &box) const;
+		float getSurfaceArea() const;
+		glm::vec3 getCenter() const;
+		glm::vec3 getExtents() const;
+
+		BoundingBox transform(const glm::mat4 &matrix) const;
+		BoundingSphere getBoundingSphere() const;
+
+		static BoundingBox merge(const BoundingBox &a, const BoundingBox &b);
+	};
+
+	struct BoundingBoxArray {
+		std::vector<float> centerX, centerY, centerZ;
+		std::vector<float> extentX, extentY, extentZ;
+
+		void reserve(std::size_t count);
+		void clear();
+		void push_back(const BoundingBox &box);
+		std::size_t size() const;
+	};
+}
+
+#endif
\ No newline at end of file
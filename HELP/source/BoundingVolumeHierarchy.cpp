@@ -0,0 +1,363 @@
+#include "BoundingVolumeHierarchy.h"
+
+namespace eng {
+	bool BoundingVolumeHierarchy::Node::isLeaf() const {
+		return left == NULL_NODE;
+	}
+
+	BoundingVolumeHierarchy::BoundingVolumeHierarchy(float margin)
+		: m_margin(margin) {
+	}
+
+	std::int32_t BoundingVolumeHierarchy::createProxy(const BoundingBox &box, std::uint32_t userData) {
+		std::int32_t proxy = allocateNode();
+
+		m_nodes[proxy].box = box;
+		m_nodes[proxy].box.inflate(m_margin);
+		m_nodes[proxy].userData = userData;
+		m_nodes[proxy].height = 0;
+
+		insertLeaf(proxy);
+		++m_proxyCount;
+
+		return proxy;
+	}
+
+	void BoundingVolumeHierarchy::destroyProxy(std::int32_t proxy) {
+		if (proxy < 0 || proxy >= static_cast<std::int32_t>(m_nodes.size()) || !m_nodes[proxy].isLeaf()) {
+			throw std::runtime_error("Failed to destroy proxy that is not a leaf.");
+		}
+
+		removeLeaf(proxy);
+		freeNode(proxy);
+		--m_proxyCount;
+	}
+
+	bool BoundingVolumeHierarchy::moveProxy(std::int32_t proxy, const BoundingBox &box) {
+		if (m_nodes[proxy].box.contains(box)) {
+			return false;
+		}
+
+		removeLeaf(proxy);
+
+		m_nodes[proxy].box = box;
+		m_nodes[proxy].box.inflate(m_margin);
+
+		insertLeaf(proxy);
+
+		return true;
+	}
+
+	void BoundingVolumeHierarchy::query(const Frustum &frustum, std::vector<std::uint32_t> &visible) const {
+		if (m_root == NULL_NODE) {
+			return;
+		}
+
+		std::vector<std::int32_t> &stack = m_stack;
+		stack.clear();
+		stack.push_back(m_root);
+
+		std::vector<std::int32_t> subtreeStack;
+
+		while (!stack.empty()) {
+			std::int32_t nodeIndex = stack.back();
+			stack.pop_back();
+
+			const Node &node = m_nodes[nodeIndex];
+			Frustum::Intersection intersection = frustum.classify(node.box);
+			if (intersection == Frustum::Intersection::Outside) {
+				continue;
+			}
+
+			if (node.isLeaf()) {
+				visible.push_back(node.userData);
+			} else if (intersection == Frustum::Intersection::Inside) {
+				collectLeaves(nodeIndex, visible, subtreeStack);
+			} else {
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+	}
+
+	void BoundingVolumeHierarchy::query(const std::vector<Frustum> &frusta, std::vector<QueryResult> &visible) const {
+		if (frusta.size() > MAX_QUERY_FRUSTA) {
+			throw std::runtime_error("Too many frusta for a single hierarchy query.");
+		}
+
+		if (m_root == NULL_NODE || frusta.empty()) {
+			return;
+		}
+
+		const std::uint64_t allFrusta = frusta.size() == MAX_QUERY_FRUSTA ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << frusta.size()) - 1;
+
+		std::vector<QueryEntry> &stack = m_queryStack;
+		stack.clear();
+		stack.push_back({ m_root, allFrusta, 0 });
+
+		while (!stack.empty()) {
+			QueryEntry entry = stack.back();
+			stack.pop_back();
+
+			const Node &node = m_nodes[entry.node];
+			for (std::size_t i = 0; i < frusta.size(); ++i) {
+				const std::uint64_t bit = std::uint64_t{ 1 } << i;
+				if ((entry.testMask & bit) == 0) {
+					continue;
+				}
+
+				Frustum::Intersection intersection = frusta[i].classify(node.box);
+				if (intersection == Frustum::Intersection::Outside) {
+					entry.testMask &= ~bit;
+				} else if (intersection == Frustum::Intersection::Inside) {
+					entry.testMask &= ~bit;
+					entry.insideMask |= bit;
+				}
+			}
+
+			const std::uint64_t mask = entry.testMask | entry.insideMask;
+			if (mask == 0) {
+				continue;
+			}
+
+			if (node.isLeaf()) {
+				visible.push_back({ node.userData, mask });
+			} else if (entry.testMask == 0) {
+				collectLeaves(entry.node, mask, visible, m_stack);
+			} else {
+				stack.push_back({ node.left, entry.testMask, entry.insideMask });
+				stack.push_back({ node.right, entry.testMask, entry.insideMask });
+			}
+		}
+	}
+
+	std::uint32_t BoundingVolumeHierarchy::getUserData(std::int32_t proxy) const {
+		return m_nodes[proxy].userData;
+	}
+
+	const BoundingBox &BoundingVolumeHierarchy::getFatBox(std::int32_t proxy) const {
+		return m_nodes[proxy].box;
+	}
+
+	std::size_t BoundingVolumeHierarchy::getProxyCount() const {
+		return m_proxyCount;
+	}
+
+	int BoundingVolumeHierarchy::getHeight() const {
+		return m_root == NULL_NODE ? 0 : m_nodes[m_root].height;
+	}
+
+	std::int32_t BoundingVolumeHierarchy::allocateNode() {
+		if (m_freeList == NULL_NODE) {
+			m_nodes.emplace_back();
+			return static_cast<std::int32_t>(m_nodes.size() - 1);
+		}
+
+		std::int32_t node = m_freeList;
+		m_freeList = m_nodes[node].parent;
+		m_nodes[node] = Node{};
+
+		return node;
+	}
+
+	void BoundingVolumeHierarchy::freeNode(std::int32_t node) {
+		m_nodes[node].parent = m_freeList;
+		m_nodes[node].left = NULL_NODE;
+		m_nodes[node].right = NULL_NODE;
+		m_nodes[node].height = -1;
+		m_freeList = node;
+	}
+
+	void BoundingVolumeHierarchy::insertLeaf(std::int32_t leaf) {
+		if (m_root == NULL_NODE) {
+			m_root = leaf;
+			m_nodes[m_root].parent = NULL_NODE;
+			return;
+		}
+
+		const BoundingBox leafBox = m_nodes[leaf].box;
+		std::int32_t index = m_root;
+		while (!m_nodes[index].isLeaf()) {
+			std::int32_t left = m_nodes[index].left;
+			std::int32_t right = m_nodes[index].right;
+
+			float area = m_nodes[index].box.getSurfaceArea();
+			float combinedArea = BoundingBox::merge(m_nodes[index].box, leafBox).getSurfaceArea();
+
+			float cost = 2.0f * combinedArea;
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](std::int32_t child) {
+				float mergedArea = BoundingBox::merge(leafBox, m_nodes[child].box).getSurfaceArea();
+				if (m_nodes[child].isLeaf()) {
+					return mergedArea + inheritanceCost;
+				}
+
+				return mergedArea - m_nodes[child].box.getSurfaceArea() + inheritanceCost;
+			};
+
+			float leftCost = descendCost(left);
+			float rightCost = descendCost(right);
+
+			if (cost < leftCost && cost < rightCost) {
+				break;
+			}
+
+			index = leftCost < rightCost ? left : right;
+		}
+
+		std::int32_t sibling = index;
+		std::int32_t oldParent = m_nodes[sibling].parent;
+		std::int32_t newParent = allocateNode();
+
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].box = BoundingBox::merge(leafBox, m_nodes[sibling].box);
+		m_nodes[newParent].height = m_nodes[sibling].height + 1;
+		m_nodes[newParent].left = sibling;
+		m_nodes[newParent].right = leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		if (oldParent == NULL_NODE) {
+			m_root = newParent;
+		} else if (m_nodes[oldParent].left == sibling) {
+			m_nodes[oldParent].left = newParent;
+		} else {
+			m_nodes[oldParent].right = newParent;
+		}
+
+		refit(m_nodes[leaf].parent);
+	}
+
+	void BoundingVolumeHierarchy::removeLeaf(std::int32_t leaf) {
+		if (leaf == m_root) {
+			m_root = NULL_NODE;
+			return;
+		}
+
+		std::int32_t parent = m_nodes[leaf].parent;
+		std::int32_t grandParent = m_nodes[parent].parent;
+		std::int32_t sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+		if (grandParent == NULL_NODE) {
+			m_root = sibling;
+			m_nodes[sibling].parent = NULL_NODE;
+			freeNode(parent);
+			return;
+		}
+
+		if (m_nodes[grandParent].left == parent) {
+			m_nodes[grandParent].left = sibling;
+		} else {
+			m_nodes[grandParent].right = sibling;
+		}
+
+		m_nodes[sibling].parent = grandParent;
+		freeNode(parent);
+
+		refit(grandParent);
+	}
+
+	void BoundingVolumeHierarchy::refit(std::int32_t node) {
+		while (node != NULL_NODE) {
+			node = balance(node);
+
+			std::int32_t left = m_nodes[node].left;
+			std::int32_t right = m_nodes[node].right;
+
+			m_nodes[node].height = 1 + std::max(m_nodes[left].height, m_nodes[right].height);
+			m_nodes[node].box = BoundingBox::merge(m_nodes[left].box, m_nodes[right].box);
+
+			node = m_nodes[node].parent;
+		}
+	}
+
+	std::int32_t BoundingVolumeHierarchy::balance(std::int32_t a) {
+		if (m_nodes[a].isLeaf() || m_nodes[a].height < 2) {
+			return a;
+		}
+
+		std::int32_t b = m_nodes[a].left;
+		std::int32_t c = m_nodes[a].right;
+		std::int32_t heightDifference = m_nodes[c].height - m_nodes[b].height;
+
+		auto rotate = [&](std::int32_t up, std::int32_t down) {
+			std::int32_t upLeft = m_nodes[up].left;
+			std::int32_t upRight = m_nodes[up].right;
+
+			m_nodes[up].left = a;
+			m_nodes[up].parent = m_nodes[a].parent;
+			m_nodes[a].parent = up;
+
+			if (m_nodes[up].parent == NULL_NODE) {
+				m_root = up;
+			} else if (m_nodes[m_nodes[up].parent].left == a) {
+				m_nodes[m_nodes[up].parent].left = up;
+			} else {
+				m_nodes[m_nodes[up].parent].right = up;
+			}
+
+			std::int32_t taller = m_nodes[upLeft].height > m_nodes[upRight].height ? upLeft : upRight;
+			std::int32_t shorter = taller == upLeft ? upRight : upLeft;
+
+			m_nodes[up].right = taller;
+			if (m_nodes[a].left == up) {
+				m_nodes[a].left = shorter;
+			} else {
+				m_nodes[a].right = shorter;
+			}
+			m_nodes[shorter].parent = a;
+
+			m_nodes[a].box = BoundingBox::merge(m_nodes[down].box, m_nodes[shorter].box);
+			m_nodes[a].height = 1 + std::max(m_nodes[down].height, m_nodes[shorter].height);
+			m_nodes[up].box = BoundingBox::merge(m_nodes[a].box, m_nodes[taller].box);
+			m_nodes[up].height = 1 + std::max(m_nodes[a].height, m_nodes[taller].height);
+
+			return up;
+		};
+
+		if (heightDifference > 1) {
+			return rotate(c, b);
+		}
+
+		if (heightDifference < -1) {
+			return rotate(b, c);
+		}
+
+		return a;
+	}
+
+	void BoundingVolumeHierarchy::collectLeaves(std::int32_t node, std::vector<std::uint32_t> &visible, std::vector<std::int32_t> &stack) const {
+		stack.clear();
+		stack.push_back(node);
+
+		while (!stack.empty()) {
+			std::int32_t index = stack.back();
+			stack.pop_back();
+
+			if (m_nodes[index].isLeaf()) {
+				visible.push_back(m_nodes[index].userData);
+			} else {
+				stack.push_back(m_nodes[index].left);
+				stack.push_back(m_nodes[index].right);
+			}
+		}
+	}
+
+	void BoundingVolumeHierarchy::collectLeaves(std::int32_t node, std::uint64_t mask, std::vector<QueryResult> &visible, std::vector<std::int32_t> &stack) const {
+		stack.clear();
+		stack.push_back(node);
+
+		while (!stack.empty()) {
+			std::int32_t index = stack.back();
+			stack.pop_back();
+
+			if (m_nodes[index].isLeaf()) {
+				visible.push_back({ m_nodes[index].userData, mask });
+			} else {
+				stack.push_back(m_nodes[index].left);
+				stack.push_back(m_nodes[index].right);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef BOUNDING_VOLUME_HIERARCHY_H
+#define BOUNDING_VOLUME_HIERARCHY_H
+
+#include "BoundingVolume.h"
+#include "Frustum.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+
+namespace eng {
+	class BoundingVolumeHierarchy {
+	public:
+		struct QueryResult {
+			std::uint32_t userData = 0;
+			std::uint64_t mask = 0;
+		};
+
+		BoundingVolumeHierarchy(float margin = 0.1f);
+
+		std::int32_t createProxy(const BoundingBox &box, std::uint32_t userData);
+		void destroyProxy(std::int32_t proxy);
+		bool moveProxy(std::int32_t proxy, const BoundingBox &box);
+
+		void query(const Frustum &frustum, std::vector<std::uint32_t> &visible) const;
+		void query(const std::vector<Frustum> &frusta, std::vector<QueryResult> &visible) const;
+
+		std::uint32_t getUserData(std::int32_t proxy) const;
+		const BoundingBox &getFatBox(std::int32_t proxy) const;
+		std::size_t getProxyCount() const;
+		int getHeight() const;
+
+		static constexpr std::int32_t NULL_NODE = -1;
+		static constexpr std::size_t MAX_QUERY_FRUSTA = 64;
+	private:
+		struct Node {
+			BoundingBox box{};
+			std::int32_t parent = NULL_NODE;
+			std::int32_t left = NULL_NODE;
+			std::int32_t right = NULL_NODE;
+			std::int32_t height = 0;
+			std::uint32_t userData = 0;
+
+			bool isLeaf() const;
+		};
+
+		struct QueryEntry {
+			std::int32_t node;
+			std::uint64_t testMask;
+			std::uint64_t insideMask;
+		};
+
+		std::int32_t allocateNode();
+		void freeNode(std::int32_t node);
+
+		void insertLeaf(std::int32_t leaf);
+		void removeLeaf(std::int32_t leaf);
+		void refit(std::int32_t node);
+		std::int32_t balance(std::int32_t node);
+
+		void collectLeaves(std::int32_t node, std::vector<std::uint32_t> &visible, std::vector<std::int32_t> &stack) const;
+		void collectLeaves(std::int32_t node, std::uint64_t mask, std::vector<QueryResult> &visible, std::vector<std::int32_t> &stack) const;
+
+		std::vector<Node> m_nodes;
+		std::int32_t m_root = NULL_NODE;
+		std::int32_t m_freeList = NULL_NODE;
+		std::size_t m_proxyCount = 0;
+		float m_margin;
+
+		mutable std::vector<std::int32_t> m_stack;
+		mutable std::vector<QueryEntry> m_queryStack;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "Camera.h"
+
+namespace eng {
+	void Camera::setOrthographicProjection(float left, float right, float top, float bottom, float near, float far) {
+		m_projection = glm::mat4{ 1.0f };
+		m_projection[0][0] = 2.0f / (right - left);
+		m_projection[1][1] = 2.0f / (bottom - top);
+		m_projection[2][2] = 1.0f / (far - near);
+		m_projection[3][0] = -(right + left) / (right - left);
+		m_projection[3][1] = -(bottom + top) / (bottom - top);
+		m_projection[3][2] = -near / (far - near);
+	}
+
+	void Camera::setPerspectiveProjection(float fovy, float aspect, float near, float far) {
+		assert(std::abs(aspect - std::numeric_limits<float>::epsilon()) > 0.0f);
+
+		const float tanHalfFovy = std::tan(fovy / 2.0f);
+
+		m_projection = glm::mat4{ 0.0f };
+		m_projection[0][0] = 1.0f / (aspect * tanHalfFovy);
+		m_projection[1][1] = 1.0f / tanHalfFovy;
+		m_projection[2][2] = far / (far - near);
+		m_projection[2][3] = 1.0f;
+		m_projection[3][2] = -(far * near) / (far - near);
+	}
+
+	void Camera::setViewDirection(const glm::vec3 &position, const glm::vec3 &direction, const glm::vec3 &up) {
+		const glm::vec3 w{ glm::normalize(direction) };
+		const glm::vec3 u{ glm::normalize(glm::cross(w, up)) };
+		const glm::vec3 v{ glm::cross(w, u) };
+
+		m_view = glm::mat4{ 1.0f };
+		m_view[0][0] = u.x;
+		m_view[1][0] = u.y;
+		m_view[2][0] = u.z;
+		m_view[0][1] = v.x;
+		m_view[1][1] = v.y;
+		m_view[2][1] = v.z;
+		m_view[0][2] = w.x;
+		m_view[1][2] = w.y;
+		m_view[2][2] = w.z;
+		m_view[3][0] = -glm::dot(u, position);
+		m_view[3][1] = -glm::dot(v, position);
+		m_view[3][2] = -glm::dot(w, position);
+		m_position = position;
+	}
+
+	void Camera::setViewTarget(const glm::vec3 &position, const glm::vec3 &target, const glm::vec3 &up) {
+		setViewDirection(position, target - position, up);
+	}
+
+	void Camera::setViewYXZ(const glm::vec3 &position, const glm::vec3 &rotation) {
+		const float c3 = glm::cos(rotation.z);
+		const float s3 = glm::sin(rotation.z);
+		const float c2 = glm::cos(rotation.x);
+		const float s2 = glm::sin(rotation.x);
+		const float c1 = glm::cos(rotation.y);
+		const float s1 = glm::sin(rotation.y);
+
+		const glm::vec3 u{ (c1 * c3 + s1 * s2 * s3), (c2 * s3), (c1 * s2 * s3 - c3 * s1) };
+		const glm::vec3 v{ (c3 * s1 * s2 - c1 * s3), (c2 * c3), (c1 * c3 * s2 + s1 * s3) };
+		const glm::vec3 w{ (c2 * s1), (-s2), (c1 * c2) };
+
+		m_view = glm::mat4{ 1.0f };
+		m_view[0][0] = u.x;
+		m_view[1][0] = u.y;
+		m_view[2][0] = u.z;
+		m_view[0][1] = v.x;
+		m_view[1][1] = v.y;
+		m_view[2][1] = v.z;
+		m_view[0][2] = w.x;
+		m_view[1][2] = w.y;
+		m_view[2][2] = w.z;
+		m_view[3][0] = -glm::dot(u, position);
+		m_view[3][1] = -glm::dot(v, position);
+		m_view[3][2] = -glm::dot(w, position);
+		m_position = position;
+	}
+
+	const glm::mat4 &Camera::getProjection() const {
+		return m_projection;
+	}
+
+	const glm::mat4 &Camera::getView() const {
+		return m_view;
+	}
+
+	glm::mat4 Camera::getProjectionView() const {
+		return m_projection * m_view;
+	}
+
+	const glm::vec3 &Camera::getPosition() const {
+		return m_position;
+	}
+
+	Frustum Camera::getFrustum() const {
+		return Frustum{ getProjectionView() };
+	}
+
+	float Camera::getScreenSize(const BoundingSphere &sphere) const {
+		float depth = (m_view * glm::vec4{ sphere.center, 1.0f }).z;
+		if (depth <= sphere.radius) {
+			return std::numeric_limits<float>::max();
+		}
+
+		return sphere.radius * m_projection[1][1] / depth;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Frustum.h"
+
+#include <cassert>
+#include <limits>
+#include <cmath>
+
+namespace eng {
+	class Camera {
+	public:
+		void setOrthographicProjection(float left, float right, float top, float bottom, float near, float far);
+		void setPerspectiveProjection(float fovy, float aspect, float near, float far);
+
+		void setViewDirection(const glm::vec3 &position, const glm::vec3 &direction, const glm::vec3 &up = { 0.0f, -1.0f, 0.0f });
+		void setViewTarget(const glm::vec3 &position, const glm::vec3 &target, const glm::vec3 &up = { 0.0f, -1.0f, 0.0f });
+		void setViewYXZ(const glm::vec3 &position, const glm::vec3 &rotation);
+
+		const glm::mat4 &getProjection() const;
+		const glm::mat4 &getView() const;
+		glm::mat4 getProjectionView() const;
+		const glm::vec3 &getPosition() const;
+		Frustum getFrustum() const;
+		float getScreenSize(const BoundingSphere &sphere) const;
+	private:
+		glm::mat4 m_projection{ 1.0f };
+		glm::mat4 m_view{ 1.0f };
+		glm::vec3 m_position{ 0.0f };
+	};
+}
+
+#endif
\ No newline at end of file
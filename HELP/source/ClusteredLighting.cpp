@@ -0,0 +1,409 @@
+#include "ClusteredLighting.h"
+
+namespace eng {
+	ClusteredLighting::Light ClusteredLighting::Light::createPointLight(const glm::vec3 &position, float radius, const glm::vec3 &color, float intensity) {
+		Light light{};
+		light.position = position;
+		light.radius = radius;
+		light.color = color;
+		light.intensity = intensity;
+		light.type = LightType::Point;
+
+		return light;
+	}
+
+	ClusteredLighting::Light ClusteredLighting::Light::createSpotLight(const glm::vec3 &position, const glm::vec3 &direction, float radius, float outerAngle, float innerAngle, const glm::vec3 &color, float intensity) {
+		outerAngle = std::clamp(outerAngle, 0.0f, glm::half_pi<float>());
+		innerAngle = std::clamp(innerAngle, 0.0f, outerAngle);
+
+		Light light{};
+		light.position = position;
+		light.radius = radius;
+		light.color = color;
+		light.intensity = intensity;
+		light.direction = glm::normalize(direction);
+		light.outerCutoff = std::cos(outerAngle);
+		light.innerCutoff = std::cos(innerAngle);
+		light.type = LightType::Spot;
+
+		return light;
+	}
+
+	ClusteredLighting::ClusteredLighting(Device &device, std::uint32_t maxLights, std::uint32_t frameCount)
+		: m_device(device), m_maxLights(maxLights), m_frameCount(frameCount) {
+		createBuffers();
+		createDescriptorSetLayout();
+		createDescriptorSets();
+		createPipeline();
+	}
+
+	ClusteredLighting::~ClusteredLighting() {
+		m_binPipeline.reset();
+
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		vkUnmapMemory(m_device.getDevice(), m_lightBufferMemory);
+		vkUnmapMemory(m_device.getDevice(), m_stagingBufferMemory);
+
+		VkBuffer buffers[] = { m_lightBuffer, m_clusterBuffer, m_stagingBuffer };
+		VkDeviceMemory memories[] = { m_lightBufferMemory, m_clusterBufferMemory, m_stagingBufferMemory };
+		for (std::size_t i = 0; i < std::size(buffers); ++i) {
+			vkDestroyBuffer(m_device.getDevice(), buffers[i], VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(memories[i]);
+		}
+	}
+
+	void ClusteredLighting::setGpuBinning(bool enabled) {
+		m_gpuBinning = enabled;
+	}
+
+	bool ClusteredLighting::isGpuBinningEnabled() const {
+		return m_gpuBinning;
+	}
+
+	void ClusteredLighting::addPasses(RenderGraph &graph, const std::vector<Light> &lights, const Camera &camera, VkExtent2D extent, std::uint32_t frameIndex) {
+		if (lights.size() > m_maxLights) {
+			throw std::runtime_error("Too many clustered lights.");
+		}
+
+		m_lightCount = static_cast<std::uint32_t>(lights.size());
+
+		const Parameters parameters = computeParameters(camera, extent, m_lightCount);
+
+		char *lightData = static_cast<char *>(m_lightBufferMapped) + m_lightSliceSize * frameIndex;
+		std::memcpy(lightData, &parameters, sizeof(Parameters));
+		if (!lights.empty()) {
+			std::memcpy(lightData + sizeof(Parameters), lights.data(), sizeof(Light) * lights.size());
+		}
+
+		RenderGraph::ResourceState initialState{};
+		initialState.stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		initialState.access = VK_ACCESS_SHADER_READ_BIT;
+
+		RenderGraph::BufferDescription clusterDescription{};
+		clusterDescription.size = CLUSTER_DATA_SIZE;
+		clusterDescription.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+		m_clusterResource = graph.importBuffer("light clusters", m_clusterBuffer, clusterDescription, initialState);
+
+		if (m_gpuBinning) {
+			graph.addPass("light binning", RenderGraph::PassType::Compute)
+				.write(m_clusterResource, RenderGraph::Access::StorageWrite)
+				.setExecute([this, frameIndex](VkCommandBuffer commandBuffer) {
+					bin(commandBuffer, frameIndex);
+				});
+		} else {
+			buildClusters(lights, parameters, reinterpret_cast<std::uint32_t *>(static_cast<char *>(m_stagingBufferMapped) + CLUSTER_DATA_SIZE * frameIndex));
+
+			graph.addPass("light cluster upload", RenderGraph::PassType::Transfer)
+				.write(m_clusterResource, RenderGraph::Access::TransferDestination)
+				.setExecute([this, frameIndex](VkCommandBuffer commandBuffer) {
+					upload(commandBuffer, frameIndex);
+				});
+		}
+	}
+
+	RenderGraph::ResourceHandle ClusteredLighting::getClusterBuffer() const {
+		return m_clusterResource;
+	}
+
+	std::vector<std::uint32_t> ClusteredLighting::readClusters() {
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		m_device.createBuffer(
+			CLUSTER_DATA_SIZE,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			stagingBuffer,
+			stagingBufferMemory
+		);
+
+		VkCommandBuffer commandBuffer = m_device.beginSingleTimeCommands();
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		VkBufferCopy bufferCopy{};
+		bufferCopy.srcOffset = 0;
+		bufferCopy.dstOffset = 0;
+		bufferCopy.size = CLUSTER_DATA_SIZE;
+		vkCmdCopyBuffer(commandBuffer, m_clusterBuffer, stagingBuffer, 1, &bufferCopy);
+
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		m_device.endSingleTimeCommands(commandBuffer);
+
+		std::vector<std::uint32_t> clusterData(CLUSTER_DATA_COUNT);
+		void *data;
+		vkMapMemory(m_device.getDevice(), stagingBufferMemory, 0, CLUSTER_DATA_SIZE, 0, &data);
+		std::memcpy(clusterData.data(), data, static_cast<std::size_t>(CLUSTER_DATA_SIZE));
+		vkUnmapMemory(m_device.getDevice(), stagingBufferMemory);
+
+		vkDestroyBuffer(m_device.getDevice(), stagingBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(stagingBufferMemory);
+
+		return clusterData;
+	}
+
+	VkDescriptorSetLayout ClusteredLighting::getDescriptorSetLayout() const {
+		return m_descriptorSetLayout;
+	}
+
+	VkDescriptorSet ClusteredLighting::getDescriptorSet(std::uint32_t frameIndex) const {
+		return m_descriptorSets[frameIndex];
+	}
+
+	std::uint32_t ClusteredLighting::getLightCount() const {
+		return m_lightCount;
+	}
+
+	ClusteredLighting::Parameters ClusteredLighting::computeParameters(const Camera &camera, VkExtent2D extent, std::uint32_t lightCount) {
+		const glm::mat4 &projection = camera.getProjection();
+		const float near = -projection[3][2] / projection[2][2];
+		const float far = projection[3][2] / (1.0f - projection[2][2]);
+		const float logDepthRange = std::log(far / near);
+
+		Parameters parameters{};
+		parameters.view = camera.getView();
+		parameters.depth = glm::vec4{
+			CLUSTER_COUNT_Z / logDepthRange,
+			-(CLUSTER_COUNT_Z * std::log(near)) / logDepthRange,
+			near,
+			far
+		};
+		parameters.projection = glm::vec4{
+			1.0f / projection[0][0],
+			1.0f / projection[1][1],
+			static_cast<float>(extent.width) / CLUSTER_COUNT_X,
+			static_cast<float>(extent.height) / CLUSTER_COUNT_Y
+		};
+		parameters.grid = glm::uvec4{ CLUSTER_COUNT_X, CLUSTER_COUNT_Y, CLUSTER_COUNT_Z, lightCount };
+
+		return parameters;
+	}
+
+	void ClusteredLighting::buildClusters(const std::vector<Light> &lights, const Parameters &parameters, std::uint32_t *clusterData) {
+		std::fill(clusterData, clusterData + CLUSTER_COUNT, 0u);
+
+		const float near = parameters.depth.z;
+		const float far = parameters.depth.w;
+
+		std::array<float, CLUSTER_COUNT_Z + 1> sliceDepths{};
+		for (std::uint32_t slice = 0; slice <= CLUSTER_COUNT_Z; ++slice) {
+			sliceDepths[slice] = near * std::pow(far / near, static_cast<float>(slice) / static_cast<float>(CLUSTER_COUNT_Z));
+		}
+
+		auto getSlice = [&parameters, near](float depth) {
+			const float slice = std::floor(std::log(std::max(depth, near)) * parameters.depth.x + parameters.depth.y);
+			return static_cast<std::int32_t>(std::clamp(slice, 0.0f, static_cast<float>(CLUSTER_COUNT_Z - 1)));
+		};
+
+		const glm::vec2 inverseProjection{ parameters.projection.x, parameters.projection.y };
+		const glm::vec2 grid{ static_cast<float>(CLUSTER_COUNT_X), static_cast<float>(CLUSTER_COUNT_Y) };
+		const std::uint32_t lightCount = std::min(parameters.grid.w, static_cast<std::uint32_t>(lights.size()));
+
+		for (std::uint32_t lightIndex = 0; lightIndex < lightCount; ++lightIndex) {
+			const glm::vec4 sphere = getBoundingSphere(lights[lightIndex]);
+			const glm::vec3 center{ parameters.view * glm::vec4{ glm::vec3{ sphere }, 1.0f } };
+			const float radius = sphere.w;
+
+			if (center.z + radius < near || center.z - radius > far) {
+				continue;
+			}
+
+			const std::int32_t firstSlice = std::max(getSlice(center.z - radius) - 1, 0);
+			const std::int32_t lastSlice = std::min(getSlice(center.z + radius) + 1, static_cast<std::int32_t>(CLUSTER_COUNT_Z) - 1);
+
+			for (std::int32_t slice = firstSlice; slice <= lastSlice; ++slice) {
+				const float sliceNear = sliceDepths[slice];
+				const float sliceFar = sliceDepths[slice + 1];
+
+				for (std::uint32_t y = 0; y < CLUSTER_COUNT_Y; ++y) {
+					for (std::uint32_t x = 0; x < CLUSTER_COUNT_X; ++x) {
+						const glm::vec2 ndcMin{ static_cast<float>(x) / grid.x * 2.0f - 1.0f, static_cast<float>(y) / grid.y * 2.0f - 1.0f };
+						const glm::vec2 ndcMax{ static_cast<float>(x + 1) / grid.x * 2.0f - 1.0f, static_cast<float>(y + 1) / grid.y * 2.0f - 1.0f };
+
+						const glm::vec3 boxMin{ glm::min(ndcMin * sliceNear, ndcMin * sliceFar) * inverseProjection, sliceNear };
+						const glm::vec3 boxMax{ glm::max(ndcMax * sliceNear, ndcMax * sliceFar) * inverseProjection, sliceFar };
+
+						const glm::vec3 offset = glm::clamp(center, boxMin, boxMax) - center;
+						if (glm::dot(offset, offset) > radius * radius) {
+							continue;
+						}
+
+						const std::uint32_t cluster = (static_cast<std::uint32_t>(slice) * CLUSTER_COUNT_Y + y) * CLUSTER_COUNT_X + x;
+						const std::uint32_t count = clusterData[cluster];
+						if (count < MAX_LIGHTS_PER_CLUSTER) {
+							clusterData[CLUSTER_COUNT + cluster * MAX_LIGHTS_PER_CLUSTER + count] = lightIndex;
+							clusterData[cluster] = count + 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	glm::vec4 ClusteredLighting::getBoundingSphere(const Light &light) {
+		if (light.type != LightType::Spot || light.outerCutoff <= 0.0f) {
+			return glm::vec4{ light.position, light.radius };
+		}
+
+		const float cosine = light.outerCutoff;
+		if (cosine < std::sqrt(0.5f)) {
+			const float sine = std::sqrt(std::max(1.0f - cosine * cosine, 0.0f));
+			return glm::vec4{ light.position + light.direction * light.radius * cosine, light.radius * sine };
+		}
+
+		const float radius = light.radius / (2.0f * cosine);
+		return glm::vec4{ light.position + light.direction * radius, radius };
+	}
+
+	void ClusteredLighting::createBuffers() {
+		VkPhysicalDeviceLimits limits = m_device.getPhysicalDeviceProperties().limits;
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+
+		m_lightSliceSize = (sizeof(Parameters) + sizeof(Light) * m_maxLights + alignment - 1) / alignment * alignment;
+
+		if (m_lightSliceSize > limits.maxStorageBufferRange || CLUSTER_DATA_SIZE > limits.maxStorageBufferRange) {
+			throw std::runtime_error("Clustered light buffers exceed the maximum storage buffer range.");
+		}
+
+		m_device.createBuffer(
+			m_lightSliceSize * m_frameCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			m_lightBuffer,
+			m_lightBufferMemory
+		);
+
+		vkMapMemory(m_device.getDevice(), m_lightBufferMemory, 0, m_lightSliceSize * m_frameCount, 0, &m_lightBufferMapped);
+
+		m_device.createBuffer(
+			CLUSTER_DATA_SIZE,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_clusterBuffer,
+			m_clusterBufferMemory
+		);
+
+		m_device.createBuffer(
+			CLUSTER_DATA_SIZE * m_frameCount,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			m_stagingBuffer,
+			m_stagingBufferMemory
+		);
+
+		vkMapMemory(m_device.getDevice(), m_stagingBufferMemory, 0, CLUSTER_DATA_SIZE * m_frameCount, 0, &m_stagingBufferMapped);
+	}
+
+	void ClusteredLighting::createDescriptorSetLayout() {
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+		for (std::uint32_t i = 0; i < bindings.size(); ++i) {
+			bindings[i].binding = i;
+			bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			bindings[i].descriptorCount = 1;
+			bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+			bindings[i].pImmutableSamplers = nullptr;
+		}
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create clustered lighting descriptor set layout.");
+		}
+	}
+
+	void ClusteredLighting::createDescriptorSets() {
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSize.descriptorCount = 2 * m_frameCount;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = m_frameCount;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create clustered lighting descriptor pool.");
+		}
+
+		std::vector<VkDescriptorSetLayout> layouts(m_frameCount, m_descriptorSetLayout);
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = m_frameCount;
+		descriptorSetAllocateInfo.pSetLayouts = layouts.data();
+
+		m_descriptorSets.resize(m_frameCount);
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, m_descriptorSets.data()) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate clustered lighting descriptor sets.");
+		}
+
+		for (std::uint32_t frame = 0; frame < m_frameCount; ++frame) {
+			std::array<VkDescriptorBufferInfo, 2> descriptorBufferInfos{};
+			descriptorBufferInfos[0] = { m_lightBuffer, m_lightSliceSize * frame, m_lightSliceSize };
+			descriptorBufferInfos[1] = { m_clusterBuffer, 0, CLUSTER_DATA_SIZE };
+
+			std::array<VkWriteDescriptorSet, 2> writeDescriptorSets{};
+			for (std::uint32_t i = 0; i < writeDescriptorSets.size(); ++i) {
+				writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				writeDescriptorSets[i].pNext = nullptr;
+				writeDescriptorSets[i].dstSet = m_descriptorSets[frame];
+				writeDescriptorSets[i].dstBinding = i;
+				writeDescriptorSets[i].dstArrayElement = 0;
+				writeDescriptorSets[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				writeDescriptorSets[i].descriptorCount = 1;
+				writeDescriptorSets[i].pBufferInfo = &descriptorBufferInfos[i];
+			}
+
+			vkUpdateDescriptorSets(m_device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+		}
+	}
+
+	void ClusteredLighting::createPipeline() {
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
+		pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create clustered lighting pipeline layout.");
+		}
+
+		m_binPipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/light_cluster.comp.spv", m_pipelineLayout);
+	}
+
+	void ClusteredLighting::bin(VkCommandBuffer commandBuffer, std::uint32_t frameIndex) {
+		m_binPipeline->bind(commandBuffer);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &m_descriptorSets[frameIndex], 0, nullptr);
+		vkCmdDispatch(commandBuffer, (CLUSTER_COUNT + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+	}
+
+	void ClusteredLighting::upload(VkCommandBuffer commandBuffer, std::uint32_t frameIndex) {
+		VkBufferCopy bufferCopy{};
+		bufferCopy.srcOffset = CLUSTER_DATA_SIZE * frameIndex;
+		bufferCopy.dstOffset = 0;
+		bufferCopy.size = CLUSTER_DATA_SIZE;
+		vkCmdCopyBuffer(commandBuffer, m_stagingBuffer, m_clusterBuffer, 1, &bufferCopy);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef CLUSTERED_LIGHTING_H
+#define CLUSTERED_LIGHTING_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include "Device.h"
+#include "Camera.h"
+#include "ComputePipeline.h"
+#include "RenderGraph.h"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class ClusteredLighting {
+	public:
+		static constexpr std::uint32_t CLUSTER_COUNT_X = 16;
+		static constexpr std::uint32_t CLUSTER_COUNT_Y = 9;
+		static constexpr std::uint32_t CLUSTER_COUNT_Z = 24;
+		static constexpr std::uint32_t CLUSTER_COUNT = CLUSTER_COUNT_X * CLUSTER_COUNT_Y * CLUSTER_COUNT_Z;
+		static constexpr std::uint32_t MAX_LIGHTS_PER_CLUSTER = 128;
+		static constexpr std::uint32_t CLUSTER_DATA_COUNT = CLUSTER_COUNT * (MAX_LIGHTS_PER_CLUSTER + 1);
+
+		enum class LightType : std::uint32_t {
+			Point,
+			Spot
+		};
+
+		struct Light {
+			glm::vec3 position{ 0.0f };
+			float radius = 1.0f;
+			glm::vec3 color{ 1.0f };
+			float intensity = 1.0f;
+			glm::vec3 direction{ 0.0f, 1.0f, 0.0f };
+			float outerCutoff = -1.0f;
+			float innerCutoff = -1.0f;
+			LightType type = LightType::Point;
+			std::uint32_t padding[2]{};
+
+			static Light createPointLight(const glm::vec3 &position, float radius, const glm::vec3 &color, float intensity);
+			static Light createSpotLight(const glm::vec3 &position, const glm::vec3 &direction, float radius, float outerAngle, float innerAngle, const glm::vec3 &color, float intensity);
+		};
+
+		struct Parameters {
+			glm::mat4 view{ 1.0f };
+			glm::vec4 depth{ 0.0f };
+			glm::vec4 projection{ 0.0f };
+			glm::uvec4 grid{ 0u };
+		};
+
+		ClusteredLighting(Device &device, std::uint32_t maxLights, std::uint32_t frameCount);
+		~ClusteredLighting();
+
+		ClusteredLighting(const ClusteredLighting &) = delete;
+		ClusteredLighting &operator=(const ClusteredLighting &) = delete;
+
+		void setGpuBinning(bool enabled);
+		bool isGpuBinningEnabled() const;
+
+		void addPasses(RenderGraph &graph, const std::vector<Light> &lights, const Camera &camera, VkExtent2D extent, std::uint32_t frameIndex);
+		RenderGraph::ResourceHandle getClusterBuffer() const;
+		std::vector<std::uint32_t> readClusters();
+
+		VkDescriptorSetLayout getDescriptorSetLayout() const;
+		VkDescriptorSet getDescriptorSet(std::uint32_t frameIndex) const;
+		std::uint32_t getLightCount() const;
+
+		static Parameters computeParameters(const Camera &camera, VkExtent2D extent, std::uint32_t lightCount);
+		static void buildClusters(const std::vector<Light> &lights, const Parameters &parameters, std::uint32_t *clusterData);
+		static glm::vec4 getBoundingSphere(const Light &light);
+	private:
+		void createBuffers();
+		void createDescriptorSetLayout();
+		void createDescriptorSets();
+		void createPipeline();
+
+		void bin(VkCommandBuffer commandBuffer, std::uint32_t frameIndex);
+		void upload(VkCommandBuffer commandBuffer, std::uint32_t frameIndex);
+
+		Device &m_device;
+		std::uint32_t m_maxLights;
+		std::uint32_t m_frameCount;
+		bool m_gpuBinning = true;
+
+		VkBuffer m_lightBuffer;
+		VkDeviceMemory m_lightBufferMemory;
+		void *m_lightBufferMapped = nullptr;
+		VkBuffer m_clusterBuffer;
+		VkDeviceMemory m_clusterBufferMemory;
+		VkBuffer m_stagingBuffer;
+		VkDeviceMemory m_stagingBufferMemory;
+		void *m_stagingBufferMapped = nullptr;
+
+		VkDeviceSize m_lightSliceSize = 0;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool;
+		std::vector<VkDescriptorSet> m_descriptorSets;
+		VkPipelineLayout m_pipelineLayout;
+		std::unique_ptr<ComputePipeline> m_binPipeline;
+
+		RenderGraph::ResourceHandle m_clusterResource = RenderGraph::INVALID_RESOURCE;
+		std::uint32_t m_lightCount = 0;
+
+		static constexpr std::uint32_t GROUP_SIZE = 64;
+		static constexpr VkDeviceSize CLUSTER_DATA_SIZE = sizeof(std::uint32_t) * CLUSTER_DATA_COUNT;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "ComputePipeline.h"
+
+namespace eng {
+	ComputePipeline::ComputePipeline(Device &device, const std::string &shaderPath, const VkPipelineLayout &layout)
+		: m_device(device) {
+		createPipeline(shaderPath, layout);
+	}
+
+	ComputePipeline::~ComputePipeline() {
+		vkDestroyPipeline(m_device.getDevice(), m_pipeline, VulkanAllocator::get(AllocationCategory::Pipeline));
+	}
+
+	void ComputePipeline::bind(VkCommandBuffer commandBuffer) {
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+	}
+
+	VkPipeline ComputePipeline::getPipeline() const {
+		return m_pipeline;
+	}
+
+	void ComputePipeline::createPipeline(const std::string &shaderPath, const VkPipelineLayout &layout) {
+		VkShaderModule shaderModule = createShaderModule(readFile(shaderPath));
+
+		VkPipelineShaderStageCreateInfo shaderStageCreateInfo{};
+		shaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		shaderStageCreateInfo.pNext = nullptr;
+		shaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		shaderStageCreateInfo.module = shaderModule;
+		shaderStageCreateInfo.pName = "main";
+
+		VkComputePipelineCreateInfo pipelineCreateInfo{};
+		pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineCreateInfo.pNext = nullptr;
+		pipelineCreateInfo.stage = shaderStageCreateInfo;
+		pipelineCreateInfo.layout = layout;
+		pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+		pipelineCreateInfo.basePipelineIndex = -1;
+
+		if (vkCreateComputePipelines(m_device.getDevice(), VK_NULL_HANDLE, 1, &pipelineCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipeline) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create compute pipeline.");
+		}
+
+		vkDestroyShaderModule(m_device.getDevice(), shaderModule, VulkanAllocator::get(AllocationCategory::Pipeline));
+	}
+
+	VkShaderModule ComputePipeline::createShaderModule(const std::vector<char> &shaderCode) {
+		VkShaderModuleCreateInfo shaderModuleCreateInfo{};
+		shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		shaderModuleCreateInfo.pNext = nullptr;
+		shaderModuleCreateInfo.codeSize = static_cast<std::uint32_t>(shaderCode.size());
+		shaderModuleCreateInfo.pCode = reinterpret_cast<const std::uint32_t *>(shaderCode.data());
+
+		VkShaderModule shaderModule;
+		if (vkCreateShaderModule(m_device.getDevice(), &shaderModuleCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &shaderModule) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create shader module.");
+		}
+
+		return shaderModule;
+	}
+
+	std::vector<char> ComputePipeline::readFile(const std::string &filename) {
+		std::ifstream file(filename, std::ios::ate | std::ios::binary);
+		if (!file.is_open()) {
+			throw std::runtime_error("Failed to open file.");
+		}
+
+		std::size_t size = static_cast<std::size_t>(file.tellg());
+		std::vector<char> buffer(size);
+
+		file.seekg(0);
+		file.read(buffer.data(), size);
+		file.close();
+
+		return buffer;
+	}
+}
\ No newline at end of file
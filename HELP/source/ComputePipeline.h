@@ -0,0 +1,37 @@
+#ifndef COMPUTE_PIPELINE_H
+#define COMPUTE_PIPELINE_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+namespace eng {
+	class ComputePipeline {
+	public:
+		ComputePipeline(Device &device, const std::string &shaderPath, const VkPipelineLayout &layout);
+		~ComputePipeline();
+
+		ComputePipeline(const ComputePipeline &) = delete;
+		ComputePipeline &operator=(const ComputePipeline &) = delete;
+
+		void bind(VkCommandBuffer commandBuffer);
+
+		VkPipeline getPipeline() const;
+	private:
+		void createPipeline(const std::string &shaderPath, const VkPipelineLayout &layout);
+
+		VkShaderModule createShaderModule(const std::vector<char> &shaderCode);
+		static std::vector<char> readFile(const std::string &filename);
+
+		VkPipeline m_pipeline;
+
+		Device &m_device;
+	};
+}
+
+#endif
\ No newline at end of file
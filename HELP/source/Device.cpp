@@ -19,27 +19,37 @@ namespace eng {
 	}
 
 	Device::Device(Window &window)
-		: m_window(window) {
+		: Device(window, DeviceSelector::getSelectionOverride()) {
+	}
+
+	Device::Device(Window &window, const std::string &selection)
+		: Device(window, selection, DeviceCapabilities::getEngineRequests()) {
+	}
+
+	Device::Device(Window &window, const std::string &selection, const std::vector<DeviceCapabilities::Request> &capabilityRequests)
+		: m_window(window), m_selection(selection), m_capabilityRequests(capabilityRequests), m_disabledCapabilities(DeviceCapabilities::getDisabledOverride()) {
 		createInstance();
 		createDebugMessenger();
 		createWindowSurface();
 		choosePhysicalDevice();
 		createLogicalDevice();
 		createCommandPool();
+		createMemoryBudget();
 	}
 
 	Device::~Device() {
-		vkDestroyCommandPool(m_device, m_commandPool, nullptr);
+		vkDestroyCommandPool(m_device, m_computeCommandPool, VulkanAllocator::get(AllocationCategory::Command));
+		vkDestroyCommandPool(m_device, m_commandPool, VulkanAllocator::get(AllocationCategory::Command));
 
-		vkDestroyDevice(m_device, nullptr);
+		vkDestroyDevice(m_device, VulkanAllocator::get(AllocationCategory::Device));
 
 		if (m_enableValidationLayers) {
-			destroyDebugUtilsMessengerEXT(m_instance, m_debugMessenger, nullptr);
+			destroyDebugUtilsMessengerEXT(m_instance, m_debugMessenger, VulkanAllocator::get(AllocationCategory::Instance));
 		}
 
-		vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+		vkDestroySurfaceKHR(m_instance, m_surface, VulkanAllocator::get(AllocationCategory::Swapchain));
 
-		vkDestroyInstance(m_instance, nullptr);
+		vkDestroyInstance(m_instance, VulkanAllocator::get(AllocationCategory::Instance));
 	}
 
 	void Device::createInstance() {
@@ -50,7 +60,7 @@ namespace eng {
 		VkApplicationInfo applicationInfo{};
 		applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
 		applicationInfo.pNext = nullptr;
-		applicationInfo.apiVersion = VK_API_VERSION_1_0;
+		applicationInfo.apiVersion = VK_API_VERSION_1_2;
 		applicationInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
 		applicationInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
 		applicationInfo.pApplicationName = "Vulkan Application";
@@ -75,7 +85,7 @@ namespace eng {
 			instanceCreateInfo.pNext = nullptr;
 		}
 
-		if (vkCreateInstance(&instanceCreateInfo, nullptr, &m_instance) != VK_SUCCESS) {
+		if (vkCreateInstance(&instanceCreateInfo, VulkanAllocator::get(AllocationCategory::Instance), &m_instance) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create instance.");
 		}
 
@@ -89,7 +99,7 @@ namespace eng {
 
 		VkDebugUtilsMessengerCreateInfoEXT debugUtilsMessengerCreateInfo = getDebugUtilsMessengerCreateInfo();
 
-		if (createDebugUtilsMessengerEXT(m_instance, &debugUtilsMessengerCreateInfo, nullptr, &m_debugMessenger) != VK_SUCCESS) {
+		if (createDebugUtilsMessengerEXT(m_instance, &debugUtilsMessengerCreateInfo, VulkanAllocator::get(AllocationCategory::Instance), &m_debugMessenger) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create debug messenger.");
 		}
 	}
@@ -104,27 +114,38 @@ namespace eng {
 			throw std::runtime_error("Failed to find a GPU with Vulkan support.");
 		}
 
-		for (const VkPhysicalDevice &physicalDevice : physicalDevices) {
-			if (isPhysicalDeviceSuitable(physicalDevice)) {
-				m_physicalDevice = physicalDevice;
-				break;
-			}
+		m_physicalDeviceInfos.clear();
+		for (std::uint32_t i = 0; i < physicalDevices.size(); ++i) {
+			m_physicalDeviceInfos.push_back(describePhysicalDevice(physicalDevices[i], i));
 		}
 
-		if (m_physicalDevice == VK_NULL_HANDLE) {
-			throw std::runtime_error("Failed to find a suitable GPU.");
-		}
+		std::uint32_t chosen = DeviceSelector::select(m_physicalDeviceInfos, m_selection);
+		m_physicalDevice = physicalDevices[chosen];
+		m_physicalDeviceIndex = chosen;
+
+		m_capabilities = std::make_unique<DeviceCapabilities>(m_physicalDevice);
+		m_capabilities->negotiate(m_capabilityRequests, m_disabledCapabilities);
 
+		DeviceSelector::printDevices(m_physicalDeviceInfos, chosen);
 		printChosenPhysicalDevice();
+		m_capabilities->printReport();
 	}
 
 	void Device::createLogicalDevice() {
 		QueueFamilyIndices queueFamilyIndices = findQueueFamilies(m_physicalDevice);
+		std::vector<VkQueueFamilyProperties> queueFamilies = getQueueFamilies(m_physicalDevice);
+
+		const std::uint32_t graphicsFamilyIndex = queueFamilyIndices.graphicsFamilyIndex.value();
+		const std::uint32_t computeFamilyIndex = queueFamilyIndices.computeFamilyIndex.value();
+		if (computeFamilyIndex == graphicsFamilyIndex && queueFamilies[graphicsFamilyIndex].queueCount > 1) {
+			m_computeQueueIndex = 1;
+		}
 
-		float queuePriorities = 1.0f;
+		float queuePriorities[] = { 1.0f, 1.0f };
 		std::set<std::uint32_t> uniqueQueueFamilies = {
-			queueFamilyIndices.graphicsFamilyIndex.value(),
-			queueFamilyIndices.presentFamilyIndex.value()
+			graphicsFamilyIndex,
+			queueFamilyIndices.presentFamilyIndex.value(),
+			computeFamilyIndex
 		};
 
 		std::vector<VkDeviceQueueCreateInfo> deviceQueueCreateInfos;
@@ -133,23 +154,26 @@ namespace eng {
 			VkDeviceQueueCreateInfo deviceQueueCreateInfo{};
 			deviceQueueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
 			deviceQueueCreateInfo.pNext = nullptr;
-			deviceQueueCreateInfo.pQueuePriorities = &queuePriorities;
-			deviceQueueCreateInfo.queueCount = 1;
+			deviceQueueCreateInfo.pQueuePriorities = queuePriorities;
+			deviceQueueCreateInfo.queueCount = uniqueQueueFamily == computeFamilyIndex ? m_computeQueueIndex + 1 : 1;
 			deviceQueueCreateInfo.queueFamilyIndex = uniqueQueueFamily;
 
 			deviceQueueCreateInfos.push_back(deviceQueueCreateInfo);
 		}
 
-		VkPhysicalDeviceFeatures deviceFeatures{};
+		DeviceCapabilities::FeatureChain enabledFeatures = m_capabilities->getEnabledFeatures();
+		enabledFeatures.link(m_capabilities->getApiVersion() >= VK_API_VERSION_1_2, m_capabilities->isEnabled(Capability::DynamicRendering), m_capabilities->isEnabled(Capability::PresentId), m_capabilities->isEnabled(Capability::PresentWait));
+
+		const std::vector<const char *> &enabledExtensions = m_capabilities->getEnabledExtensions();
 
 		VkDeviceCreateInfo deviceCreateInfo{};
 		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-		deviceCreateInfo.pNext = nullptr;
+		deviceCreateInfo.pNext = &enabledFeatures.features;
 		deviceCreateInfo.pQueueCreateInfos = deviceQueueCreateInfos.data();
 		deviceCreateInfo.queueCreateInfoCount = static_cast<std::uint32_t>(deviceQueueCreateInfos.size());
-		deviceCreateInfo.enabledExtensionCount = static_cast<std::uint32_t>(m_deviceExtensions.size());
-		deviceCreateInfo.ppEnabledExtensionNames = m_deviceExtensions.data();
-		deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
+		deviceCreateInfo.enabledExtensionCount = static_cast<std::uint32_t>(enabledExtensions.size());
+		deviceCreateInfo.ppEnabledExtensionNames = enabledExtensions.data();
+		deviceCreateInfo.pEnabledFeatures = nullptr;
 		if (m_enableValidationLayers) {
 			deviceCreateInfo.enabledLayerCount = static_cast<std::uint32_t>(m_validationLayers.size());
 			deviceCreateInfo.ppEnabledLayerNames = m_validationLayers.data();
@@ -158,12 +182,39 @@ namespace eng {
 			deviceCreateInfo.ppEnabledLayerNames = nullptr;
 		}
 
-		if (vkCreateDevice(m_physicalDevice, &deviceCreateInfo, nullptr, &m_device) != VK_SUCCESS) {
+		if (vkCreateDevice(m_physicalDevice, &deviceCreateInfo, VulkanAllocator::get(AllocationCategory::Device), &m_device) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create device.");
 		}
 
 		vkGetDeviceQueue(m_device, queueFamilyIndices.graphicsFamilyIndex.value(), 0, &m_graphicsQueue);
 		vkGetDeviceQueue(m_device, queueFamilyIndices.presentFamilyIndex.value(), 0, &m_presentQueue);
+		vkGetDeviceQueue(m_device, computeFamilyIndex, m_computeQueueIndex, &m_computeQueue);
+
+		m_queueFamilyIndices = queueFamilyIndices;
+		m_timestampPeriod = getPhysicalDeviceProperties().limits.timestampPeriod;
+		m_timestampsSupported = queueFamilies[graphicsFamilyIndex].timestampValidBits > 0 && queueFamilies[computeFamilyIndex].timestampValidBits > 0;
+
+		if (hasAsyncComputeQueue()) {
+			std::cout << "Async compute queue: family " << computeFamilyIndex << ", queue " << m_computeQueueIndex << '\n';
+		} else {
+			std::cout << "Async compute queue: shared with graphics" << '\n';
+		}
+
+		if (isDynamicRenderingEnabled()) {
+			m_cmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(m_device, "vkCmdBeginRenderingKHR"));
+			m_cmdEndRendering = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(m_device, "vkCmdEndRenderingKHR"));
+
+			if (m_cmdBeginRendering == nullptr || m_cmdEndRendering == nullptr) {
+				throw std::runtime_error("Failed to load dynamic rendering functions.");
+			}
+		}
+
+		if (m_capabilities->isEnabled(Capability::PresentId) && m_capabilities->isEnabled(Capability::PresentWait)) {
+			m_waitForPresent = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(m_device, "vkWaitForPresentKHR"));
+		}
+
+		std::cout << "Rendering path: " << (isDynamicRenderingEnabled() ? "dynamic rendering" : "render passes") << '\n';
+		std::cout << "Present wait: " << (isPresentWaitEnabled() ? "enabled" : "unavailable") << '\n';
 	}
 
 	void Device::createCommandPool() {
@@ -175,9 +226,19 @@ namespace eng {
 		commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 		commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamilyIndex.value();
 
-		if (vkCreateCommandPool(m_device, &commandPoolCreateInfo, nullptr, &m_commandPool) != VK_SUCCESS) {
+		if (vkCreateCommandPool(m_device, &commandPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Command), &m_commandPool) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create command pool.");
 		}
+
+		commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndices.computeFamilyIndex.value();
+
+		if (vkCreateCommandPool(m_device, &commandPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Command), &m_computeCommandPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create compute command pool.");
+		}
+	}
+
+	void Device::createMemoryBudget() {
+		m_memoryBudget = std::make_unique<MemoryBudget>(m_physicalDevice, m_capabilities->isEnabled(Capability::MemoryBudget));
 	}
 
 	std::vector<const char *> Device::getRequiredExtensions() {
@@ -301,6 +362,10 @@ namespace eng {
 		return m_surface;
 	}
 
+	VkPhysicalDevice Device::getPhysicalDevice() const {
+		return m_physicalDevice;
+	}
+
 	VkDevice Device::getDevice() const {
 		return m_device;
 	}
@@ -317,6 +382,62 @@ namespace eng {
 		return m_presentQueue;
 	}
 
+	VkQueue Device::getComputeQueue() const {
+		return m_computeQueue;
+	}
+
+	VkCommandPool Device::getComputeCommandPool() const {
+		return m_computeCommandPool;
+	}
+
+	const Device::QueueFamilyIndices &Device::getQueueFamilyIndices() const {
+		return m_queueFamilyIndices;
+	}
+
+	bool Device::hasAsyncComputeQueue() const {
+		return m_queueFamilyIndices.computeFamilyIndex != m_queueFamilyIndices.graphicsFamilyIndex || m_computeQueueIndex != 0;
+	}
+
+	bool Device::hasTimestamps() const {
+		return m_timestampsSupported;
+	}
+
+	float Device::getTimestampPeriod() const {
+		return m_timestampPeriod;
+	}
+
+	MemoryBudget &Device::getMemoryBudget() {
+		return *m_memoryBudget;
+	}
+
+	const DeviceCapabilities &Device::getCapabilities() const {
+		return *m_capabilities;
+	}
+
+	bool Device::isDynamicRenderingEnabled() const {
+		return m_capabilities->isEnabled(Capability::DynamicRendering);
+	}
+
+	bool Device::isMultiviewEnabled() const {
+		return m_capabilities->isEnabled(Capability::Multiview);
+	}
+
+	void Device::beginRendering(VkCommandBuffer commandBuffer, const VkRenderingInfoKHR &renderingInfo) {
+		m_cmdBeginRendering(commandBuffer, &renderingInfo);
+	}
+
+	void Device::endRendering(VkCommandBuffer commandBuffer) {
+		m_cmdEndRendering(commandBuffer);
+	}
+
+	bool Device::isPresentWaitEnabled() const {
+		return m_waitForPresent != nullptr;
+	}
+
+	VkResult Device::waitForPresent(VkSwapchainKHR swapchain, std::uint64_t presentId, std::uint64_t timeout) {
+		return m_waitForPresent(m_device, swapchain, presentId, timeout);
+	}
+
 	std::vector<VkPhysicalDevice> Device::getPhysicalDevices() {
 		std::uint32_t physicalDeviceCount = 0;
 		vkEnumeratePhysicalDevices(m_instance, &physicalDeviceCount, nullptr);
@@ -329,15 +450,57 @@ namespace eng {
 	bool Device::isPhysicalDeviceSuitable(const VkPhysicalDevice &physicalDevice) {
 		QueueFamilyIndices queueFamilyIndices = findQueueFamilies(physicalDevice);
 
-		bool extensionsSupported = checkPhysicalDeviceExtensionSupport(physicalDevice);
+		DeviceCapabilities capabilities{ physicalDevice };
+		bool capabilitiesSupported = capabilities.negotiate(m_capabilityRequests, m_disabledCapabilities);
 
 		bool swapchainSufficient = false;
-		if (extensionsSupported) {
+		if (capabilitiesSupported) {
 			SwapchainSupportDetails swapchainSupportDetails = querySwapchainSupport(physicalDevice);
 			swapchainSufficient = !swapchainSupportDetails.formats.empty() && !swapchainSupportDetails.presentModes.empty();
 		}
 
-		return queueFamilyIndices.isComplete() && extensionsSupported && swapchainSufficient;
+		return queueFamilyIndices.isComplete() && capabilitiesSupported && swapchainSufficient;
+	}
+
+	PhysicalDeviceInfo Device::describePhysicalDevice(const VkPhysicalDevice &physicalDevice, std::uint32_t index) {
+		VkPhysicalDeviceIDProperties physicalDeviceIdProperties{};
+		physicalDeviceIdProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+		physicalDeviceIdProperties.pNext = nullptr;
+
+		VkPhysicalDeviceProperties2 physicalDeviceProperties{};
+		physicalDeviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		physicalDeviceProperties.pNext = &physicalDeviceIdProperties;
+
+		vkGetPhysicalDeviceProperties2(physicalDevice, &physicalDeviceProperties);
+
+		VkPhysicalDeviceMemoryProperties memoryProperties;
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+		PhysicalDeviceInfo info{};
+		info.index = index;
+		info.name = physicalDeviceProperties.properties.deviceName;
+		info.type = physicalDeviceProperties.properties.deviceType;
+		std::copy(std::begin(physicalDeviceIdProperties.deviceUUID), std::end(physicalDeviceIdProperties.deviceUUID), info.uuid.begin());
+
+		for (std::uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+			if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+				info.deviceLocalMemory += memoryProperties.memoryHeaps[i].size;
+			}
+		}
+
+		info.suitable = isPhysicalDeviceSuitable(physicalDevice);
+		if (info.suitable) {
+			QueueFamilyIndices queueFamilyIndices = findQueueFamilies(physicalDevice);
+			std::vector<VkQueueFamilyProperties> queueFamilies = getQueueFamilies(physicalDevice);
+			DeviceCapabilities capabilities{ physicalDevice };
+
+			info.asyncCompute = queueFamilyIndices.computeFamilyIndex != queueFamilyIndices.graphicsFamilyIndex
+				|| queueFamilies[queueFamilyIndices.graphicsFamilyIndex.value()].queueCount > 1;
+			info.dynamicRendering = capabilities.isSupported(Capability::DynamicRendering);
+			info.memoryBudget = capabilities.isSupported(Capability::MemoryBudget);
+		}
+
+		return info;
 	}
 
 	void Device::printChosenPhysicalDevice() {
@@ -355,7 +518,7 @@ namespace eng {
 	}
 
 	bool Device::QueueFamilyIndices::isComplete() const {
-		return graphicsFamilyIndex.has_value() && presentFamilyIndex.has_value();
+		return graphicsFamilyIndex.has_value() && presentFamilyIndex.has_value() && computeFamilyIndex.has_value();
 	}
 
 	Device::QueueFamilyIndices Device::findQueueFamilies(const VkPhysicalDevice &physicalDevice) {
@@ -375,13 +538,24 @@ namespace eng {
 				queueFamilyIndices.presentFamilyIndex = i;
 			}
 
-			if (queueFamilyIndices.isComplete()) {
+			if (queueFamilyIndices.graphicsFamilyIndex.has_value() && queueFamilyIndices.presentFamilyIndex.has_value()) {
 				break;
 			}
 
 			++i;
 		}
 
+		for (std::uint32_t j = 0; j < static_cast<std::uint32_t>(queueFamilies.size()); ++j) {
+			if ((queueFamilies[j].queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queueFamilies[j].queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+				queueFamilyIndices.computeFamilyIndex = j;
+				break;
+			}
+		}
+
+		if (!queueFamilyIndices.computeFamilyIndex.has_value() && queueFamilyIndices.graphicsFamilyIndex.has_value()) {
+			queueFamilyIndices.computeFamilyIndex = queueFamilyIndices.graphicsFamilyIndex;
+		}
+
 		return queueFamilyIndices;
 	}
 
@@ -389,7 +563,7 @@ namespace eng {
 		return findQueueFamilies(m_physicalDevice);
 	}
 
-	void Device::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory) {
+	void Device::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory, MemoryCategory category, VkMemoryAllocateFlags allocateFlags) {
 		VkBufferCreateInfo bufferCreateInfo{};
 		bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 		bufferCreateInfo.pNext = nullptr;
@@ -397,22 +571,14 @@ namespace eng {
 		bufferCreateInfo.usage = usage;
 		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-		if (vkCreateBuffer(m_device, &bufferCreateInfo, nullptr, &buffer) != VK_SUCCESS) {
+		if (vkCreateBuffer(m_device, &bufferCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &buffer) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create vertex buffer.");
 		}
 
 		VkMemoryRequirements memoryRequirements;
 		vkGetBufferMemoryRequirements(m_device, buffer, &memoryRequirements);
 
-		VkMemoryAllocateInfo memoryAllocateInfo{};
-		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		memoryAllocateInfo.pNext = nullptr;
-		memoryAllocateInfo.allocationSize = memoryRequirements.size;
-		memoryAllocateInfo.memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, properties);
-
-		if (vkAllocateMemory(m_device, &memoryAllocateInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-			throw std::runtime_error("Failed to allocate vertex buffer memory.");
-		}
+		bufferMemory = allocateMemory(memoryRequirements, properties, category, allocateFlags);
 
 		vkBindBufferMemory(m_device, buffer, bufferMemory, 0);
 	}
@@ -430,33 +596,170 @@ namespace eng {
 		throw std::runtime_error("Failed to find suitable memory type.");
 	}
 
-	std::vector<VkQueueFamilyProperties> Device::getQueueFamilies(const VkPhysicalDevice &physicalDevice) {
-		std::uint32_t queueFamilyCount = 0;
-		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
-		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
-		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	void Device::createImage(const VkImageCreateInfo &imageCreateInfo, VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory, MemoryCategory category) {
+		if (vkCreateImage(m_device, &imageCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &image) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create image.");
+		}
 
-		return queueFamilies;
+		VkMemoryRequirements memoryRequirements;
+		vkGetImageMemoryRequirements(m_device, image, &memoryRequirements);
+
+		imageMemory = allocateMemory(memoryRequirements, properties, category);
+
+		vkBindImageMemory(m_device, image, imageMemory, 0);
 	}
 
-	bool Device::checkPhysicalDeviceExtensionSupport(const VkPhysicalDevice &physicalDevice) {
-		std::vector<VkExtensionProperties> availableExtensions = getAvailablePhysicalDeviceExtensions(physicalDevice);
+	void Device::freeMemory(VkDeviceMemory memory) {
+		if (memory == VK_NULL_HANDLE) {
+			return;
+		}
 
-		std::set<std::string> requiredExtensions(m_deviceExtensions.begin(), m_deviceExtensions.end());
+		m_memoryBudget->recordFree(memory);
+		vkFreeMemory(m_device, memory, VulkanAllocator::get(AllocationCategory::Resource));
+	}
 
-		for (const VkExtensionProperties& availableExtension : availableExtensions) {
-			requiredExtensions.erase(availableExtension.extensionName);
+	VkDeviceMemory Device::allocateMemory(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags properties, MemoryCategory category, VkMemoryAllocateFlags allocateFlags) {
+		VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{};
+		memoryAllocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+		memoryAllocateFlagsInfo.pNext = nullptr;
+		memoryAllocateFlagsInfo.flags = allocateFlags;
+		memoryAllocateFlagsInfo.deviceMask = 0;
+
+		VkMemoryAllocateInfo memoryAllocateInfo{};
+		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		memoryAllocateInfo.pNext = allocateFlags != 0 ? &memoryAllocateFlagsInfo : nullptr;
+		memoryAllocateInfo.allocationSize = memoryRequirements.size;
+		memoryAllocateInfo.memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, properties);
+
+		VkDeviceMemory memory;
+		if (vkAllocateMemory(m_device, &memoryAllocateInfo, VulkanAllocator::get(AllocationCategory::Resource), &memory) != VK_SUCCESS) {
+			m_memoryBudget->update();
+			m_memoryBudget->printUsage();
+
+			throw std::runtime_error(std::string("Failed to allocate ") + MemoryBudget::getCategoryName(category) + " memory.");
 		}
 
-		return requiredExtensions.empty();
+		m_memoryBudget->recordAllocation(memory, memoryAllocateInfo.memoryTypeIndex, memoryAllocateInfo.allocationSize, category);
+
+		return memory;
 	}
 
-	std::vector<VkExtensionProperties> Device::getAvailablePhysicalDeviceExtensions(const VkPhysicalDevice &physicalDevice) {
-		std::uint32_t availableExtensionCount = 0;
-		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &availableExtensionCount, nullptr);
-		std::vector<VkExtensionProperties> availableExtensions(availableExtensionCount);
-		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &availableExtensionCount, availableExtensions.data());
-		
-		return availableExtensions;
+	VkDeviceAddress Device::getBufferDeviceAddress(VkBuffer buffer) const {
+		VkBufferDeviceAddressInfo bufferDeviceAddressInfo{};
+		bufferDeviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+		bufferDeviceAddressInfo.pNext = nullptr;
+		bufferDeviceAddressInfo.buffer = buffer;
+
+		return vkGetBufferDeviceAddress(m_device, &bufferDeviceAddressInfo);
+	}
+
+	VkFormat Device::findSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling, VkFormatFeatureFlags features) {
+		for (VkFormat format : candidates) {
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(m_physicalDevice, format, &formatProperties);
+
+			if (tiling == VK_IMAGE_TILING_LINEAR && (formatProperties.linearTilingFeatures & features) == features) {
+				return format;
+			} else if (tiling == VK_IMAGE_TILING_OPTIMAL && (formatProperties.optimalTilingFeatures & features) == features) {
+				return format;
+			}
+		}
+
+		throw std::runtime_error("Failed to find supported format.");
+	}
+
+	VkCommandBuffer Device::beginSingleTimeCommands() {
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferAllocateInfo.pNext = nullptr;
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandPool = m_commandPool;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		if (vkAllocateCommandBuffers(m_device, &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate single time command buffer.");
+		}
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		commandBufferBeginInfo.pNext = nullptr;
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+
+		return commandBuffer;
+	}
+
+	void Device::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
+		vkEndCommandBuffer(commandBuffer);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.pNext = nullptr;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+
+		vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+		vkQueueWaitIdle(m_graphicsQueue);
+
+		vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
+	}
+
+	void Device::copyBufferToImage(VkBuffer buffer, VkImage image, std::uint32_t width, std::uint32_t height) {
+		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+
+		VkBufferImageCopy bufferImageCopy{};
+		bufferImageCopy.bufferOffset = 0;
+		bufferImageCopy.bufferRowLength = 0;
+		bufferImageCopy.bufferImageHeight = 0;
+		bufferImageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		bufferImageCopy.imageSubresource.mipLevel = 0;
+		bufferImageCopy.imageSubresource.baseArrayLayer = 0;
+		bufferImageCopy.imageSubresource.layerCount = 1;
+		bufferImageCopy.imageOffset = { 0, 0, 0 };
+		bufferImageCopy.imageExtent = { width, height, 1 };
+
+		vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferImageCopy);
+
+		endSingleTimeCommands(commandBuffer);
+	}
+
+	const std::vector<PhysicalDeviceInfo> &Device::getPhysicalDeviceInfos() const {
+		return m_physicalDeviceInfos;
+	}
+
+	std::uint32_t Device::getPhysicalDeviceIndex() const {
+		return m_physicalDeviceIndex;
+	}
+
+	VkPhysicalDeviceProperties Device::getPhysicalDeviceProperties() const {
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(m_physicalDevice, &physicalDeviceProperties);
+
+		return physicalDeviceProperties;
+	}
+
+	VkPhysicalDeviceDescriptorIndexingProperties Device::getDescriptorIndexingProperties() const {
+		VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties{};
+		descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+		descriptorIndexingProperties.pNext = nullptr;
+
+		VkPhysicalDeviceProperties2 physicalDeviceProperties{};
+		physicalDeviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		physicalDeviceProperties.pNext = &descriptorIndexingProperties;
+
+		vkGetPhysicalDeviceProperties2(m_physicalDevice, &physicalDeviceProperties);
+
+		return descriptorIndexingProperties;
+	}
+
+	std::vector<VkQueueFamilyProperties> Device::getQueueFamilies(const VkPhysicalDevice &physicalDevice) {
+		std::uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+		return queueFamilies;
 	}
 }
\ No newline at end of file
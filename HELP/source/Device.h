@@ -5,17 +5,28 @@
 #include <vulkan/vulkan.h>
 
 #include "Window.h"
+#include "VulkanAllocator.h"
+#include "MemoryBudget.h"
+#include "DeviceSelector.h"
+#include "DeviceCapabilities.h"
 
 #include <stdexcept>
 #include <iostream>
 #include <vector>
 #include <optional>
 #include <set>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
 
 namespace eng {
 	class Device {
 	public:
 		Device(Window& window);
+		Device(Window &window, const std::string &selection);
+		Device(Window &window, const std::string &selection, const std::vector<DeviceCapabilities::Request> &capabilityRequests);
 		~Device();
 
 		Device(const Device &) = delete;
@@ -35,6 +46,7 @@ namespace eng {
 		struct QueueFamilyIndices {
 			std::optional<std::uint32_t> graphicsFamilyIndex;
 			std::optional<std::uint32_t> presentFamilyIndex;
+			std::optional<std::uint32_t> computeFamilyIndex;
 
 			bool isComplete() const;
 		};
@@ -42,14 +54,43 @@ namespace eng {
 		QueueFamilyIndices findQueueFamilies(const VkPhysicalDevice &physicalDevice);
 		QueueFamilyIndices findQueueFamilies();
 		
-		void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory);
+		void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory, MemoryCategory category = MemoryCategory::Other, VkMemoryAllocateFlags allocateFlags = 0);
 		std::uint32_t findMemoryType(std::uint32_t typeFilter, VkMemoryPropertyFlags properties);
+		void createImage(const VkImageCreateInfo &imageCreateInfo, VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory, MemoryCategory category = MemoryCategory::Other);
+		VkDeviceMemory allocateMemory(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags properties, MemoryCategory category, VkMemoryAllocateFlags allocateFlags = 0);
+		void freeMemory(VkDeviceMemory memory);
+		VkFormat findSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
+		VkCommandBuffer beginSingleTimeCommands();
+		void endSingleTimeCommands(VkCommandBuffer commandBuffer);
+		VkDeviceAddress getBufferDeviceAddress(VkBuffer buffer) const;
+		void copyBufferToImage(VkBuffer buffer, VkImage image, std::uint32_t width, std::uint32_t height);
+
+		const std::vector<PhysicalDeviceInfo> &getPhysicalDeviceInfos() const;
+		std::uint32_t getPhysicalDeviceIndex() const;
+		VkPhysicalDeviceProperties getPhysicalDeviceProperties() const;
+		VkPhysicalDeviceDescriptorIndexingProperties getDescriptorIndexingProperties() const;
 
 		VkSurfaceKHR getSurface() const;
+		VkPhysicalDevice getPhysicalDevice() const;
 		VkDevice getDevice() const;
 		VkCommandPool getCommandPool() const;
 		VkQueue getGraphicsQueue() const;
 		VkQueue getPresentQueue() const;
+		VkQueue getComputeQueue() const;
+		VkCommandPool getComputeCommandPool() const;
+		const QueueFamilyIndices &getQueueFamilyIndices() const;
+		bool hasAsyncComputeQueue() const;
+		bool hasTimestamps() const;
+		float getTimestampPeriod() const;
+		MemoryBudget &getMemoryBudget();
+
+		const DeviceCapabilities &getCapabilities() const;
+		bool isDynamicRenderingEnabled() const;
+		bool isMultiviewEnabled() const;
+		void beginRendering(VkCommandBuffer commandBuffer, const VkRenderingInfoKHR &renderingInfo);
+		void endRendering(VkCommandBuffer commandBuffer);
+		bool isPresentWaitEnabled() const;
+		VkResult waitForPresent(VkSwapchainKHR swapchain, std::uint64_t presentId, std::uint64_t timeout);
 	private:
 		void createInstance();
 		void createDebugMessenger();
@@ -57,6 +98,7 @@ namespace eng {
 		void choosePhysicalDevice();
 		void createLogicalDevice();
 		void createCommandPool();
+		void createMemoryBudget();
 
 		std::vector<const char*> getRequiredExtensions();
 		std::vector<VkExtensionProperties> getAvailableExtensions();
@@ -73,26 +115,28 @@ namespace eng {
 
 		std::vector<VkPhysicalDevice> getPhysicalDevices();
 		bool isPhysicalDeviceSuitable(const VkPhysicalDevice& physicalDevice);
+		PhysicalDeviceInfo describePhysicalDevice(const VkPhysicalDevice &physicalDevice, std::uint32_t index);
 		void printChosenPhysicalDevice();
 		std::vector<VkQueueFamilyProperties> getQueueFamilies(const VkPhysicalDevice &physicalDevice);
-		bool checkPhysicalDeviceExtensionSupport(const VkPhysicalDevice &physicalDevice);
-		std::vector<VkExtensionProperties> getAvailablePhysicalDeviceExtensions(const VkPhysicalDevice &physicalDevice);
 
 		VkInstance m_instance;
 		VkDebugUtilsMessengerEXT m_debugMessenger;
 		VkSurfaceKHR m_surface;
 		VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+		std::vector<PhysicalDeviceInfo> m_physicalDeviceInfos;
+		std::uint32_t m_physicalDeviceIndex = 0;
 		VkDevice m_device;
 		VkCommandPool m_commandPool;
+		std::unique_ptr<MemoryBudget> m_memoryBudget;
+		std::unique_ptr<DeviceCapabilities> m_capabilities;
+		PFN_vkCmdBeginRenderingKHR m_cmdBeginRendering = nullptr;
+		PFN_vkCmdEndRenderingKHR m_cmdEndRendering = nullptr;
+		PFN_vkWaitForPresentKHR m_waitForPresent = nullptr;
 
 		const std::vector<const char *> m_validationLayers = {
 			"VK_LAYER_KHRONOS_validation"
 		};
 
-		const std::vector<const char *> m_deviceExtensions = {
-			VK_KHR_SWAPCHAIN_EXTENSION_NAME
-		};
-
 #ifdef NDEBUG
 		bool m_enableValidationLayers = false;
 #else
@@ -100,9 +144,18 @@ namespace eng {
 #endif
 
 		Window &m_window;
+		std::string m_selection;
+		std::vector<DeviceCapabilities::Request> m_capabilityRequests;
+		std::set<Capability> m_disabledCapabilities;
 
 		VkQueue m_graphicsQueue;
 		VkQueue m_presentQueue;
+		VkQueue m_computeQueue;
+		VkCommandPool m_computeCommandPool;
+		std::uint32_t m_computeQueueIndex = 0;
+		QueueFamilyIndices m_queueFamilyIndices{};
+		bool m_timestampsSupported = false;
+		float m_timestampPeriod = 1.0f;
 	};
 }
 
@@ -0,0 +1,353 @@
+#include "DeviceCapabilities.h"
+
+namespace eng {
+	DeviceCapabilities::FeatureChain::FeatureChain()
+		: features{}, vulkan11Features{}, vulkan12Features{}, dynamicRenderingFeatures{}, presentIdFeatures{}, presentWaitFeatures{} {
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features.pNext = nullptr;
+		vulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+		vulkan11Features.pNext = nullptr;
+		vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		vulkan12Features.pNext = nullptr;
+		dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+		dynamicRenderingFeatures.pNext = nullptr;
+		presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+		presentIdFeatures.pNext = nullptr;
+		presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+		presentWaitFeatures.pNext = nullptr;
+	}
+
+	void DeviceCapabilities::FeatureChain::link(bool vulkan12, bool dynamicRendering, bool presentId, bool presentWait) {
+		void *next = nullptr;
+
+		presentWaitFeatures.pNext = next;
+		if (presentWait) {
+			next = &presentWaitFeatures;
+		}
+
+		presentIdFeatures.pNext = next;
+		if (presentId) {
+			next = &presentIdFeatures;
+		}
+
+		dynamicRenderingFeatures.pNext = next;
+		if (dynamicRendering) {
+			next = &dynamicRenderingFeatures;
+		}
+
+		if (vulkan12) {
+			vulkan12Features.pNext = next;
+			vulkan11Features.pNext = &vulkan12Features;
+			next = &vulkan11Features;
+		}
+
+		features.pNext = next;
+	}
+
+	DeviceCapabilities::DeviceCapabilities(VkPhysicalDevice physicalDevice) {
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+		m_apiVersion = physicalDeviceProperties.apiVersion;
+
+		std::uint32_t availableExtensionCount = 0;
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &availableExtensionCount, nullptr);
+		std::vector<VkExtensionProperties> availableExtensions(availableExtensionCount);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &availableExtensionCount, availableExtensions.data());
+
+		for (const VkExtensionProperties &availableExtension : availableExtensions) {
+			m_availableExtensions.insert(availableExtension.extensionName);
+		}
+
+		const bool vulkan12 = m_apiVersion >= VK_API_VERSION_1_2;
+		const bool dynamicRendering = m_availableExtensions.count(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) != 0;
+		const bool presentId = m_availableExtensions.count(VK_KHR_PRESENT_ID_EXTENSION_NAME) != 0;
+		const bool presentWait = m_availableExtensions.count(VK_KHR_PRESENT_WAIT_EXTENSION_NAME) != 0;
+		m_supportedFeatures.link(vulkan12, dynamicRendering, presentId, presentWait);
+		vkGetPhysicalDeviceFeatures2(physicalDevice, &m_supportedFeatures.features);
+
+		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(Capability::Count); ++i) {
+			Capability capability = static_cast<Capability>(i);
+
+			FeatureChain required{};
+			selectFeatures(capability, required);
+
+			const char *extension = getExtension(capability);
+			m_supported[i] = (extension == nullptr || m_availableExtensions.count(extension) != 0) && containsFeatures(m_supportedFeatures, required);
+		}
+	}
+
+	bool DeviceCapabilities::negotiate(const std::vector<Request> &requests, const std::set<Capability> &disabled) {
+		m_requests = requests;
+		m_disabled = disabled;
+		m_missingRequirements.clear();
+		m_enabledExtensions.clear();
+		m_enabledFeatures = FeatureChain{};
+		std::fill(m_enabled.begin(), m_enabled.end(), false);
+
+		for (const Request &request : requests) {
+			const std::size_t index = static_cast<std::size_t>(request.capability);
+
+			if (!m_supported[index]) {
+				if (request.required) {
+					m_missingRequirements.push_back(request);
+				}
+				continue;
+			}
+
+			if (m_enabled[index] || (!request.required && disabled.count(request.capability) != 0)) {
+				continue;
+			}
+
+			m_enabled[index] = true;
+			selectFeatures(request.capability, m_enabledFeatures);
+
+			const char *extension = getExtension(request.capability);
+			if (extension != nullptr) {
+				m_enabledExtensions.push_back(extension);
+			}
+		}
+
+		return m_missingRequirements.empty();
+	}
+
+	bool DeviceCapabilities::isSupported(Capability capability) const {
+		return m_supported[static_cast<std::size_t>(capability)];
+	}
+
+	bool DeviceCapabilities::isEnabled(Capability capability) const {
+		return m_enabled[static_cast<std::size_t>(capability)];
+	}
+
+	const std::vector<DeviceCapabilities::Request> &DeviceCapabilities::getMissingRequirements() const {
+		return m_missingRequirements;
+	}
+
+	const std::vector<const char *> &DeviceCapabilities::getEnabledExtensions() const {
+		return m_enabledExtensions;
+	}
+
+	DeviceCapabilities::FeatureChain DeviceCapabilities::getEnabledFeatures() const {
+		return m_enabledFeatures;
+	}
+
+	std::uint32_t DeviceCapabilities::getApiVersion() const {
+		return m_apiVersion;
+	}
+
+	void DeviceCapabilities::printReport() const {
+		std::cout << "Device capabilities (Vulkan " << VK_VERSION_MAJOR(m_apiVersion) << '.' << VK_VERSION_MINOR(m_apiVersion) << '.' << VK_VERSION_PATCH(m_apiVersion) << "):\n";
+
+		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(Capability::Count); ++i) {
+			Capability capability = static_cast<Capability>(i);
+
+			bool required = false;
+			std::vector<std::string> subsystems;
+			for (const Request &request : m_requests) {
+				if (request.capability == capability) {
+					required = required || request.required;
+					subsystems.push_back(request.subsystem);
+				}
+			}
+
+			if (subsystems.empty()) {
+				continue;
+			}
+
+			std::string state = "unsupported";
+			if (isEnabled(capability)) {
+				state = "enabled";
+			} else if (isSupported(capability)) {
+				state = "disabled";
+			} else if (required) {
+				state = "missing";
+			}
+
+			std::cout << '\t' << getName(capability) << ": " << state << " (" << (required ? "required" : "optional") << ", ";
+			for (std::size_t j = 0; j < subsystems.size(); ++j) {
+				std::cout << (j == 0 ? "" : ", ") << subsystems[j];
+			}
+			std::cout << ")\n";
+		}
+	}
+
+	std::vector<DeviceCapabilities::Request> DeviceCapabilities::getEngineRequests() {
+		return {
+			{ Capability::Swapchain, true, "Swapchain" },
+			{ Capability::DescriptorIndexing, true, "BindlessResources" },
+			{ Capability::DynamicRendering, false, "RenderGraphExecutor" },
+			{ Capability::MemoryBudget, false, "MemoryBudget" },
+			{ Capability::SamplerAnisotropy, false, "Texture" },
+			{ Capability::SamplerAnisotropy, false, "TextureStreamer" },
+			{ Capability::TextureCompressionBC, false, "TextureStreamer" },
+			{ Capability::TextureCompressionASTC, false, "TextureStreamer" },
+			{ Capability::TimelineSemaphore, false, "Engine" },
+			{ Capability::BufferDeviceAddress, false, "GeometryPool" },
+			{ Capability::Storage8Bit, false, "Engine" },
+			{ Capability::Storage16Bit, false, "Engine" },
+			{ Capability::ShaderFloat16, false, "Engine" },
+			{ Capability::DrawIndirectCount, false, "Engine" },
+			{ Capability::MultiDrawIndirect, false, "Engine" },
+			{ Capability::Multiview, false, "ViewRenderer" },
+			{ Capability::PresentId, false, "Renderer" },
+			{ Capability::PresentWait, false, "Renderer" }
+		};
+	}
+
+	std::set<Capability> DeviceCapabilities::getDisabledOverride() {
+		std::set<Capability> disabled;
+
+		const char *forceRenderPass = std::getenv("HELP_FORCE_RENDER_PASS");
+		if (forceRenderPass != nullptr && std::string(forceRenderPass) != "0") {
+			disabled.insert(Capability::DynamicRendering);
+		}
+
+		const char *disabledCapabilities = std::getenv("HELP_DISABLE_CAPABILITIES");
+		if (disabledCapabilities == nullptr) {
+			return disabled;
+		}
+
+		std::stringstream stream{ disabledCapabilities };
+		std::string name;
+		while (std::getline(stream, name, ',')) {
+			for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(Capability::Count); ++i) {
+				if (name == getName(static_cast<Capability>(i))) {
+					disabled.insert(static_cast<Capability>(i));
+				}
+			}
+		}
+
+		return disabled;
+	}
+
+	const char *DeviceCapabilities::getName(Capability capability) {
+		switch (capability) {
+		case Capability::Swapchain:
+			return "swapchain";
+		case Capability::DescriptorIndexing:
+			return "descriptor_indexing";
+		case Capability::DynamicRendering:
+			return "dynamic_rendering";
+		case Capability::MemoryBudget:
+			return "memory_budget";
+		case Capability::TimelineSemaphore:
+			return "timeline_semaphore";
+		case Capability::BufferDeviceAddress:
+			return "buffer_device_address";
+		case Capability::Storage8Bit:
+			return "storage_8bit";
+		case Capability::Storage16Bit:
+			return "storage_16bit";
+		case Capability::ShaderFloat16:
+			return "shader_float16";
+		case Capability::DrawIndirectCount:
+			return "draw_indirect_count";
+		case Capability::MultiDrawIndirect:
+			return "multi_draw_indirect";
+		case Capability::SamplerAnisotropy:
+			return "sampler_anisotropy";
+		case Capability::TextureCompressionBC:
+			return "texture_compression_bc";
+		case Capability::TextureCompressionASTC:
+			return "texture_compression_astc";
+		case Capability::Multiview:
+			return "multiview";
+		case Capability::PresentId:
+			return "present_id";
+		case Capability::PresentWait:
+			return "present_wait";
+		default:
+			return "unknown";
+		}
+	}
+
+	const char *DeviceCapabilities::getExtension(Capability capability) {
+		switch (capability) {
+		case Capability::Swapchain:
+			return VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+		case Capability::DynamicRendering:
+			return VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME;
+		case Capability::MemoryBudget:
+			return VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+		case Capability::PresentId:
+			return VK_KHR_PRESENT_ID_EXTENSION_NAME;
+		case Capability::PresentWait:
+			return VK_KHR_PRESENT_WAIT_EXTENSION_NAME;
+		default:
+			return nullptr;
+		}
+	}
+
+	void DeviceCapabilities::selectFeatures(Capability capability, FeatureChain &chain) {
+		VkPhysicalDeviceFeatures &features = chain.features.features;
+		VkPhysicalDeviceVulkan11Features &vulkan11Features = chain.vulkan11Features;
+		VkPhysicalDeviceVulkan12Features &vulkan12Features = chain.vulkan12Features;
+
+		switch (capability) {
+		case Capability::DescriptorIndexing:
+			vulkan12Features.descriptorIndexing = VK_TRUE;
+			vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+			vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+			vulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+			vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+			break;
+		case Capability::DynamicRendering:
+			chain.dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+			break;
+		case Capability::TimelineSemaphore:
+			vulkan12Features.timelineSemaphore = VK_TRUE;
+			break;
+		case Capability::BufferDeviceAddress:
+			vulkan12Features.bufferDeviceAddress = VK_TRUE;
+			break;
+		case Capability::Storage8Bit:
+			vulkan12Features.storageBuffer8BitAccess = VK_TRUE;
+			vulkan12Features.shaderInt8 = VK_TRUE;
+			break;
+		case Capability::Storage16Bit:
+			vulkan11Features.storageBuffer16BitAccess = VK_TRUE;
+			features.shaderInt16 = VK_TRUE;
+			break;
+		case Capability::ShaderFloat16:
+			vulkan12Features.shaderFloat16 = VK_TRUE;
+			break;
+		case Capability::DrawIndirectCount:
+			vulkan12Features.drawIndirectCount = VK_TRUE;
+			break;
+		case Capability::MultiDrawIndirect:
+			features.multiDrawIndirect = VK_TRUE;
+			features.drawIndirectFirstInstance = VK_TRUE;
+			break;
+		case Capability::SamplerAnisotropy:
+			features.samplerAnisotropy = VK_TRUE;
+			break;
+		case Capability::TextureCompressionBC:
+			features.textureCompressionBC = VK_TRUE;
+			break;
+		case Capability::TextureCompressionASTC:
+			features.textureCompressionASTC_LDR = VK_TRUE;
+			break;
+		case Capability::Multiview:
+			vulkan11Features.multiview = VK_TRUE;
+			break;
+		case Capability::PresentId:
+			chain.presentIdFeatures.presentId = VK_TRUE;
+			break;
+		case Capability::PresentWait:
+			chain.presentWaitFeatures.presentWait = VK_TRUE;
+			break;
+		default:
+			break;
+		}
+	}
+
+	bool DeviceCapabilities::containsFeatures(const FeatureChain &supported, const FeatureChain &required) {
+		return containsFeatureBits(supported.features.features, required.features.features, 0)
+			&& containsFeatureBits(supported.vulkan11Features, required.vulkan11Features, offsetof(VkPhysicalDeviceVulkan11Features, storageBuffer16BitAccess))
+			&& containsFeatureBits(supported.vulkan12Features, required.vulkan12Features, offsetof(VkPhysicalDeviceVulkan12Features, samplerMirrorClampToEdge))
+			&& containsFeatureBits(supported.dynamicRenderingFeatures, required.dynamicRenderingFeatures, offsetof(VkPhysicalDeviceDynamicRenderingFeaturesKHR, dynamicRendering))
+			&& containsFeatureBits(supported.presentIdFeatures, required.presentIdFeatures, offsetof(VkPhysicalDevicePresentIdFeaturesKHR, presentId))
+			&& containsFeatureBits(supported.presentWaitFeatures, required.presentWaitFeatures, offsetof(VkPhysicalDevicePresentWaitFeaturesKHR, presentWait));
+	}
+}
\ No newline at end of file
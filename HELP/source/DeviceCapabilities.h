@@ -0,0 +1,108 @@
+#ifndef DEVICE_CAPABILITIES_H
+#define DEVICE_CAPABILITIES_H
+
+#include <vulkan/vulkan.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+namespace eng {
+	enum class Capability : std::uint32_t {
+		Swapchain,
+		DescriptorIndexing,
+		DynamicRendering,
+		MemoryBudget,
+		TimelineSemaphore,
+		BufferDeviceAddress,
+		Storage8Bit,
+		Storage16Bit,
+		ShaderFloat16,
+		DrawIndirectCount,
+		MultiDrawIndirect,
+		SamplerAnisotropy,
+		TextureCompressionBC,
+		TextureCompressionASTC,
+		Multiview,
+		PresentId,
+		PresentWait,
+		Count
+	};
+
+	class DeviceCapabilities {
+	public:
+		struct Request {
+			Capability capability;
+			bool required;
+			std::string subsystem;
+		};
+
+		struct FeatureChain {
+			VkPhysicalDeviceFeatures2 features;
+			VkPhysicalDeviceVulkan11Features vulkan11Features;
+			VkPhysicalDeviceVulkan12Features vulkan12Features;
+			VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures;
+			VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures;
+			VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures;
+
+			FeatureChain();
+
+			void link(bool vulkan12, bool dynamicRendering, bool presentId, bool presentWait);
+		};
+
+		DeviceCapabilities() = default;
+		DeviceCapabilities(VkPhysicalDevice physicalDevice);
+
+		bool negotiate(const std::vector<Request> &requests, const std::set<Capability> &disabled = {});
+
+		bool isSupported(Capability capability) const;
+		bool isEnabled(Capability capability) const;
+		const std::vector<Request> &getMissingRequirements() const;
+		const std::vector<const char *> &getEnabledExtensions() const;
+		FeatureChain getEnabledFeatures() const;
+		std::uint32_t getApiVersion() const;
+		void printReport() const;
+
+		static std::vector<Request> getEngineRequests();
+		static std::set<Capability> getDisabledOverride();
+		static const char *getName(Capability capability);
+		static const char *getExtension(Capability capability);
+	private:
+		static void selectFeatures(Capability capability, FeatureChain &chain);
+		static bool containsFeatures(const FeatureChain &supported, const FeatureChain &required);
+
+		template<typename T>
+		static bool containsFeatureBits(const T &supported, const T &required, std::size_t offset) {
+			const VkBool32 *supportedBits = reinterpret_cast<const VkBool32 *>(reinterpret_cast<const char *>(&supported) + offset);
+			const VkBool32 *requiredBits = reinterpret_cast<const VkBool32 *>(reinterpret_cast<const char *>(&required) + offset);
+
+			for (std::size_t i = 0; i < (sizeof(T) - offset) / sizeof(VkBool32); ++i) {
+				if (requiredBits[i] && !supportedBits[i]) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		std::uint32_t m_apiVersion = 0;
+		std::set<std::string> m_availableExtensions;
+		FeatureChain m_supportedFeatures;
+		FeatureChain m_enabledFeatures;
+		std::vector<const char *> m_enabledExtensions;
+
+		std::vector<Request> m_requests;
+		std::vector<Request> m_missingRequirements;
+		std::set<Capability> m_disabled;
+		std::vector<bool> m_supported = std::vector<bool>(static_cast<std::size_t>(Capability::Count), false);
+		std::vector<bool> m_enabled = std::vector<bool>(static_cast<std::size_t>(Capability::Count), false);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "DeviceSelector.h"
+
+namespace eng {
+	std::uint32_t DeviceSelector::select(const std::vector<PhysicalDeviceInfo> &devices, const std::string &selection) {
+		if (!selection.empty()) {
+			for (std::uint32_t i = 0; i < devices.size(); ++i) {
+				if (!matches(devices[i], selection)) {
+					continue;
+				}
+
+				if (!devices[i].suitable) {
+					throw std::runtime_error("Selected GPU " + devices[i].name + " is not suitable.");
+				}
+
+				return i;
+			}
+
+			throw std::runtime_error("No GPU matches the device selection " + selection + ".");
+		}
+
+		std::uint32_t chosen = static_cast<std::uint32_t>(devices.size());
+		std::int64_t bestScore = -1;
+		for (std::uint32_t i = 0; i < devices.size(); ++i) {
+			if (!devices[i].suitable) {
+				continue;
+			}
+
+			std::int64_t deviceScore = score(devices[i]);
+			if (deviceScore > bestScore) {
+				bestScore = deviceScore;
+				chosen = i;
+			}
+		}
+
+		if (chosen == devices.size()) {
+			throw std::runtime_error("Failed to find a suitable GPU.");
+		}
+
+		return chosen;
+	}
+
+	std::int64_t DeviceSelector::score(const PhysicalDeviceInfo &device) {
+		std::int64_t typeScore = 0;
+		switch (device.type) {
+		case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+			typeScore = 3;
+			break;
+		case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+			typeScore = 2;
+			break;
+		case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+			typeScore = 1;
+			break;
+		default:
+			typeScore = 0;
+			break;
+		}
+
+		const std::int64_t memoryMegabytes = std::min<std::int64_t>(static_cast<std::int64_t>(device.deviceLocalMemory >> 20), 999999);
+
+		std::int64_t featureScore = 0;
+		featureScore += device.asyncCompute ? 4 : 0;
+		featureScore += device.dynamicRendering ? 2 : 0;
+		featureScore += device.memoryBudget ? 1 : 0;
+
+		return typeScore * 1000000000ll + memoryMegabytes * 10 + featureScore;
+	}
+
+	bool DeviceSelector::matches(const PhysicalDeviceInfo &device, const std::string &selection) {
+		const std::string lowerSelection = toLower(selection);
+
+		if (lowerSelection.rfind("index:", 0) == 0) {
+			return lowerSelection.substr(6) == std::to_string(device.index);
+		}
+
+		if (lowerSelection.rfind("uuid:", 0) == 0) {
+			std::string uuid = lowerSelection.substr(5);
+			uuid.erase(std::remove(uuid.begin(), uuid.end(), '-'), uuid.end());
+
+			std::string deviceUuid = formatUuid(device.uuid);
+			deviceUuid.erase(std::remove(deviceUuid.begin(), deviceUuid.end(), '-'), deviceUuid.end());
+
+			return !uuid.empty() && deviceUuid.rfind(uuid, 0) == 0;
+		}
+
+		if (!lowerSelection.empty() && std::all_of(lowerSelection.begin(), lowerSelection.end(), [](unsigned char character) { return std::isdigit(character) != 0; })) {
+			return lowerSelection == std::to_string(device.index);
+		}
+
+		return toLower(device.name).find(lowerSelection) != std::string::npos;
+	}
+
+	std::string DeviceSelector::getSelectionOverride() {
+		const char *selection = std::getenv("HELP_DEVICE");
+		return selection != nullptr ? std::string(selection) : std::string();
+	}
+
+	std::string DeviceSelector::formatUuid(const std::array<std::uint8_t, VK_UUID_SIZE> &uuid) {
+		std::ostringstream stream;
+		stream << std::hex << std::setfill('0');
+
+		for (std::size_t i = 0; i < uuid.size(); ++i) {
+			if (i == 4 || i == 6 || i == 8 || i == 10) {
+				stream << '-';
+			}
+			stream << std::setw(2) << static_cast<std::uint32_t>(uuid[i]);
+		}
+
+		return stream.str();
+	}
+
+	const char *DeviceSelector::getTypeName(VkPhysicalDeviceType type) {
+		switch (type) {
+		case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+			return "discrete";
+		case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+			return "integrated";
+		case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+			return "virtual";
+		case VK_PHYSICAL_DEVICE_TYPE_CPU:
+			return "cpu";
+		default:
+			return "other";
+		}
+	}
+
+	void DeviceSelector::printDevices(const std::vector<PhysicalDeviceInfo> &devices, std::uint32_t chosen) {
+		for (std::uint32_t i = 0; i < devices.size(); ++i) {
+			const PhysicalDeviceInfo &device = devices[i];
+
+			std::cout << (i == chosen ? "* " : "  ") << device.index << ": " << device.name;
+			std::cout << " (" << getTypeName(device.type) << ", " << (device.deviceLocalMemory >> 20) << " MB";
+			std::cout << ", uuid " << formatUuid(device.uuid) << ")";
+			if (device.suitable) {
+				std::cout << " score " << score(device) << '\n';
+			} else {
+				std::cout << " unsuitable\n";
+			}
+		}
+	}
+
+	std::string DeviceSelector::toLower(const std::string &text) {
+		std::string lower = text;
+		std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char character) {
+			return static_cast<char>(std::tolower(character));
+		});
+
+		return lower;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef DEVICE_SELECTOR_H
+#define DEVICE_SELECTOR_H
+
+#include <vulkan/vulkan.h>
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace eng {
+	struct PhysicalDeviceInfo {
+		std::uint32_t index = 0;
+		std::string name;
+		VkPhysicalDeviceType type = VK_PHYSICAL_DEVICE_TYPE_OTHER;
+		std::array<std::uint8_t, VK_UUID_SIZE> uuid{};
+		VkDeviceSize deviceLocalMemory = 0;
+		bool suitable = false;
+		bool asyncCompute = false;
+		bool dynamicRendering = false;
+		bool memoryBudget = false;
+	};
+
+	class DeviceSelector {
+	public:
+		static std::uint32_t select(const std::vector<PhysicalDeviceInfo> &devices, const std::string &selection);
+		static std::int64_t score(const PhysicalDeviceInfo &device);
+		static bool matches(const PhysicalDeviceInfo &device, const std::string &selection);
+
+		static std::string getSelectionOverride();
+		static std::string formatUuid(const std::array<std::uint8_t, VK_UUID_SIZE> &uuid);
+		static const char *getTypeName(VkPhysicalDeviceType type);
+		static void printDevices(const std::vector<PhysicalDeviceInfo> &devices, std::uint32_t chosen);
+	private:
+		static std::string toLower(const std::string &text);
+	};
+}
+
+#endif
\ No newline at end of file
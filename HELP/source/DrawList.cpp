@@ -0,0 +1,174 @@
+#include "DrawList.h"
+
+namespace eng {
+	void DrawList::clear() {
+		m_packets.clear();
+		m_sortedDigitCount = 0;
+	}
+
+	void DrawList::reserve(std::size_t count) {
+		m_packets.reserve(count);
+		m_scratch.reserve(count);
+		m_entries.reserve(count);
+		m_entryScratch.reserve(count);
+	}
+
+	void DrawList::add(const RenderPacket &packet) {
+		m_packets.push_back(packet);
+	}
+
+	void DrawList::sort(std::size_t threadCount) {
+		m_sortedDigitCount = 0;
+
+		const std::size_t count = m_packets.size();
+		if (count < 2) {
+			return;
+		}
+
+		std::uint64_t varyingBits = 0;
+		for (const RenderPacket &packet : m_packets) {
+			varyingBits |= packet.sortKey ^ m_packets[0].sortKey;
+		}
+
+		threadCount = std::clamp<std::size_t>(threadCount, 1, std::max<std::size_t>(count / MIN_PACKETS_PER_THREAD, 1));
+		const std::size_t chunkSize = (count + threadCount - 1) / threadCount;
+
+		m_entries.resize(count);
+		m_entryScratch.resize(count);
+		m_histograms.resize(threadCount);
+
+		forEachChunk(threadCount, [&](std::size_t chunk) {
+			const std::size_t end = std::min(count, (chunk + 1) * chunkSize);
+			for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+				m_entries[i] = { m_packets[i].sortKey, static_cast<std::uint32_t>(i) };
+			}
+		});
+
+		for (std::uint32_t shift = 0; shift < 64; shift += DIGIT_BITS) {
+			if (((varyingBits >> shift) & (RADIX - 1)) == 0) {
+				continue;
+			}
+
+			forEachChunk(threadCount, [&](std::size_t chunk) {
+				std::array<std::size_t, RADIX> &histogram = m_histograms[chunk];
+				histogram.fill(0);
+
+				const std::size_t end = std::min(count, (chunk + 1) * chunkSize);
+				for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+					++histogram[(m_entries[i].key >> shift) & (RADIX - 1)];
+				}
+			});
+
+			std::size_t offset = 0;
+			for (std::uint32_t digit = 0; digit < RADIX; ++digit) {
+				for (std::size_t chunk = 0; chunk < threadCount; ++chunk) {
+					std::size_t digitCount = m_histograms[chunk][digit];
+					m_histograms[chunk][digit] = offset;
+					offset += digitCount;
+				}
+			}
+
+			forEachChunk(threadCount, [&](std::size_t chunk) {
+				std::array<std::size_t, RADIX> &offsets = m_histograms[chunk];
+
+				const std::size_t end = std::min(count, (chunk + 1) * chunkSize);
+				for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+					m_entryScratch[offsets[(m_entries[i].key >> shift) & (RADIX - 1)]++] = m_entries[i];
+				}
+			});
+
+			std::swap(m_entries, m_entryScratch);
+			++m_sortedDigitCount;
+		}
+
+		m_scratch.resize(count);
+		forEachChunk(threadCount, [&](std::size_t chunk) {
+			const std::size_t end = std::min(count, (chunk + 1) * chunkSize);
+			for (std::size_t i = chunk * chunkSize; i < end; ++i) {
+				m_scratch[i] = m_packets[m_entries[i].index];
+			}
+		});
+
+		std::swap(m_packets, m_scratch);
+	}
+
+	std::size_t DrawList::size() const {
+		return m_packets.size();
+	}
+
+	bool DrawList::empty() const {
+		return m_packets.empty();
+	}
+
+	const std::vector<RenderPacket> &DrawList::getPackets() const {
+		return m_packets;
+	}
+
+	std::uint32_t DrawList::getSortedDigitCount() const {
+		return m_sortedDigitCount;
+	}
+
+	std::uint64_t DrawList::encodeKey(std::uint32_t pass, std::uint32_t pipeline, std::uint32_t material, std::uint32_t model, std::uint32_t depth) {
+		auto field = [](std::uint32_t value, std::uint32_t shift, std::uint32_t bits) {
+			return (static_cast<std::uint64_t>(value) & ((1ull << bits) - 1)) << shift;
+		};
+
+		return field(pass, PASS_SHIFT, PASS_BITS)
+			| field(pipeline, PIPELINE_SHIFT, PIPELINE_BITS)
+			| field(material, MATERIAL_SHIFT, MATERIAL_BITS)
+			| field(model, MODEL_SHIFT, MODEL_BITS)
+			| field(depth, DEPTH_SHIFT, DEPTH_BITS);
+	}
+
+	std::uint32_t DrawList::getPass(std::uint64_t key) {
+		return getField(key, PASS_SHIFT, PASS_BITS);
+	}
+
+	std::uint32_t DrawList::getPipeline(std::uint64_t key) {
+		return getField(key, PIPELINE_SHIFT, PIPELINE_BITS);
+	}
+
+	std::uint32_t DrawList::getMaterial(std::uint64_t key) {
+		return getField(key, MATERIAL_SHIFT, MATERIAL_BITS);
+	}
+
+	std::uint32_t DrawList::getModel(std::uint64_t key) {
+		return getField(key, MODEL_SHIFT, MODEL_BITS);
+	}
+
+	std::uint32_t DrawList::getDepth(std::uint64_t key) {
+		return getField(key, DEPTH_SHIFT, DEPTH_BITS);
+	}
+
+	std::uint32_t DrawList::quantizeDepth(float depth, float maxDepth) {
+		const float maxValue = static_cast<float>((1u << DEPTH_BITS) - 1);
+		if (maxDepth <= 0.0f) {
+			return 0;
+		}
+
+		return static_cast<std::uint32_t>(std::clamp(depth / maxDepth, 0.0f, 1.0f) * maxValue);
+	}
+
+	void DrawList::forEachChunk(std::size_t threadCount, const std::function<void(std::size_t)> &work) {
+		if (threadCount <= 1) {
+			work(0);
+			return;
+		}
+
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount - 1);
+		for (std::size_t i = 1; i < threadCount; ++i) {
+			threads.emplace_back(work, i);
+		}
+
+		work(0);
+
+		for (std::thread &thread : threads) {
+			thread.join();
+		}
+	}
+
+	std::uint32_t DrawList::getField(std::uint64_t key, std::uint32_t shift, std::uint32_t bits) {
+		return static_cast<std::uint32_t>((key >> shift) & ((1ull << bits) - 1));
+	}
+}
\ No newline at end of file
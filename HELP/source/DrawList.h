@@ -0,0 +1,75 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <vector>
+#include <array>
+#include <thread>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+namespace eng {
+	struct RenderPacket {
+		std::uint64_t sortKey = 0;
+		std::uint32_t model = 0;
+		std::uint32_t transformIndex = 0;
+		std::uint32_t material = 0;
+		std::uint32_t lod = 0;
+	};
+
+	class DrawList {
+	public:
+		void clear();
+		void reserve(std::size_t count);
+		void add(const RenderPacket &packet);
+		void sort(std::size_t threadCount = 1);
+
+		std::size_t size() const;
+		bool empty() const;
+		const std::vector<RenderPacket> &getPackets() const;
+		std::uint32_t getSortedDigitCount() const;
+
+		static std::uint64_t encodeKey(std::uint32_t pass, std::uint32_t pipeline, std::uint32_t material, std::uint32_t model, std::uint32_t depth);
+		static std::uint32_t getPass(std::uint64_t key);
+		static std::uint32_t getPipeline(std::uint64_t key);
+		static std::uint32_t getMaterial(std::uint64_t key);
+		static std::uint32_t getModel(std::uint64_t key);
+		static std::uint32_t getDepth(std::uint64_t key);
+		static std::uint32_t quantizeDepth(float depth, float maxDepth);
+
+		static constexpr std::uint32_t DEPTH_BITS = 16;
+		static constexpr std::uint32_t MODEL_BITS = 16;
+		static constexpr std::uint32_t MATERIAL_BITS = 20;
+		static constexpr std::uint32_t PIPELINE_BITS = 8;
+		static constexpr std::uint32_t PASS_BITS = 4;
+	private:
+		static constexpr std::uint32_t DIGIT_BITS = 11;
+		static constexpr std::uint32_t RADIX = 1 << DIGIT_BITS;
+		static constexpr std::size_t MIN_PACKETS_PER_THREAD = 16384;
+
+		struct SortEntry {
+			std::uint64_t key;
+			std::uint32_t index;
+		};
+
+		static void forEachChunk(std::size_t threadCount, const std::function<void(std::size_t)> &work);
+		static std::uint32_t getField(std::uint64_t key, std::uint32_t shift, std::uint32_t bits);
+
+		std::vector<RenderPacket> m_packets;
+		std::vector<RenderPacket> m_scratch;
+		std::vector<SortEntry> m_entries;
+		std::vector<SortEntry> m_entryScratch;
+		std::vector<std::array<std::size_t, RADIX>> m_histograms;
+		std::uint32_t m_sortedDigitCount = 0;
+
+		static constexpr std::uint32_t DEPTH_SHIFT = 0;
+		static constexpr std::uint32_t MODEL_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+		static constexpr std::uint32_t MATERIAL_SHIFT = MODEL_SHIFT + MODEL_BITS;
+		static constexpr std::uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+		static constexpr std::uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "DrawRecorder.h"
+
+namespace eng {
+	DrawRecorder::DrawRecorder(VkCommandBuffer commandBuffer)
+		: m_commandBuffer(commandBuffer) {
+	}
+
+	void DrawRecorder::bindPipeline(VkPipeline pipeline) {
+		if (pipeline == m_pipeline) {
+			++m_statistics.skippedPipelineBinds;
+			return;
+		}
+
+		vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		m_pipeline = pipeline;
+		++m_statistics.pipelineBinds;
+	}
+
+	void DrawRecorder::bindDescriptorSets(VkPipelineLayout layout, std::uint32_t firstSet, std::uint32_t descriptorSetCount, const VkDescriptorSet *descriptorSets) {
+		if (firstSet + descriptorSetCount > MAX_DESCRIPTOR_SETS) {
+			throw std::runtime_error("Failed to bind descriptor sets, set index exceeds the recorder limit.");
+		}
+
+		setLayout(layout);
+
+		if (std::equal(descriptorSets, descriptorSets + descriptorSetCount, m_descriptorSets.begin() + firstSet)) {
+			++m_statistics.skippedDescriptorSetBinds;
+			return;
+		}
+
+		vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, firstSet, descriptorSetCount, descriptorSets, 0, nullptr);
+		std::copy(descriptorSets, descriptorSets + descriptorSetCount, m_descriptorSets.begin() + firstSet);
+		++m_statistics.descriptorSetBinds;
+	}
+
+	void DrawRecorder::bindVertexBuffer(VkBuffer buffer, VkDeviceSize offset) {
+		if (buffer == m_vertexBuffer && offset == m_vertexBufferOffset) {
+			++m_statistics.skippedVertexBufferBinds;
+			return;
+		}
+
+		vkCmdBindVertexBuffers(m_commandBuffer, 0, 1, &buffer, &offset);
+		m_vertexBuffer = buffer;
+		m_vertexBufferOffset = offset;
+		++m_statistics.vertexBufferBinds;
+	}
+
+	void DrawRecorder::bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType) {
+		if (buffer == m_indexBuffer && offset == m_indexBufferOffset && indexType == m_indexType) {
+			++m_statistics.skippedIndexBufferBinds;
+			return;
+		}
+
+		vkCmdBindIndexBuffer(m_commandBuffer, buffer, offset, indexType);
+		m_indexBuffer = buffer;
+		m_indexBufferOffset = offset;
+		m_indexType = indexType;
+		++m_statistics.indexBufferBinds;
+	}
+
+	void DrawRecorder::pushConstants(VkPipelineLayout layout, VkShaderStageFlags stages, std::uint32_t offset, std::uint32_t size, const void *data) {
+		if (offset + size > MAX_PUSH_CONSTANT_SIZE) {
+			throw std::runtime_error("Failed to push constants, range exceeds the recorder limit.");
+		}
+
+		setLayout(layout);
+
+		if (stages == m_pushConstantStages && offset >= m_pushConstantBegin && offset + size <= m_pushConstantEnd
+			&& std::memcmp(m_pushConstants.data() + offset, data, size) == 0) {
+			++m_statistics.skippedPushConstantUpdates;
+			return;
+		}
+
+		vkCmdPushConstants(m_commandBuffer, layout, stages, offset, size, data);
+		std::memcpy(m_pushConstants.data() + offset, data, size);
+
+		if (stages != m_pushConstantStages || m_pushConstantBegin == m_pushConstantEnd) {
+			m_pushConstantStages = stages;
+			m_pushConstantBegin = offset;
+			m_pushConstantEnd = offset + size;
+		} else {
+			m_pushConstantBegin = std::min(m_pushConstantBegin, offset);
+			m_pushConstantEnd = std::max(m_pushConstantEnd, offset + size);
+		}
+		++m_statistics.pushConstantUpdates;
+	}
+
+	void DrawRecorder::drawIndexed(std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) {
+		vkCmdDrawIndexed(m_commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+		++m_statistics.draws;
+	}
+
+	void DrawRecorder::invalidate() {
+		m_pipeline = VK_NULL_HANDLE;
+		m_layout = VK_NULL_HANDLE;
+		m_descriptorSets.fill(VK_NULL_HANDLE);
+		m_vertexBuffer = VK_NULL_HANDLE;
+		m_vertexBufferOffset = 0;
+		m_indexBuffer = VK_NULL_HANDLE;
+		m_indexBufferOffset = 0;
+		m_indexType = VK_INDEX_TYPE_UINT32;
+		m_pushConstantBegin = 0;
+		m_pushConstantEnd = 0;
+		m_pushConstantStages = 0;
+	}
+
+	VkCommandBuffer DrawRecorder::getCommandBuffer() const {
+		return m_commandBuffer;
+	}
+
+	const DrawRecorder::Statistics &DrawRecorder::getStatistics() const {
+		return m_statistics;
+	}
+
+	void DrawRecorder::setLayout(VkPipelineLayout layout) {
+		if (layout == m_layout) {
+			return;
+		}
+
+		m_layout = layout;
+		m_descriptorSets.fill(VK_NULL_HANDLE);
+		m_pushConstantBegin = 0;
+		m_pushConstantEnd = 0;
+		m_pushConstantStages = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef DRAW_RECORDER_H
+#define DRAW_RECORDER_H
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class DrawRecorder {
+	public:
+		struct Statistics {
+			std::uint64_t pipelineBinds = 0;
+			std::uint64_t skippedPipelineBinds = 0;
+			std::uint64_t descriptorSetBinds = 0;
+			std::uint64_t skippedDescriptorSetBinds = 0;
+			std::uint64_t vertexBufferBinds = 0;
+			std::uint64_t skippedVertexBufferBinds = 0;
+			std::uint64_t indexBufferBinds = 0;
+			std::uint64_t skippedIndexBufferBinds = 0;
+			std::uint64_t pushConstantUpdates = 0;
+			std::uint64_t skippedPushConstantUpdates = 0;
+			std::uint64_t draws = 0;
+		};
+
+		explicit DrawRecorder(VkCommandBuffer commandBuffer);
+
+		void bindPipeline(VkPipeline pipeline);
+		void bindDescriptorSets(VkPipelineLayout layout, std::uint32_t firstSet, std::uint32_t descriptorSetCount, const VkDescriptorSet *descriptorSets);
+		void bindVertexBuffer(VkBuffer buffer, VkDeviceSize offset);
+		void bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+		void pushConstants(VkPipelineLayout layout, VkShaderStageFlags stages, std::uint32_t offset, std::uint32_t size, const void *data);
+		void drawIndexed(std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance);
+
+		void invalidate();
+
+		VkCommandBuffer getCommandBuffer() const;
+		const Statistics &getStatistics() const;
+
+		static constexpr std::uint32_t MAX_DESCRIPTOR_SETS = 8;
+		static constexpr std::uint32_t MAX_PUSH_CONSTANT_SIZE = 256;
+	private:
+		void setLayout(VkPipelineLayout layout);
+
+		VkCommandBuffer m_commandBuffer;
+		Statistics m_statistics{};
+
+		VkPipeline m_pipeline = VK_NULL_HANDLE;
+		VkPipelineLayout m_layout = VK_NULL_HANDLE;
+		std::array<VkDescriptorSet, MAX_DESCRIPTOR_SETS> m_descriptorSets{};
+		VkBuffer m_vertexBuffer = VK_NULL_HANDLE;
+		VkDeviceSize m_vertexBufferOffset = 0;
+		VkBuffer m_indexBuffer = VK_NULL_HANDLE;
+		VkDeviceSize m_indexBufferOffset = 0;
+		VkIndexType m_indexType = VK_INDEX_TYPE_UINT32;
+
+		std::array<std::uint8_t, MAX_PUSH_CONSTANT_SIZE> m_pushConstants{};
+		std::uint32_t m_pushConstantBegin = 0;
+		std::uint32_t m_pushConstantEnd = 0;
+		VkShaderStageFlags m_pushConstantStages = 0;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include "DynamicResolution.h"
+#include "VulkanAllocator.h"
+
+namespace eng {
+	DynamicResolution::DynamicResolution(Device &device, Swapchain &swapchain, const ResolutionController::Settings &settings, std::uint32_t frameCount) : m_device(device), m_swapchain(swapchain), m_controller(settings), m_frameCount(frameCount) {
+		m_frameScales.resize(m_frameCount, m_controller.getScale());
+		m_queriesPending.resize(m_frameCount, false);
+
+		createQueryPool();
+		createDescriptorSet();
+		createPipeline();
+		createSceneTarget(m_swapchain.getExtent());
+	}
+
+	DynamicResolution::~DynamicResolution() {
+		m_pipeline.reset();
+		m_sceneTarget.reset();
+
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		if (m_queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(m_device.getDevice(), m_queryPool, VulkanAllocator::get(AllocationCategory::Query));
+		}
+	}
+
+	void DynamicResolution::beginFrame(VkCommandBuffer commandBuffer, std::uint32_t frameIndex) {
+		if (m_queryPool == VK_NULL_HANDLE) {
+			return;
+		}
+
+		if (m_queriesPending[frameIndex]) {
+			std::uint64_t timestamps[2];
+			if (vkGetQueryPoolResults(m_device.getDevice(), m_queryPool, frameIndex * 2, 2, sizeof(timestamps), timestamps, sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+				m_gpuFrameTime = static_cast<float>(static_cast<double>(timestamps[1] - timestamps[0]) * m_device.getTimestampPeriod() / 1000000.0);
+				m_controller.update(m_gpuFrameTime, m_frameScales[frameIndex]);
+			}
+
+			m_queriesPending[frameIndex] = false;
+		}
+
+		vkCmdResetQueryPool(commandBuffer, m_queryPool, frameIndex * 2, 2);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, frameIndex * 2);
+	}
+
+	void DynamicResolution::endFrame(VkCommandBuffer commandBuffer, std::uint32_t frameIndex) {
+		if (m_queryPool == VK_NULL_HANDLE) {
+			return;
+		}
+
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, frameIndex * 2 + 1);
+
+		m_frameScales[frameIndex] = static_cast<float>(m_renderExtent.width) / static_cast<float>(std::max(m_outputExtent.width, 1u));
+		m_queriesPending[frameIndex] = true;
+	}
+
+	RenderGraph::ResourceHandle DynamicResolution::importSceneImage(RenderGraph &graph, VkExtent2D outputExtent) {
+		if (outputExtent.width != m_outputExtent.width || outputExtent.height != m_outputExtent.height) {
+			vkDeviceWaitIdle(m_device.getDevice());
+			createSceneTarget(outputExtent);
+		}
+
+		m_renderExtent = computeRenderExtent(m_outputExtent, m_controller.getScale());
+
+		return m_sceneTarget->import(graph, "scene color");
+	}
+
+	void DynamicResolution::addUpscalePass(RenderGraph &graph, RenderGraph::ResourceHandle sceneImage, RenderGraph::ResourceHandle outputImage) {
+		graph.addPass("upscale", RenderGraph::PassType::Graphics)
+			.read(sceneImage, RenderGraph::Access::Sampled)
+			.write(outputImage, RenderGraph::Access::ColorAttachment)
+			.setExecute([this](VkCommandBuffer commandBuffer) {
+				upscale(commandBuffer);
+			});
+	}
+
+	void DynamicResolution::setViewport(VkCommandBuffer commandBuffer) const {
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = static_cast<float>(m_renderExtent.width);
+		viewport.height = static_cast<float>(m_renderExtent.height);
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = m_renderExtent;
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+	}
+
+	VkExtent2D DynamicResolution::getRenderExtent() const {
+		return m_renderExtent;
+	}
+
+	VkExtent2D DynamicResolution::getOutputExtent() const {
+		return m_outputExtent;
+	}
+
+	float DynamicResolution::getGpuFrameTime() const {
+		return m_gpuFrameTime;
+	}
+
+	ResolutionController &DynamicResolution::getController() {
+		return m_controller;
+	}
+
+	const ResolutionController &DynamicResolution::getController() const {
+		return m_controller;
+	}
+
+	VkExtent2D DynamicResolution::computeRenderExtent(VkExtent2D outputExtent, float scale) {
+		auto scaleDimension = [scale](std::uint32_t dimension) {
+			const std::uint32_t scaled = static_cast<std::uint32_t>(std::lround(dimension * scale / EXTENT_ALIGNMENT)) * EXTENT_ALIGNMENT;
+			return std::clamp(scaled, std::min(EXTENT_ALIGNMENT, dimension), dimension);
+		};
+
+		return { scaleDimension(outputExtent.width), scaleDimension(outputExtent.height) };
+	}
+
+	void DynamicResolution::createQueryPool() {
+		if (!m_device.hasTimestamps()) {
+			return;
+		}
+
+		VkQueryPoolCreateInfo queryPoolCreateInfo{};
+		queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolCreateInfo.pNext = nullptr;
+		queryPoolCreateInfo.flags = 0;
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCreateInfo.queryCount = 2 * m_frameCount;
+
+		if (vkCreateQueryPool(m_device.getDevice(), &queryPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Query), &m_queryPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create dynamic resolution query pool.");
+		}
+	}
+
+	void DynamicResolution::createDescriptorSet() {
+		VkDescriptorSetLayoutBinding binding{};
+		binding.binding = 0;
+		binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		binding.descriptorCount = 1;
+		binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		binding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = 1;
+		descriptorSetLayoutCreateInfo.pBindings = &binding;
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create upscale descriptor set layout.");
+		}
+
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorPoolSize.descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create upscale descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &m_descriptorSetLayout;
+
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, &m_descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate upscale descriptor set.");
+		}
+	}
+
+	void DynamicResolution::createPipeline() {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstantData);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create upscale pipeline layout.");
+		}
+
+		Pipeline::Config config = Pipeline::getDefaultConfig();
+		config.vertexShaderPath = "resources/shaders/fullscreen.vert.spv";
+		config.fragmentShaderPath = "resources/shaders/upscale.frag.spv";
+		config.modelVertexInput = false;
+		config.cullMode = VK_CULL_MODE_NONE;
+		config.depthTest = false;
+		config.depthWrite = false;
+
+		m_pipeline = std::make_unique<Pipeline>(m_device, m_swapchain, m_pipelineLayout, config);
+	}
+
+	void DynamicResolution::createSceneTarget(VkExtent2D extent) {
+		m_sceneTarget.reset();
+
+		RenderTarget::Description description{};
+		description.extent = extent;
+		description.format = m_swapchain.getImageFormat();
+		m_sceneTarget = std::make_unique<RenderTarget>(m_device, description);
+
+		m_outputExtent = extent;
+		m_renderExtent = computeRenderExtent(m_outputExtent, m_controller.getScale());
+
+		VkDescriptorImageInfo descriptorImageInfo{};
+		descriptorImageInfo.sampler = m_sceneTarget->getSampler();
+		descriptorImageInfo.imageView = m_sceneTarget->getImageView();
+		descriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.pNext = nullptr;
+		writeDescriptorSet.dstSet = m_descriptorSet;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.dstArrayElement = 0;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.pImageInfo = &descriptorImageInfo;
+
+		vkUpdateDescriptorSets(m_device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+	}
+
+	void DynamicResolution::upscale(VkCommandBuffer commandBuffer) {
+		const glm::vec2 targetSize{ static_cast<float>(m_outputExtent.width), static_cast<float>(m_outputExtent.height) };
+		const glm::vec2 renderSize{ static_cast<float>(m_renderExtent.width), static_cast<float>(m_renderExtent.height) };
+
+		PushConstantData pushConstants{};
+		pushConstants.uvScale = renderSize / targetSize;
+		pushConstants.texelSize = 1.0f / targetSize;
+		pushConstants.minUv = 0.5f / targetSize;
+		pushConstants.maxUv = (renderSize - 0.5f) / targetSize;
+
+		m_pipeline->bind(commandBuffer);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSet, 0, nullptr);
+		vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstantData), &pushConstants);
+		vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Device.h"
+#include "Swapchain.h"
+#include "Pipeline.h"
+#include "RenderGraph.h"
+#include "RenderTarget.h"
+#include "ResolutionController.h"
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class DynamicResolution {
+	public:
+		static constexpr std::uint32_t EXTENT_ALIGNMENT = 8;
+
+		DynamicResolution(Device &device, Swapchain &swapchain, const ResolutionController::Settings &settings, std::uint32_t frameCount);
+		~DynamicResolution();
+
+		DynamicResolution(const DynamicResolution &) = delete;
+		DynamicResolution &operator=(const DynamicResolution &) = delete;
+
+		void beginFrame(VkCommandBuffer commandBuffer, std::uint32_t frameIndex);
+		void endFrame(VkCommandBuffer commandBuffer, std::uint32_t frameIndex);
+
+		RenderGraph::ResourceHandle importSceneImage(RenderGraph &graph, VkExtent2D outputExtent);
+		void addUpscalePass(RenderGraph &graph, RenderGraph::ResourceHandle sceneImage, RenderGraph::ResourceHandle outputImage);
+		void setViewport(VkCommandBuffer commandBuffer) const;
+
+		VkExtent2D getRenderExtent() const;
+		VkExtent2D getOutputExtent() const;
+		float getGpuFrameTime() const;
+		ResolutionController &getController();
+		const ResolutionController &getController() const;
+
+		static VkExtent2D computeRenderExtent(VkExtent2D outputExtent, float scale);
+	private:
+		struct PushConstantData {
+			glm::vec2 uvScale{ 1.0f };
+			glm::vec2 texelSize{ 0.0f };
+			glm::vec2 minUv{ 0.0f };
+			glm::vec2 maxUv{ 1.0f };
+		};
+
+		void createQueryPool();
+		void createDescriptorSet();
+		void createPipeline();
+		void createSceneTarget(VkExtent2D extent);
+
+		void upscale(VkCommandBuffer commandBuffer);
+
+		Device &m_device;
+		Swapchain &m_swapchain;
+		ResolutionController m_controller;
+		std::uint32_t m_frameCount;
+
+		std::unique_ptr<RenderTarget> m_sceneTarget;
+		VkExtent2D m_outputExtent{};
+		VkExtent2D m_renderExtent{};
+
+		VkQueryPool m_queryPool = VK_NULL_HANDLE;
+		std::vector<float> m_frameScales;
+		std::vector<bool> m_queriesPending;
+		float m_gpuFrameTime = 0.0f;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool;
+		VkDescriptorSet m_descriptorSet;
+		VkPipelineLayout m_pipelineLayout;
+		std::unique_ptr<Pipeline> m_pipeline;
+	};
+}
+
+#endif
\ No newline at end of file
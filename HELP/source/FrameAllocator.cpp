@@ -0,0 +1,45 @@
+#include "FrameAllocator.h"
+
+namespace eng {
+	FrameAllocator::FrameAllocator(std::uint32_t frameCount, std::uint32_t threadCount, std::size_t capacity)
+		: m_frameCount(frameCount), m_threadCount(std::max(threadCount, 1u)) {
+		m_arenas.reserve(static_cast<std::size_t>(m_frameCount) * m_threadCount);
+		for (std::uint32_t i = 0; i < m_frameCount * m_threadCount; ++i) {
+			m_arenas.push_back(std::make_unique<FrameArena>(capacity));
+		}
+	}
+
+	FrameArena &FrameAllocator::getArena(std::uint32_t frameIndex, std::uint32_t threadIndex) {
+		if (frameIndex >= m_frameCount || threadIndex >= m_threadCount) {
+			throw std::runtime_error("Frame arena index is out of range.");
+		}
+
+		return *m_arenas[frameIndex * m_threadCount + threadIndex];
+	}
+
+	void FrameAllocator::reset(std::uint32_t frameIndex) {
+		for (std::uint32_t i = 0; i < m_threadCount; ++i) {
+			getArena(frameIndex, i).reset();
+		}
+	}
+
+	std::uint32_t FrameAllocator::getFrameCount() const {
+		return m_frameCount;
+	}
+
+	std::uint32_t FrameAllocator::getThreadCount() const {
+		return m_threadCount;
+	}
+
+	FrameAllocator::Statistics FrameAllocator::getStatistics() const {
+		Statistics statistics{};
+		for (const std::unique_ptr<FrameArena> &arena : m_arenas) {
+			statistics.usedBytes += arena->getUsedBytes();
+			statistics.capacity += arena->getCapacity();
+			statistics.highWaterMark = std::max(statistics.highWaterMark, arena->getHighWaterMark());
+			statistics.overflowCount += arena->getOverflowCount();
+		}
+
+		return statistics;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include "FrameArena.h"
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class FrameAllocator {
+	public:
+		struct Statistics {
+			std::size_t usedBytes = 0;
+			std::size_t capacity = 0;
+			std::size_t highWaterMark = 0;
+			std::uint64_t overflowCount = 0;
+		};
+
+		FrameAllocator(std::uint32_t frameCount, std::uint32_t threadCount, std::size_t capacity);
+
+		FrameAllocator(const FrameAllocator &) = delete;
+		FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+		FrameArena &getArena(std::uint32_t frameIndex, std::uint32_t threadIndex = 0);
+		void reset(std::uint32_t frameIndex);
+
+		std::uint32_t getFrameCount() const;
+		std::uint32_t getThreadCount() const;
+		Statistics getStatistics() const;
+	private:
+		std::uint32_t m_frameCount;
+		std::uint32_t m_threadCount;
+		std::vector<std::unique_ptr<FrameArena>> m_arenas;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "FrameArena.h"
+
+namespace eng {
+	FrameArena::FrameArena(std::size_t capacity) {
+		m_block.memory = std::make_unique<std::uint8_t[]>(capacity);
+		m_block.size = capacity;
+
+		if (POISON_ENABLED) {
+			std::memset(m_block.memory.get(), POISON_BYTE, capacity);
+		}
+	}
+
+	void *FrameArena::allocate(std::size_t size, std::size_t alignment) {
+		m_usedBytes += size;
+		m_highWaterMark = std::max(m_highWaterMark, m_usedBytes);
+
+		if (void *pointer = allocateFromBlock(m_block, size, alignment)) {
+			return pointer;
+		}
+
+		if (!m_overflowBlocks.empty()) {
+			if (void *pointer = allocateFromBlock(m_overflowBlocks.back(), size, alignment)) {
+				return pointer;
+			}
+		}
+
+		Block block{};
+		block.size = std::max(m_block.size, size + alignment);
+		block.memory = std::make_unique<std::uint8_t[]>(block.size);
+		m_overflowBlocks.push_back(std::move(block));
+		++m_overflowCount;
+
+		return allocateFromBlock(m_overflowBlocks.back(), size, alignment);
+	}
+
+	void FrameArena::reset() {
+		if (!m_overflowBlocks.empty()) {
+			std::size_t capacity = m_block.size;
+			while (capacity < m_highWaterMark) {
+				capacity *= 2;
+			}
+
+			m_overflowBlocks.clear();
+			m_block.memory = std::make_unique<std::uint8_t[]>(capacity);
+			m_block.size = capacity;
+			m_block.offset = capacity;
+		}
+
+		if (POISON_ENABLED) {
+			poison(m_block);
+		}
+
+		m_block.offset = 0;
+		m_usedBytes = 0;
+	}
+
+	std::size_t FrameArena::getUsedBytes() const {
+		return m_usedBytes;
+	}
+
+	std::size_t FrameArena::getCapacity() const {
+		return m_block.size;
+	}
+
+	std::size_t FrameArena::getHighWaterMark() const {
+		return m_highWaterMark;
+	}
+
+	std::uint64_t FrameArena::getOverflowCount() const {
+		return m_overflowCount;
+	}
+
+	void *FrameArena::allocateFromBlock(Block &block, std::size_t size, std::size_t alignment) {
+		const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+		const std::uintptr_t aligned = (base + block.offset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+		const std::size_t offset = static_cast<std::size_t>(aligned - base);
+
+		if (offset + size > block.size) {
+			return nullptr;
+		}
+
+		block.offset = offset + size;
+		return block.memory.get() + offset;
+	}
+
+	void FrameArena::poison(Block &block) {
+		std::memset(block.memory.get(), POISON_BYTE, block.offset);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+namespace eng {
+	class FrameArena {
+	public:
+		explicit FrameArena(std::size_t capacity);
+
+		FrameArena(const FrameArena &) = delete;
+		FrameArena &operator=(const FrameArena &) = delete;
+
+		void *allocate(std::size_t size, std::size_t alignment);
+		void reset();
+
+		std::size_t getUsedBytes() const;
+		std::size_t getCapacity() const;
+		std::size_t getHighWaterMark() const;
+		std::uint64_t getOverflowCount() const;
+
+		static constexpr std::uint8_t POISON_BYTE = 0xCD;
+#ifdef NDEBUG
+		static constexpr bool POISON_ENABLED = false;
+#else
+		static constexpr bool POISON_ENABLED = true;
+#endif
+	private:
+		struct Block {
+			std::unique_ptr<std::uint8_t[]> memory;
+			std::size_t size = 0;
+			std::size_t offset = 0;
+		};
+
+		static void *allocateFromBlock(Block &block, std::size_t size, std::size_t alignment);
+		static void poison(Block &block);
+
+		Block m_block;
+		std::vector<Block> m_overflowBlocks;
+		std::size_t m_usedBytes = 0;
+		std::size_t m_highWaterMark = 0;
+		std::uint64_t m_overflowCount = 0;
+	};
+
+	template<typename T>
+	class ArenaAllocator {
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		ArenaAllocator() noexcept = default;
+
+		ArenaAllocator(FrameArena &arena) noexcept
+			: m_arena(&arena) {
+		}
+
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+			: m_arena(other.getArena()) {
+		}
+
+		T *allocate(std::size_t count) {
+			if (m_arena == nullptr) {
+				return static_cast<T *>(::operator new(count * sizeof(T)));
+			}
+
+			return static_cast<T *>(m_arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T *pointer, std::size_t) noexcept {
+			if (m_arena == nullptr) {
+				::operator delete(pointer);
+			}
+		}
+
+		FrameArena *getArena() const noexcept {
+			return m_arena;
+		}
+
+		template<typename U>
+		bool operator==(const ArenaAllocator<U> &other) const noexcept {
+			return m_arena == other.getArena();
+		}
+
+		template<typename U>
+		bool operator!=(const ArenaAllocator<U> &other) const noexcept {
+			return m_arena != other.getArena();
+		}
+	private:
+		FrameArena *m_arena = nullptr;
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+	using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+}
+
+#endif
\ No newline at end of file
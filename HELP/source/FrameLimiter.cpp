@@ -0,0 +1,145 @@
+#include "FrameLimiter.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace eng {
+	FrameLimiter::FrameLimiter(float targetFrameRate) {
+		setTargetFrameRate(targetFrameRate);
+	}
+
+	void FrameLimiter::setTargetFrameRate(float targetFrameRate) {
+		m_targetFrameRate = std::max(targetFrameRate, 0.0f);
+		m_period = m_targetFrameRate > 0.0f ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_targetFrameRate)) : Clock::duration{};
+		m_deadline = {};
+	}
+
+	float FrameLimiter::getTargetFrameRate() const {
+		return m_targetFrameRate;
+	}
+
+	void FrameLimiter::wait() {
+		if (m_period > Clock::duration{}) {
+			const Clock::time_point now = Clock::now();
+
+			if (m_deadline == Clock::time_point{} || now - m_deadline > m_period) {
+				m_deadline = now;
+			} else {
+				sleepUntil(m_deadline);
+			}
+
+			m_deadline += m_period;
+		}
+
+		recordFrame(Clock::now());
+	}
+
+	FrameLimiter::Statistics FrameLimiter::getStatistics() const {
+		Statistics statistics{};
+		statistics.frameCount = m_frameCount;
+		statistics.maxFrameTime = m_maxFrameTime;
+		statistics.sleepTime = m_sleepTime;
+		statistics.spinTime = m_spinTime;
+
+		if (m_frameCount > 0) {
+			statistics.averageFrameTime = m_frameTimeSum / m_frameCount;
+			statistics.jitter = std::sqrt(std::max(m_frameTimeSquareSum / m_frameCount - statistics.averageFrameTime * statistics.averageFrameTime, 0.0));
+		}
+
+		const double elapsed = std::chrono::duration<double>(Clock::now() - m_statisticsStart).count();
+		if (elapsed > 0.0) {
+			statistics.cpuUsage = (getProcessCpuTime() - m_statisticsCpuStart) / elapsed;
+		}
+
+		return statistics;
+	}
+
+	void FrameLimiter::resetStatistics() {
+		m_lastFrame = {};
+		m_statisticsStart = Clock::now();
+		m_statisticsCpuStart = getProcessCpuTime();
+		m_frameCount = 0;
+		m_frameTimeSum = 0.0;
+		m_frameTimeSquareSum = 0.0;
+		m_maxFrameTime = 0.0;
+		m_sleepTime = 0.0;
+		m_spinTime = 0.0;
+	}
+
+	float FrameLimiter::getFrameRateOverride() {
+		const char *frameRate = std::getenv("HELP_FRAME_RATE");
+		return frameRate != nullptr ? std::max(std::strtof(frameRate, nullptr), 0.0f) : 0.0f;
+	}
+
+	double FrameLimiter::getProcessCpuTime() {
+#ifdef _WIN32
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+			return 0.0;
+		}
+
+		auto toSeconds = [](const FILETIME &time) {
+			return static_cast<double>((static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1e-7;
+		};
+
+		return toSeconds(kernelTime) + toSeconds(userTime);
+#else
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) != 0) {
+			return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+		}
+
+		return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+	}
+
+	void FrameLimiter::sleepUntil(Clock::time_point deadline) {
+		const Clock::time_point sleepStart = Clock::now();
+
+		while (true) {
+			const double remaining = std::chrono::duration<double, std::milli>(deadline - Clock::now()).count();
+			if (remaining <= m_sleepMean + std::sqrt(m_sleepVariance)) {
+				break;
+			}
+
+			const Clock::time_point start = Clock::now();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			const double observed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+			if (m_sleepSamples < MAX_SLEEP_SAMPLES) {
+				++m_sleepSamples;
+			}
+
+			const double weight = 1.0 / static_cast<double>(m_sleepSamples);
+			const double delta = observed - m_sleepMean;
+			m_sleepMean += delta * weight;
+			m_sleepVariance = (1.0 - weight) * (m_sleepVariance + weight * delta * delta);
+		}
+
+		const Clock::time_point spinStart = Clock::now();
+		while (Clock::now() < deadline) {
+			std::this_thread::yield();
+		}
+
+		m_sleepTime += std::chrono::duration<double, std::milli>(spinStart - sleepStart).count();
+		m_spinTime += std::chrono::duration<double, std::milli>(Clock::now() - spinStart).count();
+	}
+
+	void FrameLimiter::recordFrame(Clock::time_point time) {
+		if (m_lastFrame != Clock::time_point{}) {
+			const double frameTime = std::chrono::duration<double, std::milli>(time - m_lastFrame).count();
+
+			++m_frameCount;
+			m_frameTimeSum += frameTime;
+			m_frameTimeSquareSum += frameTime * frameTime;
+			m_maxFrameTime = std::max(m_maxFrameTime, frameTime);
+		}
+
+		m_lastFrame = time;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef FRAME_LIMITER_H
+#define FRAME_LIMITER_H
+
+#include <chrono>
+#include <thread>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+
+namespace eng {
+	class FrameLimiter {
+	public:
+		struct Statistics {
+			std::uint32_t frameCount = 0;
+			double averageFrameTime = 0.0;
+			double jitter = 0.0;
+			double maxFrameTime = 0.0;
+			double sleepTime = 0.0;
+			double spinTime = 0.0;
+			double cpuUsage = 0.0;
+		};
+
+		explicit FrameLimiter(float targetFrameRate = 0.0f);
+
+		void setTargetFrameRate(float targetFrameRate);
+		float getTargetFrameRate() const;
+
+		void wait();
+
+		Statistics getStatistics() const;
+		void resetStatistics();
+
+		static float getFrameRateOverride();
+		static double getProcessCpuTime();
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		void sleepUntil(Clock::time_point deadline);
+		void recordFrame(Clock::time_point time);
+
+		float m_targetFrameRate = 0.0f;
+		Clock::duration m_period{};
+		Clock::time_point m_deadline{};
+
+		double m_sleepMean = INITIAL_SLEEP_ESTIMATE;
+		double m_sleepVariance = 0.0;
+		std::uint64_t m_sleepSamples = 0;
+
+		Clock::time_point m_lastFrame{};
+		Clock::time_point m_statisticsStart = Clock::now();
+		double m_statisticsCpuStart = getProcessCpuTime();
+		std::uint32_t m_frameCount = 0;
+		double m_frameTimeSum = 0.0;
+		double m_frameTimeSquareSum = 0.0;
+		double m_maxFrameTime = 0.0;
+		double m_sleepTime = 0.0;
+		double m_spinTime = 0.0;
+
+		static constexpr double INITIAL_SLEEP_ESTIMATE = 2.0;
+		static constexpr std::uint64_t MAX_SLEEP_SAMPLES = 1000;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "Frustum.h"
+
+namespace eng {
+	Frustum::Frustum(const glm::mat4 &projectionView) {
+		glm::vec4 row0{ projectionView[0][0], projectionView[1][0], projectionView[2][0], projectionView[3][0] };
+		glm::vec4 row1{ projectionView[0][1], projectionView[1][1], projectionView[2][1], projectionView[3][1] };
+		glm::vec4 row2{ projectionView[0][2], projectionView[1][2], projectionView[2][2], projectionView[3][2] };
+		glm::vec4 row3{ projectionView[0][3], projectionView[1][3], projectionView[2][3], projectionView[3][3] };
+
+		m_planes[0] = row3 + row0;
+		m_planes[1] = row3 - row0;
+		m_planes[2] = row3 + row1;
+		m_planes[3] = row3 - row1;
+		m_planes[4] = row2;
+		m_planes[5] = row3 - row2;
+
+		for (std::size_t i = 0; i < PADDED_PLANE_COUNT; ++i) {
+			if (i < PLANE_COUNT) {
+				float length = glm::length(glm::vec3{ m_planes[i] });
+				if (length > 0.0f) {
+					m_planes[i] /= length;
+				}
+
+				m_normalX[i] = m_planes[i].x;
+				m_normalY[i] = m_planes[i].y;
+				m_normalZ[i] = m_planes[i].z;
+				m_distance[i] = m_planes[i].w;
+			} else {
+				m_normalX[i] = 0.0f;
+				m_normalY[i] = 0.0f;
+				m_normalZ[i] = 0.0f;
+				m_distance[i] = 1.0f;
+			}
+		}
+	}
+
+	Frustum::Intersection Frustum::classify(const BoundingBox &box) const {
+		glm::vec3 center = box.getCenter();
+		glm::vec3 extents = box.getExtents();
+
+#ifdef ENG_FRUSTUM_SSE
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 cx = _mm_set1_ps(center.x);
+		const __m128 cy = _mm_set1_ps(center.y);
+		const __m128 cz = _mm_set1_ps(center.z);
+		const __m128 ex = _mm_set1_ps(extents.x);
+		const __m128 ey = _mm_set1_ps(extents.y);
+		const __m128 ez = _mm_set1_ps(extents.z);
+
+		int outsideMask = 0;
+		int intersectingMask = 0;
+		for (std::size_t i = 0; i < PADDED_PLANE_COUNT; i += 4) {
+			__m128 nx = _mm_load_ps(&m_normalX[i]);
+			__m128 ny = _mm_load_ps(&m_normalY[i]);
+			__m128 nz = _mm_load_ps(&m_normalZ[i]);
+			__m128 d = _mm_load_ps(&m_distance[i]);
+
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, nx), _mm_mul_ps(cy, ny)), _mm_add_ps(_mm_mul_ps(cz, nz), d));
+			__m128 radius = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(ex, _mm_andnot_ps(signMask, nx)), _mm_mul_ps(ey, _mm_andnot_ps(signMask, ny))),
+				_mm_mul_ps(ez, _mm_andnot_ps(signMask, nz)));
+
+			outsideMask |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+			intersectingMask |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, radius), _mm_setzero_ps()));
+		}
+
+		if (outsideMask != 0) {
+			return Intersection::Outside;
+		}
+
+		return intersectingMask != 0 ? Intersection::Intersecting : Intersection::Inside;
+#else
+		Intersection result = Intersection::Inside;
+		for (const glm::vec4 &plane : m_planes) {
+			float distance = glm::dot(glm::vec3{ plane }, center) + plane.w;
+			float radius = glm::dot(glm::abs(glm::vec3{ plane }), extents);
+
+			if (distance + radius < 0.0f) {
+				return Intersection::Outside;
+			}
+
+			if (distance - radius < 0.0f) {
+				result = Intersection::Intersecting;
+			}
+		}
+
+		return result;
+#endif
+	}
+
+	bool Frustum::intersects(const BoundingBox &box) const {
+		return classify(box) != Intersection::Outside;
+	}
+
+	bool Frustum::intersects(const BoundingSphere &sphere) const {
+		for (const glm::vec4 &plane : m_planes) {
+			if (glm::dot(glm::vec3{ plane }, sphere.center) + plane.w < -sphere.radius) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void Frustum::cullBoxes(const BoundingBoxArray &boxes, std::vector<std::uint32_t> &visible) const {
+#ifdef ENG_FRUSTUM_SSE
+		const std::size_t count = boxes.size();
+		const std::size_t simdCount = count & ~static_cast<std::size_t>(3);
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+
+		for (std::size_t i = 0; i < simdCount; i += 4) {
+			__m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+			__m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+			__m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+			__m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+			__m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+			__m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+			__m128 outside = _mm_setzero_ps();
+			for (std::size_t p = 0; p < PLANE_COUNT; ++p) {
+				__m128 nx = _mm_set1_ps(m_normalX[p]);
+				__m128 ny = _mm_set1_ps(m_normalY[p]);
+				__m128 nz = _mm_set1_ps(m_normalZ[p]);
+				__m128 d = _mm_set1_ps(m_distance[p]);
+
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, nx), _mm_mul_ps(cy, ny)), _mm_add_ps(_mm_mul_ps(cz, nz), d));
+				__m128 radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(ex, _mm_andnot_ps(signMask, nx)), _mm_mul_ps(ey, _mm_andnot_ps(signMask, ny))),
+					_mm_mul_ps(ez, _mm_andnot_ps(signMask, nz)));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+			}
+
+			int visibleMask = ~_mm_movemask_ps(outside) & 0xF;
+			while (visibleMask != 0) {
+				int lane = 0;
+				while (!(visibleMask & (1 << lane))) {
+					++lane;
+				}
+
+				visible.push_back(static_cast<std::uint32_t>(i + lane));
+				visibleMask &= visibleMask - 1;
+			}
+		}
+
+		for (std::size_t i = simdCount; i < count; ++i) {
+			BoundingBox box{
+				glm::vec3{ boxes.centerX[i] - boxes.extentX[i], boxes.centerY[i] - boxes.extentY[i], boxes.centerZ[i] - boxes.extentZ[i] },
+				glm::vec3{ boxes.centerX[i] + boxes.extentX[i], boxes.centerY[i] + boxes.extentY[i], boxes.centerZ[i] + boxes.extentZ[i] }
+			};
+
+			if (intersects(box)) {
+				visible.push_back(static_cast<std::uint32_t>(i));
+			}
+		}
+#else
+		cullBoxesScalar(boxes, visible);
+#endif
+	}
+
+	void Frustum::cullBoxesScalar(const BoundingBoxArray &boxes, std::vector<std::uint32_t> &visible) const {
+		for (std::size_t i = 0; i < boxes.size(); ++i) {
+			bool outside = false;
+			for (const glm::vec4 &plane : m_planes) {
+				float distance = plane.x * boxes.centerX[i] + plane.y * boxes.centerY[i] + plane.z * boxes.centerZ[i] + plane.w;
+				float radius = std::abs(plane.x) * boxes.extentX[i] + std::abs(plane.y) * boxes.extentY[i] + std::abs(plane.z) * boxes.extentZ[i];
+
+				if (distance + radius < 0.0f) {
+					outside = true;
+					break;
+				}
+			}
+
+			if (!outside) {
+				visible.push_back(static_cast<std::uint32_t>(i));
+			}
+		}
+	}
+
+	const glm::vec4 &Frustum::getPlane(std::size_t index) const {
+		return m_planes[index];
+	}
+}
\ No newline at end of file
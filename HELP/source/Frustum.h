@@ -0,0 +1,53 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "BoundingVolume.h"
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define ENG_FRUSTUM_SSE
+#include <immintrin.h>
+#endif
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace eng {
+	class Frustum {
+	public:
+		enum class Intersection {
+			Outside,
+			Intersecting,
+			Inside
+		};
+
+		Frustum() = default;
+		explicit Frustum(const glm::mat4 &projectionView);
+
+		Intersection classify(const BoundingBox &box) const;
+		bool intersects(const BoundingBox &box) const;
+		bool intersects(const BoundingSphere &sphere) const;
+
+		void cullBoxes(const BoundingBoxArray &boxes, std::vector<std::uint32_t> &visible) const;
+		void cullBoxesScalar(const BoundingBoxArray &boxes, std::vector<std::uint32_t> &visible) const;
+
+		const glm::vec4 &getPlane(std::size_t index) const;
+
+		static constexpr std::size_t PLANE_COUNT = 6;
+	private:
+		static constexpr std::size_t PADDED_PLANE_COUNT = 8;
+
+		glm::vec4 m_planes[PLANE_COUNT]{};
+
+		alignas(16) float m_normalX[PADDED_PLANE_COUNT]{};
+		alignas(16) float m_normalY[PADDED_PLANE_COUNT]{};
+		alignas(16) float m_normalZ[PADDED_PLANE_COUNT]{};
+		alignas(16) float m_distance[PADDED_PLANE_COUNT]{};
+	};
+}
+
+#endif
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include "Model.h"
 
 #include <memory>
+#include <cstdint>
+#include <limits>
 
 namespace eng {
 	struct TransformComponent {
@@ -33,6 +35,10 @@ namespace eng {
 		std::shared_ptr<Model> model{};
 		glm::vec3 color{};
 		TransformComponent transform{};
+		std::uint32_t lod = 0;
+		std::uint32_t material = 0;
+		std::uint32_t texture = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t sceneNode = std::numeric_limits<std::uint32_t>::max();
 	private:
 		GameObject(unsigned int id);
 
@@ -0,0 +1,266 @@
+#include "GeometryPool.h"
+
+namespace eng {
+	GeometryPool::GeometryPool(Device &device, VkDeviceSize vertexStride, std::uint32_t maxVertices, std::uint32_t maxIndices)
+		: m_device(device), m_vertexStride(vertexStride), m_maxVertices(maxVertices), m_maxIndices(maxIndices) {
+		m_vertexPullingEnabled = m_device.getCapabilities().isEnabled(Capability::BufferDeviceAddress);
+
+		createBuffers();
+
+		m_freeVertexRanges[0] = maxVertices;
+		m_freeIndexRanges[0] = maxIndices;
+	}
+
+	GeometryPool::~GeometryPool() {
+		vkDestroyBuffer(m_device.getDevice(), m_indexBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(m_indexBufferMemory);
+		vkDestroyBuffer(m_device.getDevice(), m_vertexBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(m_vertexBufferMemory);
+	}
+
+	GeometryPool::Allocation GeometryPool::allocate(const void *vertices, std::uint32_t vertexCount, const std::uint32_t *indices, std::uint32_t indexCount) {
+		Allocation allocation{};
+		allocation.vertexCount = vertexCount;
+		allocation.indexCount = indexCount;
+
+		if (!allocateRange(m_freeVertexRanges, vertexCount, allocation.firstVertex)) {
+			throw std::runtime_error("Geometry pool is out of vertex space.");
+		}
+
+		if (!allocateRange(m_freeIndexRanges, indexCount, allocation.firstIndex)) {
+			freeRange(m_freeVertexRanges, allocation.firstVertex, vertexCount);
+			throw std::runtime_error("Geometry pool is out of index space.");
+		}
+
+		m_usedVertexCount += vertexCount;
+		m_usedIndexCount += indexCount;
+
+		const VkDeviceSize vertexSize = vertexCount * m_vertexStride;
+		const VkDeviceSize indexSize = indexCount * sizeof(std::uint32_t);
+		const VkDeviceSize stagingOffset = m_pendingData.size();
+
+		m_pendingData.resize(static_cast<std::size_t>(stagingOffset + vertexSize + indexSize));
+		std::memcpy(m_pendingData.data() + stagingOffset, vertices, static_cast<std::size_t>(vertexSize));
+		std::memcpy(m_pendingData.data() + stagingOffset + vertexSize, indices, static_cast<std::size_t>(indexSize));
+
+		m_pendingVertexCopies.push_back({ stagingOffset, allocation.firstVertex * m_vertexStride, vertexSize });
+		m_pendingIndexCopies.push_back({ stagingOffset + vertexSize, allocation.firstIndex * sizeof(std::uint32_t), indexSize });
+
+		return allocation;
+	}
+
+	void GeometryPool::free(const Allocation &allocation) {
+		const VkDeviceSize vertexOffset = allocation.firstVertex * m_vertexStride;
+		const VkDeviceSize indexOffset = allocation.firstIndex * sizeof(std::uint32_t);
+
+		m_pendingVertexCopies.erase(std::remove_if(m_pendingVertexCopies.begin(), m_pendingVertexCopies.end(), [vertexOffset](const VkBufferCopy &copy) {
+			return copy.dstOffset == vertexOffset;
+		}), m_pendingVertexCopies.end());
+		m_pendingIndexCopies.erase(std::remove_if(m_pendingIndexCopies.begin(), m_pendingIndexCopies.end(), [indexOffset](const VkBufferCopy &copy) {
+			return copy.dstOffset == indexOffset;
+		}), m_pendingIndexCopies.end());
+
+		m_retiredAllocations.push_back({ allocation, m_frame });
+	}
+
+	void GeometryPool::flush() {
+		if (m_pendingVertexCopies.empty() && m_pendingIndexCopies.empty()) {
+			m_pendingData.clear();
+			return;
+		}
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		m_device.createBuffer(
+			m_pendingData.size(),
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			stagingBuffer,
+			stagingBufferMemory
+		);
+
+		void *data;
+		vkMapMemory(m_device.getDevice(), stagingBufferMemory, 0, m_pendingData.size(), 0, &data);
+		std::memcpy(data, m_pendingData.data(), m_pendingData.size());
+		vkUnmapMemory(m_device.getDevice(), stagingBufferMemory);
+
+		VkCommandBuffer commandBuffer = m_device.beginSingleTimeCommands();
+
+		if (!m_pendingVertexCopies.empty()) {
+			vkCmdCopyBuffer(commandBuffer, stagingBuffer, m_vertexBuffer, static_cast<std::uint32_t>(m_pendingVertexCopies.size()), m_pendingVertexCopies.data());
+		}
+
+		if (!m_pendingIndexCopies.empty()) {
+			vkCmdCopyBuffer(commandBuffer, stagingBuffer, m_indexBuffer, static_cast<std::uint32_t>(m_pendingIndexCopies.size()), m_pendingIndexCopies.data());
+		}
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+			0,
+			1, &memoryBarrier,
+			0, nullptr,
+			0, nullptr
+		);
+
+		m_device.endSingleTimeCommands(commandBuffer);
+
+		vkDestroyBuffer(m_device.getDevice(), stagingBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(stagingBufferMemory);
+
+		m_pendingData.clear();
+		m_pendingData.shrink_to_fit();
+		m_pendingVertexCopies.clear();
+		m_pendingIndexCopies.clear();
+	}
+
+	void GeometryPool::beginFrame() {
+		releaseRetiredAllocations();
+		++m_frame;
+	}
+
+	void GeometryPool::bind(VkCommandBuffer commandBuffer) {
+		VkBuffer buffers[] = { m_vertexBuffer };
+		VkDeviceSize offsets[] = { 0 };
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+		bindIndices(commandBuffer);
+	}
+
+	void GeometryPool::bindIndices(VkCommandBuffer commandBuffer) {
+		vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+	}
+
+	void GeometryPool::bind(DrawRecorder &recorder) {
+		recorder.bindVertexBuffer(m_vertexBuffer, 0);
+		bindIndices(recorder);
+	}
+
+	void GeometryPool::bindIndices(DrawRecorder &recorder) {
+		recorder.bindIndexBuffer(m_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+	}
+
+	bool GeometryPool::isVertexPullingEnabled() const {
+		return m_vertexPullingEnabled;
+	}
+
+	VkDeviceAddress GeometryPool::getVertexBufferAddress() const {
+		return m_vertexBufferAddress;
+	}
+
+	VkBuffer GeometryPool::getVertexBuffer() const {
+		return m_vertexBuffer;
+	}
+
+	VkBuffer GeometryPool::getIndexBuffer() const {
+		return m_indexBuffer;
+	}
+
+	VkDeviceSize GeometryPool::getVertexStride() const {
+		return m_vertexStride;
+	}
+
+	std::uint32_t GeometryPool::getUsedVertexCount() const {
+		return m_usedVertexCount;
+	}
+
+	std::uint32_t GeometryPool::getUsedIndexCount() const {
+		return m_usedIndexCount;
+	}
+
+	void GeometryPool::createBuffers() {
+		VkBufferUsageFlags vertexUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		VkMemoryAllocateFlags vertexAllocateFlags = 0;
+		if (m_vertexPullingEnabled) {
+			vertexUsage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+			vertexAllocateFlags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+		}
+
+		m_device.createBuffer(
+			m_maxVertices * m_vertexStride,
+			vertexUsage,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_vertexBuffer,
+			m_vertexBufferMemory,
+			MemoryCategory::Mesh,
+			vertexAllocateFlags
+		);
+
+		m_device.createBuffer(
+			static_cast<VkDeviceSize>(m_maxIndices) * sizeof(std::uint32_t),
+			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_indexBuffer,
+			m_indexBufferMemory,
+			MemoryCategory::Mesh
+		);
+
+		if (m_vertexPullingEnabled) {
+			m_vertexBufferAddress = m_device.getBufferDeviceAddress(m_vertexBuffer);
+		}
+	}
+
+	void GeometryPool::releaseRetiredAllocations() {
+		auto retired = std::remove_if(m_retiredAllocations.begin(), m_retiredAllocations.end(), [&](const RetiredAllocation &retiredAllocation) {
+			if (m_frame < retiredAllocation.frame + Swapchain::MAX_FRAMES_IN_FLIGHT) {
+				return false;
+			}
+
+			freeRange(m_freeVertexRanges, retiredAllocation.allocation.firstVertex, retiredAllocation.allocation.vertexCount);
+			freeRange(m_freeIndexRanges, retiredAllocation.allocation.firstIndex, retiredAllocation.allocation.indexCount);
+
+			m_usedVertexCount -= retiredAllocation.allocation.vertexCount;
+			m_usedIndexCount -= retiredAllocation.allocation.indexCount;
+
+			return true;
+		});
+
+		m_retiredAllocations.erase(retired, m_retiredAllocations.end());
+	}
+
+	bool GeometryPool::allocateRange(std::map<std::uint32_t, std::uint32_t> &freeRanges, std::uint32_t count, std::uint32_t &offset) {
+		for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+			if (it->second < count) {
+				continue;
+			}
+
+			offset = it->first;
+			std::uint32_t remaining = it->second - count;
+			freeRanges.erase(it);
+
+			if (remaining > 0) {
+				freeRanges[offset + count] = remaining;
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void GeometryPool::freeRange(std::map<std::uint32_t, std::uint32_t> &freeRanges, std::uint32_t offset, std::uint32_t count) {
+		auto next = freeRanges.lower_bound(offset);
+
+		if (next != freeRanges.begin()) {
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset) {
+				offset = previous->first;
+				count += previous->second;
+				freeRanges.erase(previous);
+			}
+		}
+
+		if (next != freeRanges.end() && offset + count == next->first) {
+			count += next->second;
+			freeRanges.erase(next);
+		}
+
+		freeRanges[offset] = count;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef GEOMETRY_POOL_H
+#define GEOMETRY_POOL_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "Swapchain.h"
+#include "DrawRecorder.h"
+
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace eng {
+	class GeometryPool {
+	public:
+		struct Allocation {
+			std::uint32_t firstVertex = 0;
+			std::uint32_t vertexCount = 0;
+			std::uint32_t firstIndex = 0;
+			std::uint32_t indexCount = 0;
+		};
+
+		GeometryPool(Device &device, VkDeviceSize vertexStride, std::uint32_t maxVertices, std::uint32_t maxIndices);
+		~GeometryPool();
+
+		GeometryPool(const GeometryPool &) = delete;
+		GeometryPool &operator=(const GeometryPool &) = delete;
+
+		Allocation allocate(const void *vertices, std::uint32_t vertexCount, const std::uint32_t *indices, std::uint32_t indexCount);
+		void free(const Allocation &allocation);
+		void flush();
+		void beginFrame();
+
+		void bind(VkCommandBuffer commandBuffer);
+		void bindIndices(VkCommandBuffer commandBuffer);
+		void bind(DrawRecorder &recorder);
+		void bindIndices(DrawRecorder &recorder);
+
+		bool isVertexPullingEnabled() const;
+		VkDeviceAddress getVertexBufferAddress() const;
+		VkBuffer getVertexBuffer() const;
+		VkBuffer getIndexBuffer() const;
+		VkDeviceSize getVertexStride() const;
+		std::uint32_t getUsedVertexCount() const;
+		std::uint32_t getUsedIndexCount() const;
+	private:
+		struct RetiredAllocation {
+			Allocation allocation;
+			std::uint64_t frame;
+		};
+
+		void createBuffers();
+		void releaseRetiredAllocations();
+
+		static bool allocateRange(std::map<std::uint32_t, std::uint32_t> &freeRanges, std::uint32_t count, std::uint32_t &offset);
+		static void freeRange(std::map<std::uint32_t, std::uint32_t> &freeRanges, std::uint32_t offset, std::uint32_t count);
+
+		Device &m_device;
+		VkDeviceSize m_vertexStride;
+		std::uint32_t m_maxVertices;
+		std::uint32_t m_maxIndices;
+		bool m_vertexPullingEnabled = false;
+
+		VkBuffer m_vertexBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory m_vertexBufferMemory = VK_NULL_HANDLE;
+		VkBuffer m_indexBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory m_indexBufferMemory = VK_NULL_HANDLE;
+		VkDeviceAddress m_vertexBufferAddress = 0;
+
+		std::map<std::uint32_t, std::uint32_t> m_freeVertexRanges;
+		std::map<std::uint32_t, std::uint32_t> m_freeIndexRanges;
+		std::uint32_t m_usedVertexCount = 0;
+		std::uint32_t m_usedIndexCount = 0;
+		std::uint64_t m_frame = 0;
+		std::vector<RetiredAllocation> m_retiredAllocations;
+
+		std::vector<char> m_pendingData;
+		std::vector<VkBufferCopy> m_pendingVertexCopies;
+		std::vector<VkBufferCopy> m_pendingIndexCopies;
+	};
+}
+
+#endif
\ No newline at end of file
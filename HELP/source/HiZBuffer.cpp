@@ -0,0 +1,355 @@
+#include "HiZBuffer.h"
+
+namespace eng {
+	HiZBuffer::HiZBuffer(Device &device, VkExtent2D depthExtent, std::uint32_t frameCount)
+		: m_device(device), m_depthExtent(depthExtent), m_frameCount(frameCount) {
+		createSampler();
+		createDescriptorSetLayout();
+		createPipeline();
+		createImage();
+		createDescriptorSets();
+	}
+
+	HiZBuffer::~HiZBuffer() {
+		m_pipeline.reset();
+
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroySampler(m_device.getDevice(), m_sampler, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		destroyImage();
+	}
+
+	void HiZBuffer::resize(VkExtent2D depthExtent) {
+		if (depthExtent.width == m_depthExtent.width && depthExtent.height == m_depthExtent.height) {
+			return;
+		}
+
+		vkDeviceWaitIdle(m_device.getDevice());
+
+		m_depthExtent = depthExtent;
+
+		destroyImage();
+		createImage();
+		createDescriptorSets();
+	}
+
+	void HiZBuffer::build(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, VkImageView depthImageView) {
+		if (m_depthImageViews[frameIndex] != depthImageView) {
+			writeDescriptorSet(m_depthDescriptorSets[frameIndex], depthImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipImageViews[0]);
+			m_depthImageViews[frameIndex] = depthImageView;
+		}
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		m_pipeline->bind(commandBuffer);
+
+		VkExtent2D sourceExtent = m_depthExtent;
+		for (std::uint32_t level = 0; level < m_mipLevelCount; ++level) {
+			VkExtent2D destinationExtent = getMipExtent(level);
+			VkDescriptorSet descriptorSet = level == 0 ? m_depthDescriptorSets[frameIndex] : m_mipDescriptorSets[level - 1];
+
+			PushConstantData pushConstants{};
+			pushConstants.sourceWidth = sourceExtent.width;
+			pushConstants.sourceHeight = sourceExtent.height;
+			pushConstants.destinationWidth = destinationExtent.width;
+			pushConstants.destinationHeight = destinationExtent.height;
+
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstantData), &pushConstants);
+			vkCmdDispatch(commandBuffer, (destinationExtent.width + GROUP_SIZE - 1) / GROUP_SIZE, (destinationExtent.height + GROUP_SIZE - 1) / GROUP_SIZE, 1);
+
+			memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+			sourceExtent = destinationExtent;
+		}
+	}
+
+	VkImageView HiZBuffer::getImageView() const {
+		return m_imageView;
+	}
+
+	VkSampler HiZBuffer::getSampler() const {
+		return m_sampler;
+	}
+
+	VkExtent2D HiZBuffer::getDepthExtent() const {
+		return m_depthExtent;
+	}
+
+	VkExtent2D HiZBuffer::getExtent() const {
+		return m_extent;
+	}
+
+	std::uint32_t HiZBuffer::getMipLevelCount() const {
+		return m_mipLevelCount;
+	}
+
+	void HiZBuffer::createImage() {
+		m_extent = { std::max((m_depthExtent.width + 1) / 2, 1u), std::max((m_depthExtent.height + 1) / 2, 1u) };
+
+		m_mipLevelCount = 1;
+		while ((m_extent.width >> m_mipLevelCount) > 0 || (m_extent.height >> m_mipLevelCount) > 0) {
+			++m_mipLevelCount;
+		}
+
+		VkImageCreateInfo imageCreateInfo{};
+		imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCreateInfo.pNext = nullptr;
+		imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageCreateInfo.extent.width = m_extent.width;
+		imageCreateInfo.extent.height = m_extent.height;
+		imageCreateInfo.extent.depth = 1;
+		imageCreateInfo.mipLevels = m_mipLevelCount;
+		imageCreateInfo.arrayLayers = 1;
+		imageCreateInfo.format = VK_FORMAT_R32_SFLOAT;
+		imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageCreateInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		m_device.createImage(imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_image, m_imageMemory, MemoryCategory::RenderTarget);
+
+		VkImageViewCreateInfo imageViewCreateInfo{};
+		imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		imageViewCreateInfo.pNext = nullptr;
+		imageViewCreateInfo.image = m_image;
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		imageViewCreateInfo.format = VK_FORMAT_R32_SFLOAT;
+		imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+		imageViewCreateInfo.subresourceRange.levelCount = m_mipLevelCount;
+		imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+		imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+		if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_imageView) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create Hi-Z image view.");
+		}
+
+		m_mipImageViews.resize(m_mipLevelCount);
+		for (std::uint32_t level = 0; level < m_mipLevelCount; ++level) {
+			imageViewCreateInfo.subresourceRange.baseMipLevel = level;
+			imageViewCreateInfo.subresourceRange.levelCount = 1;
+
+			if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_mipImageViews[level]) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create Hi-Z mip image view.");
+			}
+		}
+
+		VkCommandBuffer commandBuffer = m_device.beginSingleTimeCommands();
+
+		VkImageSubresourceRange subresourceRange{};
+		subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		subresourceRange.baseMipLevel = 0;
+		subresourceRange.levelCount = m_mipLevelCount;
+		subresourceRange.baseArrayLayer = 0;
+		subresourceRange.layerCount = 1;
+
+		VkImageMemoryBarrier imageMemoryBarrier{};
+		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		imageMemoryBarrier.pNext = nullptr;
+		imageMemoryBarrier.srcAccessMask = 0;
+		imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+		imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		imageMemoryBarrier.image = m_image;
+		imageMemoryBarrier.subresourceRange = subresourceRange;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+
+		VkClearColorValue clearColor{};
+		clearColor.float32[0] = 1.0f;
+		vkCmdClearColorImage(commandBuffer, m_image, VK_IMAGE_LAYOUT_GENERAL, &clearColor, 1, &subresourceRange);
+
+		imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+		imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+
+		m_device.endSingleTimeCommands(commandBuffer);
+	}
+
+	void HiZBuffer::destroyImage() {
+		for (VkImageView imageView : m_mipImageViews) {
+			vkDestroyImageView(m_device.getDevice(), imageView, VulkanAllocator::get(AllocationCategory::Resource));
+		}
+		m_mipImageViews.clear();
+
+		if (m_imageView != VK_NULL_HANDLE) {
+			vkDestroyImageView(m_device.getDevice(), m_imageView, VulkanAllocator::get(AllocationCategory::Resource));
+			m_imageView = VK_NULL_HANDLE;
+		}
+
+		if (m_image != VK_NULL_HANDLE) {
+			vkDestroyImage(m_device.getDevice(), m_image, VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(m_imageMemory);
+			m_image = VK_NULL_HANDLE;
+			m_imageMemory = VK_NULL_HANDLE;
+		}
+	}
+
+	void HiZBuffer::createSampler() {
+		VkSamplerCreateInfo samplerCreateInfo{};
+		samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerCreateInfo.pNext = nullptr;
+		samplerCreateInfo.magFilter = VK_FILTER_NEAREST;
+		samplerCreateInfo.minFilter = VK_FILTER_NEAREST;
+		samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.anisotropyEnable = VK_FALSE;
+		samplerCreateInfo.maxAnisotropy = 1.0f;
+		samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+		samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+		samplerCreateInfo.compareEnable = VK_FALSE;
+		samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerCreateInfo.mipLodBias = 0.0f;
+		samplerCreateInfo.minLod = 0.0f;
+		samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+		if (vkCreateSampler(m_device.getDevice(), &samplerCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_sampler) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create Hi-Z sampler.");
+		}
+	}
+
+	void HiZBuffer::createDescriptorSetLayout() {
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+		bindings[0].binding = 0;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		bindings[0].descriptorCount = 1;
+		bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		bindings[0].pImmutableSamplers = nullptr;
+
+		bindings[1].binding = 1;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		bindings[1].descriptorCount = 1;
+		bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		bindings[1].pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create Hi-Z descriptor set layout.");
+		}
+	}
+
+	void HiZBuffer::createDescriptorSets() {
+		if (m_descriptorPool != VK_NULL_HANDLE) {
+			vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		}
+
+		const std::uint32_t setCount = m_frameCount + m_mipLevelCount - 1;
+
+		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
+		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorPoolSizes[0].descriptorCount = setCount;
+		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		descriptorPoolSizes[1].descriptorCount = setCount;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<std::uint32_t>(descriptorPoolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
+		descriptorPoolCreateInfo.maxSets = setCount;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create Hi-Z descriptor pool.");
+		}
+
+		std::vector<VkDescriptorSetLayout> layouts(setCount, m_descriptorSetLayout);
+		std::vector<VkDescriptorSet> descriptorSets(setCount);
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = setCount;
+		descriptorSetAllocateInfo.pSetLayouts = layouts.data();
+
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, descriptorSets.data()) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate Hi-Z descriptor sets.");
+		}
+
+		m_depthDescriptorSets.assign(descriptorSets.begin(), descriptorSets.begin() + m_frameCount);
+		m_mipDescriptorSets.assign(descriptorSets.begin() + m_frameCount, descriptorSets.end());
+		m_depthImageViews.assign(m_frameCount, VK_NULL_HANDLE);
+
+		for (std::uint32_t level = 1; level < m_mipLevelCount; ++level) {
+			writeDescriptorSet(m_mipDescriptorSets[level - 1], m_mipImageViews[level - 1], VK_IMAGE_LAYOUT_GENERAL, m_mipImageViews[level]);
+		}
+	}
+
+	void HiZBuffer::createPipeline() {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstantData);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create Hi-Z pipeline layout.");
+		}
+
+		m_pipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/hiz_build.comp.spv", m_pipelineLayout);
+	}
+
+	void HiZBuffer::writeDescriptorSet(VkDescriptorSet descriptorSet, VkImageView sourceView, VkImageLayout sourceLayout, VkImageView destinationView) {
+		VkDescriptorImageInfo sourceImageInfo{};
+		sourceImageInfo.sampler = m_sampler;
+		sourceImageInfo.imageView = sourceView;
+		sourceImageInfo.imageLayout = sourceLayout;
+
+		VkDescriptorImageInfo destinationImageInfo{};
+		destinationImageInfo.sampler = VK_NULL_HANDLE;
+		destinationImageInfo.imageView = destinationView;
+		destinationImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+		std::array<VkWriteDescriptorSet, 2> writeDescriptorSets{};
+		for (std::uint32_t i = 0; i < writeDescriptorSets.size(); ++i) {
+			writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSets[i].pNext = nullptr;
+			writeDescriptorSets[i].dstSet = descriptorSet;
+			writeDescriptorSets[i].dstBinding = i;
+			writeDescriptorSets[i].dstArrayElement = 0;
+			writeDescriptorSets[i].descriptorCount = 1;
+		}
+
+		writeDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writeDescriptorSets[0].pImageInfo = &sourceImageInfo;
+		writeDescriptorSets[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		writeDescriptorSets[1].pImageInfo = &destinationImageInfo;
+
+		vkUpdateDescriptorSets(m_device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+
+	VkExtent2D HiZBuffer::getMipExtent(std::uint32_t level) const {
+		return { std::max(m_extent.width >> level, 1u), std::max(m_extent.height >> level, 1u) };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef HI_Z_BUFFER_H
+#define HI_Z_BUFFER_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "ComputePipeline.h"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class HiZBuffer {
+	public:
+		HiZBuffer(Device &device, VkExtent2D depthExtent, std::uint32_t frameCount);
+		~HiZBuffer();
+
+		HiZBuffer(const HiZBuffer &) = delete;
+		HiZBuffer &operator=(const HiZBuffer &) = delete;
+
+		void resize(VkExtent2D depthExtent);
+		void build(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, VkImageView depthImageView);
+
+		VkImageView getImageView() const;
+		VkSampler getSampler() const;
+		VkExtent2D getDepthExtent() const;
+		VkExtent2D getExtent() const;
+		std::uint32_t getMipLevelCount() const;
+	private:
+		struct PushConstantData {
+			std::uint32_t sourceWidth;
+			std::uint32_t sourceHeight;
+			std::uint32_t destinationWidth;
+			std::uint32_t destinationHeight;
+		};
+
+		void createImage();
+		void destroyImage();
+		void createSampler();
+		void createDescriptorSetLayout();
+		void createDescriptorSets();
+		void createPipeline();
+
+		void writeDescriptorSet(VkDescriptorSet descriptorSet, VkImageView sourceView, VkImageLayout sourceLayout, VkImageView destinationView);
+		VkExtent2D getMipExtent(std::uint32_t level) const;
+
+		Device &m_device;
+		VkExtent2D m_depthExtent;
+		std::uint32_t m_frameCount;
+
+		VkImage m_image = VK_NULL_HANDLE;
+		VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+		VkImageView m_imageView = VK_NULL_HANDLE;
+		std::vector<VkImageView> m_mipImageViews;
+		VkExtent2D m_extent{};
+		std::uint32_t m_mipLevelCount = 0;
+		VkSampler m_sampler;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+		std::vector<VkDescriptorSet> m_depthDescriptorSets;
+		std::vector<VkImageView> m_depthImageViews;
+		std::vector<VkDescriptorSet> m_mipDescriptorSets;
+		VkPipelineLayout m_pipelineLayout;
+		std::unique_ptr<ComputePipeline> m_pipeline;
+
+		static constexpr std::uint32_t GROUP_SIZE = 8;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "KtxTexture.h"
+
+namespace eng {
+	namespace {
+		const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+		struct Ktx2Header {
+			unsigned char identifier[12];
+			std::uint32_t vkFormat;
+			std::uint32_t typeSize;
+			std::uint32_t pixelWidth;
+			std::uint32_t pixelHeight;
+			std::uint32_t pixelDepth;
+			std::uint32_t layerCount;
+			std::uint32_t faceCount;
+			std::uint32_t levelCount;
+			std::uint32_t supercompressionScheme;
+			std::uint32_t dfdByteOffset;
+			std::uint32_t dfdByteLength;
+			std::uint32_t kvdByteOffset;
+			std::uint32_t kvdByteLength;
+			std::uint64_t sgdByteOffset;
+			std::uint64_t sgdByteLength;
+		};
+
+		struct Ktx2LevelIndex {
+			std::uint64_t byteOffset;
+			std::uint64_t byteLength;
+			std::uint64_t uncompressedByteLength;
+		};
+	}
+
+	KtxTexture::KtxTexture(const std::string &filename) : m_filename(filename) {
+		std::ifstream file(filename, std::ios::binary);
+		if (!file.is_open()) {
+			throw std::runtime_error("Failed to open texture file: " + filename);
+		}
+
+		Ktx2Header header{};
+		file.read(reinterpret_cast<char *>(&header), sizeof(header));
+		if (!file || std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+			throw std::runtime_error("Failed to parse KTX2 header: " + filename);
+		}
+
+		if (header.supercompressionScheme != 0) {
+			throw std::runtime_error("Supercompressed KTX2 textures are not supported: " + filename);
+		}
+
+		if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1) {
+			throw std::runtime_error("Only 2D KTX2 textures are supported: " + filename);
+		}
+
+		m_format = static_cast<VkFormat>(header.vkFormat);
+		m_width = header.pixelWidth;
+		m_height = std::max(header.pixelHeight, 1u);
+
+		if (getFormatInfo(m_format).blockSize == 0) {
+			throw std::runtime_error("Unsupported KTX2 texture format: " + filename);
+		}
+
+		m_needsMipGeneration = header.levelCount == 0;
+
+		std::uint32_t maxLevelCount = 1;
+		while ((std::max(m_width, m_height) >> maxLevelCount) > 0) {
+			++maxLevelCount;
+		}
+
+		if (header.levelCount > maxLevelCount) {
+			throw std::runtime_error("Invalid KTX2 level count: " + filename);
+		}
+
+		std::vector<Ktx2LevelIndex> levelIndices(std::max(header.levelCount, 1u));
+		file.read(reinterpret_cast<char *>(levelIndices.data()), levelIndices.size() * sizeof(Ktx2LevelIndex));
+		if (!file) {
+			throw std::runtime_error("Failed to read KTX2 level index: " + filename);
+		}
+
+		file.seekg(0, std::ios::end);
+		std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
+
+		FormatInfo formatInfo = getFormatInfo(m_format);
+		for (std::uint32_t i = 0; i < levelIndices.size(); ++i) {
+			Level level{};
+			level.byteOffset = levelIndices[i].byteOffset;
+			level.byteLength = levelIndices[i].byteLength;
+			level.width = std::max(m_width >> i, 1u);
+			level.height = std::max(m_height >> i, 1u);
+
+			std::uint64_t blockCountX = (level.width + formatInfo.blockWidth - 1) / formatInfo.blockWidth;
+			std::uint64_t blockCountY = (level.height + formatInfo.blockHeight - 1) / formatInfo.blockHeight;
+			if (level.byteLength < blockCountX * blockCountY * formatInfo.blockSize) {
+				throw std::runtime_error("KTX2 level is smaller than its dimensions require: " + filename);
+			}
+
+			if (level.byteOffset > fileSize || level.byteLength > fileSize - level.byteOffset) {
+				throw std::runtime_error("KTX2 level extends past the end of the file: " + filename);
+			}
+
+			m_levels.push_back(level);
+		}
+	}
+
+	void KtxTexture::readLevel(std::uint32_t level, void *destination) const {
+		std::ifstream file(m_filename, std::ios::binary);
+		file.seekg(static_cast<std::streamoff>(m_levels[level].byteOffset));
+		file.read(static_cast<char *>(destination), static_cast<std::streamsize>(m_levels[level].byteLength));
+
+		if (!file) {
+			throw std::runtime_error("Failed to read KTX2 level: " + m_filename);
+		}
+	}
+
+	VkFormat KtxTexture::getFormat() const {
+		return m_format;
+	}
+
+	std::uint32_t KtxTexture::getWidth() const {
+		return m_width;
+	}
+
+	std::uint32_t KtxTexture::getHeight() const {
+		return m_height;
+	}
+
+	std::uint32_t KtxTexture::getLevelCount() const {
+		return static_cast<std::uint32_t>(m_levels.size());
+	}
+
+	const KtxTexture::Level &KtxTexture::getLevel(std::uint32_t level) const {
+		return m_levels[level];
+	}
+
+	bool KtxTexture::isCompressed() const {
+		return getFormatInfo(m_format).compressed;
+	}
+
+	bool KtxTexture::needsMipGeneration() const {
+		return m_needsMipGeneration;
+	}
+
+	KtxTexture::FormatInfo KtxTexture::getFormatInfo(VkFormat format) {
+		switch (format) {
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SRGB:
+		case VK_FORMAT_B8G8R8A8_UNORM:
+		case VK_FORMAT_B8G8R8A8_SRGB:
+			return { 1, 1, 4, false };
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC4_UNORM_BLOCK:
+		case VK_FORMAT_BC4_SNORM_BLOCK:
+			return { 4, 4, 8, true };
+		case VK_FORMAT_BC2_UNORM_BLOCK:
+		case VK_FORMAT_BC2_SRGB_BLOCK:
+		case VK_FORMAT_BC3_UNORM_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+		case VK_FORMAT_BC5_SNORM_BLOCK:
+		case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+		case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+		case VK_FORMAT_BC7_UNORM_BLOCK:
+		case VK_FORMAT_BC7_SRGB_BLOCK:
+			return { 4, 4, 16, true };
+		case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+		case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+			return { 4, 4, 16, true };
+		case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+		case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+			return { 6, 6, 16, true };
+		case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+		case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+			return { 8, 8, 16, true };
+		default:
+			return {};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef KTX_TEXTURE_H
+#define KTX_TEXTURE_H
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class KtxTexture {
+	public:
+		struct Level {
+			std::uint64_t byteOffset = 0;
+			std::uint64_t byteLength = 0;
+			std::uint32_t width = 0;
+			std::uint32_t height = 0;
+		};
+
+		struct FormatInfo {
+			std::uint32_t blockWidth = 1;
+			std::uint32_t blockHeight = 1;
+			std::uint32_t blockSize = 0;
+			bool compressed = false;
+		};
+
+		KtxTexture(const std::string &filename);
+
+		void readLevel(std::uint32_t level, void *destination) const;
+
+		VkFormat getFormat() const;
+		std::uint32_t getWidth() const;
+		std::uint32_t getHeight() const;
+		std::uint32_t getLevelCount() const;
+		const Level &getLevel(std::uint32_t level) const;
+		bool isCompressed() const;
+		bool needsMipGeneration() const;
+
+		static FormatInfo getFormatInfo(VkFormat format);
+	private:
+		std::string m_filename;
+
+		VkFormat m_format;
+		std::uint32_t m_width;
+		std::uint32_t m_height;
+		bool m_needsMipGeneration = false;
+		std::vector<Level> m_levels;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -1,8 +1,20 @@
 #include "Application.h"
+#include "Benchmark.h"
 
 #include <stdexcept>
+#include <string>
+
+int main(int argc, char **argv) {
+	if (argc > 2 && std::string(argv[1]) == "--benchmark") {
+		try {
+			return eng::Benchmark::run(argv[2]);
+		} catch (const std::exception &exception) {
+			std::cerr << exception.what() << '\n';
+
+			return EXIT_FAILURE;
+		}
+	}
 
-int main(void) {
 	eng::Application application{};
 	try {
 		application.run();
@@ -0,0 +1,208 @@
+#include "MemoryBudget.h"
+
+namespace eng {
+	MemoryBudget::MemoryBudget(VkPhysicalDevice physicalDevice, bool memoryBudgetSupported)
+		: m_physicalDevice(physicalDevice), m_memoryBudgetSupported(memoryBudgetSupported) {
+		vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &m_memoryProperties);
+
+		m_heaps.resize(m_memoryProperties.memoryHeapCount);
+		for (std::uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; ++i) {
+			m_heaps[i].size = m_memoryProperties.memoryHeaps[i].size;
+			m_heaps[i].deviceLocal = (m_memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+
+			if (m_heaps[i].deviceLocal) {
+				m_deviceLocalSize += m_heaps[i].size;
+			}
+		}
+
+		update();
+	}
+
+	void MemoryBudget::recordAllocation(VkDeviceMemory memory, std::uint32_t memoryTypeIndex, VkDeviceSize size, MemoryCategory category) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::uint32_t heapIndex = m_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+		m_allocations[memory] = { heapIndex, category, size };
+
+		HeapStatistics &heap = m_heaps[heapIndex];
+		heap.trackedUsage += size;
+		heap.categoryUsage[static_cast<std::size_t>(category)] += size;
+		++heap.allocationCount;
+	}
+
+	void MemoryBudget::recordFree(VkDeviceMemory memory) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto allocation = m_allocations.find(memory);
+		if (allocation == m_allocations.end()) {
+			return;
+		}
+
+		HeapStatistics &heap = m_heaps[allocation->second.heapIndex];
+		heap.trackedUsage -= allocation->second.size;
+		heap.categoryUsage[static_cast<std::size_t>(allocation->second.category)] -= allocation->second.size;
+		--heap.allocationCount;
+
+		m_allocations.erase(allocation);
+	}
+
+	void MemoryBudget::update() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_memoryBudgetSupported) {
+			for (HeapStatistics &heap : m_heaps) {
+				heap.budget = static_cast<VkDeviceSize>(static_cast<double>(heap.size) * FALLBACK_BUDGET_FRACTION);
+				heap.usage = heap.trackedUsage;
+			}
+
+			return;
+		}
+
+		VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudgetProperties{};
+		memoryBudgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+		memoryBudgetProperties.pNext = nullptr;
+
+		VkPhysicalDeviceMemoryProperties2 memoryProperties{};
+		memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+		memoryProperties.pNext = &memoryBudgetProperties;
+
+		vkGetPhysicalDeviceMemoryProperties2(m_physicalDevice, &memoryProperties);
+
+		for (std::uint32_t i = 0; i < m_heaps.size(); ++i) {
+			m_heaps[i].budget = memoryBudgetProperties.heapBudget[i];
+			m_heaps[i].usage = std::max(memoryBudgetProperties.heapUsage[i], m_heaps[i].trackedUsage);
+		}
+	}
+
+	void MemoryBudget::setBudget(VkDeviceSize budget) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_budget = budget;
+	}
+
+	VkDeviceSize MemoryBudget::getBudget() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_budget;
+	}
+
+	std::uint32_t MemoryBudget::getHeapCount() const {
+		return static_cast<std::uint32_t>(m_heaps.size());
+	}
+
+	MemoryBudget::HeapStatistics MemoryBudget::getHeapStatistics(std::uint32_t heapIndex) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		HeapStatistics heap = m_heaps[heapIndex];
+		heap.budget = getEffectiveBudget(heap);
+
+		return heap;
+	}
+
+	VkDeviceSize MemoryBudget::getCategoryUsage(MemoryCategory category) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		VkDeviceSize usage = 0;
+		for (const HeapStatistics &heap : m_heaps) {
+			usage += heap.categoryUsage[static_cast<std::size_t>(category)];
+		}
+
+		return usage;
+	}
+
+	VkDeviceSize MemoryBudget::getDeviceLocalBudget() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return getDeviceLocalBudgetUnlocked();
+	}
+
+	VkDeviceSize MemoryBudget::getDeviceLocalUsage() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		VkDeviceSize usage = 0;
+		for (const HeapStatistics &heap : m_heaps) {
+			if (heap.deviceLocal) {
+				usage += heap.usage;
+			}
+		}
+
+		return usage;
+	}
+
+	VkDeviceSize MemoryBudget::getAvailableBytes(MemoryCategory category) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		VkDeviceSize budget = getDeviceLocalBudgetUnlocked();
+		VkDeviceSize otherUsage = 0;
+		for (const HeapStatistics &heap : m_heaps) {
+			if (!heap.deviceLocal) {
+				continue;
+			}
+
+			otherUsage += heap.usage - std::min(heap.usage, heap.categoryUsage[static_cast<std::size_t>(category)]);
+		}
+
+		return budget > otherUsage ? budget - otherUsage : 0;
+	}
+
+	bool MemoryBudget::isMemoryBudgetSupported() const {
+		return m_memoryBudgetSupported;
+	}
+
+	void MemoryBudget::printUsage() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		const double megabyte = 1024.0 * 1024.0;
+
+		std::cout << "Memory heaps (" << (m_memoryBudgetSupported ? "VK_EXT_memory_budget" : "estimated") << "):\n";
+		for (std::uint32_t i = 0; i < m_heaps.size(); ++i) {
+			const HeapStatistics &heap = m_heaps[i];
+
+			std::cout << "\tHeap " << i << (heap.deviceLocal ? " (device local)" : "") << ": ";
+			std::cout << heap.usage / megabyte << " / " << getEffectiveBudget(heap) / megabyte << " MB budget, ";
+			std::cout << heap.size / megabyte << " MB total, " << heap.allocationCount << " allocations\n";
+
+			for (std::size_t category = 0; category < CATEGORY_COUNT; ++category) {
+				if (heap.categoryUsage[category] > 0) {
+					std::cout << "\t\t" << getCategoryName(static_cast<MemoryCategory>(category)) << ": " << heap.categoryUsage[category] / megabyte << " MB\n";
+				}
+			}
+		}
+	}
+
+	const char *MemoryBudget::getCategoryName(MemoryCategory category) {
+		switch (category) {
+		case MemoryCategory::Mesh:
+			return "Meshes";
+		case MemoryCategory::Texture:
+			return "Textures";
+		case MemoryCategory::RenderTarget:
+			return "Render targets";
+		case MemoryCategory::Transient:
+			return "Transient";
+		default:
+			return "Other";
+		}
+	}
+
+	VkDeviceSize MemoryBudget::getEffectiveBudget(const HeapStatistics &heap) const {
+		if (m_budget > 0 && heap.deviceLocal && m_deviceLocalSize > 0) {
+			double share = static_cast<double>(heap.size) / static_cast<double>(m_deviceLocalSize);
+			return std::min(heap.budget, static_cast<VkDeviceSize>(static_cast<double>(m_budget) * share));
+		}
+
+		return heap.budget;
+	}
+
+	VkDeviceSize MemoryBudget::getDeviceLocalBudgetUnlocked() const {
+		VkDeviceSize budget = 0;
+		for (const HeapStatistics &heap : m_heaps) {
+			if (heap.deviceLocal) {
+				budget += getEffectiveBudget(heap);
+			}
+		}
+
+		if (m_budget > 0) {
+			budget = std::min(budget, m_budget);
+		}
+
+		return budget;
+	}
+}
\ No newline at end of file
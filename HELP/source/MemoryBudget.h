@@ -0,0 +1,85 @@
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <iostream>
+#include <cstdint>
+#include <algorithm>
+
+namespace eng {
+	enum class MemoryCategory : std::uint32_t {
+		Mesh,
+		Texture,
+		RenderTarget,
+		Transient,
+		Other,
+		Count
+	};
+
+	class MemoryBudget {
+	public:
+		static constexpr std::size_t CATEGORY_COUNT = static_cast<std::size_t>(MemoryCategory::Count);
+
+		struct HeapStatistics {
+			VkDeviceSize size = 0;
+			VkDeviceSize budget = 0;
+			VkDeviceSize usage = 0;
+			VkDeviceSize trackedUsage = 0;
+			std::uint32_t allocationCount = 0;
+			bool deviceLocal = false;
+			std::array<VkDeviceSize, CATEGORY_COUNT> categoryUsage{};
+		};
+
+		MemoryBudget(VkPhysicalDevice physicalDevice, bool memoryBudgetSupported);
+
+		MemoryBudget(const MemoryBudget &) = delete;
+		MemoryBudget &operator=(const MemoryBudget &) = delete;
+
+		void recordAllocation(VkDeviceMemory memory, std::uint32_t memoryTypeIndex, VkDeviceSize size, MemoryCategory category);
+		void recordFree(VkDeviceMemory memory);
+		void update();
+
+		void setBudget(VkDeviceSize budget);
+		VkDeviceSize getBudget() const;
+
+		std::uint32_t getHeapCount() const;
+		HeapStatistics getHeapStatistics(std::uint32_t heapIndex) const;
+		VkDeviceSize getCategoryUsage(MemoryCategory category) const;
+		VkDeviceSize getDeviceLocalBudget() const;
+		VkDeviceSize getDeviceLocalUsage() const;
+		VkDeviceSize getAvailableBytes(MemoryCategory category) const;
+		bool isMemoryBudgetSupported() const;
+
+		void printUsage() const;
+
+		static const char *getCategoryName(MemoryCategory category);
+
+		static constexpr float FALLBACK_BUDGET_FRACTION = 0.8f;
+	private:
+		struct Allocation {
+			std::uint32_t heapIndex;
+			MemoryCategory category;
+			VkDeviceSize size;
+		};
+
+		VkDeviceSize getEffectiveBudget(const HeapStatistics &heap) const;
+		VkDeviceSize getDeviceLocalBudgetUnlocked() const;
+
+		VkPhysicalDevice m_physicalDevice;
+		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+		bool m_memoryBudgetSupported;
+		VkDeviceSize m_budget = 0;
+		VkDeviceSize m_deviceLocalSize = 0;
+
+		std::vector<HeapStatistics> m_heaps;
+		std::unordered_map<VkDeviceMemory, Allocation> m_allocations;
+		mutable std::mutex m_mutex;
+	};
+}
+
+#endif
\ No newline at end of file
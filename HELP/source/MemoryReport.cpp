@@ -0,0 +1,119 @@
+#include "MemoryReport.h"
+
+namespace eng {
+	MemoryReport::MemoryReport(const MemoryBudget *memoryBudget)
+		: m_memoryBudget(memoryBudget), m_lastTotal(AllocationTracker::getTotalStatistics()) {
+	}
+
+	void MemoryReport::markFrame() {
+		++m_frameCount;
+	}
+
+	MemoryReport::Snapshot MemoryReport::capture() {
+		Snapshot snapshot{};
+		for (std::size_t i = 0; i < AllocationTracker::CATEGORY_COUNT; ++i) {
+			snapshot.categories[i] = AllocationTracker::getStatistics(static_cast<AllocationCategory>(i));
+		}
+		snapshot.total = AllocationTracker::getTotalStatistics();
+
+		if (m_memoryBudget != nullptr) {
+			snapshot.heaps.reserve(m_memoryBudget->getHeapCount());
+			for (std::uint32_t i = 0; i < m_memoryBudget->getHeapCount(); ++i) {
+				snapshot.heaps.push_back(m_memoryBudget->getHeapStatistics(i));
+			}
+		}
+
+		snapshot.frameCount = m_frameCount;
+		snapshot.intervalFrameCount = m_frameCount - m_lastFrameCount;
+		if (snapshot.intervalFrameCount > 0) {
+			double frameCount = static_cast<double>(snapshot.intervalFrameCount);
+			snapshot.allocationsPerFrame = (snapshot.total.allocationCount - m_lastTotal.allocationCount) / frameCount;
+			snapshot.deallocationsPerFrame = (snapshot.total.deallocationCount - m_lastTotal.deallocationCount) / frameCount;
+			snapshot.bytesPerFrame = (snapshot.total.allocatedBytes - m_lastTotal.allocatedBytes) / frameCount;
+		}
+
+		m_lastFrameCount = m_frameCount;
+		m_lastTotal = snapshot.total;
+
+		return snapshot;
+	}
+
+	void MemoryReport::print(const Snapshot &snapshot) {
+		const double kilobyte = 1024.0;
+
+		std::cout << "Host memory: " << snapshot.total.currentBytes / kilobyte << " KB (peak " << snapshot.total.peakBytes / kilobyte << " KB)";
+		std::cout << ", " << snapshot.allocationsPerFrame << " allocations/frame";
+		std::cout << ", " << snapshot.bytesPerFrame / kilobyte << " KB/frame\n";
+
+		for (std::size_t i = 0; i < AllocationTracker::CATEGORY_COUNT; ++i) {
+			const AllocationTracker::Statistics &statistics = snapshot.categories[i];
+			if (statistics.allocationCount == 0) {
+				continue;
+			}
+
+			std::cout << "\t" << AllocationTracker::getCategoryName(static_cast<AllocationCategory>(i)) << ": ";
+			std::cout << statistics.currentBytes / kilobyte << " KB (peak " << statistics.peakBytes / kilobyte << " KB), ";
+			std::cout << statistics.allocationCount - statistics.deallocationCount << " live allocations\n";
+		}
+	}
+
+	void MemoryReport::writeJson(std::ostream &stream, const Snapshot &snapshot) {
+		stream << "{\n";
+		stream << "\t\"frameCount\": " << snapshot.frameCount << ",\n";
+		stream << "\t\"intervalFrameCount\": " << snapshot.intervalFrameCount << ",\n";
+		stream << "\t\"allocationsPerFrame\": " << snapshot.allocationsPerFrame << ",\n";
+		stream << "\t\"deallocationsPerFrame\": " << snapshot.deallocationsPerFrame << ",\n";
+		stream << "\t\"bytesPerFrame\": " << snapshot.bytesPerFrame << ",\n";
+		stream << "\t\"host\": {\n";
+		stream << "\t\t\"total\": ";
+		writeJson(stream, snapshot.total);
+		stream << ",\n\t\t\"categories\": {";
+
+		for (std::size_t i = 0; i < AllocationTracker::CATEGORY_COUNT; ++i) {
+			stream << (i == 0 ? "\n" : ",\n") << "\t\t\t\"" << AllocationTracker::getCategoryName(static_cast<AllocationCategory>(i)) << "\": ";
+			writeJson(stream, snapshot.categories[i]);
+		}
+
+		stream << "\n\t\t}\n\t},\n";
+		stream << "\t\"device\": [";
+
+		for (std::size_t i = 0; i < snapshot.heaps.size(); ++i) {
+			const MemoryBudget::HeapStatistics &heap = snapshot.heaps[i];
+
+			stream << (i == 0 ? "\n" : ",\n") << "\t\t{ \"heap\": " << i;
+			stream << ", \"deviceLocal\": " << (heap.deviceLocal ? "true" : "false");
+			stream << ", \"size\": " << heap.size;
+			stream << ", \"budget\": " << heap.budget;
+			stream << ", \"usage\": " << heap.usage;
+			stream << ", \"trackedUsage\": " << heap.trackedUsage;
+			stream << ", \"allocationCount\": " << heap.allocationCount;
+			stream << ", \"categories\": {";
+
+			for (std::size_t category = 0; category < MemoryBudget::CATEGORY_COUNT; ++category) {
+				stream << (category == 0 ? " " : ", ") << "\"" << MemoryBudget::getCategoryName(static_cast<MemoryCategory>(category)) << "\": " << heap.categoryUsage[category];
+			}
+
+			stream << " } }";
+		}
+
+		stream << (snapshot.heaps.empty() ? "]\n" : "\n\t]\n");
+		stream << "}\n";
+	}
+
+	void MemoryReport::exportJson(const std::string &path, const Snapshot &snapshot) {
+		std::ofstream file(path);
+		if (!file) {
+			throw std::runtime_error("Failed to open memory report file: " + path);
+		}
+
+		writeJson(file, snapshot);
+	}
+
+	void MemoryReport::writeJson(std::ostream &stream, const AllocationTracker::Statistics &statistics) {
+		stream << "{ \"currentBytes\": " << statistics.currentBytes;
+		stream << ", \"peakBytes\": " << statistics.peakBytes;
+		stream << ", \"allocatedBytes\": " << statistics.allocatedBytes;
+		stream << ", \"allocationCount\": " << statistics.allocationCount;
+		stream << ", \"deallocationCount\": " << statistics.deallocationCount << " }";
+	}
+}
\ No newline at end of file
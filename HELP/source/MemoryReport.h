@@ -0,0 +1,49 @@
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <vulkan/vulkan.h>
+
+#include "AllocationTracker.h"
+#include "MemoryBudget.h"
+
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+
+namespace eng {
+	class MemoryReport {
+	public:
+		struct Snapshot {
+			std::array<AllocationTracker::Statistics, AllocationTracker::CATEGORY_COUNT> categories{};
+			AllocationTracker::Statistics total{};
+			std::vector<MemoryBudget::HeapStatistics> heaps;
+			std::uint64_t frameCount = 0;
+			std::uint64_t intervalFrameCount = 0;
+			double allocationsPerFrame = 0.0;
+			double deallocationsPerFrame = 0.0;
+			double bytesPerFrame = 0.0;
+		};
+
+		explicit MemoryReport(const MemoryBudget *memoryBudget = nullptr);
+
+		void markFrame();
+		Snapshot capture();
+
+		static void print(const Snapshot &snapshot);
+		static void writeJson(std::ostream &stream, const Snapshot &snapshot);
+		static void exportJson(const std::string &path, const Snapshot &snapshot);
+	private:
+		static void writeJson(std::ostream &stream, const AllocationTracker::Statistics &statistics);
+
+		const MemoryBudget *m_memoryBudget;
+		std::uint64_t m_frameCount = 0;
+		std::uint64_t m_lastFrameCount = 0;
+		AllocationTracker::Statistics m_lastTotal{};
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include "MeshSimplifier.h"
+
+namespace eng {
+	MeshSimplifier::Quadric MeshSimplifier::Quadric::fromPlane(const glm::vec3 &normal, float distance, float weight) {
+		Quadric quadric{};
+		quadric.a2 = weight * normal.x * normal.x;
+		quadric.ab = weight * normal.x * normal.y;
+		quadric.ac = weight * normal.x * normal.z;
+		quadric.ad = weight * normal.x * distance;
+		quadric.b2 = weight * normal.y * normal.y;
+		quadric.bc = weight * normal.y * normal.z;
+		quadric.bd = weight * normal.y * distance;
+		quadric.c2 = weight * normal.z * normal.z;
+		quadric.cd = weight * normal.z * distance;
+		quadric.d2 = weight * distance * distance;
+		quadric.weight = weight;
+
+		return quadric;
+	}
+
+	void MeshSimplifier::Quadric::add(const Quadric &quadric) {
+		a2 += quadric.a2;
+		ab += quadric.ab;
+		ac += quadric.ac;
+		ad += quadric.ad;
+		b2 += quadric.b2;
+		bc += quadric.bc;
+		bd += quadric.bd;
+		c2 += quadric.c2;
+		cd += quadric.cd;
+		d2 += quadric.d2;
+		weight += quadric.weight;
+	}
+
+	double MeshSimplifier::Quadric::evaluate(const glm::vec3 &point) const {
+		double x = point.x;
+		double y = point.y;
+		double z = point.z;
+
+		double error =
+			a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+			b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+			c2 * z * z + 2.0 * cd * z +
+			d2;
+
+		if (weight > 0.0) {
+			error /= weight;
+		}
+
+		return error < 0.0 ? 0.0 : error;
+	}
+
+	bool MeshSimplifier::Collapse::operator>(const Collapse &other) const {
+		return cost > other.cost;
+	}
+
+	MeshSimplifier::MeshSimplifier(const glm::vec3 *positions, std::size_t vertexCount, std::size_t stride)
+		: m_positions(vertexCount), m_remap(vertexCount), m_seamVertices(vertexCount, false) {
+		const unsigned char *bytes = reinterpret_cast<const unsigned char *>(positions);
+		for (std::size_t i = 0; i < vertexCount; ++i) {
+			m_positions[i] = *reinterpret_cast<const glm::vec3 *>(bytes + i * stride);
+		}
+
+		struct PositionHash {
+			std::size_t operator()(const glm::vec3 &position) const {
+				std::hash<float> hasher{};
+				return hasher(position.x) ^ (hasher(position.y) << 1) ^ (hasher(position.z) << 2);
+			}
+		};
+
+		struct PositionEqual {
+			bool operator()(const glm::vec3 &a, const glm::vec3 &b) const {
+				return a.x == b.x && a.y == b.y && a.z == b.z;
+			}
+		};
+
+		std::unordered_map<std::string, std::uint32_t> firstVertex;
+		std::unordered_map<glm::vec3, std::uint32_t, PositionHash, PositionEqual> firstPosition;
+		for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(vertexCount); ++i) {
+			std::string key(reinterpret_cast<const char *>(bytes + i * stride), stride);
+
+			auto [vertexIt, vertexInserted] = firstVertex.emplace(key, i);
+			m_remap[i] = vertexIt->second;
+			if (!vertexInserted) {
+				continue;
+			}
+
+			auto [positionIt, positionInserted] = firstPosition.emplace(m_positions[i], i);
+			if (!positionInserted) {
+				m_seamVertices[i] = true;
+				m_seamVertices[positionIt->second] = true;
+			}
+		}
+	}
+
+	std::vector<std::uint32_t> MeshSimplifier::simplify(const std::vector<std::uint32_t> &sourceIndices, std::size_t targetIndexCount, float maxError) const {
+		const std::size_t vertexCount = m_positions.size();
+
+		std::vector<std::uint32_t> indices;
+		indices.reserve(sourceIndices.size());
+		for (std::size_t i = 0; i + 2 < sourceIndices.size(); i += 3) {
+			std::uint32_t i0 = m_remap[sourceIndices[i + 0]];
+			std::uint32_t i1 = m_remap[sourceIndices[i + 1]];
+			std::uint32_t i2 = m_remap[sourceIndices[i + 2]];
+
+			if (i0 != i1 && i1 != i2 && i0 != i2) {
+				indices.insert(indices.end(), { i0, i1, i2 });
+			}
+		}
+
+		const std::size_t triangleCount = indices.size() / 3;
+		std::vector<bool> removedTriangles(triangleCount, false);
+		std::vector<std::vector<std::uint32_t>> vertexTriangles(vertexCount);
+		std::vector<Quadric> quadrics(vertexCount);
+
+		for (std::uint32_t triangle = 0; triangle < triangleCount; ++triangle) {
+			std::uint32_t i0 = indices[triangle * 3 + 0];
+			std::uint32_t i1 = indices[triangle * 3 + 1];
+			std::uint32_t i2 = indices[triangle * 3 + 2];
+
+			glm::vec3 normal = glm::cross(getPosition(i1) - getPosition(i0), getPosition(i2) - getPosition(i0));
+			float area = glm::length(normal);
+			if (area > 0.0f) {
+				normal /= area;
+			}
+
+			Quadric quadric = Quadric::fromPlane(normal, -glm::dot(normal, getPosition(i0)), area);
+			quadrics[i0].add(quadric);
+			quadrics[i1].add(quadric);
+			quadrics[i2].add(quadric);
+
+			vertexTriangles[i0].push_back(triangle);
+			vertexTriangles[i1].push_back(triangle);
+			vertexTriangles[i2].push_back(triangle);
+		}
+
+		std::unordered_map<std::uint64_t, std::uint32_t> edgeUses;
+		auto edgeKey = [](std::uint32_t a, std::uint32_t b) {
+			return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+		};
+
+		for (std::uint32_t triangle = 0; triangle < triangleCount; ++triangle) {
+			for (int e = 0; e < 3; ++e) {
+				++edgeUses[edgeKey(indices[triangle * 3 + e], indices[triangle * 3 + (e + 1) % 3])];
+			}
+		}
+
+		std::vector<bool> boundaryVertices(vertexCount, false);
+		for (std::uint32_t triangle = 0; triangle < triangleCount; ++triangle) {
+			for (int e = 0; e < 3; ++e) {
+				std::uint32_t a = indices[triangle * 3 + e];
+				std::uint32_t b = indices[triangle * 3 + (e + 1) % 3];
+				if (edgeUses[edgeKey(a, b)] != 1) {
+					continue;
+				}
+
+				std::uint32_t c = indices[triangle * 3 + (e + 2) % 3];
+				glm::vec3 edge = getPosition(b) - getPosition(a);
+				glm::vec3 faceNormal = glm::cross(edge, getPosition(c) - getPosition(a));
+				glm::vec3 planeNormal = glm::cross(edge, faceNormal);
+
+				float length = glm::length(planeNormal);
+				if (length == 0.0f) {
+					continue;
+				}
+				planeNormal /= length;
+
+				Quadric quadric = Quadric::fromPlane(planeNormal, -glm::dot(planeNormal, getPosition(a)), BOUNDARY_WEIGHT * glm::dot(edge, edge));
+				quadrics[a].add(quadric);
+				quadrics[b].add(quadric);
+				boundaryVertices[a] = true;
+				boundaryVertices[b] = true;
+			}
+		}
+
+		std::vector<std::uint32_t> versions(vertexCount, 0);
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+
+		auto pushCollapse = [&](std::uint32_t from, std::uint32_t to) {
+			if (from == to || m_seamVertices[from]) {
+				return;
+			}
+
+			Quadric quadric = quadrics[from];
+			quadric.add(quadrics[to]);
+
+			collapses.push(Collapse{ quadric.evaluate(getPosition(to)), from, to, versions[from], versions[to] });
+		};
+
+		for (const auto &[key, uses] : edgeUses) {
+			std::uint32_t a = static_cast<std::uint32_t>(key >> 32);
+			std::uint32_t b = static_cast<std::uint32_t>(key & 0xFFFFFFFF);
+			pushCollapse(a, b);
+			pushCollapse(b, a);
+		}
+
+		const double maxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+		std::size_t liveTriangles = triangleCount;
+		m_lastError = 0.0f;
+
+		while (liveTriangles * 3 > targetIndexCount && !collapses.empty()) {
+			Collapse collapse = collapses.top();
+			collapses.pop();
+
+			if (collapse.fromVersion != versions[collapse.from] || collapse.toVersion != versions[collapse.to]) {
+				continue;
+			}
+
+			if (collapse.cost > maxCost) {
+				break;
+			}
+
+			if (boundaryVertices[collapse.from] && !boundaryVertices[collapse.to]) {
+				continue;
+			}
+
+			bool flips = false;
+			for (std::uint32_t triangle : vertexTriangles[collapse.from]) {
+				if (!removedTriangles[triangle] && flipsTriangle(indices, triangle, collapse.from, collapse.to)) {
+					flips = true;
+					break;
+				}
+			}
+
+			if (flips) {
+				continue;
+			}
+
+			for (std::uint32_t triangle : vertexTriangles[collapse.from]) {
+				if (removedTriangles[triangle]) {
+					continue;
+				}
+
+				std::uint32_t *triangleIndices = &indices[triangle * 3];
+				for (int v = 0; v < 3; ++v) {
+					if (triangleIndices[v] == collapse.from) {
+						triangleIndices[v] = collapse.to;
+					}
+				}
+
+				if (triangleIndices[0] == triangleIndices[1] || triangleIndices[1] == triangleIndices[2] || triangleIndices[0] == triangleIndices[2]) {
+					removedTriangles[triangle] = true;
+					--liveTriangles;
+				} else {
+					vertexTriangles[collapse.to].push_back(triangle);
+				}
+			}
+
+			vertexTriangles[collapse.from].clear();
+			quadrics[collapse.to].add(quadrics[collapse.from]);
+			++versions[collapse.from];
+			++versions[collapse.to];
+
+			m_lastError = std::max(m_lastError, static_cast<float>(std::sqrt(collapse.cost)));
+
+			for (std::uint32_t triangle : vertexTriangles[collapse.to]) {
+				if (removedTriangles[triangle]) {
+					continue;
+				}
+
+				for (int v = 0; v < 3; ++v) {
+					std::uint32_t neighbor = indices[triangle * 3 + v];
+					if (neighbor != collapse.to) {
+						pushCollapse(neighbor, collapse.to);
+						pushCollapse(collapse.to, neighbor);
+					}
+				}
+			}
+		}
+
+		std::vector<std::uint32_t> result;
+		result.reserve(liveTriangles * 3);
+		for (std::uint32_t triangle = 0; triangle < triangleCount; ++triangle) {
+			if (!removedTriangles[triangle]) {
+				result.insert(result.end(), indices.begin() + triangle * 3, indices.begin() + triangle * 3 + 3);
+			}
+		}
+
+		return result;
+	}
+
+	float MeshSimplifier::getLastError() const {
+		return m_lastError;
+	}
+
+	const glm::vec3 &MeshSimplifier::getPosition(std::uint32_t vertex) const {
+		return m_positions[vertex];
+	}
+
+	bool MeshSimplifier::flipsTriangle(const std::vector<std::uint32_t> &indices, std::uint32_t triangle, std::uint32_t from, std::uint32_t to) const {
+		glm::vec3 before[3];
+		glm::vec3 after[3];
+
+		for (int v = 0; v < 3; ++v) {
+			std::uint32_t index = indices[triangle * 3 + v];
+			before[v] = getPosition(index);
+			after[v] = getPosition(index == from ? to : index);
+
+			if (index == to) {
+				return false;
+			}
+		}
+
+		glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+		glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+
+		return glm::dot(normalBefore, normalAfter) <= 0.0f;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <queue>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include <functional>
+#include <string>
+#include <cmath>
+
+namespace eng {
+	class MeshSimplifier {
+	public:
+		MeshSimplifier(const glm::vec3 *positions, std::size_t vertexCount, std::size_t stride);
+
+		std::vector<std::uint32_t> simplify(const std::vector<std::uint32_t> &indices, std::size_t targetIndexCount, float maxError) const;
+
+		float getLastError() const;
+	private:
+		struct Quadric {
+			double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+			double b2 = 0.0, bc = 0.0, bd = 0.0;
+			double c2 = 0.0, cd = 0.0;
+			double d2 = 0.0;
+			double weight = 0.0;
+
+			static Quadric fromPlane(const glm::vec3 &normal, float distance, float weight);
+
+			void add(const Quadric &quadric);
+			double evaluate(const glm::vec3 &point) const;
+		};
+
+		struct Collapse {
+			double cost;
+			std::uint32_t from;
+			std::uint32_t to;
+			std::uint32_t fromVersion;
+			std::uint32_t toVersion;
+
+			bool operator>(const Collapse &other) const;
+		};
+
+		const glm::vec3 &getPosition(std::uint32_t vertex) const;
+		bool flipsTriangle(const std::vector<std::uint32_t> &indices, std::uint32_t triangle, std::uint32_t from, std::uint32_t to) const;
+
+		std::vector<glm::vec3> m_positions;
+		std::vector<std::uint32_t> m_remap;
+		std::vector<bool> m_seamVertices;
+
+		mutable float m_lastError = 0.0f;
+
+		static constexpr float BOUNDARY_WEIGHT = 10.0f;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "MeshletBuilder.h"
+
+namespace eng {
+	MeshletBuilder::MeshletBuilder(const glm::vec3 *positions, std::size_t vertexCount, std::size_t stride) {
+		m_positions.resize(vertexCount);
+		for (std::size_t i = 0; i < vertexCount; ++i) {
+			m_positions[i] = *reinterpret_cast<const glm::vec3 *>(reinterpret_cast<const char *>(positions) + i * stride);
+		}
+	}
+
+	std::vector<Meshlet> MeshletBuilder::build(std::vector<std::uint32_t> &indices, std::uint32_t firstIndex, std::uint32_t indexCount, std::uint32_t maxVertices, std::uint32_t maxTriangles) {
+		maxVertices = std::min(maxVertices, MAX_VERTICES);
+		maxTriangles = std::min(maxTriangles, MAX_TRIANGLES);
+
+		std::vector<Meshlet> meshlets;
+		std::vector<std::int32_t> localVertices(m_positions.size(), -1);
+		std::vector<std::uint32_t> triangles;
+		std::vector<std::uint32_t> orderedIndices;
+		orderedIndices.reserve(indexCount);
+
+		m_meshletVertices.clear();
+		m_meshletTriangles.clear();
+
+		Meshlet meshlet{};
+		meshlet.firstIndex = firstIndex;
+
+		for (std::uint32_t i = firstIndex; i + 2 < firstIndex + indexCount; i += 3) {
+			const std::uint32_t triangle[] = { indices[i], indices[i + 1], indices[i + 2] };
+
+			std::uint32_t newVertices = 0;
+			for (std::uint32_t vertex : triangle) {
+				newVertices += localVertices[vertex] < 0 ? 1 : 0;
+			}
+
+			if (meshlet.vertexCount + newVertices > maxVertices || triangles.size() / 3 + 1 > maxTriangles) {
+				finishMeshlet(meshlet, triangles, localVertices);
+				meshlets.push_back(meshlet);
+
+				meshlet = Meshlet{};
+				meshlet.firstIndex = firstIndex + static_cast<std::uint32_t>(orderedIndices.size());
+				triangles.clear();
+			}
+
+			if (meshlet.vertexCount == 0) {
+				meshlet.firstVertex = static_cast<std::uint32_t>(m_meshletVertices.size());
+			}
+
+			for (std::uint32_t vertex : triangle) {
+				if (localVertices[vertex] < 0) {
+					localVertices[vertex] = static_cast<std::int32_t>(meshlet.vertexCount++);
+					m_meshletVertices.push_back(vertex);
+				}
+
+				m_meshletTriangles.push_back(static_cast<std::uint8_t>(localVertices[vertex]));
+				triangles.push_back(vertex);
+				orderedIndices.push_back(vertex);
+			}
+		}
+
+		if (!triangles.empty()) {
+			finishMeshlet(meshlet, triangles, localVertices);
+			meshlets.push_back(meshlet);
+		}
+
+		std::copy(orderedIndices.begin(), orderedIndices.end(), indices.begin() + firstIndex);
+
+		return meshlets;
+	}
+
+	const std::vector<std::uint32_t> &MeshletBuilder::getMeshletVertices() const {
+		return m_meshletVertices;
+	}
+
+	const std::vector<std::uint8_t> &MeshletBuilder::getMeshletTriangles() const {
+		return m_meshletTriangles;
+	}
+
+	void MeshletBuilder::finishMeshlet(Meshlet &meshlet, const std::vector<std::uint32_t> &triangles, std::vector<std::int32_t> &localVertices) {
+		meshlet.indexCount = static_cast<std::uint32_t>(triangles.size());
+		computeBounds(meshlet, triangles);
+
+		for (std::uint32_t i = meshlet.firstVertex; i < meshlet.firstVertex + meshlet.vertexCount; ++i) {
+			localVertices[m_meshletVertices[i]] = -1;
+		}
+	}
+
+	void MeshletBuilder::computeBounds(Meshlet &meshlet, const std::vector<std::uint32_t> &triangles) const {
+		BoundingBox box{};
+		for (std::uint32_t vertex : triangles) {
+			box.min = glm::min(box.min, m_positions[vertex]);
+			box.max = glm::max(box.max, m_positions[vertex]);
+		}
+
+		meshlet.bounds.center = (box.min + box.max) * 0.5f;
+		meshlet.bounds.radius = 0.0f;
+		for (std::uint32_t vertex : triangles) {
+			meshlet.bounds.radius = std::max(meshlet.bounds.radius, glm::length(m_positions[vertex] - meshlet.bounds.center));
+		}
+
+		std::vector<glm::vec3> normals;
+		normals.reserve(triangles.size() / 3);
+
+		glm::vec3 axis{ 0.0f };
+		for (std::size_t i = 0; i < triangles.size(); i += 3) {
+			const glm::vec3 &a = m_positions[triangles[i]];
+			const glm::vec3 &b = m_positions[triangles[i + 1]];
+			const glm::vec3 &c = m_positions[triangles[i + 2]];
+
+			glm::vec3 normal = glm::cross(c - a, b - a);
+			float length = glm::length(normal);
+			if (length <= std::numeric_limits<float>::epsilon()) {
+				continue;
+			}
+
+			normals.push_back(normal / length);
+			axis += normals.back();
+		}
+
+		meshlet.coneAxis = glm::vec3{ 0.0f };
+		meshlet.coneCutoff = 1.0f;
+
+		float axisLength = glm::length(axis);
+		if (normals.empty() || axisLength <= std::numeric_limits<float>::epsilon()) {
+			return;
+		}
+		axis /= axisLength;
+
+		float minimumDot = 1.0f;
+		for (const glm::vec3 &normal : normals) {
+			minimumDot = std::min(minimumDot, glm::dot(normal, axis));
+		}
+
+		if (minimumDot <= 0.0f) {
+			return;
+		}
+
+		meshlet.coneAxis = axis;
+		meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+	}
+}
\ No newline at end of file
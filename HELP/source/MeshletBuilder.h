@@ -0,0 +1,49 @@
+#ifndef MESHLET_BUILDER_H
+#define MESHLET_BUILDER_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "BoundingVolume.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace eng {
+	struct Meshlet {
+		BoundingSphere bounds{};
+		glm::vec3 coneAxis{ 0.0f };
+		float coneCutoff = 1.0f;
+		std::uint32_t firstIndex = 0;
+		std::uint32_t indexCount = 0;
+		std::uint32_t firstVertex = 0;
+		std::uint32_t vertexCount = 0;
+	};
+
+	class MeshletBuilder {
+	public:
+		MeshletBuilder(const glm::vec3 *positions, std::size_t vertexCount, std::size_t stride);
+
+		std::vector<Meshlet> build(std::vector<std::uint32_t> &indices, std::uint32_t firstIndex, std::uint32_t indexCount, std::uint32_t maxVertices, std::uint32_t maxTriangles);
+
+		const std::vector<std::uint32_t> &getMeshletVertices() const;
+		const std::vector<std::uint8_t> &getMeshletTriangles() const;
+
+		static constexpr std::uint32_t MAX_VERTICES = 64;
+		static constexpr std::uint32_t MAX_TRIANGLES = 124;
+	private:
+		void finishMeshlet(Meshlet &meshlet, const std::vector<std::uint32_t> &triangles, std::vector<std::int32_t> &localVertices);
+		void computeBounds(Meshlet &meshlet, const std::vector<std::uint32_t> &triangles) const;
+
+		std::vector<glm::vec3> m_positions;
+		std::vector<std::uint32_t> m_meshletVertices;
+		std::vector<std::uint8_t> m_meshletTriangles;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,429 @@
+#include "MeshletCuller.h"
+
+namespace eng {
+	MeshletCuller::MeshletCuller(Device &device, std::uint32_t maxMeshlets, std::uint32_t maxInstances, std::uint32_t maxDraws, std::uint32_t frameCount)
+		: m_device(device), m_maxMeshlets(maxMeshlets), m_maxInstances(maxInstances), m_maxDraws(maxDraws), m_frameCount(frameCount),
+		m_instanceCounts(frameCount, 0), m_drawSlotCounts(frameCount, 0), m_submittedTriangleCounts(frameCount, 0) {
+		m_compactionEnabled = m_device.getCapabilities().isEnabled(Capability::DrawIndirectCount);
+
+		createBuffers();
+		createDescriptorSetLayout();
+		createDescriptorSet();
+		createPipeline();
+	}
+
+	MeshletCuller::~MeshletCuller() {
+		m_cullPipeline.reset();
+
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		vkUnmapMemory(m_device.getDevice(), m_instanceBufferMemory);
+
+		VkBuffer buffers[] = { m_meshletBuffer, m_instanceBuffer, m_drawBuffer, m_counterBuffer };
+		VkDeviceMemory memories[] = { m_meshletBufferMemory, m_instanceBufferMemory, m_drawBufferMemory, m_counterBufferMemory };
+		for (std::size_t i = 0; i < std::size(buffers); ++i) {
+			vkDestroyBuffer(m_device.getDevice(), buffers[i], VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(memories[i]);
+		}
+	}
+
+	MeshletCuller::MeshId MeshletCuller::addMesh(const Model &model) {
+		const GeometryPool::Allocation &allocation = model.getAllocation();
+
+		std::vector<Meshlet> meshlets = model.getMeshlets();
+		if (meshlets.empty()) {
+			Meshlet meshlet{};
+			meshlet.bounds = model.getBoundingBox().getBoundingSphere();
+			meshlet.indexCount = model.getLod(0).indexCount;
+			meshlets.push_back(meshlet);
+		}
+
+		if (m_meshletCount + meshlets.size() > m_maxMeshlets) {
+			throw std::runtime_error("Meshlet culler is out of meshlet space.");
+		}
+
+		std::vector<MeshletData> meshletData(meshlets.size());
+		std::uint32_t triangleCount = 0;
+		for (std::size_t i = 0; i < meshlets.size(); ++i) {
+			const Meshlet &meshlet = meshlets[i];
+
+			meshletData[i].boundingSphere = glm::vec4{ meshlet.bounds.center, meshlet.bounds.radius };
+			meshletData[i].cone = glm::vec4{ meshlet.coneAxis, meshlet.coneCutoff };
+			meshletData[i].firstIndex = allocation.firstIndex + meshlet.firstIndex;
+			meshletData[i].indexCount = meshlet.indexCount;
+			meshletData[i].vertexOffset = static_cast<std::int32_t>(allocation.firstVertex);
+			meshletData[i].padding = 0;
+
+			triangleCount += meshlet.indexCount / 3;
+		}
+
+		const VkDeviceSize size = sizeof(MeshletData) * meshletData.size();
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		m_device.createBuffer(
+			size,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			stagingBuffer,
+			stagingBufferMemory
+		);
+
+		void *data;
+		vkMapMemory(m_device.getDevice(), stagingBufferMemory, 0, size, 0, &data);
+		std::memcpy(data, meshletData.data(), static_cast<std::size_t>(size));
+		vkUnmapMemory(m_device.getDevice(), stagingBufferMemory);
+
+		VkCommandBuffer commandBuffer = m_device.beginSingleTimeCommands();
+
+		VkBufferCopy bufferCopy{};
+		bufferCopy.srcOffset = 0;
+		bufferCopy.dstOffset = sizeof(MeshletData) * m_meshletCount;
+		bufferCopy.size = size;
+		vkCmdCopyBuffer(commandBuffer, stagingBuffer, m_meshletBuffer, 1, &bufferCopy);
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		m_device.endSingleTimeCommands(commandBuffer);
+
+		vkDestroyBuffer(m_device.getDevice(), stagingBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(stagingBufferMemory);
+
+		m_meshes.push_back(Mesh{ m_meshletCount, static_cast<std::uint32_t>(meshlets.size()), triangleCount });
+		m_meshletCount += static_cast<std::uint32_t>(meshlets.size());
+
+		return static_cast<MeshId>(m_meshes.size() - 1);
+	}
+
+	void MeshletCuller::setInstances(std::uint32_t frameIndex, const std::vector<Instance> &instances) {
+		if (instances.size() > m_maxInstances) {
+			throw std::runtime_error("Too many meshlet culler instances.");
+		}
+
+		InstanceData *instanceData = reinterpret_cast<InstanceData *>(static_cast<char *>(m_instanceBufferMapped) + m_instanceSliceSize * frameIndex);
+
+		std::uint32_t drawCount = 0;
+		std::uint64_t triangleCount = 0;
+		for (std::size_t i = 0; i < instances.size(); ++i) {
+			const Instance &instance = instances[i];
+			const Mesh &mesh = m_meshes[instance.mesh];
+
+			if (drawCount + mesh.meshletCount > m_maxDraws) {
+				throw std::runtime_error("Meshlet culler is out of draw space.");
+			}
+
+			const glm::mat4 &transform = instance.transform;
+			float scale = std::sqrt(std::max({
+				glm::dot(glm::vec3{ transform[0] }, glm::vec3{ transform[0] }),
+				glm::dot(glm::vec3{ transform[1] }, glm::vec3{ transform[1] }),
+				glm::dot(glm::vec3{ transform[2] }, glm::vec3{ transform[2] })
+			}));
+
+			instanceData[i].transform = transform;
+			instanceData[i].firstMeshlet = mesh.firstMeshlet;
+			instanceData[i].meshletCount = mesh.meshletCount;
+			instanceData[i].firstDraw = drawCount;
+			instanceData[i].materialIndex = instance.materialIndex;
+			instanceData[i].scale = scale;
+
+			drawCount += mesh.meshletCount;
+			triangleCount += mesh.triangleCount;
+		}
+
+		m_instanceCounts[frameIndex] = static_cast<std::uint32_t>(instances.size());
+		m_drawSlotCounts[frameIndex] = drawCount;
+		m_submittedTriangleCounts[frameIndex] = triangleCount;
+	}
+
+	void MeshletCuller::cull(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, const Camera &camera) {
+		vkCmdFillBuffer(commandBuffer, m_counterBuffer, m_counterSliceSize * frameIndex, COUNTER_SIZE, 0);
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			0,
+			1, &memoryBarrier,
+			0, nullptr,
+			0, nullptr
+		);
+
+		const std::uint32_t instanceCount = m_instanceCounts[frameIndex];
+		if (instanceCount > 0) {
+			const Frustum frustum = camera.getFrustum();
+
+			PushConstantData pushConstants{};
+			for (std::size_t i = 0; i < Frustum::PLANE_COUNT; ++i) {
+				pushConstants.frustumPlanes[i] = frustum.getPlane(i);
+			}
+			pushConstants.cameraPosition = glm::vec4{ camera.getPosition(), 1.0f };
+			pushConstants.instanceCount = instanceCount;
+			pushConstants.compact = m_compactionEnabled ? 1 : 0;
+
+			std::array<std::uint32_t, 3> dynamicOffsets = getDynamicOffsets(frameIndex);
+
+			m_cullPipeline->bind(commandBuffer);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &m_descriptorSet, static_cast<std::uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstantData), &pushConstants);
+			vkCmdDispatch(commandBuffer, instanceCount, 1, 1);
+		}
+
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+			0,
+			1, &memoryBarrier,
+			0, nullptr,
+			0, nullptr
+		);
+	}
+
+	void MeshletCuller::draw(VkCommandBuffer commandBuffer, std::uint32_t frameIndex) {
+		const std::uint32_t drawSlotCount = m_drawSlotCounts[frameIndex];
+		if (drawSlotCount == 0) {
+			return;
+		}
+
+		const VkDeviceSize drawOffset = m_drawSliceSize * frameIndex;
+		const std::uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+		if (m_compactionEnabled) {
+			vkCmdDrawIndexedIndirectCount(commandBuffer, m_drawBuffer, drawOffset, m_counterBuffer, m_counterSliceSize * frameIndex, drawSlotCount, stride);
+		} else if (m_device.getCapabilities().isEnabled(Capability::MultiDrawIndirect)) {
+			vkCmdDrawIndexedIndirect(commandBuffer, m_drawBuffer, drawOffset, drawSlotCount, stride);
+		} else {
+			for (std::uint32_t i = 0; i < drawSlotCount; ++i) {
+				vkCmdDrawIndexedIndirect(commandBuffer, m_drawBuffer, drawOffset + static_cast<VkDeviceSize>(i) * stride, 1, stride);
+			}
+		}
+	}
+
+	MeshletCuller::Statistics MeshletCuller::readStatistics(std::uint32_t frameIndex) {
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		m_device.createBuffer(
+			COUNTER_SIZE,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			stagingBuffer,
+			stagingBufferMemory
+		);
+
+		VkCommandBuffer commandBuffer = m_device.beginSingleTimeCommands();
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		VkBufferCopy bufferCopy{};
+		bufferCopy.srcOffset = m_counterSliceSize * frameIndex;
+		bufferCopy.dstOffset = 0;
+		bufferCopy.size = COUNTER_SIZE;
+		vkCmdCopyBuffer(commandBuffer, m_counterBuffer, stagingBuffer, 1, &bufferCopy);
+
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		m_device.endSingleTimeCommands(commandBuffer);
+
+		std::uint32_t counters[4]{};
+		void *data;
+		vkMapMemory(m_device.getDevice(), stagingBufferMemory, 0, COUNTER_SIZE, 0, &data);
+		std::memcpy(counters, data, static_cast<std::size_t>(COUNTER_SIZE));
+		vkUnmapMemory(m_device.getDevice(), stagingBufferMemory);
+
+		vkDestroyBuffer(m_device.getDevice(), stagingBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(stagingBufferMemory);
+
+		Statistics statistics{};
+		statistics.meshletCount = m_drawSlotCounts[frameIndex];
+		statistics.submittedTriangleCount = m_submittedTriangleCounts[frameIndex];
+		statistics.drawCount = counters[0];
+		statistics.visibleTriangleCount = counters[1];
+		statistics.frustumCulledMeshletCount = counters[2];
+		statistics.coneCulledMeshletCount = counters[3];
+
+		return statistics;
+	}
+
+	VkDescriptorBufferInfo MeshletCuller::getInstanceBufferInfo(std::uint32_t frameIndex) const {
+		return VkDescriptorBufferInfo{ m_instanceBuffer, m_instanceSliceSize * frameIndex, sizeof(InstanceData) * m_maxInstances };
+	}
+
+	bool MeshletCuller::isCompactionEnabled() const {
+		return m_compactionEnabled;
+	}
+
+	void MeshletCuller::createBuffers() {
+		VkPhysicalDeviceLimits limits = m_device.getPhysicalDeviceProperties().limits;
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+
+		auto align = [alignment](VkDeviceSize size) {
+			return (size + alignment - 1) / alignment * alignment;
+		};
+
+		m_instanceSliceSize = align(sizeof(InstanceData) * m_maxInstances);
+		m_drawSliceSize = align(sizeof(VkDrawIndexedIndirectCommand) * m_maxDraws);
+		m_counterSliceSize = align(COUNTER_SIZE);
+
+		if (sizeof(MeshletData) * m_maxMeshlets > limits.maxStorageBufferRange || m_drawSliceSize > limits.maxStorageBufferRange) {
+			throw std::runtime_error("Meshlet count exceeds the maximum storage buffer range.");
+		}
+
+		m_device.createBuffer(
+			sizeof(MeshletData) * m_maxMeshlets,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_meshletBuffer,
+			m_meshletBufferMemory,
+			MemoryCategory::Mesh
+		);
+
+		m_device.createBuffer(
+			m_instanceSliceSize * m_frameCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			m_instanceBuffer,
+			m_instanceBufferMemory
+		);
+
+		vkMapMemory(m_device.getDevice(), m_instanceBufferMemory, 0, m_instanceSliceSize * m_frameCount, 0, &m_instanceBufferMapped);
+
+		m_device.createBuffer(
+			m_drawSliceSize * m_frameCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_drawBuffer,
+			m_drawBufferMemory
+		);
+
+		m_device.createBuffer(
+			m_counterSliceSize * m_frameCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_counterBuffer,
+			m_counterBufferMemory
+		);
+	}
+
+	void MeshletCuller::createDescriptorSetLayout() {
+		std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
+		for (std::uint32_t i = 0; i < bindings.size(); ++i) {
+			bindings[i].binding = i;
+			bindings[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+			bindings[i].descriptorCount = 1;
+			bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			bindings[i].pImmutableSamplers = nullptr;
+		}
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create meshlet culling descriptor set layout.");
+		}
+	}
+
+	void MeshletCuller::createDescriptorSet() {
+		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
+		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSizes[0].descriptorCount = 1;
+		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		descriptorPoolSizes[1].descriptorCount = 3;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<std::uint32_t>(descriptorPoolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create meshlet culling descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &m_descriptorSetLayout;
+
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, &m_descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate meshlet culling descriptor set.");
+		}
+
+		std::array<VkDescriptorBufferInfo, 4> descriptorBufferInfos{};
+		descriptorBufferInfos[0] = { m_meshletBuffer, 0, VK_WHOLE_SIZE };
+		descriptorBufferInfos[1] = { m_instanceBuffer, 0, m_instanceSliceSize };
+		descriptorBufferInfos[2] = { m_drawBuffer, 0, m_drawSliceSize };
+		descriptorBufferInfos[3] = { m_counterBuffer, 0, COUNTER_SIZE };
+
+		std::array<VkWriteDescriptorSet, 4> writeDescriptorSets{};
+		for (std::uint32_t i = 0; i < writeDescriptorSets.size(); ++i) {
+			writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSets[i].pNext = nullptr;
+			writeDescriptorSets[i].dstSet = m_descriptorSet;
+			writeDescriptorSets[i].dstBinding = i;
+			writeDescriptorSets[i].dstArrayElement = 0;
+			writeDescriptorSets[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+			writeDescriptorSets[i].descriptorCount = 1;
+			writeDescriptorSets[i].pBufferInfo = &descriptorBufferInfos[i];
+		}
+
+		vkUpdateDescriptorSets(m_device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+
+	void MeshletCuller::createPipeline() {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstantData);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create meshlet culling pipeline layout.");
+		}
+
+		m_cullPipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/meshlet_cull.comp.spv", m_pipelineLayout);
+	}
+
+	std::array<std::uint32_t, 3> MeshletCuller::getDynamicOffsets(std::uint32_t frameIndex) const {
+		return {
+			static_cast<std::uint32_t>(m_instanceSliceSize * frameIndex),
+			static_cast<std::uint32_t>(m_drawSliceSize * frameIndex),
+			static_cast<std::uint32_t>(m_counterSliceSize * frameIndex)
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef MESHLET_CULLER_H
+#define MESHLET_CULLER_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Device.h"
+#include "Model.h"
+#include "Camera.h"
+#include "Frustum.h"
+#include "ComputePipeline.h"
+#include "MeshletBuilder.h"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class MeshletCuller {
+	public:
+		using MeshId = std::uint32_t;
+
+		struct Instance {
+			glm::mat4 transform{ 1.0f };
+			MeshId mesh = 0;
+			std::uint32_t materialIndex = 0;
+		};
+
+		struct Statistics {
+			std::uint32_t meshletCount = 0;
+			std::uint64_t submittedTriangleCount = 0;
+			std::uint32_t drawCount = 0;
+			std::uint32_t visibleTriangleCount = 0;
+			std::uint32_t frustumCulledMeshletCount = 0;
+			std::uint32_t coneCulledMeshletCount = 0;
+		};
+
+		MeshletCuller(Device &device, std::uint32_t maxMeshlets, std::uint32_t maxInstances, std::uint32_t maxDraws, std::uint32_t frameCount);
+		~MeshletCuller();
+
+		MeshletCuller(const MeshletCuller &) = delete;
+		MeshletCuller &operator=(const MeshletCuller &) = delete;
+
+		MeshId addMesh(const Model &model);
+		void setInstances(std::uint32_t frameIndex, const std::vector<Instance> &instances);
+
+		void cull(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, const Camera &camera);
+		void draw(VkCommandBuffer commandBuffer, std::uint32_t frameIndex);
+
+		Statistics readStatistics(std::uint32_t frameIndex);
+		VkDescriptorBufferInfo getInstanceBufferInfo(std::uint32_t frameIndex) const;
+		bool isCompactionEnabled() const;
+	private:
+		struct MeshletData {
+			glm::vec4 boundingSphere;
+			glm::vec4 cone;
+			std::uint32_t firstIndex;
+			std::uint32_t indexCount;
+			std::int32_t vertexOffset;
+			std::uint32_t padding;
+		};
+
+		struct InstanceData {
+			glm::mat4 transform;
+			std::uint32_t firstMeshlet;
+			std::uint32_t meshletCount;
+			std::uint32_t firstDraw;
+			std::uint32_t materialIndex;
+			float scale;
+			std::uint32_t padding[3];
+		};
+
+		struct Mesh {
+			std::uint32_t firstMeshlet;
+			std::uint32_t meshletCount;
+			std::uint32_t triangleCount;
+		};
+
+		struct PushConstantData {
+			glm::vec4 frustumPlanes[Frustum::PLANE_COUNT];
+			glm::vec4 cameraPosition;
+			std::uint32_t instanceCount;
+			std::uint32_t compact;
+		};
+
+		void createBuffers();
+		void createDescriptorSetLayout();
+		void createDescriptorSet();
+		void createPipeline();
+
+		std::array<std::uint32_t, 3> getDynamicOffsets(std::uint32_t frameIndex) const;
+
+		Device &m_device;
+		std::uint32_t m_maxMeshlets;
+		std::uint32_t m_maxInstances;
+		std::uint32_t m_maxDraws;
+		std::uint32_t m_frameCount;
+		bool m_compactionEnabled = false;
+
+		VkBuffer m_meshletBuffer;
+		VkDeviceMemory m_meshletBufferMemory;
+		VkBuffer m_instanceBuffer;
+		VkDeviceMemory m_instanceBufferMemory;
+		void *m_instanceBufferMapped = nullptr;
+		VkBuffer m_drawBuffer;
+		VkDeviceMemory m_drawBufferMemory;
+		VkBuffer m_counterBuffer;
+		VkDeviceMemory m_counterBufferMemory;
+
+		VkDeviceSize m_instanceSliceSize = 0;
+		VkDeviceSize m_drawSliceSize = 0;
+		VkDeviceSize m_counterSliceSize = 0;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool;
+		VkDescriptorSet m_descriptorSet;
+		VkPipelineLayout m_pipelineLayout;
+		std::unique_ptr<ComputePipeline> m_cullPipeline;
+
+		std::vector<Mesh> m_meshes;
+		std::uint32_t m_meshletCount = 0;
+		std::vector<std::uint32_t> m_instanceCounts;
+		std::vector<std::uint32_t> m_drawSlotCounts;
+		std::vector<std::uint64_t> m_submittedTriangleCounts;
+
+		static constexpr std::uint32_t GROUP_SIZE = 64;
+		static constexpr VkDeviceSize COUNTER_SIZE = sizeof(std::uint32_t) * 4;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -1,46 +1,173 @@
 #include "Model.h"
 
 namespace eng {
-	Model::Model(Device &device, const std::vector<Vertex> &vertices)
-		: m_device(device) {
-		createVertexBuffers(vertices);
+	void Model::Builder::weldVertices() {
+		std::vector<Vertex> uniqueVertices;
+		std::unordered_map<std::string, std::uint32_t> vertexIndices;
+
+		indices.clear();
+		indices.reserve(vertices.size());
+
+		for (const Vertex &vertex : vertices) {
+			std::string key(reinterpret_cast<const char *>(&vertex), sizeof(Vertex));
+
+			auto [it, inserted] = vertexIndices.emplace(key, static_cast<std::uint32_t>(uniqueVertices.size()));
+			if (inserted) {
+				uniqueVertices.push_back(vertex);
+			}
+
+			indices.push_back(it->second);
+		}
+
+		vertices = std::move(uniqueVertices);
 	}
 
-	Model::~Model() {
-		vkDestroyBuffer(m_device.getDevice(), m_vertexBuffer, nullptr);
-		vkFreeMemory(m_device.getDevice(), m_vertexBufferMemory, nullptr);
+	void Model::Builder::generateLods(std::uint32_t maxLodCount, float reduction, float maxError) {
+		if (indices.empty()) {
+			weldVertices();
+		}
+
+		if (!lods.empty()) {
+			indices.resize(lods[0].indexCount);
+		}
+
+		lods.clear();
+		lods.push_back(Lod{ 0, static_cast<std::uint32_t>(indices.size()), 0.0f, 0.0f });
+
+		MeshSimplifier simplifier{ &vertices[0].position, vertices.size(), sizeof(Vertex) };
+
+		std::vector<std::uint32_t> lodIndices = indices;
+		while (lods.size() < maxLodCount) {
+			std::size_t targetIndexCount = static_cast<std::size_t>(static_cast<float>(lodIndices.size()) * reduction) / 3 * 3;
+			std::vector<std::uint32_t> simplified = simplifier.simplify(lodIndices, targetIndexCount, maxError);
+
+			if (simplified.empty() || simplified.size() >= lodIndices.size() * 95 / 100) {
+				break;
+			}
+
+			lods.push_back(Lod{ static_cast<std::uint32_t>(indices.size()), static_cast<std::uint32_t>(simplified.size()), 0.0f, simplifier.getLastError() });
+			indices.insert(indices.end(), simplified.begin(), simplified.end());
+			lodIndices = std::move(simplified);
+		}
+
+		const float fullIndexCount = static_cast<float>(lods[0].indexCount);
+		for (std::size_t i = 0; i + 1 < lods.size(); ++i) {
+			lods[i].screenSize = LOD_BASE_SCREEN_SIZE * std::sqrt(static_cast<float>(lods[i + 1].indexCount) / fullIndexCount);
+		}
+		lods.back().screenSize = 0.0f;
+	}
+
+	void Model::Builder::generateMeshlets(std::uint32_t maxVertices, std::uint32_t maxTriangles) {
+		if (indices.empty()) {
+			weldVertices();
+		}
+
+		const std::uint32_t indexCount = lods.empty() ? static_cast<std::uint32_t>(indices.size()) : lods[0].indexCount;
+
+		MeshletBuilder meshletBuilder{ &vertices[0].position, vertices.size(), sizeof(Vertex) };
+		meshlets = meshletBuilder.build(indices, 0, indexCount, maxVertices, maxTriangles);
+	}
+
+	Model::Model(GeometryPool &geometryPool, const Builder &builder)
+		: m_geometryPool(geometryPool) {
+		allocateGeometry(builder);
 	}
 
-	void Model::bind(VkCommandBuffer commandBuffer) {
-		VkBuffer buffers[] = { m_vertexBuffer };
-		VkDeviceSize offsets[] = { 0 };
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+	Model::~Model() {
+		m_geometryPool.free(m_allocation);
 	}
 
 	void Model::draw(VkCommandBuffer commandBuffer) {
-		vkCmdDraw(commandBuffer, m_vertexCount, 1, 0, 0);
+		draw(commandBuffer, 0);
+	}
+
+	void Model::draw(VkCommandBuffer commandBuffer, std::uint32_t lod) {
+		const Lod &selectedLod = m_lods[std::min(lod, getLodCount() - 1)];
+		vkCmdDrawIndexed(commandBuffer, selectedLod.indexCount, 1, m_allocation.firstIndex + selectedLod.firstIndex, static_cast<std::int32_t>(m_allocation.firstVertex), 0);
+	}
+
+	void Model::draw(DrawRecorder &recorder, std::uint32_t lod) {
+		const Lod &selectedLod = m_lods[std::min(lod, getLodCount() - 1)];
+		recorder.drawIndexed(selectedLod.indexCount, 1, m_allocation.firstIndex + selectedLod.firstIndex, static_cast<std::int32_t>(m_allocation.firstVertex), 0);
+	}
+
+	std::uint32_t Model::selectLod(float screenSize, std::uint32_t currentLod) const {
+		return selectLod(m_lods, screenSize, currentLod);
 	}
 
-	void Model::createVertexBuffers(const std::vector<Vertex> &vertices) {
-		m_vertexCount = static_cast<std::uint32_t>(vertices.size());
-		if (m_vertexCount < 3) {
+	std::uint32_t Model::selectLod(const std::vector<Lod> &lods, float screenSize, std::uint32_t currentLod) {
+		const std::uint32_t lodCount = static_cast<std::uint32_t>(lods.size());
+		currentLod = std::min(currentLod, lodCount - 1);
+
+		std::uint32_t targetLod = lodCount - 1;
+		for (std::uint32_t i = 0; i < lodCount; ++i) {
+			if (screenSize >= lods[i].screenSize) {
+				targetLod = i;
+				break;
+			}
+		}
+
+		while (targetLod < currentLod && screenSize < lods[targetLod].screenSize * (1.0f + LOD_HYSTERESIS)) {
+			++targetLod;
+		}
+
+		while (targetLod > currentLod && screenSize >= lods[targetLod - 1].screenSize * (1.0f - LOD_HYSTERESIS)) {
+			--targetLod;
+		}
+
+		return targetLod;
+	}
+
+	const BoundingBox &Model::getBoundingBox() const {
+		return m_boundingBox;
+	}
+
+	std::uint32_t Model::getLodCount() const {
+		return static_cast<std::uint32_t>(m_lods.size());
+	}
+
+	const Model::Lod &Model::getLod(std::uint32_t lod) const {
+		return m_lods[lod];
+	}
+
+	const GeometryPool::Allocation &Model::getAllocation() const {
+		return m_allocation;
+	}
+
+	const std::vector<Meshlet> &Model::getMeshlets() const {
+		return m_meshlets;
+	}
+
+	void Model::allocateGeometry(const Builder &builder) {
+		Builder indexedBuilder{};
+		const Builder *source = &builder;
+		if (builder.indices.empty()) {
+			indexedBuilder = builder;
+			indexedBuilder.weldVertices();
+			source = &indexedBuilder;
+		}
+
+		const std::vector<Vertex> &vertices = source->vertices;
+		const std::vector<std::uint32_t> &indices = source->indices;
+
+		if (vertices.size() < 3) {
 			throw std::runtime_error("Model vertex count must be at least 3.");
 		}
 
-		VkDeviceSize bufferSize = sizeof(vertices[0]) * m_vertexCount;
+		m_lods = source->lods;
+		if (m_lods.empty()) {
+			m_lods.push_back(Lod{ 0, static_cast<std::uint32_t>(indices.size()), 0.0f, 0.0f });
+		}
 
-		m_device.createBuffer(
-			bufferSize,
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			m_vertexBuffer,
-			m_vertexBufferMemory
-		);
+		m_meshlets = source->meshlets;
+		m_boundingBox = BoundingBox::fromPoints(&vertices[0].position, vertices.size(), sizeof(Vertex));
 
-		void *data;
-		vkMapMemory(m_device.getDevice(), m_vertexBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, vertices.data(), static_cast<std::size_t>(bufferSize));
-		vkUnmapMemory(m_device.getDevice(), m_vertexBufferMemory);
+		m_allocation = m_geometryPool.allocate(
+			vertices.data(),
+			static_cast<std::uint32_t>(vertices.size()),
+			indices.data(),
+			static_cast<std::uint32_t>(indices.size())
+		);
 	}
 
 	std::vector<VkVertexInputBindingDescription> Model::Vertex::getBindDescriptions() {
@@ -53,7 +180,7 @@ namespace eng {
 	}
 
 	std::vector<VkVertexInputAttributeDescription> Model::Vertex::getAttributeDescriptions() {
-		std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptions(2);
+		std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptions(3);
 		vertexInputAttributeDescriptions[0].binding = 0;
 		vertexInputAttributeDescriptions[0].location = 0;
 		vertexInputAttributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
@@ -64,6 +191,11 @@ namespace eng {
 		vertexInputAttributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
 		vertexInputAttributeDescriptions[1].offset = offsetof(Vertex, color);
 
+		vertexInputAttributeDescriptions[2].binding = 0;
+		vertexInputAttributeDescriptions[2].location = 2;
+		vertexInputAttributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
+		vertexInputAttributeDescriptions[2].offset = offsetof(Vertex, uv);
+
 		return vertexInputAttributeDescriptions;
 	}
 }
\ No newline at end of file
@@ -7,11 +7,19 @@
 #include <glm/glm.hpp>
 
 #include "Device.h"
+#include "GeometryPool.h"
+#include "DrawRecorder.h"
+#include "BoundingVolume.h"
+#include "MeshSimplifier.h"
+#include "MeshletBuilder.h"
 
 #include <vector>
 #include <cstdint>
 #include <stdexcept>
 #include <cstring>
+#include <cmath>
+#include <unordered_map>
+#include <string>
 
 namespace eng {
 	class Model {
@@ -19,12 +27,31 @@ namespace eng {
 		struct Vertex {
 			glm::vec3 position;
 			glm::vec3 color;
+			glm::vec2 uv;
 
 			static std::vector<VkVertexInputBindingDescription> getBindDescriptions();
 			static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
 		};
 
-		Model(Device &device, const std::vector<Vertex> &vertices);
+		struct Lod {
+			std::uint32_t firstIndex = 0;
+			std::uint32_t indexCount = 0;
+			float screenSize = 0.0f;
+			float error = 0.0f;
+		};
+
+		struct Builder {
+			std::vector<Vertex> vertices{};
+			std::vector<std::uint32_t> indices{};
+			std::vector<Lod> lods{};
+			std::vector<Meshlet> meshlets{};
+
+			void weldVertices();
+			void generateLods(std::uint32_t maxLodCount, float reduction, float maxError);
+			void generateMeshlets(std::uint32_t maxVertices = MeshletBuilder::MAX_VERTICES, std::uint32_t maxTriangles = MeshletBuilder::MAX_TRIANGLES);
+		};
+
+		Model(GeometryPool &geometryPool, const Builder &builder);
 		~Model();
 
 		Model(const Model &) = delete;
@@ -32,15 +59,29 @@ namespace eng {
 		Model(Model &&) = delete;
 		Model &operator=(Model &&) = delete;
 
-		void bind(VkCommandBuffer commandBuffer);
 		void draw(VkCommandBuffer commandBuffer);
+		void draw(VkCommandBuffer commandBuffer, std::uint32_t lod);
+		void draw(DrawRecorder &recorder, std::uint32_t lod);
+
+		std::uint32_t selectLod(float screenSize, std::uint32_t currentLod) const;
+		static std::uint32_t selectLod(const std::vector<Lod> &lods, float screenSize, std::uint32_t currentLod);
+
+		const BoundingBox &getBoundingBox() const;
+		std::uint32_t getLodCount() const;
+		const Lod &getLod(std::uint32_t lod) const;
+		const GeometryPool::Allocation &getAllocation() const;
+		const std::vector<Meshlet> &getMeshlets() const;
+
+		static constexpr float LOD_BASE_SCREEN_SIZE = 0.25f;
+		static constexpr float LOD_HYSTERESIS = 0.1f;
 	private:
-		void createVertexBuffers(const std::vector<Vertex> &vertices);
+		void allocateGeometry(const Builder &builder);
 
-		Device &m_device;
-		VkBuffer m_vertexBuffer;
-		VkDeviceMemory m_vertexBufferMemory;
-		std::uint32_t m_vertexCount;
+		GeometryPool &m_geometryPool;
+		GeometryPool::Allocation m_allocation{};
+		std::vector<Lod> m_lods;
+		std::vector<Meshlet> m_meshlets;
+		BoundingBox m_boundingBox{};
 	};
 }
 
@@ -0,0 +1,375 @@
+#include "OcclusionCuller.h"
+
+namespace eng {
+	OcclusionCuller::OcclusionCuller(Device &device, HiZBuffer &hiZBuffer, std::uint32_t maxObjects, std::uint32_t frameCount)
+		: m_device(device), m_hiZBuffer(hiZBuffer), m_maxObjects(maxObjects), m_frameCount(frameCount), m_objectCounts(frameCount, 0) {
+		m_compactionEnabled = m_device.getCapabilities().isEnabled(Capability::DrawIndirectCount);
+
+		createBuffers();
+		createDescriptorSetLayout();
+		createDescriptorSets();
+		createPipeline();
+	}
+
+	OcclusionCuller::~OcclusionCuller() {
+		m_cullPipeline.reset();
+
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		vkUnmapMemory(m_device.getDevice(), m_objectBufferMemory);
+
+		VkBuffer buffers[] = { m_objectBuffer, m_visibilityBuffer, m_drawBuffer, m_counterBuffer };
+		VkDeviceMemory memories[] = { m_objectBufferMemory, m_visibilityBufferMemory, m_drawBufferMemory, m_counterBufferMemory };
+		for (std::size_t i = 0; i < std::size(buffers); ++i) {
+			vkDestroyBuffer(m_device.getDevice(), buffers[i], VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(memories[i]);
+		}
+	}
+
+	void OcclusionCuller::setObjects(std::uint32_t frameIndex, const std::vector<Object> &objects) {
+		if (objects.size() > m_maxObjects) {
+			throw std::runtime_error("Too many occlusion culling objects.");
+		}
+
+		ObjectData *objectData = reinterpret_cast<ObjectData *>(static_cast<char *>(m_objectBufferMapped) + m_objectSliceSize * frameIndex);
+		for (std::size_t i = 0; i < objects.size(); ++i) {
+			const Object &object = objects[i];
+
+			objectData[i].boundingSphere = glm::vec4{ object.bounds.center, object.bounds.radius };
+			objectData[i].indexCount = object.indexCount;
+			objectData[i].firstIndex = object.firstIndex;
+			objectData[i].vertexOffset = object.vertexOffset;
+			objectData[i].firstInstance = object.firstInstance;
+		}
+
+		m_objectCounts[frameIndex] = static_cast<std::uint32_t>(objects.size());
+	}
+
+	void OcclusionCuller::setOcclusionEnabled(bool enabled) {
+		m_occlusionEnabled = enabled;
+	}
+
+	OcclusionCuller::GraphResources OcclusionCuller::importResources(RenderGraph &graph, std::uint32_t frameIndex) const {
+		RenderGraph::ResourceState initialState{};
+		initialState.stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+		initialState.access = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+		RenderGraph::BufferDescription drawDescription{};
+		drawDescription.size = m_drawSliceSize;
+		drawDescription.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+		RenderGraph::BufferDescription counterDescription{};
+		counterDescription.size = COUNTER_SIZE;
+		counterDescription.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+		GraphResources resources{};
+		resources.draws = graph.importBuffer("occlusion draws " + std::to_string(frameIndex), m_drawBuffer, drawDescription, initialState);
+		resources.counters = graph.importBuffer("occlusion counters " + std::to_string(frameIndex), m_counterBuffer, counterDescription, initialState);
+
+		return resources;
+	}
+
+	void OcclusionCuller::cull(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, Phase phase, const Camera &camera) {
+		updateHiZDescriptor(frameIndex);
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+
+		if (phase == Phase::Early) {
+			vkCmdFillBuffer(commandBuffer, m_counterBuffer, m_counterSliceSize * frameIndex, COUNTER_SIZE, 0);
+
+			memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+			vkCmdPipelineBarrier(
+				commandBuffer,
+				VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				0,
+				1, &memoryBarrier,
+				0, nullptr,
+				0, nullptr
+			);
+		}
+
+		const std::uint32_t objectCount = m_objectCounts[frameIndex];
+		if (objectCount > 0) {
+			const VkExtent2D depthExtent = m_hiZBuffer.getDepthExtent();
+
+			PushConstantData pushConstants{};
+			pushConstants.projectionView = camera.getProjectionView();
+			pushConstants.depthExtent = glm::vec2{ static_cast<float>(depthExtent.width), static_cast<float>(depthExtent.height) };
+			pushConstants.mipLevelCount = m_hiZBuffer.getMipLevelCount();
+			pushConstants.objectCount = objectCount;
+			pushConstants.maxObjects = m_maxObjects;
+			pushConstants.phase = static_cast<std::uint32_t>(phase);
+			pushConstants.occlusion = m_occlusionEnabled ? 1 : 0;
+			pushConstants.compact = m_compactionEnabled ? 1 : 0;
+
+			m_cullPipeline->bind(commandBuffer);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &m_descriptorSets[frameIndex], 0, nullptr);
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstantData), &pushConstants);
+			vkCmdDispatch(commandBuffer, (objectCount + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+		}
+
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			0,
+			1, &memoryBarrier,
+			0, nullptr,
+			0, nullptr
+		);
+	}
+
+	void OcclusionCuller::draw(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, Phase phase) {
+		const std::uint32_t objectCount = m_objectCounts[frameIndex];
+		if (objectCount == 0) {
+			return;
+		}
+
+		const VkDeviceSize drawOffset = getDrawOffset(frameIndex, phase);
+		const std::uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+		if (m_compactionEnabled) {
+			const VkDeviceSize countOffset = m_counterSliceSize * frameIndex + sizeof(std::uint32_t) * static_cast<std::uint32_t>(phase);
+			vkCmdDrawIndexedIndirectCount(commandBuffer, m_drawBuffer, drawOffset, m_counterBuffer, countOffset, objectCount, stride);
+		} else if (m_device.getCapabilities().isEnabled(Capability::MultiDrawIndirect)) {
+			vkCmdDrawIndexedIndirect(commandBuffer, m_drawBuffer, drawOffset, objectCount, stride);
+		} else {
+			for (std::uint32_t i = 0; i < objectCount; ++i) {
+				vkCmdDrawIndexedIndirect(commandBuffer, m_drawBuffer, drawOffset + static_cast<VkDeviceSize>(i) * stride, 1, stride);
+			}
+		}
+	}
+
+	OcclusionCuller::Statistics OcclusionCuller::readStatistics(std::uint32_t frameIndex) {
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		m_device.createBuffer(
+			COUNTER_SIZE,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			stagingBuffer,
+			stagingBufferMemory
+		);
+
+		VkCommandBuffer commandBuffer = m_device.beginSingleTimeCommands();
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		VkBufferCopy bufferCopy{};
+		bufferCopy.srcOffset = m_counterSliceSize * frameIndex;
+		bufferCopy.dstOffset = 0;
+		bufferCopy.size = COUNTER_SIZE;
+		vkCmdCopyBuffer(commandBuffer, m_counterBuffer, stagingBuffer, 1, &bufferCopy);
+
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		m_device.endSingleTimeCommands(commandBuffer);
+
+		std::uint32_t counters[8]{};
+		void *data;
+		vkMapMemory(m_device.getDevice(), stagingBufferMemory, 0, COUNTER_SIZE, 0, &data);
+		std::memcpy(counters, data, static_cast<std::size_t>(COUNTER_SIZE));
+		vkUnmapMemory(m_device.getDevice(), stagingBufferMemory);
+
+		vkDestroyBuffer(m_device.getDevice(), stagingBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(stagingBufferMemory);
+
+		Statistics statistics{};
+		statistics.objectCount = m_objectCounts[frameIndex];
+		statistics.earlyDrawCount = counters[0];
+		statistics.lateDrawCount = counters[1];
+		statistics.frustumCulledCount = counters[2];
+		statistics.occludedCount = counters[3];
+
+		return statistics;
+	}
+
+	bool OcclusionCuller::isOcclusionEnabled() const {
+		return m_occlusionEnabled;
+	}
+
+	void OcclusionCuller::createBuffers() {
+		VkPhysicalDeviceLimits limits = m_device.getPhysicalDeviceProperties().limits;
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+
+		auto align = [alignment](VkDeviceSize size) {
+			return (size + alignment - 1) / alignment * alignment;
+		};
+
+		m_objectSliceSize = align(sizeof(ObjectData) * m_maxObjects);
+		m_visibilitySliceSize = align(sizeof(std::uint32_t) * m_maxObjects);
+		m_drawSliceSize = align(sizeof(VkDrawIndexedIndirectCommand) * m_maxObjects * 2);
+		m_counterSliceSize = align(COUNTER_SIZE);
+
+		if (m_drawSliceSize > limits.maxStorageBufferRange) {
+			throw std::runtime_error("Occlusion culling object count exceeds the maximum storage buffer range.");
+		}
+
+		m_device.createBuffer(
+			m_objectSliceSize * m_frameCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			m_objectBuffer,
+			m_objectBufferMemory
+		);
+
+		vkMapMemory(m_device.getDevice(), m_objectBufferMemory, 0, m_objectSliceSize * m_frameCount, 0, &m_objectBufferMapped);
+
+		m_device.createBuffer(m_visibilitySliceSize * m_frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_visibilityBuffer, m_visibilityBufferMemory);
+		m_device.createBuffer(m_drawSliceSize * m_frameCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_drawBuffer, m_drawBufferMemory);
+		m_device.createBuffer(
+			m_counterSliceSize * m_frameCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_counterBuffer,
+			m_counterBufferMemory
+		);
+	}
+
+	void OcclusionCuller::createDescriptorSetLayout() {
+		std::array<VkDescriptorSetLayoutBinding, 5> bindings{};
+		for (std::uint32_t i = 0; i < bindings.size(); ++i) {
+			bindings[i].binding = i;
+			bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			bindings[i].descriptorCount = 1;
+			bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			bindings[i].pImmutableSamplers = nullptr;
+		}
+		bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create occlusion culling descriptor set layout.");
+		}
+	}
+
+	void OcclusionCuller::createDescriptorSets() {
+		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
+		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSizes[0].descriptorCount = 4 * m_frameCount;
+		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorPoolSizes[1].descriptorCount = m_frameCount;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<std::uint32_t>(descriptorPoolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
+		descriptorPoolCreateInfo.maxSets = m_frameCount;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create occlusion culling descriptor pool.");
+		}
+
+		std::vector<VkDescriptorSetLayout> layouts(m_frameCount, m_descriptorSetLayout);
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = m_frameCount;
+		descriptorSetAllocateInfo.pSetLayouts = layouts.data();
+
+		m_descriptorSets.resize(m_frameCount);
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, m_descriptorSets.data()) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate occlusion culling descriptor sets.");
+		}
+
+		m_hiZImageViews.assign(m_frameCount, VK_NULL_HANDLE);
+
+		for (std::uint32_t frame = 0; frame < m_frameCount; ++frame) {
+			std::array<VkDescriptorBufferInfo, 4> descriptorBufferInfos{};
+			descriptorBufferInfos[0] = { m_objectBuffer, m_objectSliceSize * frame, sizeof(ObjectData) * m_maxObjects };
+			descriptorBufferInfos[1] = { m_visibilityBuffer, m_visibilitySliceSize * frame, sizeof(std::uint32_t) * m_maxObjects };
+			descriptorBufferInfos[2] = { m_drawBuffer, m_drawSliceSize * frame, sizeof(VkDrawIndexedIndirectCommand) * m_maxObjects * 2 };
+			descriptorBufferInfos[3] = { m_counterBuffer, m_counterSliceSize * frame, COUNTER_SIZE };
+
+			std::array<VkWriteDescriptorSet, 4> writeDescriptorSets{};
+			for (std::uint32_t i = 0; i < writeDescriptorSets.size(); ++i) {
+				writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				writeDescriptorSets[i].pNext = nullptr;
+				writeDescriptorSets[i].dstSet = m_descriptorSets[frame];
+				writeDescriptorSets[i].dstBinding = i;
+				writeDescriptorSets[i].dstArrayElement = 0;
+				writeDescriptorSets[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				writeDescriptorSets[i].descriptorCount = 1;
+				writeDescriptorSets[i].pBufferInfo = &descriptorBufferInfos[i];
+			}
+
+			vkUpdateDescriptorSets(m_device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+		}
+	}
+
+	void OcclusionCuller::createPipeline() {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstantData);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create occlusion culling pipeline layout.");
+		}
+
+		m_cullPipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/occlusion_cull.comp.spv", m_pipelineLayout);
+	}
+
+	void OcclusionCuller::updateHiZDescriptor(std::uint32_t frameIndex) {
+		VkImageView imageView = m_hiZBuffer.getImageView();
+		if (m_hiZImageViews[frameIndex] == imageView) {
+			return;
+		}
+
+		VkDescriptorImageInfo descriptorImageInfo{};
+		descriptorImageInfo.sampler = m_hiZBuffer.getSampler();
+		descriptorImageInfo.imageView = imageView;
+		descriptorImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.pNext = nullptr;
+		writeDescriptorSet.dstSet = m_descriptorSets[frameIndex];
+		writeDescriptorSet.dstBinding = 4;
+		writeDescriptorSet.dstArrayElement = 0;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.pImageInfo = &descriptorImageInfo;
+
+		vkUpdateDescriptorSets(m_device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+
+		m_hiZImageViews[frameIndex] = imageView;
+	}
+
+	VkDeviceSize OcclusionCuller::getDrawOffset(std::uint32_t frameIndex, Phase phase) const {
+		return m_drawSliceSize * frameIndex + sizeof(VkDrawIndexedIndirectCommand) * m_maxObjects * static_cast<std::uint32_t>(phase);
+	}
+}
\ No newline at end of file
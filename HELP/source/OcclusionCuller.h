@@ -0,0 +1,132 @@
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Device.h"
+#include "Camera.h"
+#include "BoundingVolume.h"
+#include "ComputePipeline.h"
+#include "HiZBuffer.h"
+#include "RenderGraph.h"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class OcclusionCuller {
+	public:
+		enum class Phase : std::uint32_t {
+			Early,
+			Late
+		};
+
+		struct Object {
+			BoundingSphere bounds{};
+			std::uint32_t indexCount = 0;
+			std::uint32_t firstIndex = 0;
+			std::int32_t vertexOffset = 0;
+			std::uint32_t firstInstance = 0;
+		};
+
+		struct Statistics {
+			std::uint32_t objectCount = 0;
+			std::uint32_t frustumCulledCount = 0;
+			std::uint32_t occludedCount = 0;
+			std::uint32_t earlyDrawCount = 0;
+			std::uint32_t lateDrawCount = 0;
+		};
+
+		struct GraphResources {
+			RenderGraph::ResourceHandle draws;
+			RenderGraph::ResourceHandle counters;
+		};
+
+		OcclusionCuller(Device &device, HiZBuffer &hiZBuffer, std::uint32_t maxObjects, std::uint32_t frameCount);
+		~OcclusionCuller();
+
+		OcclusionCuller(const OcclusionCuller &) = delete;
+		OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+
+		void setObjects(std::uint32_t frameIndex, const std::vector<Object> &objects);
+		void setOcclusionEnabled(bool enabled);
+		GraphResources importResources(RenderGraph &graph, std::uint32_t frameIndex) const;
+
+		void cull(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, Phase phase, const Camera &camera);
+		void draw(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, Phase phase);
+
+		Statistics readStatistics(std::uint32_t frameIndex);
+		bool isOcclusionEnabled() const;
+	private:
+		struct ObjectData {
+			glm::vec4 boundingSphere;
+			std::uint32_t indexCount;
+			std::uint32_t firstIndex;
+			std::int32_t vertexOffset;
+			std::uint32_t firstInstance;
+		};
+
+		struct PushConstantData {
+			glm::mat4 projectionView;
+			glm::vec2 depthExtent;
+			std::uint32_t mipLevelCount;
+			std::uint32_t objectCount;
+			std::uint32_t maxObjects;
+			std::uint32_t phase;
+			std::uint32_t occlusion;
+			std::uint32_t compact;
+		};
+
+		void createBuffers();
+		void createDescriptorSetLayout();
+		void createDescriptorSets();
+		void createPipeline();
+
+		void updateHiZDescriptor(std::uint32_t frameIndex);
+		VkDeviceSize getDrawOffset(std::uint32_t frameIndex, Phase phase) const;
+
+		Device &m_device;
+		HiZBuffer &m_hiZBuffer;
+		std::uint32_t m_maxObjects;
+		std::uint32_t m_frameCount;
+		bool m_compactionEnabled = false;
+		bool m_occlusionEnabled = true;
+
+		VkBuffer m_objectBuffer;
+		VkDeviceMemory m_objectBufferMemory;
+		void *m_objectBufferMapped = nullptr;
+		VkBuffer m_visibilityBuffer;
+		VkDeviceMemory m_visibilityBufferMemory;
+		VkBuffer m_drawBuffer;
+		VkDeviceMemory m_drawBufferMemory;
+		VkBuffer m_counterBuffer;
+		VkDeviceMemory m_counterBufferMemory;
+
+		VkDeviceSize m_objectSliceSize = 0;
+		VkDeviceSize m_visibilitySliceSize = 0;
+		VkDeviceSize m_drawSliceSize = 0;
+		VkDeviceSize m_counterSliceSize = 0;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool;
+		std::vector<VkDescriptorSet> m_descriptorSets;
+		std::vector<VkImageView> m_hiZImageViews;
+		VkPipelineLayout m_pipelineLayout;
+		std::unique_ptr<ComputePipeline> m_cullPipeline;
+
+		std::vector<std::uint32_t> m_objectCounts;
+
+		static constexpr std::uint32_t GROUP_SIZE = 64;
+		static constexpr VkDeviceSize COUNTER_SIZE = sizeof(std::uint32_t) * 8;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,405 @@
+#include "ParticleSystem.h"
+
+namespace eng {
+	ParticleSystem::ParticleSystem(Device &device, std::uint32_t maxParticles, std::uint32_t frameCount)
+		: m_device(device), m_maxParticles(maxParticles), m_frameCount(frameCount) {
+		createBuffers();
+		createDescriptorSetLayout();
+		createDescriptorSet();
+		createComputePipelines();
+	}
+
+	ParticleSystem::~ParticleSystem() {
+		m_renderPipeline.reset();
+		m_simulatePipeline.reset();
+		m_emitPipeline.reset();
+		m_dispatchPipeline.reset();
+		m_initPipeline.reset();
+
+		if (m_renderPipelineLayout != VK_NULL_HANDLE) {
+			vkDestroyPipelineLayout(m_device.getDevice(), m_renderPipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		}
+		vkDestroyPipelineLayout(m_device.getDevice(), m_computePipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		vkUnmapMemory(m_device.getDevice(), m_emitterBufferMemory);
+
+		VkBuffer buffers[] = { m_particleBuffer, m_deadListBuffer, m_aliveListBuffer, m_counterBuffer, m_emitterBuffer };
+		VkDeviceMemory memories[] = { m_particleBufferMemory, m_deadListBufferMemory, m_aliveListBufferMemory, m_counterBufferMemory, m_emitterBufferMemory };
+		for (std::size_t i = 0; i < std::size(buffers); ++i) {
+			vkDestroyBuffer(m_device.getDevice(), buffers[i], VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(memories[i]);
+		}
+	}
+
+	ParticleSystem::EmitterId ParticleSystem::addEmitter(const Emitter &emitter) {
+		if (m_emitters.size() >= MAX_EMITTERS) {
+			throw std::runtime_error("Too many particle emitters.");
+		}
+
+		m_emitters.push_back(emitter);
+		m_emitAccumulators.push_back(0.0f);
+
+		return static_cast<EmitterId>(m_emitters.size() - 1);
+	}
+
+	ParticleSystem::Emitter &ParticleSystem::getEmitter(EmitterId emitter) {
+		return m_emitters[emitter];
+	}
+
+	void ParticleSystem::setGravity(const glm::vec3 &gravity) {
+		m_gravity = gravity;
+	}
+
+	void ParticleSystem::setParticleSize(float size) {
+		m_particleSize = size;
+	}
+
+	void ParticleSystem::createRenderPipeline(Swapchain &swapchain) {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(RenderPushConstantData);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_renderPipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create particle render pipeline layout.");
+		}
+
+		Pipeline::Config config = Pipeline::getDefaultConfig();
+		config.vertexShaderPath = "resources/shaders/particle.vert.spv";
+		config.fragmentShaderPath = "resources/shaders/particle.frag.spv";
+		config.modelVertexInput = false;
+		config.cullMode = VK_CULL_MODE_NONE;
+		config.depthWrite = false;
+		config.additiveBlend = true;
+
+		m_renderPipeline = std::make_unique<Pipeline>(m_device, swapchain, m_renderPipelineLayout, config);
+	}
+
+	ParticleSystem::GraphResources ParticleSystem::importResources(RenderGraph &graph) const {
+		RenderGraph::ResourceState initialState{};
+		initialState.stages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+		initialState.access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+		RenderGraph::BufferDescription particleDescription{};
+		particleDescription.size = static_cast<VkDeviceSize>(m_maxParticles) * sizeof(glm::vec4) * 2;
+		particleDescription.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+		RenderGraph::BufferDescription aliveListDescription{};
+		aliveListDescription.size = static_cast<VkDeviceSize>(m_maxParticles) * sizeof(std::uint32_t) * 2;
+		aliveListDescription.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+		RenderGraph::BufferDescription counterDescription{};
+		counterDescription.size = COUNTER_BUFFER_SIZE;
+		counterDescription.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+		GraphResources resources{};
+		resources.particles = graph.importBuffer("particles", m_particleBuffer, particleDescription, initialState);
+		resources.aliveList = graph.importBuffer("particle alive list", m_aliveListBuffer, aliveListDescription, initialState);
+		resources.counters = graph.importBuffer("particle counters", m_counterBuffer, counterDescription, initialState);
+
+		return resources;
+	}
+
+	void ParticleSystem::update(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, float deltaTime) {
+		recordComputeBarrier(commandBuffer);
+
+		ComputePushConstantData pushConstants{};
+		pushConstants.gravityDeltaTime = glm::vec4{ m_gravity, deltaTime };
+		pushConstants.maxParticles = m_maxParticles;
+		pushConstants.emitterCount = static_cast<std::uint32_t>(m_emitters.size());
+		pushConstants.requestedEmitCount = writeEmitters(frameIndex, deltaTime);
+		pushConstants.seed = ++m_seed * 0x9e3779b9u;
+		pushConstants.current = m_current;
+
+		if (!m_initialized) {
+			bindComputePipeline(commandBuffer, *m_initPipeline, pushConstants, frameIndex);
+			vkCmdDispatch(commandBuffer, (m_maxParticles + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+			recordComputeBarrier(commandBuffer);
+
+			m_initialized = true;
+		}
+
+		if (pushConstants.requestedEmitCount > 0) {
+			pushConstants.mode = 0;
+			bindComputePipeline(commandBuffer, *m_dispatchPipeline, pushConstants, frameIndex);
+			vkCmdDispatch(commandBuffer, 1, 1, 1);
+			recordComputeBarrier(commandBuffer);
+
+			bindComputePipeline(commandBuffer, *m_emitPipeline, pushConstants, frameIndex);
+			vkCmdDispatch(commandBuffer, (pushConstants.requestedEmitCount + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1);
+			recordComputeBarrier(commandBuffer);
+		}
+
+		pushConstants.mode = 1;
+		bindComputePipeline(commandBuffer, *m_dispatchPipeline, pushConstants, frameIndex);
+		vkCmdDispatch(commandBuffer, 1, 1, 1);
+		recordComputeBarrier(commandBuffer);
+
+		bindComputePipeline(commandBuffer, *m_simulatePipeline, pushConstants, frameIndex);
+		vkCmdDispatchIndirect(commandBuffer, m_counterBuffer, DISPATCH_INDIRECT_OFFSET);
+
+		m_current = 1 - m_current;
+	}
+
+	void ParticleSystem::draw(VkCommandBuffer commandBuffer, const Camera &camera, std::uint32_t frameIndex) {
+		if (!m_renderPipeline) {
+			return;
+		}
+
+		const glm::mat4 &view = camera.getView();
+
+		RenderPushConstantData pushConstants{};
+		pushConstants.projectionView = camera.getProjectionView();
+		pushConstants.cameraRight = glm::vec4{ view[0][0], view[1][0], view[2][0], m_particleSize };
+		pushConstants.cameraUp = glm::vec4{ view[0][1], view[1][1], view[2][1], 0.0f };
+		pushConstants.aliveOffset = m_current * m_maxParticles;
+
+		std::uint32_t dynamicOffset = static_cast<std::uint32_t>(m_emitterSliceSize * frameIndex);
+
+		m_renderPipeline->bind(commandBuffer);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_renderPipelineLayout, 0, 1, &m_descriptorSet, 1, &dynamicOffset);
+		vkCmdPushConstants(commandBuffer, m_renderPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(RenderPushConstantData), &pushConstants);
+		vkCmdDrawIndirect(commandBuffer, m_counterBuffer, DRAW_INDIRECT_OFFSET, 1, sizeof(VkDrawIndirectCommand));
+	}
+
+	std::uint32_t ParticleSystem::getMaxParticles() const {
+		return m_maxParticles;
+	}
+
+	std::uint32_t ParticleSystem::readAliveCount() {
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		m_device.createBuffer(
+			sizeof(std::uint32_t),
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			stagingBuffer,
+			stagingBufferMemory
+		);
+
+		VkCommandBuffer commandBuffer = m_device.beginSingleTimeCommands();
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		VkBufferCopy bufferCopy{};
+		bufferCopy.srcOffset = sizeof(std::uint32_t) * (1 + m_current);
+		bufferCopy.dstOffset = 0;
+		bufferCopy.size = sizeof(std::uint32_t);
+		vkCmdCopyBuffer(commandBuffer, m_counterBuffer, stagingBuffer, 1, &bufferCopy);
+
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+		m_device.endSingleTimeCommands(commandBuffer);
+
+		std::uint32_t aliveCount = 0;
+		void *data;
+		vkMapMemory(m_device.getDevice(), stagingBufferMemory, 0, sizeof(std::uint32_t), 0, &data);
+		std::memcpy(&aliveCount, data, sizeof(std::uint32_t));
+		vkUnmapMemory(m_device.getDevice(), stagingBufferMemory);
+
+		vkDestroyBuffer(m_device.getDevice(), stagingBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(stagingBufferMemory);
+
+		return aliveCount;
+	}
+
+	void ParticleSystem::createBuffers() {
+		VkPhysicalDeviceLimits limits = m_device.getPhysicalDeviceProperties().limits;
+
+		const VkDeviceSize particleBufferSize = static_cast<VkDeviceSize>(m_maxParticles) * sizeof(glm::vec4) * 2;
+		const VkDeviceSize listSize = static_cast<VkDeviceSize>(m_maxParticles) * sizeof(std::uint32_t);
+		if (particleBufferSize > limits.maxStorageBufferRange) {
+			throw std::runtime_error("Particle count exceeds the maximum storage buffer range.");
+		}
+
+		m_device.createBuffer(particleBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_particleBuffer, m_particleBufferMemory);
+		m_device.createBuffer(listSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_deadListBuffer, m_deadListBufferMemory);
+		m_device.createBuffer(listSize * 2, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_aliveListBuffer, m_aliveListBufferMemory);
+		m_device.createBuffer(
+			COUNTER_BUFFER_SIZE,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_counterBuffer,
+			m_counterBufferMemory
+		);
+
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+		m_emitterSliceSize = (sizeof(EmitterData) * MAX_EMITTERS + alignment - 1) / alignment * alignment;
+
+		m_device.createBuffer(
+			m_emitterSliceSize * m_frameCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			m_emitterBuffer,
+			m_emitterBufferMemory
+		);
+
+		vkMapMemory(m_device.getDevice(), m_emitterBufferMemory, 0, m_emitterSliceSize * m_frameCount, 0, &m_emitterBufferMapped);
+	}
+
+	void ParticleSystem::createDescriptorSetLayout() {
+		std::array<VkDescriptorSetLayoutBinding, 5> bindings{};
+		for (std::uint32_t i = 0; i < bindings.size(); ++i) {
+			bindings[i].binding = i;
+			bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			bindings[i].descriptorCount = 1;
+			bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+			bindings[i].pImmutableSamplers = nullptr;
+		}
+		bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		bindings[4].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = static_cast<std::uint32_t>(bindings.size());
+		descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create particle descriptor set layout.");
+		}
+	}
+
+	void ParticleSystem::createDescriptorSet() {
+		std::array<VkDescriptorPoolSize, 2> descriptorPoolSizes{};
+		descriptorPoolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorPoolSizes[0].descriptorCount = 4;
+		descriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		descriptorPoolSizes[1].descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = static_cast<std::uint32_t>(descriptorPoolSizes.size());
+		descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create particle descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &m_descriptorSetLayout;
+
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, &m_descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate particle descriptor set.");
+		}
+
+		std::array<VkDescriptorBufferInfo, 5> descriptorBufferInfos{};
+		descriptorBufferInfos[0] = { m_particleBuffer, 0, VK_WHOLE_SIZE };
+		descriptorBufferInfos[1] = { m_deadListBuffer, 0, VK_WHOLE_SIZE };
+		descriptorBufferInfos[2] = { m_aliveListBuffer, 0, VK_WHOLE_SIZE };
+		descriptorBufferInfos[3] = { m_counterBuffer, 0, VK_WHOLE_SIZE };
+		descriptorBufferInfos[4] = { m_emitterBuffer, 0, m_emitterSliceSize };
+
+		std::array<VkWriteDescriptorSet, 5> writeDescriptorSets{};
+		for (std::uint32_t i = 0; i < writeDescriptorSets.size(); ++i) {
+			writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writeDescriptorSets[i].pNext = nullptr;
+			writeDescriptorSets[i].dstSet = m_descriptorSet;
+			writeDescriptorSets[i].dstBinding = i;
+			writeDescriptorSets[i].dstArrayElement = 0;
+			writeDescriptorSets[i].descriptorType = i == 4 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writeDescriptorSets[i].descriptorCount = 1;
+			writeDescriptorSets[i].pBufferInfo = &descriptorBufferInfos[i];
+		}
+
+		vkUpdateDescriptorSets(m_device.getDevice(), static_cast<std::uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+
+	void ParticleSystem::createComputePipelines() {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(ComputePushConstantData);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_computePipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create particle compute pipeline layout.");
+		}
+
+		m_initPipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/particle_init.comp.spv", m_computePipelineLayout);
+		m_dispatchPipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/particle_dispatch.comp.spv", m_computePipelineLayout);
+		m_emitPipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/particle_emit.comp.spv", m_computePipelineLayout);
+		m_simulatePipeline = std::make_unique<ComputePipeline>(m_device, "resources/shaders/particle_simulate.comp.spv", m_computePipelineLayout);
+	}
+
+	std::uint32_t ParticleSystem::writeEmitters(std::uint32_t frameIndex, float deltaTime) {
+		EmitterData *emitterData = reinterpret_cast<EmitterData *>(static_cast<char *>(m_emitterBufferMapped) + m_emitterSliceSize * frameIndex);
+
+		std::uint32_t particleCount = 0;
+		for (std::size_t i = 0; i < m_emitters.size(); ++i) {
+			const Emitter &emitter = m_emitters[i];
+
+			m_emitAccumulators[i] += emitter.rate * deltaTime;
+			float count = std::floor(m_emitAccumulators[i]);
+			m_emitAccumulators[i] -= count;
+
+			std::uint32_t emitCount = static_cast<std::uint32_t>(std::min(count, static_cast<float>(m_maxParticles - particleCount)));
+
+			emitterData[i].positionSpread = glm::vec4{ emitter.position, emitter.spread };
+			emitterData[i].velocityLifetime = glm::vec4{ emitter.velocity, emitter.lifetime };
+			emitterData[i].color = emitter.color;
+			emitterData[i].firstParticle = particleCount;
+			emitterData[i].particleCount = emitCount;
+
+			particleCount += emitCount;
+		}
+
+		return particleCount;
+	}
+
+	void ParticleSystem::bindComputePipeline(VkCommandBuffer commandBuffer, ComputePipeline &pipeline, const ComputePushConstantData &pushConstants, std::uint32_t frameIndex) {
+		std::uint32_t dynamicOffset = static_cast<std::uint32_t>(m_emitterSliceSize * frameIndex);
+
+		pipeline.bind(commandBuffer);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipelineLayout, 0, 1, &m_descriptorSet, 1, &dynamicOffset);
+		vkCmdPushConstants(commandBuffer, m_computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ComputePushConstantData), &pushConstants);
+	}
+
+	void ParticleSystem::recordComputeBarrier(VkCommandBuffer commandBuffer) {
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+			0,
+			1, &memoryBarrier,
+			0, nullptr,
+			0, nullptr
+		);
+	}
+}
\ No newline at end of file
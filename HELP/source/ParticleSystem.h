@@ -0,0 +1,146 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Device.h"
+#include "Swapchain.h"
+#include "Camera.h"
+#include "Pipeline.h"
+#include "ComputePipeline.h"
+#include "RenderGraph.h"
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class ParticleSystem {
+	public:
+		using EmitterId = std::uint32_t;
+
+		struct Emitter {
+			glm::vec3 position{ 0.0f };
+			float rate = 1000.0f;
+			glm::vec3 velocity{ 0.0f, -1.0f, 0.0f };
+			float spread = 0.5f;
+			glm::vec4 color{ 1.0f };
+			float lifetime = 2.0f;
+		};
+
+		struct GraphResources {
+			RenderGraph::ResourceHandle particles;
+			RenderGraph::ResourceHandle aliveList;
+			RenderGraph::ResourceHandle counters;
+		};
+
+		ParticleSystem(Device &device, std::uint32_t maxParticles, std::uint32_t frameCount);
+		~ParticleSystem();
+
+		ParticleSystem(const ParticleSystem &) = delete;
+		ParticleSystem &operator=(const ParticleSystem &) = delete;
+
+		EmitterId addEmitter(const Emitter &emitter);
+		Emitter &getEmitter(EmitterId emitter);
+		void setGravity(const glm::vec3 &gravity);
+		void setParticleSize(float size);
+
+		void createRenderPipeline(Swapchain &swapchain);
+		GraphResources importResources(RenderGraph &graph) const;
+
+		void update(VkCommandBuffer commandBuffer, std::uint32_t frameIndex, float deltaTime);
+		void draw(VkCommandBuffer commandBuffer, const Camera &camera, std::uint32_t frameIndex);
+
+		std::uint32_t getMaxParticles() const;
+		std::uint32_t readAliveCount();
+
+		static constexpr std::uint32_t MAX_EMITTERS = 64;
+	private:
+		struct EmitterData {
+			glm::vec4 positionSpread;
+			glm::vec4 velocityLifetime;
+			glm::vec4 color;
+			std::uint32_t firstParticle;
+			std::uint32_t particleCount;
+			std::uint32_t padding[2];
+		};
+
+		struct ComputePushConstantData {
+			glm::vec4 gravityDeltaTime;
+			std::uint32_t maxParticles;
+			std::uint32_t emitterCount;
+			std::uint32_t requestedEmitCount;
+			std::uint32_t seed;
+			std::uint32_t current;
+			std::uint32_t mode;
+		};
+
+		struct RenderPushConstantData {
+			glm::mat4 projectionView;
+			glm::vec4 cameraRight;
+			glm::vec4 cameraUp;
+			std::uint32_t aliveOffset;
+		};
+
+		void createBuffers();
+		void createDescriptorSetLayout();
+		void createDescriptorSet();
+		void createComputePipelines();
+
+		std::uint32_t writeEmitters(std::uint32_t frameIndex, float deltaTime);
+		void bindComputePipeline(VkCommandBuffer commandBuffer, ComputePipeline &pipeline, const ComputePushConstantData &pushConstants, std::uint32_t frameIndex);
+		void recordComputeBarrier(VkCommandBuffer commandBuffer);
+
+		Device &m_device;
+		std::uint32_t m_maxParticles;
+		std::uint32_t m_frameCount;
+
+		VkBuffer m_particleBuffer;
+		VkDeviceMemory m_particleBufferMemory;
+		VkBuffer m_deadListBuffer;
+		VkDeviceMemory m_deadListBufferMemory;
+		VkBuffer m_aliveListBuffer;
+		VkDeviceMemory m_aliveListBufferMemory;
+		VkBuffer m_counterBuffer;
+		VkDeviceMemory m_counterBufferMemory;
+		VkBuffer m_emitterBuffer;
+		VkDeviceMemory m_emitterBufferMemory;
+		void *m_emitterBufferMapped = nullptr;
+		VkDeviceSize m_emitterSliceSize = 0;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkDescriptorPool m_descriptorPool;
+		VkDescriptorSet m_descriptorSet;
+		VkPipelineLayout m_computePipelineLayout;
+		VkPipelineLayout m_renderPipelineLayout = VK_NULL_HANDLE;
+
+		std::unique_ptr<ComputePipeline> m_initPipeline;
+		std::unique_ptr<ComputePipeline> m_dispatchPipeline;
+		std::unique_ptr<ComputePipeline> m_emitPipeline;
+		std::unique_ptr<ComputePipeline> m_simulatePipeline;
+		std::unique_ptr<Pipeline> m_renderPipeline;
+
+		std::vector<Emitter> m_emitters;
+		std::vector<float> m_emitAccumulators;
+		glm::vec3 m_gravity{ 0.0f, 9.81f, 0.0f };
+		float m_particleSize = 0.02f;
+		std::uint32_t m_current = 0;
+		std::uint32_t m_seed = 0;
+		bool m_initialized = false;
+
+		static constexpr std::uint32_t GROUP_SIZE = 256;
+		static constexpr VkDeviceSize DISPATCH_INDIRECT_OFFSET = 16;
+		static constexpr VkDeviceSize DRAW_INDIRECT_OFFSET = 32;
+		static constexpr VkDeviceSize COUNTER_BUFFER_SIZE = 48;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -2,28 +2,62 @@
 
 namespace eng {
 	Pipeline::Pipeline(Device &device, Swapchain &swapchain, const VkPipelineLayout &layout)
+		: Pipeline(device, swapchain, layout, getDefaultConfig()) {
+	}
+
+	Pipeline::Pipeline(Device &device, Swapchain &swapchain, const VkPipelineLayout &layout, const Config &config)
 		: m_device(device), m_swapchain(swapchain) {
-		createPipeline(layout);
+		createPipeline(layout, config);
 	}
 
 	Pipeline::~Pipeline() {
-		vkDestroyPipeline(m_device.getDevice(), m_pipeline, nullptr);
+		vkDestroyPipeline(m_device.getDevice(), m_pipeline, VulkanAllocator::get(AllocationCategory::Pipeline));
+
+		if (m_renderPass != VK_NULL_HANDLE) {
+			vkDestroyRenderPass(m_device.getDevice(), m_renderPass, VulkanAllocator::get(AllocationCategory::Pipeline));
+		}
 	}
 
 	void Pipeline::bind(VkCommandBuffer commandBuffer) {
 		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
 	}
 
+	void Pipeline::bind(DrawRecorder &recorder) {
+		recorder.bindPipeline(m_pipeline);
+	}
+
 	VkPipeline Pipeline::getPipeline() const {
 		return m_pipeline;
 	}
 
-	void Pipeline::createPipeline(const VkPipelineLayout &layout) {
-		std::vector<char> vertexShaderCode = readFile("resources/shaders/simple.vert.spv");
-		std::vector<char> fragmentShaderCode = readFile("resources/shaders/simple.frag.spv");
+	Pipeline::Config Pipeline::getDefaultConfig() {
+		Config config{};
+		config.vertexShaderPath = "resources/shaders/simple.vert.spv";
+		config.fragmentShaderPath = "resources/shaders/simple.frag.spv";
+		config.modelVertexInput = true;
+		config.cullMode = VK_CULL_MODE_BACK_BIT;
+		config.depthTest = true;
+		config.depthWrite = true;
+		config.additiveBlend = false;
+		config.colorFormat = VK_FORMAT_UNDEFINED;
+		config.depthFormat = VK_FORMAT_UNDEFINED;
+		config.viewMask = 0;
+		config.depthOnly = false;
+		config.depthBiasConstant = 0.0f;
+		config.depthBiasSlope = 0.0f;
+
+		return config;
+	}
 
+	void Pipeline::createPipeline(const VkPipelineLayout &layout, const Config &config) {
+		std::vector<char> vertexShaderCode = readFile(config.vertexShaderPath);
 		VkShaderModule vertexShaderModule = createShaderModule(vertexShaderCode);
-		VkShaderModule fragmentShaderModule = createShaderModule(fragmentShaderCode);
+
+		VkShaderModule fragmentShaderModule = VK_NULL_HANDLE;
+		if (!config.depthOnly) {
+			std::vector<char> fragmentShaderCode = readFile(config.fragmentShaderPath);
+			fragmentShaderModule = createShaderModule(fragmentShaderCode);
+		}
 
 		VkPipelineShaderStageCreateInfo vertexShaderStageCreateInfo{};
 		vertexShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -44,13 +78,17 @@ namespace eng {
 			fragmentShaderStageCreateInfo
 		};
 
-		std::vector<VkDynamicState> dynamicStates = {
+		std::array<VkDynamicState, 2> dynamicStates = {
 			VK_DYNAMIC_STATE_VIEWPORT,
 			VK_DYNAMIC_STATE_SCISSOR
 		};
 
-		std::vector<VkVertexInputBindingDescription> bindingDescriptions = Model::Vertex::getBindDescriptions();
-		std::vector<VkVertexInputAttributeDescription> attributeDescriptions = Model::Vertex::getAttributeDescriptions();
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions;
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+		if (config.modelVertexInput) {
+			bindingDescriptions = Model::Vertex::getBindDescriptions();
+			attributeDescriptions = Model::Vertex::getAttributeDescriptions();
+		}
 
 		VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
 		vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -87,12 +125,12 @@ namespace eng {
 		rasterizationStateCreateInfo.rasterizerDiscardEnable = VK_FALSE;
 		rasterizationStateCreateInfo.polygonMode = VK_POLYGON_MODE_FILL;
 		rasterizationStateCreateInfo.lineWidth = 1.0f;
-		rasterizationStateCreateInfo.cullMode = VK_CULL_MODE_BACK_BIT;
+		rasterizationStateCreateInfo.cullMode = config.cullMode;
 		rasterizationStateCreateInfo.frontFace = VK_FRONT_FACE_CLOCKWISE;
-		rasterizationStateCreateInfo.depthBiasEnable = VK_FALSE;
+		rasterizationStateCreateInfo.depthBiasEnable = config.depthBiasConstant != 0.0f || config.depthBiasSlope != 0.0f ? VK_TRUE : VK_FALSE;
 		rasterizationStateCreateInfo.depthBiasClamp = 0.0f;
-		rasterizationStateCreateInfo.depthBiasConstantFactor = 0.0f;
-		rasterizationStateCreateInfo.depthBiasSlopeFactor = 0.0f;
+		rasterizationStateCreateInfo.depthBiasConstantFactor = config.depthBiasConstant;
+		rasterizationStateCreateInfo.depthBiasSlopeFactor = config.depthBiasSlope;
 
 		VkPipelineMultisampleStateCreateInfo multisampleStateCreateInfo{};
 		multisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
@@ -104,15 +142,28 @@ namespace eng {
 		multisampleStateCreateInfo.alphaToCoverageEnable = VK_FALSE;
 		multisampleStateCreateInfo.alphaToOneEnable = VK_FALSE;
 
+		VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo{};
+		depthStencilStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+		depthStencilStateCreateInfo.pNext = nullptr;
+		depthStencilStateCreateInfo.depthTestEnable = config.depthTest ? VK_TRUE : VK_FALSE;
+		depthStencilStateCreateInfo.depthWriteEnable = config.depthTest && config.depthWrite ? VK_TRUE : VK_FALSE;
+		depthStencilStateCreateInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+		depthStencilStateCreateInfo.depthBoundsTestEnable = VK_FALSE;
+		depthStencilStateCreateInfo.minDepthBounds = 0.0f;
+		depthStencilStateCreateInfo.maxDepthBounds = 1.0f;
+		depthStencilStateCreateInfo.stencilTestEnable = VK_FALSE;
+		depthStencilStateCreateInfo.front = {};
+		depthStencilStateCreateInfo.back = {};
+
 		VkPipelineColorBlendAttachmentState colorBlendAttachmentState{};
 		colorBlendAttachmentState.colorWriteMask =
 			VK_COLOR_COMPONENT_R_BIT |
 			VK_COLOR_COMPONENT_G_BIT |
 			VK_COLOR_COMPONENT_B_BIT |
 			VK_COLOR_COMPONENT_A_BIT;
-		colorBlendAttachmentState.blendEnable = VK_FALSE;
-		colorBlendAttachmentState.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-		colorBlendAttachmentState.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+		colorBlendAttachmentState.blendEnable = config.additiveBlend ? VK_TRUE : VK_FALSE;
+		colorBlendAttachmentState.srcColorBlendFactor = config.additiveBlend ? VK_BLEND_FACTOR_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
+		colorBlendAttachmentState.dstColorBlendFactor = config.additiveBlend ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ZERO;
 		colorBlendAttachmentState.colorBlendOp = VK_BLEND_OP_ADD;
 		colorBlendAttachmentState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
 		colorBlendAttachmentState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
@@ -123,38 +174,130 @@ namespace eng {
 		colorBlendStateCreateInfo.pNext = nullptr;
 		colorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
 		colorBlendStateCreateInfo.logicOp = VK_LOGIC_OP_COPY;
-		colorBlendStateCreateInfo.attachmentCount = 1;
+		colorBlendStateCreateInfo.attachmentCount = config.depthOnly ? 0 : 1;
 		colorBlendStateCreateInfo.pAttachments = &colorBlendAttachmentState;
 		colorBlendStateCreateInfo.blendConstants[0] = 0.0f;
 		colorBlendStateCreateInfo.blendConstants[1] = 0.0f;
 		colorBlendStateCreateInfo.blendConstants[2] = 0.0f;
 		colorBlendStateCreateInfo.blendConstants[3] = 0.0f;
 
+		VkFormat colorAttachmentFormat = config.colorFormat != VK_FORMAT_UNDEFINED ? config.colorFormat : m_swapchain.getImageFormat();
+		VkFormat depthAttachmentFormat = config.depthFormat != VK_FORMAT_UNDEFINED ? config.depthFormat : m_swapchain.getDepthFormat();
+		if (!config.depthTest) {
+			depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+		}
+
+		VkPipelineRenderingCreateInfoKHR pipelineRenderingCreateInfo{};
+		pipelineRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+		pipelineRenderingCreateInfo.pNext = nullptr;
+		pipelineRenderingCreateInfo.viewMask = config.viewMask;
+		pipelineRenderingCreateInfo.colorAttachmentCount = config.depthOnly ? 0 : 1;
+		pipelineRenderingCreateInfo.pColorAttachmentFormats = &colorAttachmentFormat;
+		pipelineRenderingCreateInfo.depthAttachmentFormat = depthAttachmentFormat;
+		pipelineRenderingCreateInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+
 		VkGraphicsPipelineCreateInfo pipelineCreateInfo{};
 		pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-		pipelineCreateInfo.pNext = nullptr;
-		pipelineCreateInfo.stageCount = 2;
+		pipelineCreateInfo.pNext = m_device.isDynamicRenderingEnabled() ? &pipelineRenderingCreateInfo : nullptr;
+		pipelineCreateInfo.stageCount = config.depthOnly ? 1 : 2;
 		pipelineCreateInfo.pStages = shaderStages;
 		pipelineCreateInfo.pVertexInputState = &vertexInputStateCreateInfo;
 		pipelineCreateInfo.pInputAssemblyState = &inputAssemblyStateCreateInfo;
 		pipelineCreateInfo.pViewportState = &viewportStateCreateInfo;
 		pipelineCreateInfo.pRasterizationState = &rasterizationStateCreateInfo;
 		pipelineCreateInfo.pMultisampleState = &multisampleStateCreateInfo;
-		pipelineCreateInfo.pDepthStencilState = nullptr;
+		pipelineCreateInfo.pDepthStencilState = config.depthTest ? &depthStencilStateCreateInfo : nullptr;
 		pipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
 		pipelineCreateInfo.pDynamicState = &dynamicState;
 		pipelineCreateInfo.layout = layout;
 		pipelineCreateInfo.renderPass = m_swapchain.getRenderPass();
+
+		if (!m_device.isDynamicRenderingEnabled() && (config.depthOnly || colorAttachmentFormat != m_swapchain.getImageFormat() || depthAttachmentFormat != m_swapchain.getDepthFormat() || config.viewMask != 0)) {
+			createRenderPass(config.depthOnly ? VK_FORMAT_UNDEFINED : colorAttachmentFormat, depthAttachmentFormat, config.viewMask);
+			pipelineCreateInfo.renderPass = m_renderPass;
+		}
 		pipelineCreateInfo.subpass = 0;
 		pipelineCreateInfo.basePipelineIndex = -1;
 		pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-		if (vkCreateGraphicsPipelines(m_device.getDevice(), VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &m_pipeline) != VK_SUCCESS) {
+		if (vkCreateGraphicsPipelines(m_device.getDevice(), VK_NULL_HANDLE, 1, &pipelineCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipeline) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create pipeline.");
 		}
 
-		vkDestroyShaderModule(m_device.getDevice(), vertexShaderModule, nullptr);
-		vkDestroyShaderModule(m_device.getDevice(), fragmentShaderModule, nullptr);
+		vkDestroyShaderModule(m_device.getDevice(), vertexShaderModule, VulkanAllocator::get(AllocationCategory::Pipeline));
+		if (fragmentShaderModule != VK_NULL_HANDLE) {
+			vkDestroyShaderModule(m_device.getDevice(), fragmentShaderModule, VulkanAllocator::get(AllocationCategory::Pipeline));
+		}
+	}
+
+	void Pipeline::createRenderPass(VkFormat colorFormat, VkFormat depthFormat, std::uint32_t viewMask) {
+		const bool hasColorAttachment = colorFormat != VK_FORMAT_UNDEFINED;
+		const bool hasDepthAttachment = depthFormat != VK_FORMAT_UNDEFINED;
+
+		std::vector<VkAttachmentDescription> attachmentDescriptions;
+		if (hasColorAttachment) {
+			VkAttachmentDescription colorAttachmentDescription{};
+			colorAttachmentDescription.format = colorFormat;
+			colorAttachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+			colorAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			colorAttachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			colorAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			colorAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			colorAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			colorAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions.push_back(colorAttachmentDescription);
+		}
+
+		if (hasDepthAttachment) {
+			VkAttachmentDescription depthAttachmentDescription{};
+			depthAttachmentDescription.format = depthFormat;
+			depthAttachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+			depthAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			depthAttachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			depthAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			depthAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			depthAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			depthAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions.push_back(depthAttachmentDescription);
+		}
+
+		VkAttachmentReference colorAttachmentReference{};
+		colorAttachmentReference.attachment = 0;
+		colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		VkAttachmentReference depthAttachmentReference{};
+		depthAttachmentReference.attachment = hasColorAttachment ? 1 : 0;
+		depthAttachmentReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		VkSubpassDescription subpassDescription{};
+		subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpassDescription.colorAttachmentCount = hasColorAttachment ? 1 : 0;
+		subpassDescription.pColorAttachments = hasColorAttachment ? &colorAttachmentReference : nullptr;
+		subpassDescription.pDepthStencilAttachment = hasDepthAttachment ? &depthAttachmentReference : nullptr;
+
+		VkRenderPassMultiviewCreateInfo renderPassMultiviewCreateInfo{};
+		renderPassMultiviewCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+		renderPassMultiviewCreateInfo.pNext = nullptr;
+		renderPassMultiviewCreateInfo.subpassCount = 1;
+		renderPassMultiviewCreateInfo.pViewMasks = &viewMask;
+		renderPassMultiviewCreateInfo.dependencyCount = 0;
+		renderPassMultiviewCreateInfo.pViewOffsets = nullptr;
+		renderPassMultiviewCreateInfo.correlationMaskCount = 1;
+		renderPassMultiviewCreateInfo.pCorrelationMasks = &viewMask;
+
+		VkRenderPassCreateInfo renderPassCreateInfo{};
+		renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassCreateInfo.pNext = viewMask != 0 ? &renderPassMultiviewCreateInfo : nullptr;
+		renderPassCreateInfo.attachmentCount = static_cast<std::uint32_t>(attachmentDescriptions.size());
+		renderPassCreateInfo.pAttachments = attachmentDescriptions.data();
+		renderPassCreateInfo.subpassCount = 1;
+		renderPassCreateInfo.pSubpasses = &subpassDescription;
+		renderPassCreateInfo.dependencyCount = 0;
+		renderPassCreateInfo.pDependencies = nullptr;
+
+		if (vkCreateRenderPass(m_device.getDevice(), &renderPassCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_renderPass) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create pipeline render pass.");
+		}
 	}
 
 	VkShaderModule Pipeline::createShaderModule(const std::vector<char> shaderCode) {
@@ -165,7 +308,7 @@ namespace eng {
 		shaderModuleCreateInfo.pCode = reinterpret_cast<const std::uint32_t *>(shaderCode.data());
 
 		VkShaderModule shaderModule;
-		if (vkCreateShaderModule(m_device.getDevice(), &shaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+		if (vkCreateShaderModule(m_device.getDevice(), &shaderModuleCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &shaderModule) != VK_SUCCESS) {
 			throw std::runtime_error("Failed to create shader module.");
 		}
 
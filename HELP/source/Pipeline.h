@@ -6,28 +6,55 @@
 #include "Device.h"
 #include "Swapchain.h"
 #include "Model.h"
+#include "DrawRecorder.h"
 
 #include <fstream>
 #include <vector>
+#include <array>
 #include <string>
 #include <stdexcept>
 
 namespace eng {
 	class Pipeline {
 	public:
+		struct Config {
+			std::string vertexShaderPath;
+			std::string fragmentShaderPath;
+			bool modelVertexInput;
+			VkCullModeFlags cullMode;
+			bool depthTest;
+			bool depthWrite;
+			bool additiveBlend;
+			VkFormat colorFormat;
+			VkFormat depthFormat;
+			std::uint32_t viewMask;
+			bool depthOnly;
+			float depthBiasConstant;
+			float depthBiasSlope;
+		};
+
 		Pipeline(Device &device, Swapchain &swapchain, const VkPipelineLayout &layout);
+		Pipeline(Device &device, Swapchain &swapchain, const VkPipelineLayout &layout, const Config &config);
 		~Pipeline();
 
+		Pipeline(const Pipeline &) = delete;
+		Pipeline &operator=(const Pipeline &) = delete;
+
 		void bind(VkCommandBuffer commandBuffer);
+		void bind(DrawRecorder &recorder);
 
 		VkPipeline getPipeline() const;
+
+		static Config getDefaultConfig();
 	private:
-		void createPipeline(const VkPipelineLayout &layout);
+		void createPipeline(const VkPipelineLayout &layout, const Config &config);
+		void createRenderPass(VkFormat colorFormat, VkFormat depthFormat, std::uint32_t viewMask);
 
 		VkShaderModule createShaderModule(const std::vector<char> shaderCode);
 		static std::vector<char> readFile(const std::string &filename);
 
 		VkPipeline m_pipeline;
+		VkRenderPass m_renderPass = VK_NULL_HANDLE;
 
 		Device &m_device;
 		Swapchain &m_swapchain;
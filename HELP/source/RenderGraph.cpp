@@ -0,0 +1,563 @@
+#include "RenderGraph.h"
+
+namespace eng {
+	RenderGraph::RenderGraph()
+		: m_resources(m_arena), m_passes(m_arena), m_passBarriers(m_arena), m_finalBarriers(m_arena), m_memoryBlocks(m_arena) {
+	}
+
+	RenderGraph::PassBuilder::PassBuilder(RenderGraph &graph, std::uint32_t pass)
+		: m_graph(graph), m_pass(pass) {
+	}
+
+	RenderGraph::PassBuilder &RenderGraph::PassBuilder::read(ResourceHandle resource, Access access) {
+		return use(resource, access, false, false, VkClearValue{});
+	}
+
+	RenderGraph::PassBuilder &RenderGraph::PassBuilder::write(ResourceHandle resource, Access access) {
+		return use(resource, access, true, false, VkClearValue{});
+	}
+
+	RenderGraph::PassBuilder &RenderGraph::PassBuilder::clear(ResourceHandle resource, Access access, const VkClearValue &clearValue) {
+		return use(resource, access, true, true, clearValue);
+	}
+
+	RenderGraph::PassBuilder &RenderGraph::PassBuilder::setSideEffect() {
+		m_graph.m_passes[m_pass].sideEffect = true;
+		return *this;
+	}
+
+	RenderGraph::PassBuilder &RenderGraph::PassBuilder::setViewMask(std::uint32_t viewMask) {
+		m_graph.m_passes[m_pass].viewMask = viewMask;
+		return *this;
+	}
+
+	RenderGraph::PassBuilder &RenderGraph::PassBuilder::setExecute(std::function<void(VkCommandBuffer)> execute) {
+		m_graph.m_passes[m_pass].execute = std::move(execute);
+		return *this;
+	}
+
+	RenderGraph::PassBuilder &RenderGraph::PassBuilder::use(ResourceHandle resource, Access access, bool write, bool clear, const VkClearValue &clearValue) {
+		if (resource >= m_graph.m_resources.size()) {
+			throw std::runtime_error("Render graph pass uses an invalid resource.");
+		}
+
+		Use use{};
+		use.resource = resource;
+		use.access = access;
+		use.write = write;
+		use.clear = clear;
+		use.clearValue = clearValue;
+
+		m_graph.m_passes[m_pass].uses.push_back(use);
+		return *this;
+	}
+
+	void RenderGraph::reset() {
+		m_resources = FrameVector<Resource>(m_arena);
+		m_passes = FrameVector<Pass>(m_arena);
+		m_passBarriers = FrameVector<FrameVector<Barrier>>(m_arena);
+		m_finalBarriers = FrameVector<Barrier>(m_arena);
+		m_memoryBlocks = FrameVector<MemoryBlock>(m_arena);
+		m_statistics = {};
+
+		m_arena.reset();
+	}
+
+	RenderGraph::ResourceHandle RenderGraph::createImage(std::string_view name, const ImageDescription &description) {
+		Resource resource = createResource(name);
+		resource.image = true;
+		resource.imageDescription = description;
+
+		m_resources.push_back(resource);
+		return static_cast<ResourceHandle>(m_resources.size() - 1);
+	}
+
+	RenderGraph::ResourceHandle RenderGraph::createBuffer(std::string_view name, const BufferDescription &description) {
+		Resource resource = createResource(name);
+		resource.image = false;
+		resource.bufferDescription = description;
+
+		m_resources.push_back(resource);
+		return static_cast<ResourceHandle>(m_resources.size() - 1);
+	}
+
+	RenderGraph::ResourceHandle RenderGraph::importImage(std::string_view name, VkImage image, VkImageView imageView, const ImageDescription &description, const ResourceState &initialState, VkImageLayout finalLayout) {
+		Resource resource = createResource(name);
+		resource.image = true;
+		resource.imported = true;
+		resource.imageDescription = description;
+		resource.importedImage = image;
+		resource.importedImageView = imageView;
+		resource.initialState = initialState;
+		resource.finalLayout = finalLayout;
+
+		m_resources.push_back(resource);
+		return static_cast<ResourceHandle>(m_resources.size() - 1);
+	}
+
+	RenderGraph::ResourceHandle RenderGraph::importBuffer(std::string_view name, VkBuffer buffer, const BufferDescription &description, const ResourceState &initialState) {
+		Resource resource = createResource(name);
+		resource.image = false;
+		resource.imported = true;
+		resource.bufferDescription = description;
+		resource.importedBuffer = buffer;
+		resource.initialState = initialState;
+
+		m_resources.push_back(resource);
+		return static_cast<ResourceHandle>(m_resources.size() - 1);
+	}
+
+	void RenderGraph::markOutput(ResourceHandle resource) {
+		m_resources[resource].output = true;
+	}
+
+	RenderGraph::PassBuilder RenderGraph::addPass(std::string_view name, PassType type) {
+		Pass pass{};
+		pass.name = FrameString(name.data(), name.size(), m_arena);
+		pass.type = type;
+		pass.uses = FrameVector<Use>(m_arena);
+
+		m_passes.push_back(std::move(pass));
+		return PassBuilder{ *this, static_cast<std::uint32_t>(m_passes.size() - 1) };
+	}
+
+	void RenderGraph::compile() {
+		cullPasses();
+		computeLifetimes();
+		resolvePassStates();
+	}
+
+	void RenderGraph::assignMemory(const std::vector<VkMemoryRequirements> &memoryRequirements) {
+		if (memoryRequirements.size() < m_resources.size()) {
+			throw std::runtime_error("Render graph memory requirements do not cover every resource.");
+		}
+
+		planAliasing(memoryRequirements);
+		buildBarriers();
+	}
+
+	std::uint32_t RenderGraph::getResourceCount() const {
+		return static_cast<std::uint32_t>(m_resources.size());
+	}
+
+	const RenderGraph::Resource &RenderGraph::getResource(ResourceHandle resource) const {
+		return m_resources[resource];
+	}
+
+	std::uint32_t RenderGraph::getPassCount() const {
+		return static_cast<std::uint32_t>(m_passes.size());
+	}
+
+	const RenderGraph::Pass &RenderGraph::getPass(std::uint32_t pass) const {
+		return m_passes[pass];
+	}
+
+	const FrameVector<RenderGraph::Barrier> &RenderGraph::getPassBarriers(std::uint32_t pass) const {
+		return m_passBarriers[pass];
+	}
+
+	const FrameVector<RenderGraph::Barrier> &RenderGraph::getFinalBarriers() const {
+		return m_finalBarriers;
+	}
+
+	const FrameVector<RenderGraph::MemoryBlock> &RenderGraph::getMemoryBlocks() const {
+		return m_memoryBlocks;
+	}
+
+	const FrameArena &RenderGraph::getArena() const {
+		return m_arena;
+	}
+
+	const RenderGraph::Statistics &RenderGraph::getStatistics() const {
+		return m_statistics;
+	}
+
+	bool RenderGraph::isTransient(ResourceHandle resource) const {
+		return !m_resources[resource].imported && m_resources[resource].firstPass != INVALID_PASS;
+	}
+
+	VkAttachmentLoadOp RenderGraph::getLoadOp(std::uint32_t pass, const Use &use) const {
+		if (use.clear) {
+			return VK_ATTACHMENT_LOAD_OP_CLEAR;
+		}
+
+		const Resource &resource = m_resources[use.resource];
+		if (resource.firstPass == pass && (!resource.imported || resource.initialState.layout == VK_IMAGE_LAYOUT_UNDEFINED)) {
+			return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		}
+
+		return VK_ATTACHMENT_LOAD_OP_LOAD;
+	}
+
+	VkAttachmentStoreOp RenderGraph::getStoreOp(std::uint32_t pass, const Use &use) const {
+		const Resource &resource = m_resources[use.resource];
+		if (resource.imported || resource.output || resource.lastPass > pass) {
+			return VK_ATTACHMENT_STORE_OP_STORE;
+		}
+
+		return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	}
+
+	void RenderGraph::printStatistics() const {
+		const double megabyte = 1024.0 * 1024.0;
+
+		std::cout << "Render graph: " << m_statistics.passCount << " passes (" << m_statistics.culledPassCount << " culled)";
+		std::cout << ", " << m_statistics.barrierCount << " barriers";
+		std::cout << ", " << m_statistics.transientResourceCount << " transient resources in " << m_memoryBlocks.size() << " memory blocks";
+		std::cout << ", " << m_statistics.transientMemory / megabyte << " MB -> " << m_statistics.aliasedMemory / megabyte << " MB";
+		std::cout << " (" << (m_statistics.transientMemory - m_statistics.aliasedMemory) / megabyte << " MB saved by aliasing)\n";
+	}
+
+	RenderGraph::ResourceState RenderGraph::getAccessState(Access access, PassType type) {
+		VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		if (type == PassType::Graphics) {
+			shaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		} else if (type == PassType::Compute) {
+			shaderStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		}
+
+		switch (access) {
+		case Access::ColorAttachment:
+			return { VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT };
+		case Access::DepthAttachment:
+			return { VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+		case Access::DepthRead:
+			return { VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT };
+		case Access::Sampled:
+			return { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, shaderStages, VK_ACCESS_SHADER_READ_BIT };
+		case Access::StorageRead:
+			return { VK_IMAGE_LAYOUT_GENERAL, shaderStages, VK_ACCESS_SHADER_READ_BIT };
+		case Access::StorageWrite:
+			return { VK_IMAGE_LAYOUT_GENERAL, shaderStages, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT };
+		case Access::TransferSource:
+			return { VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT };
+		case Access::TransferDestination:
+			return { VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT };
+		case Access::IndirectBuffer:
+			return { VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT };
+		case Access::VertexBuffer:
+			return { VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT };
+		case Access::UniformBuffer:
+			return { VK_IMAGE_LAYOUT_UNDEFINED, shaderStages, VK_ACCESS_UNIFORM_READ_BIT };
+		}
+
+		throw std::runtime_error("Unknown render graph access.");
+	}
+
+	bool RenderGraph::isAttachmentAccess(Access access) {
+		return access == Access::ColorAttachment || access == Access::DepthAttachment || access == Access::DepthRead;
+	}
+
+	bool RenderGraph::hasWriteAccess(VkAccessFlags access) {
+		return getWriteAccess(access) != 0;
+	}
+
+	VkAccessFlags RenderGraph::getWriteAccess(VkAccessFlags access) {
+		const VkAccessFlags writeAccess =
+			VK_ACCESS_SHADER_WRITE_BIT |
+			VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+			VK_ACCESS_TRANSFER_WRITE_BIT |
+			VK_ACCESS_HOST_WRITE_BIT |
+			VK_ACCESS_MEMORY_WRITE_BIT;
+
+		return access & writeAccess;
+	}
+
+	void RenderGraph::cullPasses() {
+		FrameVector<bool> required(m_resources.size(), false, m_arena);
+		for (std::size_t i = 0; i < m_resources.size(); ++i) {
+			required[i] = m_resources[i].output || (m_resources[i].imported && m_resources[i].finalLayout != VK_IMAGE_LAYOUT_UNDEFINED);
+		}
+
+		m_statistics.passCount = static_cast<std::uint32_t>(m_passes.size());
+		m_statistics.culledPassCount = 0;
+
+		for (std::size_t i = m_passes.size(); i-- > 0;) {
+			Pass &pass = m_passes[i];
+
+			pass.culled = !pass.sideEffect && std::none_of(pass.uses.begin(), pass.uses.end(), [&](const Use &use) {
+				return use.write && required[use.resource];
+			});
+
+			if (pass.culled) {
+				++m_statistics.culledPassCount;
+				continue;
+			}
+
+			for (const Use &use : pass.uses) {
+				if (use.clear) {
+					required[use.resource] = false;
+				}
+			}
+
+			for (const Use &use : pass.uses) {
+				if (!use.clear) {
+					required[use.resource] = true;
+				}
+			}
+		}
+	}
+
+	void RenderGraph::computeLifetimes() {
+		FrameVector<bool> written(m_resources.size(), false, m_arena);
+
+		for (Resource &resource : m_resources) {
+			resource.firstPass = INVALID_PASS;
+			resource.lastPass = INVALID_PASS;
+			resource.memoryBlock = INVALID_BLOCK;
+		}
+
+		for (std::uint32_t i = 0; i < m_passes.size(); ++i) {
+			const Pass &pass = m_passes[i];
+			if (pass.culled) {
+				continue;
+			}
+
+			for (const Use &use : pass.uses) {
+				Resource &resource = m_resources[use.resource];
+				if (!resource.imported && !use.write && !written[use.resource]) {
+					throw std::runtime_error(std::string("Render graph resource ") + resource.name.c_str() + " is read by " + pass.name.c_str() + " before it is written.");
+				}
+
+				if (resource.firstPass == INVALID_PASS) {
+					resource.firstPass = i;
+				}
+				resource.lastPass = i;
+			}
+
+			for (const Use &use : pass.uses) {
+				if (use.write) {
+					written[use.resource] = true;
+				}
+			}
+		}
+	}
+
+	void RenderGraph::resolvePassStates() {
+		for (Pass &pass : m_passes) {
+			if (pass.culled) {
+				continue;
+			}
+
+			for (Use &use : pass.uses) {
+				use.state = getAccessState(use.access, pass.type);
+			}
+
+			for (Use &use : pass.uses) {
+				for (const Use &other : pass.uses) {
+					if (&other != &use && other.resource == use.resource) {
+						use.state = combineStates(use.state, getAccessState(other.access, pass.type));
+					}
+				}
+
+				if (!m_resources[use.resource].image) {
+					use.state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+				}
+			}
+		}
+	}
+
+	void RenderGraph::planAliasing(const std::vector<VkMemoryRequirements> &memoryRequirements) {
+		m_memoryBlocks.clear();
+		m_statistics.transientResourceCount = 0;
+		m_statistics.transientMemory = 0;
+		m_statistics.aliasedMemory = 0;
+
+		FrameVector<ResourceHandle> transientResources(m_arena);
+		for (ResourceHandle i = 0; i < m_resources.size(); ++i) {
+			m_resources[i].memoryBlock = INVALID_BLOCK;
+			if (isTransient(i)) {
+				transientResources.push_back(i);
+			}
+		}
+
+		std::sort(transientResources.begin(), transientResources.end(), [&](ResourceHandle a, ResourceHandle b) {
+			if (memoryRequirements[a].size != memoryRequirements[b].size) {
+				return memoryRequirements[a].size > memoryRequirements[b].size;
+			}
+
+			return a < b;
+		});
+
+		for (ResourceHandle handle : transientResources) {
+			Resource &resource = m_resources[handle];
+			const VkMemoryRequirements &requirements = memoryRequirements[handle];
+
+			std::uint32_t blockIndex = INVALID_BLOCK;
+			for (std::uint32_t i = 0; i < m_memoryBlocks.size(); ++i) {
+				const MemoryBlock &block = m_memoryBlocks[i];
+				if ((block.memoryTypeBits & requirements.memoryTypeBits) == 0) {
+					continue;
+				}
+
+				bool overlaps = std::any_of(block.resources.begin(), block.resources.end(), [&](ResourceHandle other) {
+					return !(m_resources[other].lastPass < resource.firstPass || resource.lastPass < m_resources[other].firstPass);
+				});
+
+				if (!overlaps) {
+					blockIndex = i;
+					break;
+				}
+			}
+
+			if (blockIndex == INVALID_BLOCK) {
+				MemoryBlock block{};
+				block.resources = FrameVector<ResourceHandle>(m_arena);
+
+				blockIndex = static_cast<std::uint32_t>(m_memoryBlocks.size());
+				m_memoryBlocks.push_back(std::move(block));
+			}
+
+			MemoryBlock &block = m_memoryBlocks[blockIndex];
+			block.size = std::max(block.size, requirements.size);
+			block.memoryTypeBits &= requirements.memoryTypeBits;
+			block.resources.push_back(handle);
+			resource.memoryBlock = blockIndex;
+
+			++m_statistics.transientResourceCount;
+			m_statistics.transientMemory += requirements.size;
+		}
+
+		for (const MemoryBlock &block : m_memoryBlocks) {
+			m_statistics.aliasedMemory += block.size;
+		}
+	}
+
+	void RenderGraph::buildBarriers() {
+		FrameVector<ResourceState> states(m_resources.size(), ResourceState{}, m_arena);
+		FrameVector<ResourceState> writeStates(m_resources.size(), ResourceState{}, m_arena);
+		for (ResourceHandle i = 0; i < m_resources.size(); ++i) {
+			if (m_resources[i].imported) {
+				states[i] = m_resources[i].initialState;
+			} else if (m_resources[i].firstPass != INVALID_PASS) {
+				states[i] = getTransientInitialState(i);
+			}
+			writeStates[i] = states[i];
+		}
+
+		m_passBarriers.assign(m_passes.size(), FrameVector<Barrier>(m_arena));
+		m_finalBarriers.clear();
+		m_statistics.barrierCount = 0;
+
+		for (std::uint32_t i = 0; i < m_passes.size(); ++i) {
+			const Pass &pass = m_passes[i];
+			if (pass.culled) {
+				continue;
+			}
+
+			FrameVector<Barrier> &barriers = m_passBarriers[i];
+			for (std::size_t j = 0; j < pass.uses.size(); ++j) {
+				const Use &use = pass.uses[j];
+
+				bool handled = std::any_of(pass.uses.begin(), pass.uses.begin() + j, [&](const Use &other) {
+					return other.resource == use.resource;
+				});
+				if (handled) {
+					continue;
+				}
+
+				ResourceState &current = states[use.resource];
+				const ResourceState &required = use.state;
+
+				bool layoutChange = m_resources[use.resource].image && current.layout != required.layout;
+				if (layoutChange || hasWriteAccess(current.access) || hasWriteAccess(required.access)) {
+					barriers.push_back({ use.resource, current, required });
+					current = required;
+
+					if (hasWriteAccess(required.access)) {
+						writeStates[use.resource] = required;
+					}
+				} else if ((required.stages & ~current.stages) != 0 || (required.access & ~current.access) != 0) {
+					ResourceState before = writeStates[use.resource];
+					before.layout = current.layout;
+
+					barriers.push_back({ use.resource, before, required });
+					current.stages |= required.stages;
+					current.access |= required.access;
+				}
+			}
+
+			m_statistics.barrierCount += static_cast<std::uint32_t>(barriers.size());
+		}
+
+		for (ResourceHandle i = 0; i < m_resources.size(); ++i) {
+			const Resource &resource = m_resources[i];
+			if (!resource.imported || resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.finalLayout == states[i].layout) {
+				continue;
+			}
+
+			m_finalBarriers.push_back({ i, states[i], { resource.finalLayout, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0 } });
+		}
+
+		m_statistics.barrierCount += static_cast<std::uint32_t>(m_finalBarriers.size());
+	}
+
+	RenderGraph::Resource RenderGraph::createResource(std::string_view name) {
+		Resource resource{};
+		resource.name = FrameString(name.data(), name.size(), m_arena);
+		return resource;
+	}
+
+	RenderGraph::ResourceState RenderGraph::getTransientInitialState(ResourceHandle resource) const {
+		const Resource &target = m_resources[resource];
+
+		ResourceHandle previous = resource;
+		if (target.memoryBlock != INVALID_BLOCK) {
+			const MemoryBlock &block = m_memoryBlocks[target.memoryBlock];
+
+			std::uint32_t previousLastPass = 0;
+			bool found = false;
+			for (ResourceHandle other : block.resources) {
+				if (m_resources[other].lastPass < target.firstPass && (!found || m_resources[other].lastPass > previousLastPass)) {
+					previous = other;
+					previousLastPass = m_resources[other].lastPass;
+					found = true;
+				}
+			}
+
+			if (!found) {
+				for (ResourceHandle other : block.resources) {
+					if (m_resources[other].lastPass >= m_resources[previous].lastPass) {
+						previous = other;
+					}
+				}
+			}
+		}
+
+		ResourceState lastState = getLastState(previous);
+		return { VK_IMAGE_LAYOUT_UNDEFINED, lastState.stages, lastState.access };
+	}
+
+	RenderGraph::ResourceState RenderGraph::getLastState(ResourceHandle resource) const {
+		const Resource &target = m_resources[resource];
+		if (target.lastPass == INVALID_PASS) {
+			return target.initialState;
+		}
+
+		for (const Use &use : m_passes[target.lastPass].uses) {
+			if (use.resource == resource) {
+				return use.state;
+			}
+		}
+
+		return target.initialState;
+	}
+
+	RenderGraph::ResourceState RenderGraph::combineStates(const ResourceState &first, const ResourceState &second) {
+		ResourceState state{};
+		state.stages = first.stages | second.stages;
+		state.access = first.access | second.access;
+
+		if (first.layout == second.layout) {
+			state.layout = first.layout;
+		} else if ((first.layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL && second.layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) ||
+			(first.layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && second.layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL)) {
+			state.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+		} else {
+			state.layout = VK_IMAGE_LAYOUT_GENERAL;
+		}
+
+		return state;
+	}
+}
\ No newline at end of file
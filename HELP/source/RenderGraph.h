@@ -0,0 +1,207 @@
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <vulkan/vulkan.h>
+
+#include "FrameArena.h"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <iostream>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class RenderGraph {
+	public:
+		using ResourceHandle = std::uint32_t;
+
+		enum class PassType {
+			Graphics,
+			Compute,
+			Transfer
+		};
+
+		enum class Access {
+			ColorAttachment,
+			DepthAttachment,
+			DepthRead,
+			Sampled,
+			StorageRead,
+			StorageWrite,
+			TransferSource,
+			TransferDestination,
+			IndirectBuffer,
+			VertexBuffer,
+			UniformBuffer
+		};
+
+		struct ImageDescription {
+			VkFormat format = VK_FORMAT_UNDEFINED;
+			VkExtent2D extent{};
+			VkImageUsageFlags usage = 0;
+			VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+			std::uint32_t baseLayer = 0;
+			std::uint32_t layerCount = 1;
+		};
+
+		struct BufferDescription {
+			VkDeviceSize size = 0;
+			VkBufferUsageFlags usage = 0;
+		};
+
+		struct ResourceState {
+			VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VkPipelineStageFlags stages = 0;
+			VkAccessFlags access = 0;
+		};
+
+		struct Resource {
+			FrameString name;
+			bool image = true;
+			bool imported = false;
+			bool output = false;
+			ImageDescription imageDescription{};
+			BufferDescription bufferDescription{};
+
+			VkImage importedImage = VK_NULL_HANDLE;
+			VkImageView importedImageView = VK_NULL_HANDLE;
+			VkBuffer importedBuffer = VK_NULL_HANDLE;
+			ResourceState initialState{};
+			VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+			std::uint32_t firstPass = INVALID_PASS;
+			std::uint32_t lastPass = INVALID_PASS;
+			std::uint32_t memoryBlock = INVALID_BLOCK;
+		};
+
+		struct Use {
+			ResourceHandle resource;
+			Access access;
+			bool write = false;
+			bool clear = false;
+			VkClearValue clearValue{};
+			ResourceState state{};
+		};
+
+		struct Pass {
+			FrameString name;
+			PassType type;
+			FrameVector<Use> uses;
+			std::function<void(VkCommandBuffer)> execute;
+			std::uint32_t viewMask = 0;
+			bool sideEffect = false;
+			bool culled = false;
+		};
+
+		struct Barrier {
+			ResourceHandle resource;
+			ResourceState before;
+			ResourceState after;
+		};
+
+		struct MemoryBlock {
+			VkDeviceSize size = 0;
+			std::uint32_t memoryTypeBits = std::numeric_limits<std::uint32_t>::max();
+			FrameVector<ResourceHandle> resources;
+		};
+
+		struct Statistics {
+			std::uint32_t passCount = 0;
+			std::uint32_t culledPassCount = 0;
+			std::uint32_t barrierCount = 0;
+			std::uint32_t transientResourceCount = 0;
+			VkDeviceSize transientMemory = 0;
+			VkDeviceSize aliasedMemory = 0;
+		};
+
+		class PassBuilder {
+		public:
+			PassBuilder(RenderGraph &graph, std::uint32_t pass);
+
+			PassBuilder &read(ResourceHandle resource, Access access);
+			PassBuilder &write(ResourceHandle resource, Access access);
+			PassBuilder &clear(ResourceHandle resource, Access access, const VkClearValue &clearValue);
+			PassBuilder &setSideEffect();
+			PassBuilder &setViewMask(std::uint32_t viewMask);
+			PassBuilder &setExecute(std::function<void(VkCommandBuffer)> execute);
+		private:
+			PassBuilder &use(ResourceHandle resource, Access access, bool write, bool clear, const VkClearValue &clearValue);
+
+			RenderGraph &m_graph;
+			std::uint32_t m_pass;
+		};
+
+		RenderGraph();
+
+		RenderGraph(const RenderGraph &) = delete;
+		RenderGraph &operator=(const RenderGraph &) = delete;
+
+		void reset();
+
+		ResourceHandle createImage(std::string_view name, const ImageDescription &description);
+		ResourceHandle createBuffer(std::string_view name, const BufferDescription &description);
+		ResourceHandle importImage(std::string_view name, VkImage image, VkImageView imageView, const ImageDescription &description, const ResourceState &initialState, VkImageLayout finalLayout);
+		ResourceHandle importBuffer(std::string_view name, VkBuffer buffer, const BufferDescription &description, const ResourceState &initialState);
+		void markOutput(ResourceHandle resource);
+
+		PassBuilder addPass(std::string_view name, PassType type);
+
+		void compile();
+		void assignMemory(const std::vector<VkMemoryRequirements> &memoryRequirements);
+
+		std::uint32_t getResourceCount() const;
+		const Resource &getResource(ResourceHandle resource) const;
+		std::uint32_t getPassCount() const;
+		const Pass &getPass(std::uint32_t pass) const;
+		const FrameVector<Barrier> &getPassBarriers(std::uint32_t pass) const;
+		const FrameVector<Barrier> &getFinalBarriers() const;
+		const FrameVector<MemoryBlock> &getMemoryBlocks() const;
+		const FrameArena &getArena() const;
+		const Statistics &getStatistics() const;
+
+		bool isTransient(ResourceHandle resource) const;
+		VkAttachmentLoadOp getLoadOp(std::uint32_t pass, const Use &use) const;
+		VkAttachmentStoreOp getStoreOp(std::uint32_t pass, const Use &use) const;
+
+		void printStatistics() const;
+
+		static ResourceState getAccessState(Access access, PassType type);
+		static bool isAttachmentAccess(Access access);
+		static bool hasWriteAccess(VkAccessFlags access);
+		static VkAccessFlags getWriteAccess(VkAccessFlags access);
+
+		static constexpr ResourceHandle INVALID_RESOURCE = std::numeric_limits<ResourceHandle>::max();
+		static constexpr std::uint32_t INVALID_PASS = std::numeric_limits<std::uint32_t>::max();
+		static constexpr std::uint32_t INVALID_BLOCK = std::numeric_limits<std::uint32_t>::max();
+	private:
+		void cullPasses();
+		void computeLifetimes();
+		void resolvePassStates();
+		void planAliasing(const std::vector<VkMemoryRequirements> &memoryRequirements);
+		void buildBarriers();
+
+		ResourceState getTransientInitialState(ResourceHandle resource) const;
+		ResourceState getLastState(ResourceHandle resource) const;
+
+		static ResourceState combineStates(const ResourceState &first, const ResourceState &second);
+
+		Resource createResource(std::string_view name);
+
+		FrameArena m_arena{ ARENA_SIZE };
+		FrameVector<Resource> m_resources;
+		FrameVector<Pass> m_passes;
+		FrameVector<FrameVector<Barrier>> m_passBarriers;
+		FrameVector<Barrier> m_finalBarriers;
+		FrameVector<MemoryBlock> m_memoryBlocks;
+		Statistics m_statistics{};
+
+		static constexpr std::size_t ARENA_SIZE = 64 * 1024;
+	};
+}
+
+#endif
\ No newline at end of file
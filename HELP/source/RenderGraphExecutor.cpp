@@ -0,0 +1,608 @@
+#include "RenderGraphExecutor.h"
+
+namespace eng {
+	RenderGraphExecutor::RenderGraphExecutor(Device &device)
+		: m_device(device) {
+	}
+
+	RenderGraphExecutor::~RenderGraphExecutor() {
+		destroyResources();
+
+		for (auto &[key, renderPass] : m_renderPasses) {
+			vkDestroyRenderPass(m_device.getDevice(), renderPass, VulkanAllocator::get(AllocationCategory::Pipeline));
+		}
+		m_renderPasses.clear();
+	}
+
+	void RenderGraphExecutor::execute(RenderGraph &graph, VkCommandBuffer commandBuffer, FrameArena &frameArena) {
+		graph.compile();
+
+		createSignature(graph, m_nextSignature);
+		if (m_nextSignature != m_signature) {
+			destroyResources();
+			createResources(graph);
+			std::swap(m_signature, m_nextSignature);
+
+			++m_rebuildCount;
+		} else {
+			graph.assignMemory(m_memoryRequirements);
+		}
+
+		bindResources(graph);
+
+		for (std::uint32_t i = 0; i < graph.getPassCount(); ++i) {
+			const RenderGraph::Pass &pass = graph.getPass(i);
+			if (pass.culled) {
+				continue;
+			}
+
+			recordBarriers(commandBuffer, graph, graph.getPassBarriers(i), frameArena);
+
+			bool rendering = beginRendering(commandBuffer, graph, i, frameArena);
+
+			if (pass.execute) {
+				pass.execute(commandBuffer);
+			}
+
+			if (rendering) {
+				endRendering(commandBuffer);
+			}
+		}
+
+		recordBarriers(commandBuffer, graph, graph.getFinalBarriers(), frameArena);
+	}
+
+	void RenderGraphExecutor::releaseResources() {
+		destroyResources();
+	}
+
+	VkImage RenderGraphExecutor::getImage(RenderGraph::ResourceHandle resource) const {
+		return m_resolvedImages[resource];
+	}
+
+	VkImageView RenderGraphExecutor::getImageView(RenderGraph::ResourceHandle resource) const {
+		return m_resolvedImageViews[resource];
+	}
+
+	VkBuffer RenderGraphExecutor::getBuffer(RenderGraph::ResourceHandle resource) const {
+		return m_resolvedBuffers[resource];
+	}
+
+	std::uint64_t RenderGraphExecutor::getRebuildCount() const {
+		return m_rebuildCount;
+	}
+
+	void RenderGraphExecutor::createResources(RenderGraph &graph) {
+		const std::uint32_t resourceCount = graph.getResourceCount();
+
+		m_images.assign(resourceCount, VK_NULL_HANDLE);
+		m_imageViews.assign(resourceCount, VK_NULL_HANDLE);
+		m_buffers.assign(resourceCount, VK_NULL_HANDLE);
+		m_memoryRequirements.assign(resourceCount, VkMemoryRequirements{});
+
+		for (RenderGraph::ResourceHandle i = 0; i < resourceCount; ++i) {
+			if (!graph.isTransient(i)) {
+				continue;
+			}
+
+			const RenderGraph::Resource &resource = graph.getResource(i);
+			if (resource.image) {
+				VkImageCreateInfo imageCreateInfo{};
+				imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+				imageCreateInfo.pNext = nullptr;
+				imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+				imageCreateInfo.extent.width = resource.imageDescription.extent.width;
+				imageCreateInfo.extent.height = resource.imageDescription.extent.height;
+				imageCreateInfo.extent.depth = 1;
+				imageCreateInfo.mipLevels = 1;
+				imageCreateInfo.arrayLayers = resource.imageDescription.layerCount;
+				imageCreateInfo.format = resource.imageDescription.format;
+				imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+				imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+				imageCreateInfo.usage = resource.imageDescription.usage;
+				imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+				imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+				imageCreateInfo.flags = 0;
+
+				if (vkCreateImage(m_device.getDevice(), &imageCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_images[i]) != VK_SUCCESS) {
+					throw std::runtime_error(std::string("Failed to create render graph image ") + resource.name.c_str() + ".");
+				}
+
+				vkGetImageMemoryRequirements(m_device.getDevice(), m_images[i], &m_memoryRequirements[i]);
+			} else {
+				VkBufferCreateInfo bufferCreateInfo{};
+				bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+				bufferCreateInfo.pNext = nullptr;
+				bufferCreateInfo.size = resource.bufferDescription.size;
+				bufferCreateInfo.usage = resource.bufferDescription.usage;
+				bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+				if (vkCreateBuffer(m_device.getDevice(), &bufferCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_buffers[i]) != VK_SUCCESS) {
+					throw std::runtime_error(std::string("Failed to create render graph buffer ") + resource.name.c_str() + ".");
+				}
+
+				vkGetBufferMemoryRequirements(m_device.getDevice(), m_buffers[i], &m_memoryRequirements[i]);
+			}
+		}
+
+		graph.assignMemory(m_memoryRequirements);
+
+		for (const RenderGraph::MemoryBlock &block : graph.getMemoryBlocks()) {
+			VkMemoryRequirements memoryRequirements{};
+			memoryRequirements.size = block.size;
+			memoryRequirements.alignment = 1;
+			memoryRequirements.memoryTypeBits = block.memoryTypeBits;
+
+			m_memoryBlocks.push_back(m_device.allocateMemory(memoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::RenderTarget));
+		}
+
+		for (RenderGraph::ResourceHandle i = 0; i < resourceCount; ++i) {
+			if (!graph.isTransient(i)) {
+				continue;
+			}
+
+			const RenderGraph::Resource &resource = graph.getResource(i);
+			VkDeviceMemory memory = m_memoryBlocks[resource.memoryBlock];
+
+			if (!resource.image) {
+				vkBindBufferMemory(m_device.getDevice(), m_buffers[i], memory, 0);
+				continue;
+			}
+
+			vkBindImageMemory(m_device.getDevice(), m_images[i], memory, 0);
+
+			VkImageViewCreateInfo imageViewCreateInfo{};
+			imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			imageViewCreateInfo.pNext = nullptr;
+			imageViewCreateInfo.image = m_images[i];
+			imageViewCreateInfo.viewType = resource.imageDescription.layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+			imageViewCreateInfo.format = resource.imageDescription.format;
+			imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+			imageViewCreateInfo.subresourceRange.aspectMask = resource.imageDescription.aspect;
+			imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+			imageViewCreateInfo.subresourceRange.levelCount = 1;
+			imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+			imageViewCreateInfo.subresourceRange.layerCount = resource.imageDescription.layerCount;
+
+			if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_imageViews[i]) != VK_SUCCESS) {
+				throw std::runtime_error(std::string("Failed to create render graph image view ") + resource.name.c_str() + ".");
+			}
+		}
+	}
+
+	void RenderGraphExecutor::destroyResources() {
+		bool hasResources = !m_memoryBlocks.empty() || !m_framebuffers.empty() ||
+			std::any_of(m_images.begin(), m_images.end(), [](VkImage image) { return image != VK_NULL_HANDLE; }) ||
+			std::any_of(m_buffers.begin(), m_buffers.end(), [](VkBuffer buffer) { return buffer != VK_NULL_HANDLE; });
+
+		if (hasResources) {
+			vkDeviceWaitIdle(m_device.getDevice());
+		}
+
+		for (auto &[key, framebuffer] : m_framebuffers) {
+			vkDestroyFramebuffer(m_device.getDevice(), framebuffer, VulkanAllocator::get(AllocationCategory::Pipeline));
+		}
+		m_framebuffers.clear();
+
+		for (VkImageView imageView : m_imageViews) {
+			if (imageView != VK_NULL_HANDLE) {
+				vkDestroyImageView(m_device.getDevice(), imageView, VulkanAllocator::get(AllocationCategory::Resource));
+			}
+		}
+
+		for (VkImage image : m_images) {
+			if (image != VK_NULL_HANDLE) {
+				vkDestroyImage(m_device.getDevice(), image, VulkanAllocator::get(AllocationCategory::Resource));
+			}
+		}
+
+		for (VkBuffer buffer : m_buffers) {
+			if (buffer != VK_NULL_HANDLE) {
+				vkDestroyBuffer(m_device.getDevice(), buffer, VulkanAllocator::get(AllocationCategory::Resource));
+			}
+		}
+
+		for (VkDeviceMemory memory : m_memoryBlocks) {
+			m_device.freeMemory(memory);
+		}
+
+		m_imageViews.clear();
+		m_images.clear();
+		m_buffers.clear();
+		m_memoryBlocks.clear();
+		m_memoryRequirements.clear();
+		m_signature.clear();
+	}
+
+	void RenderGraphExecutor::bindResources(const RenderGraph &graph) {
+		const std::uint32_t resourceCount = graph.getResourceCount();
+
+		m_resolvedImages.assign(resourceCount, VK_NULL_HANDLE);
+		m_resolvedImageViews.assign(resourceCount, VK_NULL_HANDLE);
+		m_resolvedBuffers.assign(resourceCount, VK_NULL_HANDLE);
+
+		for (RenderGraph::ResourceHandle i = 0; i < resourceCount; ++i) {
+			const RenderGraph::Resource &resource = graph.getResource(i);
+			if (resource.imported) {
+				m_resolvedImages[i] = resource.importedImage;
+				m_resolvedImageViews[i] = resource.importedImageView;
+				m_resolvedBuffers[i] = resource.importedBuffer;
+			} else if (i < m_images.size()) {
+				m_resolvedImages[i] = m_images[i];
+				m_resolvedImageViews[i] = m_imageViews[i];
+				m_resolvedBuffers[i] = m_buffers[i];
+			}
+		}
+	}
+
+	void RenderGraphExecutor::recordBarriers(VkCommandBuffer commandBuffer, const RenderGraph &graph, const FrameVector<RenderGraph::Barrier> &barriers, FrameArena &frameArena) {
+		if (barriers.empty()) {
+			return;
+		}
+
+		FrameVector<VkImageMemoryBarrier> imageMemoryBarriers(frameArena);
+		FrameVector<VkBufferMemoryBarrier> bufferMemoryBarriers(frameArena);
+		imageMemoryBarriers.reserve(barriers.size());
+		bufferMemoryBarriers.reserve(barriers.size());
+		VkPipelineStageFlags sourceStages = 0;
+		VkPipelineStageFlags destinationStages = 0;
+
+		for (const RenderGraph::Barrier &barrier : barriers) {
+			const RenderGraph::Resource &resource = graph.getResource(barrier.resource);
+
+			sourceStages |= barrier.before.stages;
+			destinationStages |= barrier.after.stages;
+
+			if (resource.image) {
+				VkImageMemoryBarrier imageMemoryBarrier{};
+				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				imageMemoryBarrier.pNext = nullptr;
+				imageMemoryBarrier.srcAccessMask = RenderGraph::getWriteAccess(barrier.before.access);
+				imageMemoryBarrier.dstAccessMask = barrier.after.access;
+				imageMemoryBarrier.oldLayout = barrier.before.layout;
+				imageMemoryBarrier.newLayout = barrier.after.layout;
+				imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				imageMemoryBarrier.image = m_resolvedImages[barrier.resource];
+				imageMemoryBarrier.subresourceRange.aspectMask = getBarrierAspect(resource.imageDescription);
+				imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+				imageMemoryBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+				imageMemoryBarrier.subresourceRange.baseArrayLayer = resource.imageDescription.baseLayer;
+				imageMemoryBarrier.subresourceRange.layerCount = resource.imageDescription.layerCount;
+
+				imageMemoryBarriers.push_back(imageMemoryBarrier);
+			} else {
+				VkBufferMemoryBarrier bufferMemoryBarrier{};
+				bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+				bufferMemoryBarrier.pNext = nullptr;
+				bufferMemoryBarrier.srcAccessMask = RenderGraph::getWriteAccess(barrier.before.access);
+				bufferMemoryBarrier.dstAccessMask = barrier.after.access;
+				bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				bufferMemoryBarrier.buffer = m_resolvedBuffers[barrier.resource];
+				bufferMemoryBarrier.offset = 0;
+				bufferMemoryBarrier.size = VK_WHOLE_SIZE;
+
+				bufferMemoryBarriers.push_back(bufferMemoryBarrier);
+			}
+		}
+
+		if (sourceStages == 0) {
+			sourceStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		}
+
+		if (destinationStages == 0) {
+			destinationStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		}
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			sourceStages,
+			destinationStages,
+			0,
+			0,
+			nullptr,
+			static_cast<std::uint32_t>(bufferMemoryBarriers.size()),
+			bufferMemoryBarriers.data(),
+			static_cast<std::uint32_t>(imageMemoryBarriers.size()),
+			imageMemoryBarriers.data()
+		);
+	}
+
+	bool RenderGraphExecutor::beginRendering(VkCommandBuffer commandBuffer, const RenderGraph &graph, std::uint32_t pass, FrameArena &frameArena) {
+		const RenderGraph::Pass &graphPass = graph.getPass(pass);
+		if (graphPass.type != RenderGraph::PassType::Graphics) {
+			return false;
+		}
+
+		FrameVector<const RenderGraph::Use *> attachments = getAttachments(graph, pass, frameArena);
+		if (attachments.empty()) {
+			return false;
+		}
+
+		VkExtent2D extent = graph.getResource(attachments[0]->resource).imageDescription.extent;
+
+		if (m_device.isDynamicRenderingEnabled()) {
+			beginDynamicRendering(commandBuffer, graph, pass, attachments, extent, frameArena);
+		} else {
+			beginRenderPass(commandBuffer, graph, pass, attachments, extent, frameArena);
+		}
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = static_cast<float>(extent.width);
+		viewport.height = static_cast<float>(extent.height);
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = extent;
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+		return true;
+	}
+
+	void RenderGraphExecutor::endRendering(VkCommandBuffer commandBuffer) {
+		if (m_device.isDynamicRenderingEnabled()) {
+			m_device.endRendering(commandBuffer);
+		} else {
+			vkCmdEndRenderPass(commandBuffer);
+		}
+	}
+
+	void RenderGraphExecutor::beginDynamicRendering(VkCommandBuffer commandBuffer, const RenderGraph &graph, std::uint32_t pass, const FrameVector<const RenderGraph::Use *> &attachments, VkExtent2D extent, FrameArena &frameArena) {
+		FrameVector<VkRenderingAttachmentInfoKHR> colorAttachments(frameArena);
+		colorAttachments.reserve(attachments.size());
+		VkRenderingAttachmentInfoKHR depthAttachment{};
+		bool hasDepthAttachment = false;
+
+		for (const RenderGraph::Use *attachment : attachments) {
+			VkRenderingAttachmentInfoKHR renderingAttachmentInfo{};
+			renderingAttachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+			renderingAttachmentInfo.pNext = nullptr;
+			renderingAttachmentInfo.imageView = m_resolvedImageViews[attachment->resource];
+			renderingAttachmentInfo.imageLayout = attachment->state.layout;
+			renderingAttachmentInfo.resolveMode = VK_RESOLVE_MODE_NONE;
+			renderingAttachmentInfo.resolveImageView = VK_NULL_HANDLE;
+			renderingAttachmentInfo.resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			renderingAttachmentInfo.loadOp = graph.getLoadOp(pass, *attachment);
+			renderingAttachmentInfo.storeOp = graph.getStoreOp(pass, *attachment);
+			renderingAttachmentInfo.clearValue = attachment->clearValue;
+
+			if (attachment->access == RenderGraph::Access::ColorAttachment) {
+				colorAttachments.push_back(renderingAttachmentInfo);
+			} else {
+				depthAttachment = renderingAttachmentInfo;
+				hasDepthAttachment = true;
+			}
+		}
+
+		VkRenderingInfoKHR renderingInfo{};
+		renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+		renderingInfo.pNext = nullptr;
+		renderingInfo.flags = 0;
+		renderingInfo.renderArea.offset = { 0, 0 };
+		renderingInfo.renderArea.extent = extent;
+		renderingInfo.layerCount = 1;
+		renderingInfo.viewMask = graph.getPass(pass).viewMask;
+		renderingInfo.colorAttachmentCount = static_cast<std::uint32_t>(colorAttachments.size());
+		renderingInfo.pColorAttachments = colorAttachments.data();
+		renderingInfo.pDepthAttachment = hasDepthAttachment ? &depthAttachment : nullptr;
+		renderingInfo.pStencilAttachment = nullptr;
+
+		m_device.beginRendering(commandBuffer, renderingInfo);
+	}
+
+	void RenderGraphExecutor::beginRenderPass(VkCommandBuffer commandBuffer, const RenderGraph &graph, std::uint32_t pass, const FrameVector<const RenderGraph::Use *> &attachments, VkExtent2D extent, FrameArena &frameArena) {
+		VkRenderPass renderPass = getRenderPass(graph, pass, attachments);
+
+		FrameVector<VkImageView> imageViews(frameArena);
+		FrameVector<VkClearValue> clearValues(frameArena);
+		imageViews.reserve(attachments.size());
+		clearValues.reserve(attachments.size());
+		for (const RenderGraph::Use *attachment : attachments) {
+			imageViews.push_back(m_resolvedImageViews[attachment->resource]);
+			clearValues.push_back(attachment->clearValue);
+		}
+
+		VkRenderPassBeginInfo renderPassBeginInfo{};
+		renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassBeginInfo.pNext = nullptr;
+		renderPassBeginInfo.renderPass = renderPass;
+		renderPassBeginInfo.framebuffer = getFramebuffer(renderPass, imageViews, extent);
+		renderPassBeginInfo.renderArea.offset = { 0, 0 };
+		renderPassBeginInfo.renderArea.extent = extent;
+		renderPassBeginInfo.clearValueCount = static_cast<std::uint32_t>(clearValues.size());
+		renderPassBeginInfo.pClearValues = clearValues.data();
+
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+	}
+
+	VkRenderPass RenderGraphExecutor::getRenderPass(const RenderGraph &graph, std::uint32_t pass, const FrameVector<const RenderGraph::Use *> &attachments) {
+		const std::uint32_t viewMask = graph.getPass(pass).viewMask;
+
+		RenderPassKey &key = m_renderPassKey;
+		key.clear();
+		key.push_back(viewMask);
+		for (const RenderGraph::Use *attachment : attachments) {
+			key.push_back(static_cast<std::uint64_t>(graph.getResource(attachment->resource).imageDescription.format));
+			key.push_back(static_cast<std::uint64_t>(attachment->state.layout));
+			key.push_back(static_cast<std::uint64_t>(graph.getLoadOp(pass, *attachment)));
+			key.push_back(static_cast<std::uint64_t>(graph.getStoreOp(pass, *attachment)));
+		}
+
+		auto cached = m_renderPasses.find(key);
+		if (cached != m_renderPasses.end()) {
+			return cached->second;
+		}
+
+		std::vector<VkAttachmentDescription> attachmentDescriptions;
+		std::vector<VkAttachmentReference> colorAttachmentReferences;
+		VkAttachmentReference depthAttachmentReference{};
+		bool hasDepthAttachment = false;
+
+		for (const RenderGraph::Use *attachment : attachments) {
+			VkAttachmentDescription attachmentDescription{};
+			attachmentDescription.format = graph.getResource(attachment->resource).imageDescription.format;
+			attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+			attachmentDescription.loadOp = graph.getLoadOp(pass, *attachment);
+			attachmentDescription.storeOp = graph.getStoreOp(pass, *attachment);
+			attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescription.initialLayout = attachment->state.layout;
+			attachmentDescription.finalLayout = attachment->state.layout;
+
+			VkAttachmentReference attachmentReference{};
+			attachmentReference.attachment = static_cast<std::uint32_t>(attachmentDescriptions.size());
+			attachmentReference.layout = attachment->state.layout;
+
+			if (attachment->access == RenderGraph::Access::ColorAttachment) {
+				colorAttachmentReferences.push_back(attachmentReference);
+			} else {
+				depthAttachmentReference = attachmentReference;
+				hasDepthAttachment = true;
+			}
+
+			attachmentDescriptions.push_back(attachmentDescription);
+		}
+
+		VkSubpassDescription subpassDescription{};
+		subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpassDescription.colorAttachmentCount = static_cast<std::uint32_t>(colorAttachmentReferences.size());
+		subpassDescription.pColorAttachments = colorAttachmentReferences.data();
+		subpassDescription.pDepthStencilAttachment = hasDepthAttachment ? &depthAttachmentReference : nullptr;
+
+		VkRenderPassMultiviewCreateInfo renderPassMultiviewCreateInfo{};
+		renderPassMultiviewCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+		renderPassMultiviewCreateInfo.pNext = nullptr;
+		renderPassMultiviewCreateInfo.subpassCount = 1;
+		renderPassMultiviewCreateInfo.pViewMasks = &viewMask;
+		renderPassMultiviewCreateInfo.dependencyCount = 0;
+		renderPassMultiviewCreateInfo.pViewOffsets = nullptr;
+		renderPassMultiviewCreateInfo.correlationMaskCount = 1;
+		renderPassMultiviewCreateInfo.pCorrelationMasks = &viewMask;
+
+		VkRenderPassCreateInfo renderPassCreateInfo{};
+		renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassCreateInfo.pNext = viewMask != 0 ? &renderPassMultiviewCreateInfo : nullptr;
+		renderPassCreateInfo.attachmentCount = static_cast<std::uint32_t>(attachmentDescriptions.size());
+		renderPassCreateInfo.pAttachments = attachmentDescriptions.data();
+		renderPassCreateInfo.subpassCount = 1;
+		renderPassCreateInfo.pSubpasses = &subpassDescription;
+		renderPassCreateInfo.dependencyCount = 0;
+		renderPassCreateInfo.pDependencies = nullptr;
+
+		VkRenderPass renderPass;
+		if (vkCreateRenderPass(m_device.getDevice(), &renderPassCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &renderPass) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create render graph render pass.");
+		}
+
+		m_renderPasses.emplace(key, renderPass);
+		return renderPass;
+	}
+
+	VkFramebuffer RenderGraphExecutor::getFramebuffer(VkRenderPass renderPass, const FrameVector<VkImageView> &attachments, VkExtent2D extent) {
+		FramebufferKey &key = m_framebufferKey;
+		std::get<0>(key) = renderPass;
+		std::get<1>(key).assign(attachments.begin(), attachments.end());
+		std::get<2>(key) = extent.width;
+		std::get<3>(key) = extent.height;
+
+		auto cached = m_framebuffers.find(key);
+		if (cached != m_framebuffers.end()) {
+			return cached->second;
+		}
+
+		VkFramebufferCreateInfo framebufferCreateInfo{};
+		framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferCreateInfo.pNext = nullptr;
+		framebufferCreateInfo.renderPass = renderPass;
+		framebufferCreateInfo.attachmentCount = static_cast<std::uint32_t>(attachments.size());
+		framebufferCreateInfo.pAttachments = attachments.data();
+		framebufferCreateInfo.width = extent.width;
+		framebufferCreateInfo.height = extent.height;
+		framebufferCreateInfo.layers = 1;
+
+		VkFramebuffer framebuffer;
+		if (vkCreateFramebuffer(m_device.getDevice(), &framebufferCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &framebuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create render graph framebuffer.");
+		}
+
+		m_framebuffers.emplace(key, framebuffer);
+		return framebuffer;
+	}
+
+	FrameVector<const RenderGraph::Use *> RenderGraphExecutor::getAttachments(const RenderGraph &graph, std::uint32_t pass, FrameArena &frameArena) {
+		const RenderGraph::Pass &graphPass = graph.getPass(pass);
+
+		FrameVector<const RenderGraph::Use *> colorAttachments(frameArena);
+		colorAttachments.reserve(graphPass.uses.size());
+		const RenderGraph::Use *depthAttachment = nullptr;
+
+		for (const RenderGraph::Use &use : graphPass.uses) {
+			if (!RenderGraph::isAttachmentAccess(use.access)) {
+				continue;
+			}
+
+			if (use.access == RenderGraph::Access::ColorAttachment) {
+				colorAttachments.push_back(&use);
+			} else if (depthAttachment == nullptr) {
+				depthAttachment = &use;
+			}
+		}
+
+		if (depthAttachment != nullptr) {
+			colorAttachments.push_back(depthAttachment);
+		}
+
+		return colorAttachments;
+	}
+
+	void RenderGraphExecutor::createSignature(const RenderGraph &graph, std::vector<std::uint64_t> &signature) {
+		signature.clear();
+
+		for (RenderGraph::ResourceHandle i = 0; i < graph.getResourceCount(); ++i) {
+			const RenderGraph::Resource &resource = graph.getResource(i);
+
+			signature.push_back(resource.imported ? 1 : 0);
+			signature.push_back(resource.image ? 1 : 0);
+			signature.push_back(resource.firstPass);
+			signature.push_back(resource.lastPass);
+
+			if (resource.imported) {
+				continue;
+			}
+
+			if (resource.image) {
+				signature.push_back(static_cast<std::uint64_t>(resource.imageDescription.format));
+				signature.push_back(resource.imageDescription.extent.width);
+				signature.push_back(resource.imageDescription.extent.height);
+				signature.push_back(resource.imageDescription.usage);
+				signature.push_back(resource.imageDescription.aspect);
+				signature.push_back(resource.imageDescription.layerCount);
+			} else {
+				signature.push_back(resource.bufferDescription.size);
+				signature.push_back(resource.bufferDescription.usage);
+			}
+		}
+	}
+
+	VkImageAspectFlags RenderGraphExecutor::getBarrierAspect(const RenderGraph::ImageDescription &description) {
+		VkImageAspectFlags aspect = description.aspect;
+
+		if ((aspect & VK_IMAGE_ASPECT_DEPTH_BIT) != 0 && (
+			description.format == VK_FORMAT_D16_UNORM_S8_UINT ||
+			description.format == VK_FORMAT_D24_UNORM_S8_UINT ||
+			description.format == VK_FORMAT_D32_SFLOAT_S8_UINT)) {
+			aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
+
+		return aspect;
+	}
+}
\ No newline at end of file
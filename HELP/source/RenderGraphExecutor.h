@@ -0,0 +1,76 @@
+#ifndef RENDER_GRAPH_EXECUTOR_H
+#define RENDER_GRAPH_EXECUTOR_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "RenderGraph.h"
+#include "FrameArena.h"
+
+#include <vector>
+#include <map>
+#include <tuple>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class RenderGraphExecutor {
+	public:
+		RenderGraphExecutor(Device &device);
+		~RenderGraphExecutor();
+
+		RenderGraphExecutor(const RenderGraphExecutor &) = delete;
+		RenderGraphExecutor &operator=(const RenderGraphExecutor &) = delete;
+
+		void execute(RenderGraph &graph, VkCommandBuffer commandBuffer, FrameArena &frameArena);
+		void releaseResources();
+
+		VkImage getImage(RenderGraph::ResourceHandle resource) const;
+		VkImageView getImageView(RenderGraph::ResourceHandle resource) const;
+		VkBuffer getBuffer(RenderGraph::ResourceHandle resource) const;
+		std::uint64_t getRebuildCount() const;
+	private:
+		using RenderPassKey = std::vector<std::uint64_t>;
+		using FramebufferKey = std::tuple<VkRenderPass, std::vector<VkImageView>, std::uint32_t, std::uint32_t>;
+
+		void createResources(RenderGraph &graph);
+		void destroyResources();
+		void bindResources(const RenderGraph &graph);
+
+		void recordBarriers(VkCommandBuffer commandBuffer, const RenderGraph &graph, const FrameVector<RenderGraph::Barrier> &barriers, FrameArena &frameArena);
+		bool beginRendering(VkCommandBuffer commandBuffer, const RenderGraph &graph, std::uint32_t pass, FrameArena &frameArena);
+		void endRendering(VkCommandBuffer commandBuffer);
+		void beginDynamicRendering(VkCommandBuffer commandBuffer, const RenderGraph &graph, std::uint32_t pass, const FrameVector<const RenderGraph::Use *> &attachments, VkExtent2D extent, FrameArena &frameArena);
+		void beginRenderPass(VkCommandBuffer commandBuffer, const RenderGraph &graph, std::uint32_t pass, const FrameVector<const RenderGraph::Use *> &attachments, VkExtent2D extent, FrameArena &frameArena);
+
+		VkRenderPass getRenderPass(const RenderGraph &graph, std::uint32_t pass, const FrameVector<const RenderGraph::Use *> &attachments);
+		VkFramebuffer getFramebuffer(VkRenderPass renderPass, const FrameVector<VkImageView> &attachments, VkExtent2D extent);
+
+		static FrameVector<const RenderGraph::Use *> getAttachments(const RenderGraph &graph, std::uint32_t pass, FrameArena &frameArena);
+		static void createSignature(const RenderGraph &graph, std::vector<std::uint64_t> &signature);
+		static VkImageAspectFlags getBarrierAspect(const RenderGraph::ImageDescription &description);
+
+		Device &m_device;
+
+		std::vector<std::uint64_t> m_signature;
+		std::vector<std::uint64_t> m_nextSignature;
+		std::uint64_t m_rebuildCount = 0;
+		RenderPassKey m_renderPassKey;
+		FramebufferKey m_framebufferKey;
+		std::vector<VkMemoryRequirements> m_memoryRequirements;
+		std::vector<VkImage> m_images;
+		std::vector<VkImageView> m_imageViews;
+		std::vector<VkBuffer> m_buffers;
+		std::vector<VkDeviceMemory> m_memoryBlocks;
+
+		std::vector<VkImage> m_resolvedImages;
+		std::vector<VkImageView> m_resolvedImageViews;
+		std::vector<VkBuffer> m_resolvedBuffers;
+
+		std::map<RenderPassKey, VkRenderPass> m_renderPasses;
+		std::map<FramebufferKey, VkFramebuffer> m_framebuffers;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "RenderQueue.h"
+
+namespace eng {
+	void RenderFrame::clear() {
+		transforms.clear();
+		drawList.clear();
+		textureRequests.clear();
+		views.clear();
+		shadows.clear();
+		lights.clear();
+	}
+
+	RenderFrame *RenderQueue::acquireWrite() {
+		const std::uint64_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+
+		std::uint32_t attempt = 0;
+		while (writeIndex - m_readIndex.load(std::memory_order_acquire) >= SNAPSHOT_COUNT) {
+			if (m_closed.load(std::memory_order_acquire)) {
+				return nullptr;
+			}
+
+			if (attempt == 0) {
+				m_producerStalls.fetch_add(1, std::memory_order_relaxed);
+			}
+			backOff(attempt);
+		}
+
+		if (m_closed.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+
+		RenderFrame &frame = m_frames[writeIndex % SNAPSHOT_COUNT];
+		frame.clear();
+
+		return &frame;
+	}
+
+	void RenderQueue::publish() {
+		m_writeIndex.store(m_writeIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	RenderFrame *RenderQueue::acquireRead() {
+		const std::uint64_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+
+		std::uint32_t attempt = 0;
+		while (readIndex == m_writeIndex.load(std::memory_order_acquire)) {
+			if (m_closed.load(std::memory_order_acquire)) {
+				return nullptr;
+			}
+
+			if (attempt == 0) {
+				m_consumerStalls.fetch_add(1, std::memory_order_relaxed);
+			}
+			backOff(attempt);
+		}
+
+		return &m_frames[readIndex % SNAPSHOT_COUNT];
+	}
+
+	void RenderQueue::release() {
+		m_readIndex.store(m_readIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	void RenderQueue::close() {
+		m_closed.store(true, std::memory_order_release);
+	}
+
+	void RenderQueue::reset() {
+		m_writeIndex.store(0, std::memory_order_relaxed);
+		m_readIndex.store(0, std::memory_order_relaxed);
+		m_producerStalls.store(0, std::memory_order_relaxed);
+		m_consumerStalls.store(0, std::memory_order_relaxed);
+		m_closed.store(false, std::memory_order_release);
+	}
+
+	bool RenderQueue::isClosed() const {
+		return m_closed.load(std::memory_order_acquire);
+	}
+
+	std::uint64_t RenderQueue::getProducerStallCount() const {
+		return m_producerStalls.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t RenderQueue::getConsumerStallCount() const {
+		return m_consumerStalls.load(std::memory_order_relaxed);
+	}
+
+	void RenderQueue::backOff(std::uint32_t &attempt) {
+		if (attempt < SPIN_COUNT) {
+			std::this_thread::yield();
+		} else {
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		++attempt;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "DrawList.h"
+#include "View.h"
+#include "ShadowMap.h"
+#include "ClusteredLighting.h"
+
+#include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+namespace eng {
+	struct RenderFrame {
+		struct TextureRequest {
+			std::uint32_t texture = 0;
+			float pixelSize = 0.0f;
+		};
+
+		Camera camera{};
+		float frameTime = 0.0f;
+		float gameTime = 0.0f;
+		std::vector<glm::mat4> transforms;
+		DrawList drawList;
+		std::vector<TextureRequest> textureRequests;
+		ViewBatch views;
+		ShadowFrame shadows;
+		std::vector<ClusteredLighting::Light> lights;
+
+		void clear();
+	};
+
+	class RenderQueue {
+	public:
+		RenderQueue() = default;
+
+		RenderQueue(const RenderQueue &) = delete;
+		RenderQueue &operator=(const RenderQueue &) = delete;
+
+		RenderFrame *acquireWrite();
+		void publish();
+
+		RenderFrame *acquireRead();
+		void release();
+
+		void close();
+		void reset();
+
+		bool isClosed() const;
+		std::uint64_t getProducerStallCount() const;
+		std::uint64_t getConsumerStallCount() const;
+
+		static constexpr std::uint32_t SNAPSHOT_COUNT = 2;
+	private:
+		static void backOff(std::uint32_t &attempt);
+
+		std::array<RenderFrame, SNAPSHOT_COUNT> m_frames{};
+
+		alignas(64) std::atomic<std::uint64_t> m_writeIndex{ 0 };
+		alignas(64) std::atomic<std::uint64_t> m_readIndex{ 0 };
+		alignas(64) std::atomic<bool> m_closed{ false };
+
+		std::atomic<std::uint64_t> m_producerStalls{ 0 };
+		std::atomic<std::uint64_t> m_consumerStalls{ 0 };
+
+		static constexpr std::uint32_t SPIN_COUNT = 64;
+	};
+}
+
+#endif
\ No newline at end of file
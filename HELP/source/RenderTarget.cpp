@@ -0,0 +1,149 @@
+#include "RenderTarget.h"
+
+namespace eng {
+	RenderTarget::RenderTarget(Device &device, const Description &description)
+		: m_device(device), m_description(description) {
+		if (m_description.extent.width == 0 || m_description.extent.height == 0 || m_description.layerCount == 0) {
+			throw std::runtime_error("Render target must have a non-zero extent and layer count.");
+		}
+
+		createImage();
+		createSampler();
+	}
+
+	RenderTarget::~RenderTarget() {
+		vkDestroySampler(m_device.getDevice(), m_sampler, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		for (VkImageView imageView : m_layerImageViews) {
+			vkDestroyImageView(m_device.getDevice(), imageView, VulkanAllocator::get(AllocationCategory::Resource));
+		}
+
+		vkDestroyImageView(m_device.getDevice(), m_imageView, VulkanAllocator::get(AllocationCategory::Resource));
+		vkDestroyImage(m_device.getDevice(), m_image, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(m_imageMemory);
+	}
+
+	RenderGraph::ResourceHandle RenderTarget::import(RenderGraph &graph, std::string_view name) {
+		RenderGraph::ImageDescription imageDescription{};
+		imageDescription.format = m_description.format;
+		imageDescription.extent = m_description.extent;
+		imageDescription.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		imageDescription.aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageDescription.layerCount = m_description.layerCount;
+
+		RenderGraph::ResourceState initialState{};
+		if (m_rendered) {
+			initialState.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			initialState.stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			initialState.access = VK_ACCESS_SHADER_READ_BIT;
+		} else {
+			initialState.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+			initialState.stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			initialState.access = 0;
+		}
+
+		m_rendered = true;
+
+		return graph.importImage(name, m_image, m_imageView, imageDescription, initialState, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	}
+
+	VkImage RenderTarget::getImage() const {
+		return m_image;
+	}
+
+	VkImageView RenderTarget::getImageView() const {
+		return m_imageView;
+	}
+
+	VkImageView RenderTarget::getLayerImageView(std::uint32_t layer) const {
+		return m_layerImageViews[layer];
+	}
+
+	VkSampler RenderTarget::getSampler() const {
+		return m_sampler;
+	}
+
+	VkExtent2D RenderTarget::getExtent() const {
+		return m_description.extent;
+	}
+
+	VkFormat RenderTarget::getFormat() const {
+		return m_description.format;
+	}
+
+	std::uint32_t RenderTarget::getLayerCount() const {
+		return m_description.layerCount;
+	}
+
+	void RenderTarget::createImage() {
+		VkImageCreateInfo imageCreateInfo{};
+		imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCreateInfo.pNext = nullptr;
+		imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageCreateInfo.extent.width = m_description.extent.width;
+		imageCreateInfo.extent.height = m_description.extent.height;
+		imageCreateInfo.extent.depth = 1;
+		imageCreateInfo.mipLevels = 1;
+		imageCreateInfo.arrayLayers = m_description.layerCount;
+		imageCreateInfo.format = m_description.format;
+		imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageCreateInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		m_device.createImage(imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_image, m_imageMemory, MemoryCategory::RenderTarget);
+
+		VkImageViewCreateInfo imageViewCreateInfo{};
+		imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		imageViewCreateInfo.pNext = nullptr;
+		imageViewCreateInfo.image = m_image;
+		imageViewCreateInfo.viewType = m_description.layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+		imageViewCreateInfo.format = m_description.format;
+		imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+		imageViewCreateInfo.subresourceRange.levelCount = 1;
+		imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+		imageViewCreateInfo.subresourceRange.layerCount = m_description.layerCount;
+
+		if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_imageView) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create render target image view.");
+		}
+
+		m_layerImageViews.resize(m_description.layerCount);
+		for (std::uint32_t layer = 0; layer < m_description.layerCount; ++layer) {
+			imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			imageViewCreateInfo.subresourceRange.baseArrayLayer = layer;
+			imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+			if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_layerImageViews[layer]) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create render target layer image view.");
+			}
+		}
+	}
+
+	void RenderTarget::createSampler() {
+		VkSamplerCreateInfo samplerCreateInfo{};
+		samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerCreateInfo.pNext = nullptr;
+		samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.anisotropyEnable = VK_FALSE;
+		samplerCreateInfo.maxAnisotropy = 1.0f;
+		samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+		samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+		samplerCreateInfo.compareEnable = VK_FALSE;
+		samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerCreateInfo.mipLodBias = 0.0f;
+		samplerCreateInfo.minLod = 0.0f;
+		samplerCreateInfo.maxLod = 0.0f;
+
+		if (vkCreateSampler(m_device.getDevice(), &samplerCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_sampler) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create render target sampler.");
+		}
+	}
+}
\ No newline at end of file
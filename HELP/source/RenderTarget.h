@@ -0,0 +1,54 @@
+#ifndef RENDER_TARGET_H
+#define RENDER_TARGET_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "RenderGraph.h"
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <stdexcept>
+
+namespace eng {
+	class RenderTarget {
+	public:
+		struct Description {
+			VkExtent2D extent{};
+			VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+			std::uint32_t layerCount = 1;
+		};
+
+		RenderTarget(Device &device, const Description &description);
+		~RenderTarget();
+
+		RenderTarget(const RenderTarget &) = delete;
+		RenderTarget &operator=(const RenderTarget &) = delete;
+
+		RenderGraph::ResourceHandle import(RenderGraph &graph, std::string_view name);
+
+		VkImage getImage() const;
+		VkImageView getImageView() const;
+		VkImageView getLayerImageView(std::uint32_t layer) const;
+		VkSampler getSampler() const;
+		VkExtent2D getExtent() const;
+		VkFormat getFormat() const;
+		std::uint32_t getLayerCount() const;
+	private:
+		void createImage();
+		void createSampler();
+
+		Device &m_device;
+		Description m_description;
+
+		VkImage m_image = VK_NULL_HANDLE;
+		VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+		VkImageView m_imageView = VK_NULL_HANDLE;
+		std::vector<VkImageView> m_layerImageViews;
+		VkSampler m_sampler;
+		bool m_rendered = false;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -11,20 +11,30 @@ namespace eng {
 	}
 
 	VkCommandBuffer Renderer::beginFrame() {
+		applyRequestedSettings();
+
+		if (m_device.isPresentWaitEnabled() && m_presentId > 1) {
+			m_device.waitForPresent(m_swapchain.getSwapchain(), m_presentId - 1, PRESENT_WAIT_TIMEOUT);
+		}
+
+		m_frameLimiter.wait();
+
 		const VkFence inFlightFence = m_swapchain.getInFlightFence(m_currentFrame);
 
 		vkWaitForFences(m_device.getDevice(), 1, &inFlightFence, VK_TRUE, UINT64_MAX);
-		vkResetFences(m_device.getDevice(), 1, &inFlightFence);
+		m_frameAllocator.reset(m_currentFrame);
 
 		VkResult result = vkAcquireNextImageKHR(m_device.getDevice(), m_swapchain.getSwapchain(), UINT64_MAX, m_swapchain.getImageAvailableSemaphore(m_currentFrame), VK_NULL_HANDLE, &m_imageIndex);
 		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-			m_swapchain.recreateSwapchain();
+			recreateSwapchain();
 			return nullptr;
 		}
 		else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
 			throw std::runtime_error("Failed to acquire next swapchain image.");
 		}
 
+		vkResetFences(m_device.getDevice(), 1, &inFlightFence);
+
 		VkCommandBuffer commandBuffer = m_commandBuffers[m_currentFrame];
 
 		VkCommandBufferBeginInfo commandBufferBeginInfo{};
@@ -49,11 +59,11 @@ namespace eng {
 		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 		submitInfo.pNext = nullptr;
 
-		VkSemaphore waitSemaphores[] = { m_swapchain.getImageAvailableSemaphore(m_currentFrame) };
-		VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-		submitInfo.waitSemaphoreCount = 1;
-		submitInfo.pWaitSemaphores = waitSemaphores;
-		submitInfo.pWaitDstStageMask = waitStages;
+		m_waitSemaphores.push_back(m_swapchain.getImageAvailableSemaphore(m_currentFrame));
+		m_waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+		submitInfo.waitSemaphoreCount = static_cast<std::uint32_t>(m_waitSemaphores.size());
+		submitInfo.pWaitSemaphores = m_waitSemaphores.data();
+		submitInfo.pWaitDstStageMask = m_waitStages.data();
 		submitInfo.commandBufferCount = 1;
 		submitInfo.pCommandBuffers = &m_commandBuffers[m_currentFrame];
 
@@ -65,6 +75,9 @@ namespace eng {
 			throw std::runtime_error("Failed to submit draw command buffer.");
 		}
 
+		m_waitSemaphores.clear();
+		m_waitStages.clear();
+
 		VkPresentInfoKHR presentInfo{};
 		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 		presentInfo.pNext = nullptr;
@@ -77,14 +90,25 @@ namespace eng {
 		presentInfo.pImageIndices = &m_imageIndex;
 		presentInfo.pResults = nullptr;
 
+		VkPresentIdKHR presentId{};
+		if (m_device.isPresentWaitEnabled()) {
+			++m_presentId;
+
+			presentId.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+			presentId.pNext = nullptr;
+			presentId.swapchainCount = 1;
+			presentId.pPresentIds = &m_presentId;
+			presentInfo.pNext = &presentId;
+		}
+
 		VkResult result = vkQueuePresentKHR(m_device.getPresentQueue(), &presentInfo);
 		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || m_window.getResizeFlag()) {
-			while (m_window.getWidth() == 0 || m_window.getHeight() == 0) {
-				glfwWaitEvents();
+			while ((m_window.getWidth() == 0 || m_window.getHeight() == 0) && !m_window.shouldClose()) {
+				m_window.waitEvents();
 			}
 
 			m_window.resetResizeFlag();
-			m_swapchain.recreateSwapchain();
+			recreateSwapchain();
 		}
 		else if (result != VK_SUCCESS) {
 			throw std::runtime_error("Failed to present swapchain image.");
@@ -93,44 +117,110 @@ namespace eng {
 		m_currentFrame = (m_currentFrame + 1) % m_swapchain.MAX_FRAMES_IN_FLIGHT;
 	}
 
-	void Renderer::beginSwapchainRenderPass(VkCommandBuffer commandBuffer) {
-		VkRenderPassBeginInfo renderPassBeginInfo{};
-		renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassBeginInfo.pNext = nullptr;
-		renderPassBeginInfo.renderPass = m_swapchain.getRenderPass();
-		renderPassBeginInfo.framebuffer = m_swapchain.getFramebuffer(m_imageIndex);
-		renderPassBeginInfo.renderArea.offset = { 0, 0 };
-		renderPassBeginInfo.renderArea.extent = m_swapchain.getExtent();
+	RenderGraph::ResourceHandle Renderer::importSwapchainImage(RenderGraph &graph) {
+		RenderGraph::ImageDescription imageDescription{};
+		imageDescription.format = m_swapchain.getImageFormat();
+		imageDescription.extent = m_swapchain.getExtent();
+		imageDescription.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		imageDescription.aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+
+		RenderGraph::ResourceState initialState{};
+		initialState.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		initialState.stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		initialState.access = 0;
+
+		return graph.importImage(
+			"swapchain",
+			m_swapchain.getImage(m_imageIndex),
+			m_swapchain.getImageView(m_imageIndex),
+			imageDescription,
+			initialState,
+			VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+		);
+	}
+
+	void Renderer::executeRenderGraph(RenderGraph &graph, VkCommandBuffer commandBuffer) {
+		m_renderGraphExecutor.execute(graph, commandBuffer, getFrameArena());
 
-		VkClearValue clearColor = { { { 0.01f, 0.01f, 0.01f } } };
-		renderPassBeginInfo.clearValueCount = 1;
-		renderPassBeginInfo.pClearValues = &clearColor;
+		if (m_measureRecreation) {
+			m_measureRecreation = false;
 
-		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+			std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - m_recreationStart;
+			m_lastRecreationTime = duration.count();
+		}
+	}
 
-		VkViewport viewport{};
-		viewport.x = 0.0f;
-		viewport.y = 0.0f;
-		viewport.width = static_cast<float>(m_swapchain.getExtent().width);
-		viewport.height = static_cast<float>(m_swapchain.getExtent().height);
-		viewport.minDepth = 0.0f;
-		viewport.maxDepth = 1.0f;
-		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+	void Renderer::addWaitSemaphore(VkSemaphore semaphore, VkPipelineStageFlags stages) {
+		m_waitSemaphores.push_back(semaphore);
+		m_waitStages.push_back(stages);
+	}
 
-		VkRect2D scissor{};
-		scissor.offset = { 0, 0 };
-		scissor.extent = m_swapchain.getExtent();
-		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+	void Renderer::setPresentMode(VkPresentModeKHR presentMode) {
+		m_requestedPresentMode = presentMode;
 	}
 
-	void Renderer::endSwapchainRenderPass(VkCommandBuffer commandBuffer) {
-		vkCmdEndRenderPass(commandBuffer);
+	void Renderer::setFrameRateLimit(float frameRate) {
+		m_requestedFrameRate = std::max(frameRate, 0.0f);
 	}
 
 	Swapchain& Renderer::getSwapchain() {
 		return m_swapchain;
 	}
 
+	RenderGraphExecutor &Renderer::getRenderGraphExecutor() {
+		return m_renderGraphExecutor;
+	}
+
+	AsyncCompute &Renderer::getAsyncCompute() {
+		return m_asyncCompute;
+	}
+
+	FrameAllocator &Renderer::getFrameAllocator() {
+		return m_frameAllocator;
+	}
+
+	FrameArena &Renderer::getFrameArena(std::uint32_t threadIndex) {
+		return m_frameAllocator.getArena(m_currentFrame, threadIndex);
+	}
+
+	FrameLimiter &Renderer::getFrameLimiter() {
+		return m_frameLimiter;
+	}
+
+	float Renderer::getAspectRatio() const {
+		return m_swapchain.getAspectRatio();
+	}
+
+	std::uint32_t Renderer::getFrameIndex() const {
+		return m_currentFrame;
+	}
+
+	double Renderer::getLastRecreationTime() const {
+		return m_lastRecreationTime;
+	}
+
+	void Renderer::applyRequestedSettings() {
+		const VkPresentModeKHR presentMode = m_requestedPresentMode;
+		if (presentMode != m_swapchain.getRequestedPresentMode()) {
+			m_swapchain.setPresentMode(presentMode);
+			recreateSwapchain();
+		}
+
+		const float frameRate = m_requestedFrameRate;
+		if (frameRate != m_frameLimiter.getTargetFrameRate()) {
+			m_frameLimiter.setTargetFrameRate(frameRate);
+		}
+	}
+
+	void Renderer::recreateSwapchain() {
+		m_recreationStart = std::chrono::steady_clock::now();
+		m_measureRecreation = true;
+
+		m_swapchain.recreateSwapchain();
+		m_renderGraphExecutor.releaseResources();
+		m_presentId = 0;
+	}
+
 	void Renderer::createCommandBuffers() {
 		m_commandBuffers.resize(m_swapchain.MAX_FRAMES_IN_FLIGHT);
 
@@ -11,10 +11,19 @@
 #include "Device.h"
 #include "Swapchain.h"
 #include "Model.h"
+#include "RenderGraph.h"
+#include "RenderGraphExecutor.h"
+#include "AsyncCompute.h"
+#include "FrameAllocator.h"
+#include "FrameLimiter.h"
 
 #include <vector>
 #include <stdexcept>
 #include <memory>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 namespace eng {
 	class Renderer {
@@ -25,21 +34,51 @@ namespace eng {
 		VkCommandBuffer beginFrame();
 		void endFrame();
 
-		void beginSwapchainRenderPass(VkCommandBuffer commandBuffer);
-		void endSwapchainRenderPass(VkCommandBuffer commandBuffer);
+		RenderGraph::ResourceHandle importSwapchainImage(RenderGraph &graph);
+		void executeRenderGraph(RenderGraph &graph, VkCommandBuffer commandBuffer);
+		void addWaitSemaphore(VkSemaphore semaphore, VkPipelineStageFlags stages);
+		void setPresentMode(VkPresentModeKHR presentMode);
+		void setFrameRateLimit(float frameRate);
 
 		Swapchain& getSwapchain();
+		RenderGraphExecutor &getRenderGraphExecutor();
+		AsyncCompute &getAsyncCompute();
+		FrameAllocator &getFrameAllocator();
+		FrameArena &getFrameArena(std::uint32_t threadIndex = 0);
+		FrameLimiter &getFrameLimiter();
+		float getAspectRatio() const;
+		std::uint32_t getFrameIndex() const;
+		double getLastRecreationTime() const;
 	private:
+		void applyRequestedSettings();
+		void recreateSwapchain();
 		void createCommandBuffers();
 		void freeCommandBuffers();
 
 		std::uint32_t m_currentFrame = 0;
 		std::uint32_t m_imageIndex = 0;
+		std::uint64_t m_presentId = 0;
+
+		std::chrono::steady_clock::time_point m_recreationStart{};
+		bool m_measureRecreation = false;
+		double m_lastRecreationTime = 0.0;
 
 		Window &m_window;
 		Device &m_device;
-		Swapchain m_swapchain{ m_device, m_window.getExtent() };
+		Swapchain m_swapchain{ m_device, m_window.getExtent(), Swapchain::getPresentModeOverride() };
+		RenderGraphExecutor m_renderGraphExecutor{ m_device };
+		AsyncCompute m_asyncCompute{ m_device, Swapchain::MAX_FRAMES_IN_FLIGHT };
+		FrameAllocator m_frameAllocator{ Swapchain::MAX_FRAMES_IN_FLIGHT, std::max(std::thread::hardware_concurrency(), 1u), FRAME_ARENA_SIZE };
+		FrameLimiter m_frameLimiter{ FrameLimiter::getFrameRateOverride() };
+		std::atomic<VkPresentModeKHR> m_requestedPresentMode{ m_swapchain.getRequestedPresentMode() };
+		std::atomic<float> m_requestedFrameRate{ m_frameLimiter.getTargetFrameRate() };
 		std::vector<VkCommandBuffer> m_commandBuffers;
+
+		std::vector<VkSemaphore> m_waitSemaphores;
+		std::vector<VkPipelineStageFlags> m_waitStages;
+
+		static constexpr std::size_t FRAME_ARENA_SIZE = 256 * 1024;
+		static constexpr std::uint64_t PRESENT_WAIT_TIMEOUT = 100000000;
 	};
 }
 
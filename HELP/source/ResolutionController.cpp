@@ -0,0 +1,86 @@
+#include "ResolutionController.h"
+
+namespace eng {
+	ResolutionController::ResolutionController(const Settings &settings) : m_settings(settings), m_scale(settings.maxScale) {
+		m_history.reserve(m_settings.historySize);
+	}
+
+	float ResolutionController::update(float frameTime, float renderedScale) {
+		if (frameTime <= 0.0f || renderedScale <= 0.0f) {
+			return m_scale;
+		}
+
+		m_filteredFrameTime = m_filteredFrameTime <= 0.0f ? frameTime : m_filteredFrameTime + (frameTime - m_filteredFrameTime) * m_settings.smoothing;
+
+		const float budget = m_settings.targetFrameTime * m_settings.headroom;
+		const float load = std::max(frameTime, m_filteredFrameTime);
+		const float desiredScale = renderedScale * std::sqrt(budget / load);
+
+		if (desiredScale < m_scale) {
+			m_scale = desiredScale;
+		}
+		else {
+			m_scale = std::min(desiredScale, m_scale + m_settings.increaseRate);
+		}
+
+		m_scale = std::clamp(m_scale, m_settings.minScale, m_settings.maxScale);
+
+		Sample sample{};
+		sample.frameTime = frameTime;
+		sample.filteredFrameTime = m_filteredFrameTime;
+		sample.renderedScale = renderedScale;
+		sample.scale = m_scale;
+
+		if (m_history.size() < m_settings.historySize) {
+			m_history.push_back(sample);
+		}
+		else if (!m_history.empty()) {
+			m_history[m_historyNext] = sample;
+		}
+
+		if (m_settings.historySize > 0) {
+			m_historyNext = (m_historyNext + 1) % m_settings.historySize;
+		}
+
+		return m_scale;
+	}
+
+	void ResolutionController::reset() {
+		m_scale = m_settings.maxScale;
+		m_filteredFrameTime = 0.0f;
+		m_history.clear();
+		m_historyNext = 0;
+	}
+
+	void ResolutionController::setTargetFrameTime(float targetFrameTime) {
+		m_settings.targetFrameTime = targetFrameTime;
+	}
+
+	float ResolutionController::getTargetFrameTime() const {
+		return m_settings.targetFrameTime;
+	}
+
+	float ResolutionController::getScale() const {
+		return m_scale;
+	}
+
+	float ResolutionController::getFilteredFrameTime() const {
+		return m_filteredFrameTime;
+	}
+
+	std::vector<ResolutionController::Sample> ResolutionController::getHistory() const {
+		if (m_history.size() < m_settings.historySize) {
+			return m_history;
+		}
+
+		std::vector<Sample> history;
+		history.reserve(m_history.size());
+		history.insert(history.end(), m_history.begin() + m_historyNext, m_history.end());
+		history.insert(history.end(), m_history.begin(), m_history.begin() + m_historyNext);
+		return history;
+	}
+
+	const ResolutionController::Settings &ResolutionController::getSettings() const {
+		return m_settings;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef RESOLUTION_CONTROLLER_H
+#define RESOLUTION_CONTROLLER_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace eng {
+	class ResolutionController {
+	public:
+		struct Settings {
+			float targetFrameTime = 1000.0f / 60.0f;
+			float minScale = 0.5f;
+			float maxScale = 1.0f;
+			float headroom = 0.9f;
+			float smoothing = 0.1f;
+			float increaseRate = 0.02f;
+			std::uint32_t historySize = 240;
+		};
+
+		struct Sample {
+			float frameTime = 0.0f;
+			float filteredFrameTime = 0.0f;
+			float renderedScale = 1.0f;
+			float scale = 1.0f;
+		};
+
+		explicit ResolutionController(const Settings &settings);
+
+		float update(float frameTime, float renderedScale);
+		void reset();
+
+		void setTargetFrameTime(float targetFrameTime);
+		float getTargetFrameTime() const;
+		float getScale() const;
+		float getFilteredFrameTime() const;
+		std::vector<Sample> getHistory() const;
+		const Settings &getSettings() const;
+	private:
+		Settings m_settings;
+		float m_scale;
+		float m_filteredFrameTime = 0.0f;
+
+		std::vector<Sample> m_history;
+		std::size_t m_historyNext = 0;
+	};
+}
+
+#endif
\ No newline at end of file
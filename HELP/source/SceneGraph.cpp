@@ -0,0 +1,251 @@
+#include "SceneGraph.h"
+
+namespace eng {
+	SceneGraph::~SceneGraph() {
+		stopWorkers();
+	}
+
+	SceneGraph::NodeId SceneGraph::createNode(NodeId parent, const TransformComponent &localTransform) {
+		if (parent != INVALID_NODE && parent >= m_nodeIndices.size()) {
+			throw std::runtime_error("Failed to create scene node with an invalid parent.");
+		}
+
+		NodeId node = static_cast<NodeId>(m_nodeIndices.size());
+		std::uint32_t index = static_cast<std::uint32_t>(m_ids.size());
+
+		m_nodeIndices.push_back(index);
+		m_parentIds.push_back(parent);
+		m_children.emplace_back();
+
+		if (parent == INVALID_NODE) {
+			m_roots.push_back(node);
+		} else {
+			m_children[parent].push_back(node);
+		}
+
+		m_ids.push_back(node);
+		m_parents.push_back(parent == INVALID_NODE ? NO_PARENT : m_nodeIndices[parent]);
+		m_localTransforms.push_back(localTransform);
+		m_worldTransforms.emplace_back(1.0f);
+		m_localDirty.push_back(1);
+		m_worldChanged.push_back(0);
+
+		m_orderDirty = true;
+
+		return node;
+	}
+
+	void SceneGraph::setLocalTransform(NodeId node, const TransformComponent &localTransform) {
+		std::uint32_t index = m_nodeIndices[node];
+
+		m_localTransforms[index] = localTransform;
+		m_localDirty[index] = 1;
+	}
+
+	const TransformComponent &SceneGraph::getLocalTransform(NodeId node) const {
+		return m_localTransforms[m_nodeIndices[node]];
+	}
+
+	const glm::mat4 &SceneGraph::getWorldTransform(NodeId node) const {
+		return m_worldTransforms[m_nodeIndices[node]];
+	}
+
+	SceneGraph::NodeId SceneGraph::getParent(NodeId node) const {
+		return m_parentIds[node];
+	}
+
+	void SceneGraph::update(std::size_t threadCount) {
+		if (m_orderDirty) {
+			sortBreadthFirst();
+		}
+
+		threadCount = std::min(threadCount, std::max<std::size_t>(1, m_ids.size() / MIN_NODES_PER_THREAD));
+		threadCount = std::min(threadCount, m_subtrees.size());
+
+		if (threadCount <= 1) {
+			m_lastUpdatedCount = updateRange(0, static_cast<std::uint32_t>(m_ids.size()));
+			return;
+		}
+
+		if (m_workers.size() < threadCount - 1) {
+			stopWorkers();
+			startWorkers(threadCount - 1);
+		}
+
+		m_workerRanges.resize(m_workers.size() + 1);
+		for (std::vector<SubtreeRange> &ranges : m_workerRanges) {
+			ranges.clear();
+		}
+
+		const std::size_t nodesPerThread = (m_ids.size() + threadCount - 1) / threadCount;
+
+		std::size_t worker = 0;
+		std::size_t assignedNodes = 0;
+		for (const SubtreeRange &subtree : m_subtrees) {
+			if (assignedNodes >= nodesPerThread && worker + 1 < threadCount) {
+				++worker;
+				assignedNodes = 0;
+			}
+
+			m_workerRanges[worker].push_back(subtree);
+			assignedNodes += subtree.end - subtree.begin;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pendingWorkers = m_workers.size();
+			m_workerUpdatedCount = 0;
+			++m_generation;
+		}
+		m_condition.notify_all();
+
+		std::size_t updatedCount = updateRanges(m_workerRanges[0]);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [this]() { return m_pendingWorkers == 0; });
+
+		m_lastUpdatedCount = updatedCount + m_workerUpdatedCount;
+	}
+
+	std::size_t SceneGraph::getNodeCount() const {
+		return m_ids.size();
+	}
+
+	std::size_t SceneGraph::getSubtreeCount() const {
+		return m_subtrees.size();
+	}
+
+	std::size_t SceneGraph::getLastUpdatedCount() const {
+		return m_lastUpdatedCount;
+	}
+
+	void SceneGraph::sortBreadthFirst() {
+		const std::size_t nodeCount = m_ids.size();
+
+		std::vector<NodeId> order;
+		order.reserve(nodeCount);
+		m_subtrees.clear();
+
+		for (NodeId root : m_roots) {
+			std::uint32_t begin = static_cast<std::uint32_t>(order.size());
+
+			order.push_back(root);
+			for (std::size_t head = begin; head < order.size(); ++head) {
+				const std::vector<NodeId> &children = m_children[order[head]];
+				order.insert(order.end(), children.begin(), children.end());
+			}
+
+			m_subtrees.push_back(SubtreeRange{ begin, static_cast<std::uint32_t>(order.size()) });
+		}
+
+		std::vector<TransformComponent> localTransforms(nodeCount);
+		std::vector<glm::mat4> worldTransforms(nodeCount);
+		std::vector<std::uint8_t> localDirty(nodeCount);
+		std::vector<std::uint32_t> parents(nodeCount);
+
+		for (std::uint32_t index = 0; index < nodeCount; ++index) {
+			std::uint32_t oldIndex = m_nodeIndices[order[index]];
+
+			localTransforms[index] = m_localTransforms[oldIndex];
+			worldTransforms[index] = m_worldTransforms[oldIndex];
+			localDirty[index] = m_localDirty[oldIndex];
+		}
+
+		for (std::uint32_t index = 0; index < nodeCount; ++index) {
+			m_nodeIndices[order[index]] = index;
+		}
+
+		for (std::uint32_t index = 0; index < nodeCount; ++index) {
+			NodeId parent = m_parentIds[order[index]];
+			parents[index] = parent == INVALID_NODE ? NO_PARENT : m_nodeIndices[parent];
+		}
+
+		m_ids = std::move(order);
+		m_parents = std::move(parents);
+		m_localTransforms = std::move(localTransforms);
+		m_worldTransforms = std::move(worldTransforms);
+		m_localDirty = std::move(localDirty);
+		m_worldChanged.assign(nodeCount, 0);
+
+		m_orderDirty = false;
+	}
+
+	std::size_t SceneGraph::updateRange(std::uint32_t begin, std::uint32_t end) {
+		std::size_t updatedCount = 0;
+
+		for (std::uint32_t index = begin; index < end; ++index) {
+			std::uint32_t parent = m_parents[index];
+
+			bool changed = m_localDirty[index] != 0 || (parent != NO_PARENT && m_worldChanged[parent] != 0);
+			m_worldChanged[index] = changed ? 1 : 0;
+
+			if (!changed) {
+				continue;
+			}
+
+			glm::mat4 localTransform = m_localTransforms[index].getTransform();
+			m_worldTransforms[index] = parent == NO_PARENT ? localTransform : m_worldTransforms[parent] * localTransform;
+			m_localDirty[index] = 0;
+
+			++updatedCount;
+		}
+
+		return updatedCount;
+	}
+	std::size_t SceneGraph::updateRanges(const std::vector<SubtreeRange> &ranges) {
+		std::size_t updatedCount = 0;
+		for (const SubtreeRange &range : ranges) {
+			updatedCount += updateRange(range.begin, range.end);
+		}
+
+		return updatedCount;
+	}
+
+	void SceneGraph::startWorkers(std::size_t workerCount) {
+		m_running = true;
+
+		m_workers.reserve(workerCount);
+		for (std::size_t i = 0; i < workerCount; ++i) {
+			m_workers.emplace_back(&SceneGraph::workerLoop, this, i + 1, m_generation);
+		}
+	}
+
+	void SceneGraph::stopWorkers() {
+		if (m_workers.empty()) {
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+		m_condition.notify_all();
+
+		for (std::thread &worker : m_workers) {
+			worker.join();
+		}
+		m_workers.clear();
+	}
+
+	void SceneGraph::workerLoop(std::size_t worker, std::uint64_t generation) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		while (true) {
+			m_condition.wait(lock, [this, generation]() { return m_generation != generation || !m_running; });
+			if (!m_running) {
+				return;
+			}
+
+			generation = m_generation;
+
+			lock.unlock();
+			std::size_t updatedCount = updateRanges(m_workerRanges[worker]);
+			lock.lock();
+
+			m_workerUpdatedCount += updatedCount;
+			if (--m_pendingWorkers == 0) {
+				m_condition.notify_all();
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef SCENE_GRAPH_H
+#define SCENE_GRAPH_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "GameObject.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+namespace eng {
+	class SceneGraph {
+	public:
+		using NodeId = std::uint32_t;
+
+		SceneGraph() = default;
+		~SceneGraph();
+
+		SceneGraph(const SceneGraph &) = delete;
+		SceneGraph &operator=(const SceneGraph &) = delete;
+
+		NodeId createNode(NodeId parent = INVALID_NODE, const TransformComponent &localTransform = {});
+
+		void setLocalTransform(NodeId node, const TransformComponent &localTransform);
+		const TransformComponent &getLocalTransform(NodeId node) const;
+		const glm::mat4 &getWorldTransform(NodeId node) const;
+		NodeId getParent(NodeId node) const;
+
+		void update(std::size_t threadCount = 1);
+
+		std::size_t getNodeCount() const;
+		std::size_t getSubtreeCount() const;
+		std::size_t getLastUpdatedCount() const;
+
+		static constexpr NodeId INVALID_NODE = std::numeric_limits<NodeId>::max();
+	private:
+		struct SubtreeRange {
+			std::uint32_t begin;
+			std::uint32_t end;
+		};
+
+		void sortBreadthFirst();
+		std::size_t updateRange(std::uint32_t begin, std::uint32_t end);
+		std::size_t updateRanges(const std::vector<SubtreeRange> &ranges);
+
+		void startWorkers(std::size_t workerCount);
+		void stopWorkers();
+		void workerLoop(std::size_t worker, std::uint64_t generation);
+
+		std::vector<std::uint32_t> m_nodeIndices;
+		std::vector<NodeId> m_parentIds;
+		std::vector<std::vector<NodeId>> m_children;
+		std::vector<NodeId> m_roots;
+
+		std::vector<NodeId> m_ids;
+		std::vector<std::uint32_t> m_parents;
+		std::vector<TransformComponent> m_localTransforms;
+		std::vector<glm::mat4> m_worldTransforms;
+		std::vector<std::uint8_t> m_localDirty;
+		std::vector<std::uint8_t> m_worldChanged;
+		std::vector<SubtreeRange> m_subtrees;
+
+		bool m_orderDirty = false;
+		std::size_t m_lastUpdatedCount = 0;
+
+		std::vector<std::thread> m_workers;
+		std::vector<std::vector<SubtreeRange>> m_workerRanges;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::uint64_t m_generation = 0;
+		std::size_t m_pendingWorkers = 0;
+		std::size_t m_workerUpdatedCount = 0;
+		bool m_running = false;
+
+		static constexpr std::uint32_t NO_PARENT = std::numeric_limits<std::uint32_t>::max();
+		static constexpr std::size_t MIN_NODES_PER_THREAD = 4096;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,402 @@
+#include "ShadowMap.h"
+
+namespace eng {
+	ShadowMap::ShadowMap(Device &device, Swapchain &swapchain, GeometryPool &geometryPool, const Settings &settings)
+		: m_device(device), m_swapchain(swapchain), m_geometryPool(geometryPool), m_settings(settings) {
+		if (m_settings.resolution == 0 || m_settings.maxDistance <= 0.0f) {
+			throw std::runtime_error("Shadow map must have a non-zero resolution and distance.");
+		}
+
+		for (std::uint32_t cascade = 0; cascade < CASCADE_COUNT; ++cascade) {
+			m_imageNames[cascade] = "shadow cascade " + std::to_string(cascade);
+			m_passNames[cascade] = "shadows " + std::to_string(cascade);
+		}
+
+		m_frusta.reserve(CASCADE_COUNT);
+
+		createImage();
+		createSampler();
+		createPipeline();
+	}
+
+	ShadowMap::~ShadowMap() {
+		m_pipeline.reset();
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroySampler(m_device.getDevice(), m_sampler, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		for (VkImageView imageView : m_layerImageViews) {
+			vkDestroyImageView(m_device.getDevice(), imageView, VulkanAllocator::get(AllocationCategory::Resource));
+		}
+
+		vkDestroyImageView(m_device.getDevice(), m_imageView, VulkanAllocator::get(AllocationCategory::Resource));
+		vkDestroyImage(m_device.getDevice(), m_image, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(m_imageMemory);
+	}
+
+	void ShadowMap::setLightDirection(const glm::vec3 &direction) {
+		m_lightDirection = glm::normalize(direction);
+		m_lightChanged = true;
+	}
+
+	void ShadowMap::setCachingEnabled(bool enabled) {
+		m_settings.caching = enabled;
+	}
+
+	void ShadowMap::update(const Camera &camera, const BoundingVolumeHierarchy &boundingVolumeHierarchy, const std::vector<bool> &dynamicObjects, ShadowFrame &frame) {
+		fitCascades(camera);
+
+		m_frusta.clear();
+		for (const CascadeFit &fit : m_fits) {
+			m_frusta.push_back(fit.frustum);
+		}
+
+		const std::size_t first = frame.casters.visible.size();
+		boundingVolumeHierarchy.query(m_frusta, frame.casters.visible);
+
+		std::uint64_t dynamicMask = 0;
+		for (std::size_t i = first; i < frame.casters.visible.size(); ++i) {
+			const BoundingVolumeHierarchy::QueryResult &result = frame.casters.visible[i];
+			if (result.userData < dynamicObjects.size() && dynamicObjects[result.userData]) {
+				dynamicMask |= result.mask;
+			}
+		}
+
+		frame.lightDirection = m_lightDirection;
+		frame.casters.views.resize(CASCADE_COUNT);
+
+		std::uint64_t renderMask = 0;
+		for (std::uint32_t cascade = 0; cascade < CASCADE_COUNT; ++cascade) {
+			CascadeFit &fit = m_fits[cascade];
+
+			const bool dynamic = (dynamicMask & (std::uint64_t{ 1 } << cascade)) != 0;
+			if (!m_settings.caching || dynamic || fit.dynamic) {
+				++fit.version;
+			}
+			fit.dynamic = dynamic;
+
+			ShadowFrame::Cascade &result = frame.cascades[cascade];
+			result.projectionView = fit.projectionView;
+			result.version = fit.version;
+			result.render = fit.version != m_renderedVersions[cascade].load(std::memory_order_acquire);
+
+			if (result.render) {
+				renderMask |= std::uint64_t{ 1 } << cascade;
+			}
+
+			frame.casters.views[cascade].position = fit.position;
+			frame.casters.views[cascade].projectionViews[0] = fit.projectionView;
+		}
+
+		for (std::size_t i = first; i < frame.casters.visible.size(); ++i) {
+			frame.casters.visible[i].mask &= renderMask;
+		}
+	}
+
+	void ShadowMap::addPasses(RenderGraph &graph, const ShadowFrame &frame, const std::vector<std::shared_ptr<Model>> &models) {
+		m_frame = &frame;
+		m_models = &models;
+		m_statistics = {};
+
+		VkClearValue depthClearValue{};
+		depthClearValue.depthStencil = { 1.0f, 0 };
+
+		for (std::uint32_t cascade = 0; cascade < CASCADE_COUNT; ++cascade) {
+			RenderGraph::ImageDescription imageDescription{};
+			imageDescription.format = m_format;
+			imageDescription.extent = { m_settings.resolution, m_settings.resolution };
+			imageDescription.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+			imageDescription.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+			imageDescription.baseLayer = cascade;
+			imageDescription.layerCount = 1;
+
+			RenderGraph::ResourceState initialState{};
+			if (m_imported[cascade]) {
+				initialState.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				initialState.stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+				initialState.access = VK_ACCESS_SHADER_READ_BIT;
+			} else {
+				initialState.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+				initialState.stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+				initialState.access = 0;
+			}
+
+			m_imported[cascade] = true;
+			m_cascadeImages[cascade] = graph.importImage(m_imageNames[cascade], m_image, m_layerImageViews[cascade], imageDescription, initialState, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+			const ShadowFrame::Cascade &result = frame.cascades[cascade];
+			if (!result.render || result.version == m_renderedVersions[cascade].load(std::memory_order_relaxed)) {
+				++m_statistics.cachedCascades;
+				continue;
+			}
+
+			graph.addPass(m_passNames[cascade], RenderGraph::PassType::Graphics)
+				.clear(m_cascadeImages[cascade], RenderGraph::Access::DepthAttachment, depthClearValue)
+				.setExecute([this, cascade](VkCommandBuffer commandBuffer) {
+					render(commandBuffer, cascade);
+				});
+
+			m_renderedVersions[cascade].store(result.version, std::memory_order_release);
+			++m_statistics.renderedCascades;
+		}
+	}
+
+	RenderGraph::ResourceHandle ShadowMap::getCascadeImage(std::uint32_t cascade) const {
+		return m_cascadeImages[cascade];
+	}
+
+	VkImageView ShadowMap::getImageView() const {
+		return m_imageView;
+	}
+
+	VkSampler ShadowMap::getSampler() const {
+		return m_sampler;
+	}
+
+	const glm::vec3 &ShadowMap::getLightDirection() const {
+		return m_lightDirection;
+	}
+
+	const ShadowMap::Statistics &ShadowMap::getStatistics() const {
+		return m_statistics;
+	}
+
+	void ShadowMap::createImage() {
+		m_format = m_device.findSupportedFormat(
+			{ VK_FORMAT_D32_SFLOAT, VK_FORMAT_D16_UNORM },
+			VK_IMAGE_TILING_OPTIMAL,
+			VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+		);
+
+		VkImageCreateInfo imageCreateInfo{};
+		imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCreateInfo.pNext = nullptr;
+		imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageCreateInfo.extent.width = m_settings.resolution;
+		imageCreateInfo.extent.height = m_settings.resolution;
+		imageCreateInfo.extent.depth = 1;
+		imageCreateInfo.mipLevels = 1;
+		imageCreateInfo.arrayLayers = CASCADE_COUNT;
+		imageCreateInfo.format = m_format;
+		imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		m_device.createImage(imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_image, m_imageMemory, MemoryCategory::RenderTarget);
+
+		VkImageViewCreateInfo imageViewCreateInfo{};
+		imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		imageViewCreateInfo.pNext = nullptr;
+		imageViewCreateInfo.image = m_image;
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+		imageViewCreateInfo.format = m_format;
+		imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+		imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+		imageViewCreateInfo.subresourceRange.levelCount = 1;
+		imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+		imageViewCreateInfo.subresourceRange.layerCount = CASCADE_COUNT;
+
+		if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_imageView) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create shadow map image view.");
+		}
+
+		for (std::uint32_t cascade = 0; cascade < CASCADE_COUNT; ++cascade) {
+			imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			imageViewCreateInfo.subresourceRange.baseArrayLayer = cascade;
+			imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+			if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_layerImageViews[cascade]) != VK_SUCCESS) {
+				throw std::runtime_error("Failed to create shadow cascade image view.");
+			}
+		}
+	}
+
+	void ShadowMap::createSampler() {
+		VkSamplerCreateInfo samplerCreateInfo{};
+		samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerCreateInfo.pNext = nullptr;
+		samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+		samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+		samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+		samplerCreateInfo.anisotropyEnable = VK_FALSE;
+		samplerCreateInfo.maxAnisotropy = 1.0f;
+		samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+		samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+		samplerCreateInfo.compareEnable = VK_TRUE;
+		samplerCreateInfo.compareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerCreateInfo.mipLodBias = 0.0f;
+		samplerCreateInfo.minLod = 0.0f;
+		samplerCreateInfo.maxLod = 0.0f;
+
+		if (vkCreateSampler(m_device.getDevice(), &samplerCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_sampler) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create shadow map sampler.");
+		}
+	}
+
+	void ShadowMap::createPipeline() {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstantData);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 0;
+		pipelineLayoutCreateInfo.pSetLayouts = nullptr;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create shadow pipeline layout.");
+		}
+
+		Pipeline::Config config = Pipeline::getDefaultConfig();
+		config.vertexShaderPath = "resources/shaders/shadow.vert.spv";
+		config.depthFormat = m_format;
+		config.depthOnly = true;
+		config.depthBiasConstant = m_settings.depthBiasConstant;
+		config.depthBiasSlope = m_settings.depthBiasSlope;
+
+		if (m_geometryPool.isVertexPullingEnabled()) {
+			config.vertexShaderPath = "resources/shaders/shadow_pulling.vert.spv";
+			config.modelVertexInput = false;
+		}
+
+		m_pipeline = std::make_unique<Pipeline>(m_device, m_swapchain, m_pipelineLayout, config);
+	}
+
+	void ShadowMap::fitCascades(const Camera &camera) {
+		const glm::mat4 inverseProjectionView = glm::inverse(camera.getProjectionView());
+
+		std::array<glm::vec3, 8> corners{};
+		for (std::uint32_t i = 0; i < corners.size(); ++i) {
+			glm::vec4 corner = inverseProjectionView * glm::vec4{ (i & 1) != 0 ? 1.0f : -1.0f, (i & 2) != 0 ? 1.0f : -1.0f, (i & 4) != 0 ? 1.0f : 0.0f, 1.0f };
+			corners[i] = glm::vec3{ corner } / corner.w;
+		}
+
+		glm::vec3 nearCenter{ 0.0f };
+		glm::vec3 farCenter{ 0.0f };
+		for (std::uint32_t i = 0; i < 4; ++i) {
+			nearCenter += corners[i] * 0.25f;
+			farCenter += corners[i + 4] * 0.25f;
+		}
+
+		const glm::vec3 forward = glm::normalize(farCenter - nearCenter);
+		const float nearDistance = glm::dot(nearCenter - camera.getPosition(), forward);
+		const float farDistance = glm::dot(farCenter - camera.getPosition(), forward);
+		const float shadowDistance = std::min(farDistance, m_settings.maxDistance);
+
+		float sliceStart = nearDistance;
+		for (std::uint32_t cascade = 0; cascade < CASCADE_COUNT; ++cascade) {
+			const float fraction = static_cast<float>(cascade + 1) / static_cast<float>(CASCADE_COUNT);
+			const float logarithmic = nearDistance * std::pow(shadowDistance / nearDistance, fraction);
+			const float uniform = nearDistance + (shadowDistance - nearDistance) * fraction;
+			const float sliceEnd = m_settings.splitLambda * logarithmic + (1.0f - m_settings.splitLambda) * uniform;
+
+			const float start = (sliceStart - nearDistance) / (farDistance - nearDistance);
+			const float end = (sliceEnd - nearDistance) / (farDistance - nearDistance);
+
+			std::array<glm::vec3, 8> sliceCorners{};
+			glm::vec3 center{ 0.0f };
+			for (std::uint32_t i = 0; i < 4; ++i) {
+				sliceCorners[i] = corners[i] + (corners[i + 4] - corners[i]) * start;
+				sliceCorners[i + 4] = corners[i] + (corners[i + 4] - corners[i]) * end;
+				center += (sliceCorners[i] + sliceCorners[i + 4]) * 0.125f;
+			}
+
+			float radius = 0.0f;
+			for (const glm::vec3 &corner : sliceCorners) {
+				radius = std::max(radius, glm::length(corner - center));
+			}
+			radius = std::ceil(radius * 16.0f) / 16.0f;
+
+			fitCascade(m_fits[cascade], center, radius);
+			sliceStart = sliceEnd;
+		}
+
+		m_lightChanged = false;
+	}
+
+	void ShadowMap::fitCascade(CascadeFit &fit, const glm::vec3 &center, float radius) {
+		if (!m_lightChanged && glm::length(center - fit.center) + radius <= fit.radius) {
+			return;
+		}
+
+		fit.center = center;
+		fit.radius = radius * (1.0f + m_settings.refitMargin);
+
+		const glm::vec3 up = std::abs(m_lightDirection.y) > 0.99f ? glm::vec3{ 0.0f, 0.0f, 1.0f } : glm::vec3{ 0.0f, -1.0f, 0.0f };
+
+		Camera lightCamera{};
+		lightCamera.setViewDirection(glm::vec3{ 0.0f }, m_lightDirection, up);
+
+		const float texelSize = 2.0f * fit.radius / static_cast<float>(m_settings.resolution);
+		glm::vec3 lightCenter = glm::vec3{ lightCamera.getView() * glm::vec4{ center, 1.0f } };
+		lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+		lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+
+		lightCamera.setOrthographicProjection(
+			lightCenter.x - fit.radius,
+			lightCenter.x + fit.radius,
+			lightCenter.y - fit.radius,
+			lightCenter.y + fit.radius,
+			lightCenter.z - fit.radius - m_settings.casterDistance,
+			lightCenter.z + fit.radius
+		);
+
+		fit.position = center - m_lightDirection * (fit.radius + m_settings.casterDistance);
+		fit.projectionView = lightCamera.getProjectionView();
+		fit.frustum = lightCamera.getFrustum();
+		++fit.version;
+	}
+
+	void ShadowMap::render(VkCommandBuffer commandBuffer, std::uint32_t cascade) {
+		DrawRecorder recorder(commandBuffer);
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = static_cast<float>(m_settings.resolution);
+		viewport.height = static_cast<float>(m_settings.resolution);
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = { m_settings.resolution, m_settings.resolution };
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+		const ViewBatch &casters = m_frame->casters;
+		const glm::mat4 &projectionView = m_frame->cascades[cascade].projectionView;
+
+		for (const RenderPacket &packet : casters.views[cascade].drawList.getPackets()) {
+			m_pipeline->bind(recorder);
+
+			if (m_geometryPool.isVertexPullingEnabled()) {
+				m_geometryPool.bindIndices(recorder);
+			} else {
+				m_geometryPool.bind(recorder);
+			}
+
+			PushConstantData pushConstantData{};
+			pushConstantData.transform = projectionView * casters.transforms[packet.transformIndex];
+			pushConstantData.vertexAddress = m_geometryPool.getVertexBufferAddress();
+
+			recorder.pushConstants(m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstantData), &pushConstantData);
+
+			(*m_models)[packet.model]->draw(recorder, packet.lod);
+		}
+
+		m_statistics.draws += recorder.getStatistics().draws;
+	}
+
+	void ShadowFrame::clear() {
+		casters.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef SHADOW_MAP_H
+#define SHADOW_MAP_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Device.h"
+#include "Swapchain.h"
+#include "Pipeline.h"
+#include "Model.h"
+#include "GeometryPool.h"
+#include "Camera.h"
+#include "Frustum.h"
+#include "BoundingVolumeHierarchy.h"
+#include "RenderGraph.h"
+#include "View.h"
+#include "DrawRecorder.h"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace eng {
+	struct ShadowFrame;
+
+	class ShadowMap {
+	public:
+		static constexpr std::uint32_t CASCADE_COUNT = 4;
+
+		struct Settings {
+			std::uint32_t resolution = 2048;
+			float maxDistance = 60.0f;
+			float splitLambda = 0.75f;
+			float casterDistance = 50.0f;
+			float refitMargin = 0.2f;
+			float depthBiasConstant = 1.25f;
+			float depthBiasSlope = 1.75f;
+			bool caching = true;
+		};
+
+		struct Statistics {
+			std::uint32_t renderedCascades = 0;
+			std::uint32_t cachedCascades = 0;
+			std::uint64_t draws = 0;
+		};
+
+		ShadowMap(Device &device, Swapchain &swapchain, GeometryPool &geometryPool, const Settings &settings);
+		~ShadowMap();
+
+		ShadowMap(const ShadowMap &) = delete;
+		ShadowMap &operator=(const ShadowMap &) = delete;
+
+		void setLightDirection(const glm::vec3 &direction);
+		void setCachingEnabled(bool enabled);
+
+		void update(const Camera &camera, const BoundingVolumeHierarchy &boundingVolumeHierarchy, const std::vector<bool> &dynamicObjects, ShadowFrame &frame);
+		void addPasses(RenderGraph &graph, const ShadowFrame &frame, const std::vector<std::shared_ptr<Model>> &models);
+		RenderGraph::ResourceHandle getCascadeImage(std::uint32_t cascade) const;
+
+		VkImageView getImageView() const;
+		VkSampler getSampler() const;
+		const glm::vec3 &getLightDirection() const;
+		const Statistics &getStatistics() const;
+	private:
+		struct PushConstantData {
+			glm::mat4 transform{ 1.0f };
+			VkDeviceAddress vertexAddress = 0;
+		};
+
+		struct CascadeFit {
+			glm::vec3 center{ 0.0f };
+			float radius = 0.0f;
+			glm::vec3 position{ 0.0f };
+			glm::mat4 projectionView{ 1.0f };
+			Frustum frustum{};
+			std::uint64_t version = 0;
+			bool dynamic = false;
+		};
+
+		void createImage();
+		void createSampler();
+		void createPipeline();
+
+		void fitCascades(const Camera &camera);
+		void fitCascade(CascadeFit &fit, const glm::vec3 &center, float radius);
+		void render(VkCommandBuffer commandBuffer, std::uint32_t cascade);
+
+		Device &m_device;
+		Swapchain &m_swapchain;
+		GeometryPool &m_geometryPool;
+		Settings m_settings;
+
+		VkFormat m_format;
+		VkImage m_image = VK_NULL_HANDLE;
+		VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+		VkImageView m_imageView = VK_NULL_HANDLE;
+		std::array<VkImageView, CASCADE_COUNT> m_layerImageViews{};
+		VkSampler m_sampler;
+		VkPipelineLayout m_pipelineLayout;
+		std::unique_ptr<Pipeline> m_pipeline;
+
+		glm::vec3 m_lightDirection{ 0.0f, 1.0f, 0.0f };
+		bool m_lightChanged = true;
+		std::array<CascadeFit, CASCADE_COUNT> m_fits{};
+		std::vector<Frustum> m_frusta;
+
+		std::array<std::atomic<std::uint64_t>, CASCADE_COUNT> m_renderedVersions{};
+		std::array<bool, CASCADE_COUNT> m_imported{};
+		std::array<RenderGraph::ResourceHandle, CASCADE_COUNT> m_cascadeImages{};
+		std::array<std::string, CASCADE_COUNT> m_imageNames;
+		std::array<std::string, CASCADE_COUNT> m_passNames;
+
+		const ShadowFrame *m_frame = nullptr;
+		const std::vector<std::shared_ptr<Model>> *m_models = nullptr;
+		Statistics m_statistics{};
+	};
+
+	struct ShadowFrame {
+		struct Cascade {
+			glm::mat4 projectionView{ 1.0f };
+			std::uint64_t version = 0;
+			bool render = false;
+		};
+
+		std::array<Cascade, ShadowMap::CASCADE_COUNT> cascades{};
+		glm::vec3 lightDirection{ 0.0f, 1.0f, 0.0f };
+		ViewBatch casters;
+
+		void clear();
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "Simulation.h"
+
+namespace eng {
+	Simulation::Simulation(float timeStep) : m_timeStep(timeStep) {
+		if (timeStep <= 0.0f) {
+			throw std::runtime_error("Failed to create simulation with a non-positive time step.");
+		}
+	}
+
+	Simulation::~Simulation() {
+		stop();
+	}
+
+	std::uint32_t Simulation::addBody(const TransformComponent &transform, const glm::vec3 &angularVelocity) {
+		if (m_worker.joinable()) {
+			throw std::runtime_error("Failed to add body to a running simulation.");
+		}
+
+		m_previousTransforms.push_back(transform);
+		m_currentTransforms.push_back(transform);
+		m_angularVelocities.push_back(angularVelocity);
+
+		return static_cast<std::uint32_t>(m_currentTransforms.size() - 1);
+	}
+
+	void Simulation::start() {
+		if (m_worker.joinable()) {
+			return;
+		}
+
+		m_running = true;
+		m_worker = std::thread(&Simulation::workerLoop, this);
+	}
+
+	void Simulation::stop() {
+		if (!m_worker.joinable()) {
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+		m_condition.notify_all();
+
+		m_worker.join();
+		m_busy = false;
+	}
+
+	void Simulation::advance(float frameTime) {
+		if (!m_worker.joinable()) {
+			integrate(frameTime);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pendingFrameTime = frameTime;
+			m_busy = true;
+		}
+		m_condition.notify_all();
+	}
+
+	void Simulation::wait() {
+		if (!m_worker.joinable()) {
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [this]() { return !m_busy; });
+	}
+
+	void Simulation::step() {
+		m_previousTransforms = m_currentTransforms;
+
+		for (std::size_t i = 0; i < m_currentTransforms.size(); ++i) {
+			glm::vec3 &rotation = m_currentTransforms[i].rotation;
+
+			rotation = glm::mod(rotation + m_angularVelocities[i] * m_timeStep, glm::vec3{ glm::two_pi<float>() });
+		}
+
+		++m_tick;
+
+		if (m_tick == m_checksumTick) {
+			m_recordedChecksum = getChecksum();
+		}
+	}
+
+	void Simulation::interpolate(std::vector<TransformComponent> &transforms) const {
+		transforms.resize(m_currentTransforms.size());
+
+		float alpha = getAlpha();
+		for (std::size_t i = 0; i < m_currentTransforms.size(); ++i) {
+			transforms[i] = interpolate(m_previousTransforms[i], m_currentTransforms[i], alpha);
+		}
+	}
+
+	float Simulation::getTimeStep() const {
+		return m_timeStep;
+	}
+
+	float Simulation::getAlpha() const {
+		return std::min(m_accumulator / m_timeStep, 1.0f);
+	}
+
+	std::uint64_t Simulation::getTick() const {
+		return m_tick;
+	}
+
+	std::size_t Simulation::getBodyCount() const {
+		return m_currentTransforms.size();
+	}
+
+	bool Simulation::isBodyStatic(std::uint32_t body) const {
+		return m_angularVelocities[body] == glm::vec3{ 0.0f };
+	}
+
+	std::uint64_t Simulation::getChecksum() const {
+		std::uint64_t hash = 14695981039346656037ull;
+
+		const unsigned char *bytes = reinterpret_cast<const unsigned char *>(m_currentTransforms.data());
+		for (std::size_t i = 0; i < m_currentTransforms.size() * sizeof(TransformComponent); ++i) {
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	void Simulation::recordChecksumAt(std::uint64_t tick) {
+		m_checksumTick = tick;
+		m_recordedChecksum = 0;
+	}
+
+	std::uint64_t Simulation::getRecordedChecksum() const {
+		return m_recordedChecksum;
+	}
+
+	void Simulation::integrate(float frameTime) {
+		m_accumulator += std::max(frameTime, 0.0f);
+
+		std::uint32_t steps = 0;
+		while (m_accumulator >= m_timeStep && steps < MAX_STEPS_PER_FRAME) {
+			step();
+
+			m_accumulator -= m_timeStep;
+			++steps;
+		}
+
+		if (steps == MAX_STEPS_PER_FRAME) {
+			m_accumulator = std::min(m_accumulator, m_timeStep);
+		}
+	}
+
+	void Simulation::workerLoop() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		while (true) {
+			m_condition.wait(lock, [this]() { return m_busy || !m_running; });
+			if (!m_running) {
+				return;
+			}
+
+			float frameTime = m_pendingFrameTime;
+
+			lock.unlock();
+			integrate(frameTime);
+			lock.lock();
+
+			m_busy = false;
+			m_condition.notify_all();
+		}
+	}
+
+	TransformComponent Simulation::interpolate(const TransformComponent &previous, const TransformComponent &current, float alpha) {
+		TransformComponent transform{};
+		transform.translation = glm::mix(previous.translation, current.translation, alpha);
+		transform.scale = glm::mix(previous.scale, current.scale, alpha);
+
+		glm::vec3 delta = current.rotation - previous.rotation;
+		for (int i = 0; i < 3; ++i) {
+			if (delta[i] > glm::pi<float>()) {
+				delta[i] -= glm::two_pi<float>();
+			} else if (delta[i] < -glm::pi<float>()) {
+				delta[i] += glm::two_pi<float>();
+			}
+		}
+		transform.rotation = previous.rotation + delta * alpha;
+
+		return transform;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include "GameObject.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace eng {
+	class Simulation {
+	public:
+		Simulation(float timeStep = 1.0f / 60.0f);
+		~Simulation();
+
+		Simulation(const Simulation &) = delete;
+		Simulation &operator=(const Simulation &) = delete;
+
+		std::uint32_t addBody(const TransformComponent &transform, const glm::vec3 &angularVelocity);
+
+		void start();
+		void stop();
+
+		void advance(float frameTime);
+		void wait();
+		void step();
+
+		void interpolate(std::vector<TransformComponent> &transforms) const;
+
+		float getTimeStep() const;
+		float getAlpha() const;
+		std::uint64_t getTick() const;
+		std::size_t getBodyCount() const;
+		bool isBodyStatic(std::uint32_t body) const;
+		std::uint64_t getChecksum() const;
+
+		void recordChecksumAt(std::uint64_t tick);
+		std::uint64_t getRecordedChecksum() const;
+
+		static constexpr std::uint32_t MAX_STEPS_PER_FRAME = 8;
+	private:
+		void integrate(float frameTime);
+		void workerLoop();
+
+		static TransformComponent interpolate(const TransformComponent &previous, const TransformComponent &current, float alpha);
+
+		float m_timeStep;
+		float m_accumulator = 0.0f;
+		std::uint64_t m_tick = 0;
+		std::uint64_t m_checksumTick = 0;
+		std::uint64_t m_recordedChecksum = 0;
+
+		std::vector<TransformComponent> m_previousTransforms;
+		std::vector<TransformComponent> m_currentTransforms;
+		std::vector<glm::vec3> m_angularVelocities;
+
+		std::thread m_worker;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		float m_pendingFrameTime = 0.0f;
+		bool m_busy = false;
+		bool m_running = false;
+	};
+}
+
+#endif
\ No newline at end of file
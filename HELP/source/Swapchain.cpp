@@ -1,23 +1,28 @@
 #include "Swapchain.h"
 
 namespace eng {
-    Swapchain::Swapchain(Device &device, const VkExtent2D &windowExtent)
-        : m_device(device), m_windowExtent(windowExtent) {
+    Swapchain::Swapchain(Device &device, const VkExtent2D &windowExtent, VkPresentModeKHR presentMode)
+        : m_requestedPresentMode(presentMode), m_device(device), m_windowExtent(windowExtent) {
+        m_depthFormat = findDepthFormat();
+
         createSwapchain();
         createImageViews();
-        createRenderPass();
-        createFramebuffers();
+        if (!m_device.isDynamicRenderingEnabled()) {
+            createRenderPass();
+        }
         createSyncObjects();
     }
 
     Swapchain::~Swapchain() {
         for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
-            vkDestroySemaphore(m_device.getDevice(), m_imageAvailableSemaphores[i], nullptr);
-            vkDestroySemaphore(m_device.getDevice(), m_renderFinishedSemaphores[i], nullptr);
-            vkDestroyFence(m_device.getDevice(), m_inFlightFences[i], nullptr);
+            vkDestroySemaphore(m_device.getDevice(), m_imageAvailableSemaphores[i], VulkanAllocator::get(AllocationCategory::Synchronization));
+            vkDestroySemaphore(m_device.getDevice(), m_renderFinishedSemaphores[i], VulkanAllocator::get(AllocationCategory::Synchronization));
+            vkDestroyFence(m_device.getDevice(), m_inFlightFences[i], VulkanAllocator::get(AllocationCategory::Synchronization));
         }
 
-        vkDestroyRenderPass(m_device.getDevice(), m_renderPass, nullptr);
+        if (m_renderPass != VK_NULL_HANDLE) {
+            vkDestroyRenderPass(m_device.getDevice(), m_renderPass, VulkanAllocator::get(AllocationCategory::Pipeline));
+        }
 
         cleanupSwapchain();
     }
@@ -29,25 +34,53 @@ namespace eng {
 
         createSwapchain();
         createImageViews();
-        createFramebuffers();
+    }
+
+    void Swapchain::setPresentMode(VkPresentModeKHR presentMode) {
+        m_requestedPresentMode = presentMode;
+    }
+
+    bool Swapchain::isPresentModeSupported(VkPresentModeKHR presentMode) {
+        const std::vector<VkPresentModeKHR> presentModes = m_device.querySwapchainSupport().presentModes;
+        return std::find(presentModes.begin(), presentModes.end(), presentMode) != presentModes.end();
     }
 
     VkRenderPass Swapchain::getRenderPass() const {
         return m_renderPass;
     }
 
-    VkFramebuffer Swapchain::getFramebuffer(std::uint32_t imageIndex) const {
-        if (imageIndex >= m_framebuffers.size()) {
-            throw std::runtime_error("Failed to get framebuffer with the image index.");
+    VkImage Swapchain::getImage(std::uint32_t imageIndex) const {
+        if (imageIndex >= m_images.size()) {
+            throw std::runtime_error("Failed to get swapchain image with the image index.");
+        }
+
+        return m_images[imageIndex];
+    }
+
+    VkImageView Swapchain::getImageView(std::uint32_t imageIndex) const {
+        if (imageIndex >= m_imageViews.size()) {
+            throw std::runtime_error("Failed to get swapchain image view with the image index.");
         }
 
-        return m_framebuffers[imageIndex];
+        return m_imageViews[imageIndex];
+    }
+
+    VkFormat Swapchain::getImageFormat() const {
+        return m_imageFormat;
+    }
+
+    VkFormat Swapchain::getDepthFormat() const {
+        return m_depthFormat;
     }
 
     VkExtent2D Swapchain::getExtent() const {
         return m_extent;
     }
 
+    float Swapchain::getAspectRatio() const {
+        return static_cast<float>(m_extent.width) / static_cast<float>(m_extent.height);
+    }
+
     VkSemaphore Swapchain::getImageAvailableSemaphore(std::uint32_t currentFrame) const {
         return m_imageAvailableSemaphores[currentFrame];
     }
@@ -64,6 +97,47 @@ namespace eng {
         return m_swapchain;
     }
 
+    VkPresentModeKHR Swapchain::getPresentMode() const {
+        return m_presentMode;
+    }
+
+    VkPresentModeKHR Swapchain::getRequestedPresentMode() const {
+        return m_requestedPresentMode;
+    }
+
+    VkPresentModeKHR Swapchain::getPresentModeOverride() {
+        const char *presentMode = std::getenv("HELP_PRESENT_MODE");
+        if (presentMode == nullptr) {
+            return VK_PRESENT_MODE_FIFO_KHR;
+        }
+
+        const std::string name{ presentMode };
+        if (name == "mailbox") {
+            return VK_PRESENT_MODE_MAILBOX_KHR;
+        } else if (name == "immediate") {
+            return VK_PRESENT_MODE_IMMEDIATE_KHR;
+        } else if (name == "fifo_relaxed") {
+            return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        }
+
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
+    const char *Swapchain::getPresentModeName(VkPresentModeKHR presentMode) {
+        switch (presentMode) {
+        case VK_PRESENT_MODE_MAILBOX_KHR:
+            return "Mailbox";
+        case VK_PRESENT_MODE_FIFO_KHR:
+            return "FIFO";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+            return "FIFO Relaxed";
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:
+            return "Immediate";
+        default:
+            return "Unknown";
+        }
+    }
+
     void Swapchain::createSwapchain() {
         Device::SwapchainSupportDetails swapchainSupportDetails = m_device.querySwapchainSupport();
 
@@ -73,6 +147,7 @@ namespace eng {
     
         m_imageFormat = surfaceFormat.format;
         m_extent = extent;
+        m_presentMode = presentMode;
 
         std::uint32_t imageCount = swapchainSupportDetails.capabilities.minImageCount + 1;
 
@@ -113,7 +188,7 @@ namespace eng {
         swapchainCreateInfo.clipped = VK_TRUE;
         swapchainCreateInfo.oldSwapchain = VK_NULL_HANDLE;
 
-        if (vkCreateSwapchainKHR(m_device.getDevice(), &swapchainCreateInfo, nullptr, &m_swapchain) != VK_SUCCESS) {
+        if (vkCreateSwapchainKHR(m_device.getDevice(), &swapchainCreateInfo, VulkanAllocator::get(AllocationCategory::Swapchain), &m_swapchain) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create swapchain.");
         }
 
@@ -144,7 +219,7 @@ namespace eng {
             imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
             imageViewCreateInfo.subresourceRange.layerCount = 1;
 
-            if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, nullptr, &m_imageViews[i]) != VK_SUCCESS) {
+            if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &m_imageViews[i]) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create image views.");
             }
         }
@@ -161,62 +236,58 @@ namespace eng {
         colorAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         colorAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
+        VkAttachmentDescription depthAttachmentDescription{};
+        depthAttachmentDescription.format = m_depthFormat;
+        depthAttachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
         VkAttachmentReference colorAttachmentReference{};
         colorAttachmentReference.attachment = 0;
         colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+        VkAttachmentReference depthAttachmentReference{};
+        depthAttachmentReference.attachment = 1;
+        depthAttachmentReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
         VkSubpassDependency subpassDependency{};
         subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
         subpassDependency.dstSubpass = 0;
-        subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        subpassDependency.srcAccessMask = 0;
-        subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        subpassDependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
         VkSubpassDescription subpassDescription{};
         subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
         subpassDescription.colorAttachmentCount = 1;
         subpassDescription.pColorAttachments = &colorAttachmentReference;
+        subpassDescription.pDepthStencilAttachment = &depthAttachmentReference;
+
+        VkAttachmentDescription attachmentDescriptions[] = {
+            colorAttachmentDescription,
+            depthAttachmentDescription
+        };
 
         VkRenderPassCreateInfo renderPassCreateInfo{};
         renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
         renderPassCreateInfo.pNext = nullptr;
-        renderPassCreateInfo.attachmentCount = 1;
-        renderPassCreateInfo.pAttachments = &colorAttachmentDescription;
+        renderPassCreateInfo.attachmentCount = 2;
+        renderPassCreateInfo.pAttachments = attachmentDescriptions;
         renderPassCreateInfo.subpassCount = 1;
         renderPassCreateInfo.pSubpasses = &subpassDescription;
         renderPassCreateInfo.dependencyCount = 1;
         renderPassCreateInfo.pDependencies = &subpassDependency;
 
-        if (vkCreateRenderPass(m_device.getDevice(), &renderPassCreateInfo, nullptr, &m_renderPass) != VK_SUCCESS) {
+        if (vkCreateRenderPass(m_device.getDevice(), &renderPassCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_renderPass) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create render pass.");
         }
     }
 
-    void Swapchain::createFramebuffers() {
-        m_framebuffers.resize(m_imageViews.size());
-
-        for (std::size_t i = 0; i < m_imageViews.size(); ++i) {
-            VkImageView attachments[] = {
-                m_imageViews[i]
-            };
-
-            VkFramebufferCreateInfo framebufferCreateInfo{};
-            framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-            framebufferCreateInfo.pNext = nullptr;
-            framebufferCreateInfo.renderPass = m_renderPass;
-            framebufferCreateInfo.attachmentCount = 1;
-            framebufferCreateInfo.pAttachments = attachments;
-            framebufferCreateInfo.width = m_extent.width;
-            framebufferCreateInfo.height = m_extent.height;
-            framebufferCreateInfo.layers = 1;
-
-            if (vkCreateFramebuffer(m_device.getDevice(), &framebufferCreateInfo, nullptr, &m_framebuffers[i]) != VK_SUCCESS) {
-                throw std::runtime_error("Failed to create framebuffers.");
-            }
-        }
-    }
-
     void Swapchain::createSyncObjects() {
         m_imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
         m_renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
@@ -232,24 +303,20 @@ namespace eng {
         fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
         for (std::size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
-            if (vkCreateSemaphore(m_device.getDevice(), &semaphoreCreateInfo, nullptr, &m_imageAvailableSemaphores[i]) != VK_SUCCESS ||
-                vkCreateSemaphore(m_device.getDevice(), &semaphoreCreateInfo, nullptr, &m_renderFinishedSemaphores[i]) != VK_SUCCESS ||
-                vkCreateFence(m_device.getDevice(), &fenceCreateInfo, nullptr, &m_inFlightFences[i]) != VK_SUCCESS) {
+            if (vkCreateSemaphore(m_device.getDevice(), &semaphoreCreateInfo, VulkanAllocator::get(AllocationCategory::Synchronization), &m_imageAvailableSemaphores[i]) != VK_SUCCESS ||
+                vkCreateSemaphore(m_device.getDevice(), &semaphoreCreateInfo, VulkanAllocator::get(AllocationCategory::Synchronization), &m_renderFinishedSemaphores[i]) != VK_SUCCESS ||
+                vkCreateFence(m_device.getDevice(), &fenceCreateInfo, VulkanAllocator::get(AllocationCategory::Synchronization), &m_inFlightFences[i]) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create sync objects.");
             }
         }
     }
 
     void Swapchain::cleanupSwapchain() {
-        for (VkFramebuffer framebuffer : m_framebuffers) {
-            vkDestroyFramebuffer(m_device.getDevice(), framebuffer, nullptr);
-        }
-
         for (VkImageView imageView : m_imageViews) {
-            vkDestroyImageView(m_device.getDevice(), imageView, nullptr);
+            vkDestroyImageView(m_device.getDevice(), imageView, VulkanAllocator::get(AllocationCategory::Resource));
         }
 
-        vkDestroySwapchainKHR(m_device.getDevice(), m_swapchain, nullptr);
+        vkDestroySwapchainKHR(m_device.getDevice(), m_swapchain, VulkanAllocator::get(AllocationCategory::Swapchain));
     }
 
     VkSurfaceFormatKHR Swapchain::chooseSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats) {
@@ -264,12 +331,12 @@ namespace eng {
 
     VkPresentModeKHR Swapchain::choosePresentModes(const std::vector<VkPresentModeKHR> &availablePresentModes) {
         for (const VkPresentModeKHR &availablePresentMode : availablePresentModes) {
-            if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
+            if (availablePresentMode == m_requestedPresentMode) {
                 return availablePresentMode;
             }
         }
-        
-        return VK_PRESENT_MODE_IMMEDIATE_KHR;
+
+        return VK_PRESENT_MODE_FIFO_KHR;
     }
 
     VkExtent2D Swapchain::chooseExtent(const VkSurfaceCapabilitiesKHR &capabilities) {
@@ -294,18 +361,19 @@ namespace eng {
         return actualExtent;
     }
 
+    VkFormat Swapchain::findDepthFormat() {
+        return m_device.findSupportedFormat(
+            { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT },
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+        );
+    }
+
     void Swapchain::printPresentMode(const VkPresentModeKHR &presentMode) {
-        std::string mode = "";
-        if (presentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-            mode = "Mailbox";
-        } else if (presentMode == VK_PRESENT_MODE_FIFO_KHR) {
-            mode = "FIFO";
-        } else if (presentMode == VK_PRESENT_MODE_FIFO_RELAXED_KHR) {
-            mode = "FIFO Relaxed";
-        } else if (presentMode == VK_PRESENT_MODE_IMMEDIATE_KHR) {
-            mode = "Immediate";
+        std::cout << "Present Mode: " << getPresentModeName(presentMode);
+        if (presentMode != m_requestedPresentMode) {
+            std::cout << " (" << getPresentModeName(m_requestedPresentMode) << " unsupported)";
         }
-
-        std::cout << "Present Mode: " << mode << '\n';
+        std::cout << '\n';
     }
 }
\ No newline at end of file
@@ -6,32 +6,44 @@
 #include "Device.h"
 
 #include <vector>
+#include <string>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <algorithm>
 
 namespace eng {
 	class Swapchain {
 	public:
-		Swapchain(Device &device, const VkExtent2D &windowExtent);
+		Swapchain(Device &device, const VkExtent2D &windowExtent, VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR);
 		~Swapchain();
 
 		void recreateSwapchain();
+		void setPresentMode(VkPresentModeKHR presentMode);
+		bool isPresentModeSupported(VkPresentModeKHR presentMode);
 
 		VkRenderPass getRenderPass() const;
-		VkFramebuffer getFramebuffer(std::uint32_t imageIndex) const;
+		VkImage getImage(std::uint32_t imageIndex) const;
+		VkImageView getImageView(std::uint32_t imageIndex) const;
+		VkFormat getImageFormat() const;
+		VkFormat getDepthFormat() const;
 		VkExtent2D getExtent() const;
+		float getAspectRatio() const;
 		VkSemaphore getImageAvailableSemaphore(std::uint32_t currentFrame) const;
 		VkSemaphore getRenderFinishedSemaphore(std::uint32_t currentFrame) const;
 		VkFence getInFlightFence(std::uint32_t currentFrame) const;
 		VkSwapchainKHR getSwapchain() const;
+		VkPresentModeKHR getPresentMode() const;
+		VkPresentModeKHR getRequestedPresentMode() const;
 
-		const int MAX_FRAMES_IN_FLIGHT = 2;
+		static VkPresentModeKHR getPresentModeOverride();
+		static const char *getPresentModeName(VkPresentModeKHR presentMode);
+
+		static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
 	private:
 		void createSwapchain();
 		void createImageViews();
 		void createRenderPass();
-		void createFramebuffers();
 		void createSyncObjects();
 
 		void cleanupSwapchain();
@@ -39,19 +51,23 @@ namespace eng {
 		VkSurfaceFormatKHR chooseSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats);
 		VkPresentModeKHR choosePresentModes(const std::vector<VkPresentModeKHR> &availablePresentModes);
 		VkExtent2D chooseExtent(const VkSurfaceCapabilitiesKHR &capabilities);
+		VkFormat findDepthFormat();
 		void printPresentMode(const VkPresentModeKHR &presentMode);
 		
 		VkSwapchainKHR m_swapchain;
-		VkRenderPass m_renderPass;
+		VkRenderPass m_renderPass = VK_NULL_HANDLE;
 		std::vector<VkImageView> m_imageViews;
-		std::vector<VkFramebuffer> m_framebuffers;
 		std::vector<VkSemaphore> m_imageAvailableSemaphores;
 		std::vector<VkSemaphore> m_renderFinishedSemaphores;
 		std::vector<VkFence> m_inFlightFences;
 
 		std::vector<VkImage> m_images;
 		VkFormat m_imageFormat;
+
+		VkFormat m_depthFormat;
 		VkExtent2D m_extent;
+		VkPresentModeKHR m_presentMode = VK_PRESENT_MODE_FIFO_KHR;
+		VkPresentModeKHR m_requestedPresentMode;
 
 		Device &m_device;
 		VkExtent2D m_windowExtent;
@@ -0,0 +1,52 @@
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class Texture {
+	public:
+		Texture(Device &device, std::uint32_t width, std::uint32_t height, VkFormat format, const void *pixels, VkDeviceSize size, bool generateMipmaps = false);
+		~Texture();
+
+		Texture(const Texture &) = delete;
+		Texture &operator=(const Texture &) = delete;
+
+		VkImageView getImageView() const;
+		VkSampler getSampler() const;
+		std::uint32_t getWidth() const;
+		std::uint32_t getHeight() const;
+		std::uint32_t getMipLevels() const;
+		VkDeviceSize getMemorySize() const;
+	private:
+		void createImage(const void *pixels, VkDeviceSize size);
+		void createImageView();
+		void createSampler();
+
+		void transitionImageLayout(VkImageLayout oldLayout, VkImageLayout newLayout);
+		void generateMipmaps();
+
+		Device &m_device;
+
+		std::uint32_t m_width;
+		std::uint32_t m_height;
+		VkFormat m_format;
+		std::uint32_t m_mipLevels = 1;
+		VkDeviceSize m_memorySize = 0;
+
+		VkImage m_image;
+		VkDeviceMemory m_imageMemory;
+		VkImageView m_imageView;
+		VkSampler m_sampler;
+	};
+}
+
+#endif
\ No newline at end of file
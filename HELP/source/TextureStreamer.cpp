@@ -0,0 +1,476 @@
+#include "TextureStreamer.h"
+
+namespace eng {
+	TextureStreamer::TextureStreamer(Device &device, BindlessResources &bindlessResources, VkDeviceSize budget, VkDeviceSize uploadBytesPerFrame)
+		: m_device(device), m_bindlessResources(bindlessResources), m_budget(budget), m_uploadBytesPerFrame(uploadBytesPerFrame) {
+		createSampler();
+	}
+
+	TextureStreamer::~TextureStreamer() {
+		destroyRetiredImages(true);
+
+		for (StreamedTexture &texture : m_textures) {
+			vkDestroyImageView(m_device.getDevice(), texture.imageView, VulkanAllocator::get(AllocationCategory::Resource));
+			vkDestroyImage(m_device.getDevice(), texture.image, VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(texture.imageMemory);
+		}
+		m_textures.clear();
+
+		for (StagingBuffer &stagingBuffer : m_stagingBuffers) {
+			destroyStagingBuffer(stagingBuffer);
+		}
+
+		vkDestroySampler(m_device.getDevice(), m_sampler, VulkanAllocator::get(AllocationCategory::Descriptor));
+	}
+
+	TextureStreamer::TextureId TextureStreamer::load(const std::string &filename) {
+		StreamedTexture texture{};
+		texture.file = std::make_unique<KtxTexture>(filename);
+		texture.lastUsedFrame = m_frame;
+
+		const KtxTexture &file = *texture.file;
+
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(m_device.getPhysicalDevice(), file.getFormat(), &formatProperties);
+		if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+			throw std::runtime_error("Texture format is not supported by the device: " + filename);
+		}
+
+		if (file.getLevelCount() == 1) {
+			std::vector<char> pixels(static_cast<std::size_t>(file.getLevel(0).byteLength));
+			file.readLevel(0, pixels.data());
+
+			texture.texture = std::make_unique<Texture>(
+				m_device,
+				file.getWidth(),
+				file.getHeight(),
+				file.getFormat(),
+				pixels.data(),
+				static_cast<VkDeviceSize>(pixels.size()),
+				file.needsMipGeneration() && !file.isCompressed()
+			);
+			texture.memorySize = texture.texture->getMemorySize();
+			texture.bindlessIndex = m_bindlessResources.addTexture(*texture.texture);
+			texture.file.reset();
+
+			m_residentBytes += texture.memorySize;
+		} else {
+			texture.tailMip = file.getLevelCount() - 1;
+			for (std::uint32_t i = 0; i < file.getLevelCount(); ++i) {
+				if (std::max(file.getLevel(i).width, file.getLevel(i).height) <= TAIL_SIZE) {
+					texture.tailMip = i;
+					break;
+				}
+			}
+
+			texture.residentMip = file.getLevelCount();
+			texture.requestedMip = texture.tailMip;
+			texture.targetMip = texture.tailMip;
+			texture.bindlessIndex = m_bindlessResources.addTexture(m_bindlessResources.getDefaultTexture());
+		}
+
+		m_textures.push_back(std::move(texture));
+
+		return static_cast<TextureId>(m_textures.size() - 1);
+	}
+
+	void TextureStreamer::requestResolution(TextureId texture, float pixelSize) {
+		StreamedTexture &streamedTexture = m_textures[texture];
+		streamedTexture.lastUsedFrame = m_frame;
+
+		if (!streamedTexture.file) {
+			return;
+		}
+
+		float texels = static_cast<float>(std::max(streamedTexture.file->getWidth(), streamedTexture.file->getHeight()));
+		float mip = pixelSize > 0.0f ? std::floor(std::log2(texels / pixelSize)) : static_cast<float>(streamedTexture.tailMip);
+
+		std::uint32_t requestedMip = static_cast<std::uint32_t>(std::clamp(mip, 0.0f, static_cast<float>(streamedTexture.tailMip)));
+		streamedTexture.requestedMip = std::min(streamedTexture.requestedMip, requestedMip);
+	}
+
+	void TextureStreamer::update(VkCommandBuffer commandBuffer, std::uint32_t frameIndex) {
+		destroyRetiredImages(false);
+		chooseTargetMips();
+
+		std::vector<std::pair<StreamedTexture *, std::uint32_t>> rebuilds;
+		VkDeviceSize uploadBytes = 0;
+		VkDeviceSize stagingBytes = 0;
+
+		for (StreamedTexture &texture : m_textures) {
+			if (!texture.file || texture.targetMip == texture.residentMip) {
+				continue;
+			}
+
+			const KtxTexture &file = *texture.file;
+			std::uint32_t mip = texture.residentMip;
+
+			if (mip == file.getLevelCount()) {
+				mip = texture.tailMip;
+				uploadBytes += getLevelBytes(texture, mip);
+				stagingBytes += getLevelBytes(texture, mip) + 16 * (file.getLevelCount() - mip);
+			}
+
+			while (mip > texture.targetMip) {
+				VkDeviceSize levelBytes = file.getLevel(mip - 1).byteLength;
+				if (uploadBytes > 0 && uploadBytes + levelBytes > m_uploadBytesPerFrame) {
+					break;
+				}
+
+				uploadBytes += levelBytes;
+				stagingBytes += levelBytes + 16;
+				--mip;
+			}
+
+			if (texture.targetMip > texture.residentMip) {
+				mip = texture.targetMip;
+			}
+
+			if (mip != texture.residentMip) {
+				rebuilds.emplace_back(&texture, mip);
+			}
+		}
+
+		if (rebuilds.empty()) {
+			++m_frame;
+			return;
+		}
+
+		StagingBuffer &stagingBuffer = m_stagingBuffers[frameIndex];
+		ensureStagingCapacity(stagingBuffer, stagingBytes);
+
+		VkDeviceSize stagingOffset = 0;
+		for (const std::pair<StreamedTexture *, std::uint32_t> &rebuild : rebuilds) {
+			rebuildTexture(commandBuffer, stagingBuffer, stagingOffset, *rebuild.first, rebuild.second);
+		}
+
+		m_uploadedBytes += uploadBytes;
+		++m_frame;
+	}
+
+	std::uint32_t TextureStreamer::getBindlessIndex(TextureId texture) const {
+		return m_textures[texture].bindlessIndex;
+	}
+
+	std::uint32_t TextureStreamer::getResidentMip(TextureId texture) const {
+		return m_textures[texture].residentMip;
+	}
+
+	VkDeviceSize TextureStreamer::getResidentBytes() const {
+		return m_residentBytes;
+	}
+
+	VkDeviceSize TextureStreamer::getUploadedBytes() const {
+		return m_uploadedBytes;
+	}
+
+	VkDeviceSize TextureStreamer::getBudget() const {
+		return m_budget;
+	}
+
+	void TextureStreamer::setBudget(VkDeviceSize budget) {
+		m_budget = budget;
+	}
+
+	void TextureStreamer::chooseTargetMips() {
+		VkDeviceSize budget = std::min(m_budget, m_device.getMemoryBudget().getAvailableBytes(MemoryCategory::Texture));
+		VkDeviceSize totalBytes = 0;
+		std::vector<StreamedTexture *> streamedTextures;
+
+		for (StreamedTexture &texture : m_textures) {
+			if (!texture.file) {
+				totalBytes += texture.memorySize;
+				continue;
+			}
+
+			texture.targetMip = texture.lastUsedFrame == m_frame ? texture.requestedMip : std::min(texture.residentMip, texture.tailMip);
+			texture.requestedMip = texture.tailMip;
+
+			totalBytes += getLevelBytes(texture, texture.targetMip);
+			streamedTextures.push_back(&texture);
+		}
+
+		if (totalBytes <= budget) {
+			return;
+		}
+
+		std::sort(streamedTextures.begin(), streamedTextures.end(), [](const StreamedTexture *a, const StreamedTexture *b) {
+			if (a->lastUsedFrame != b->lastUsedFrame) {
+				return a->lastUsedFrame < b->lastUsedFrame;
+			}
+
+			return a->targetMip < b->targetMip;
+		});
+
+		for (StreamedTexture *texture : streamedTextures) {
+			while (totalBytes > budget && texture->targetMip < texture->tailMip) {
+				totalBytes -= texture->file->getLevel(texture->targetMip).byteLength;
+				++texture->targetMip;
+			}
+
+			if (totalBytes <= budget) {
+				break;
+			}
+		}
+	}
+
+	void TextureStreamer::rebuildTexture(VkCommandBuffer commandBuffer, StagingBuffer &stagingBuffer, VkDeviceSize &stagingOffset, StreamedTexture &texture, std::uint32_t mip) {
+		const KtxTexture &file = *texture.file;
+		const std::uint32_t levelCount = file.getLevelCount();
+		const std::uint32_t oldMip = texture.residentMip;
+
+		VkImageCreateInfo imageCreateInfo{};
+		imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCreateInfo.pNext = nullptr;
+		imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageCreateInfo.extent.width = file.getLevel(mip).width;
+		imageCreateInfo.extent.height = file.getLevel(mip).height;
+		imageCreateInfo.extent.depth = 1;
+		imageCreateInfo.mipLevels = levelCount - mip;
+		imageCreateInfo.arrayLayers = 1;
+		imageCreateInfo.format = file.getFormat();
+		imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageCreateInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VkImage image;
+		VkDeviceMemory imageMemory;
+		m_device.createImage(imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, imageMemory, MemoryCategory::Texture);
+
+		VkMemoryRequirements memoryRequirements;
+		vkGetImageMemoryRequirements(m_device.getDevice(), image, &memoryRequirements);
+
+		std::array<VkImageMemoryBarrier, 2> imageMemoryBarriers{};
+		for (VkImageMemoryBarrier &imageMemoryBarrier : imageMemoryBarriers) {
+			imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			imageMemoryBarrier.pNext = nullptr;
+			imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageMemoryBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+			imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+			imageMemoryBarrier.subresourceRange.layerCount = 1;
+		}
+
+		imageMemoryBarriers[0].image = image;
+		imageMemoryBarriers[0].subresourceRange.levelCount = levelCount - mip;
+		imageMemoryBarriers[0].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageMemoryBarriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageMemoryBarriers[0].srcAccessMask = 0;
+		imageMemoryBarriers[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		std::uint32_t barrierCount = 1;
+		if (texture.image != VK_NULL_HANDLE) {
+			imageMemoryBarriers[1].image = texture.image;
+			imageMemoryBarriers[1].subresourceRange.levelCount = levelCount - oldMip;
+			imageMemoryBarriers[1].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			imageMemoryBarriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+			imageMemoryBarriers[1].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			imageMemoryBarriers[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+			++barrierCount;
+		}
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			barrierCount, imageMemoryBarriers.data()
+		);
+
+		if (texture.image != VK_NULL_HANDLE) {
+			std::vector<VkImageCopy> imageCopies;
+			for (std::uint32_t level = std::max(mip, oldMip); level < levelCount; ++level) {
+				VkImageCopy imageCopy{};
+				imageCopy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				imageCopy.srcSubresource.mipLevel = level - oldMip;
+				imageCopy.srcSubresource.baseArrayLayer = 0;
+				imageCopy.srcSubresource.layerCount = 1;
+				imageCopy.srcOffset = { 0, 0, 0 };
+				imageCopy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				imageCopy.dstSubresource.mipLevel = level - mip;
+				imageCopy.dstSubresource.baseArrayLayer = 0;
+				imageCopy.dstSubresource.layerCount = 1;
+				imageCopy.dstOffset = { 0, 0, 0 };
+				imageCopy.extent = { file.getLevel(level).width, file.getLevel(level).height, 1 };
+
+				imageCopies.push_back(imageCopy);
+			}
+
+			vkCmdCopyImage(
+				commandBuffer,
+				texture.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+				image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				static_cast<std::uint32_t>(imageCopies.size()), imageCopies.data()
+			);
+		}
+
+		std::vector<VkBufferImageCopy> bufferImageCopies;
+		for (std::uint32_t level = mip; level < std::min(oldMip, levelCount); ++level) {
+			stagingOffset = (stagingOffset + 15) & ~static_cast<VkDeviceSize>(15);
+			file.readLevel(level, stagingBuffer.mapped + stagingOffset);
+
+			VkBufferImageCopy bufferImageCopy{};
+			bufferImageCopy.bufferOffset = stagingOffset;
+			bufferImageCopy.bufferRowLength = 0;
+			bufferImageCopy.bufferImageHeight = 0;
+			bufferImageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			bufferImageCopy.imageSubresource.mipLevel = level - mip;
+			bufferImageCopy.imageSubresource.baseArrayLayer = 0;
+			bufferImageCopy.imageSubresource.layerCount = 1;
+			bufferImageCopy.imageOffset = { 0, 0, 0 };
+			bufferImageCopy.imageExtent = { file.getLevel(level).width, file.getLevel(level).height, 1 };
+
+			bufferImageCopies.push_back(bufferImageCopy);
+			stagingOffset += file.getLevel(level).byteLength;
+		}
+
+		if (!bufferImageCopies.empty()) {
+			vkCmdCopyBufferToImage(
+				commandBuffer,
+				stagingBuffer.buffer,
+				image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				static_cast<std::uint32_t>(bufferImageCopies.size()), bufferImageCopies.data()
+			);
+		}
+
+		imageMemoryBarriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageMemoryBarriers[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		imageMemoryBarriers[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageMemoryBarriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &imageMemoryBarriers[0]
+		);
+
+		VkImageViewCreateInfo imageViewCreateInfo{};
+		imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		imageViewCreateInfo.pNext = nullptr;
+		imageViewCreateInfo.image = image;
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		imageViewCreateInfo.format = file.getFormat();
+		imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+		imageViewCreateInfo.subresourceRange.levelCount = levelCount - mip;
+		imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+		imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+		VkImageView imageView;
+		if (vkCreateImageView(m_device.getDevice(), &imageViewCreateInfo, VulkanAllocator::get(AllocationCategory::Resource), &imageView) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create streamed texture image view.");
+		}
+
+		std::uint32_t bindlessIndex = m_bindlessResources.addTexture(imageView, m_sampler);
+		m_bindlessResources.replaceTexture(texture.bindlessIndex, bindlessIndex);
+
+		m_retiredImages.push_back({ texture.image, texture.imageMemory, texture.imageView, texture.bindlessIndex, m_frame });
+
+		m_residentBytes = m_residentBytes - texture.memorySize + memoryRequirements.size;
+
+		texture.image = image;
+		texture.imageMemory = imageMemory;
+		texture.imageView = imageView;
+		texture.memorySize = memoryRequirements.size;
+		texture.bindlessIndex = bindlessIndex;
+		texture.residentMip = mip;
+	}
+
+	void TextureStreamer::ensureStagingCapacity(StagingBuffer &stagingBuffer, VkDeviceSize size) {
+		if (size <= stagingBuffer.size) {
+			return;
+		}
+
+		destroyStagingBuffer(stagingBuffer);
+
+		stagingBuffer.size = std::max(size, m_uploadBytesPerFrame);
+		m_device.createBuffer(
+			stagingBuffer.size,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			stagingBuffer.buffer,
+			stagingBuffer.bufferMemory,
+			MemoryCategory::Transient
+		);
+
+		void *data;
+		vkMapMemory(m_device.getDevice(), stagingBuffer.bufferMemory, 0, stagingBuffer.size, 0, &data);
+		stagingBuffer.mapped = static_cast<char *>(data);
+	}
+
+	void TextureStreamer::destroyStagingBuffer(StagingBuffer &stagingBuffer) {
+		if (stagingBuffer.buffer == VK_NULL_HANDLE) {
+			return;
+		}
+
+		vkUnmapMemory(m_device.getDevice(), stagingBuffer.bufferMemory);
+		vkDestroyBuffer(m_device.getDevice(), stagingBuffer.buffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(stagingBuffer.bufferMemory);
+
+		stagingBuffer = {};
+	}
+
+	void TextureStreamer::destroyRetiredImages(bool force) {
+		auto retired = std::remove_if(m_retiredImages.begin(), m_retiredImages.end(), [&](const RetiredImage &retiredImage) {
+			if (!force && m_frame < retiredImage.frame + Swapchain::MAX_FRAMES_IN_FLIGHT) {
+				return false;
+			}
+
+			vkDestroyImageView(m_device.getDevice(), retiredImage.imageView, VulkanAllocator::get(AllocationCategory::Resource));
+			vkDestroyImage(m_device.getDevice(), retiredImage.image, VulkanAllocator::get(AllocationCategory::Resource));
+			m_device.freeMemory(retiredImage.imageMemory);
+			m_bindlessResources.removeTexture(retiredImage.bindlessIndex);
+
+			return true;
+		});
+
+		m_retiredImages.erase(retired, m_retiredImages.end());
+	}
+
+	void TextureStreamer::createSampler() {
+		VkSamplerCreateInfo samplerCreateInfo{};
+		samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerCreateInfo.pNext = nullptr;
+		samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		samplerCreateInfo.anisotropyEnable = VK_FALSE;
+		samplerCreateInfo.maxAnisotropy = 1.0f;
+		if (m_device.getCapabilities().isEnabled(Capability::SamplerAnisotropy)) {
+			samplerCreateInfo.anisotropyEnable = VK_TRUE;
+			samplerCreateInfo.maxAnisotropy = std::min(16.0f, m_device.getPhysicalDeviceProperties().limits.maxSamplerAnisotropy);
+		}
+		samplerCreateInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+		samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+		samplerCreateInfo.compareEnable = VK_FALSE;
+		samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+		samplerCreateInfo.mipLodBias = 0.0f;
+		samplerCreateInfo.minLod = 0.0f;
+		samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+		if (vkCreateSampler(m_device.getDevice(), &samplerCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_sampler) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create streaming sampler.");
+		}
+	}
+
+	VkDeviceSize TextureStreamer::getLevelBytes(const StreamedTexture &texture, std::uint32_t firstMip) const {
+		VkDeviceSize bytes = 0;
+		for (std::uint32_t level = firstMip; level < texture.file->getLevelCount(); ++level) {
+			bytes += texture.file->getLevel(level).byteLength;
+		}
+
+		return bytes;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <vulkan/vulkan.h>
+
+#include "Device.h"
+#include "Swapchain.h"
+#include "Texture.h"
+#include "KtxTexture.h"
+#include "BindlessResources.h"
+
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace eng {
+	class TextureStreamer {
+	public:
+		using TextureId = std::uint32_t;
+
+		TextureStreamer(Device &device, BindlessResources &bindlessResources, VkDeviceSize budget = 256ull << 20, VkDeviceSize uploadBytesPerFrame = 16ull << 20);
+		~TextureStreamer();
+
+		TextureStreamer(const TextureStreamer &) = delete;
+		TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+		TextureId load(const std::string &filename);
+		void requestResolution(TextureId texture, float pixelSize);
+		void update(VkCommandBuffer commandBuffer, std::uint32_t frameIndex);
+
+		std::uint32_t getBindlessIndex(TextureId texture) const;
+		std::uint32_t getResidentMip(TextureId texture) const;
+		VkDeviceSize getResidentBytes() const;
+		VkDeviceSize getUploadedBytes() const;
+		VkDeviceSize getBudget() const;
+		void setBudget(VkDeviceSize budget);
+
+		static constexpr TextureId INVALID_TEXTURE = std::numeric_limits<TextureId>::max();
+		static constexpr std::uint32_t TAIL_SIZE = 64;
+	private:
+		struct StreamedTexture {
+			std::unique_ptr<KtxTexture> file;
+			std::unique_ptr<Texture> texture;
+
+			VkImage image = VK_NULL_HANDLE;
+			VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+			VkImageView imageView = VK_NULL_HANDLE;
+			VkDeviceSize memorySize = 0;
+
+			std::uint32_t bindlessIndex = 0;
+			std::uint32_t residentMip = 0;
+			std::uint32_t requestedMip = 0;
+			std::uint32_t targetMip = 0;
+			std::uint32_t tailMip = 0;
+			std::uint64_t lastUsedFrame = 0;
+		};
+
+		struct RetiredImage {
+			VkImage image;
+			VkDeviceMemory imageMemory;
+			VkImageView imageView;
+			std::uint32_t bindlessIndex;
+			std::uint64_t frame;
+		};
+
+		struct StagingBuffer {
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceMemory bufferMemory = VK_NULL_HANDLE;
+			VkDeviceSize size = 0;
+			char *mapped = nullptr;
+		};
+
+		void chooseTargetMips();
+		void rebuildTexture(VkCommandBuffer commandBuffer, StagingBuffer &stagingBuffer, VkDeviceSize &stagingOffset, StreamedTexture &texture, std::uint32_t mip);
+		void ensureStagingCapacity(StagingBuffer &stagingBuffer, VkDeviceSize size);
+		void destroyStagingBuffer(StagingBuffer &stagingBuffer);
+		void destroyRetiredImages(bool force);
+		void createSampler();
+
+		VkDeviceSize getLevelBytes(const StreamedTexture &texture, std::uint32_t firstMip) const;
+
+		Device &m_device;
+		BindlessResources &m_bindlessResources;
+
+		VkDeviceSize m_budget;
+		VkDeviceSize m_uploadBytesPerFrame;
+		VkDeviceSize m_residentBytes = 0;
+		VkDeviceSize m_uploadedBytes = 0;
+		std::uint64_t m_frame = 0;
+
+		VkSampler m_sampler;
+		std::vector<StreamedTexture> m_textures;
+		std::vector<RetiredImage> m_retiredImages;
+		std::array<StagingBuffer, Swapchain::MAX_FRAMES_IN_FLIGHT> m_stagingBuffers{};
+	};
+}
+
+#endif
\ No newline at end of file
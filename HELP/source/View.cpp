@@ -0,0 +1,70 @@
+#include "View.h"
+#include "RenderTarget.h"
+
+namespace eng {
+	View::View(RenderTarget &target, const VkRect2D &region, std::uint32_t layerCount)
+		: m_target(&target), m_region(region), m_layerCount(layerCount) {
+		if (m_layerCount == 0 || m_layerCount > MAX_LAYERS) {
+			throw std::runtime_error("View layer count must be between 1 and 6.");
+		}
+
+		if (m_region.offset.x < 0 || m_region.offset.y < 0 ||
+			m_region.offset.x + m_region.extent.width > target.getExtent().width ||
+			m_region.offset.y + m_region.extent.height > target.getExtent().height) {
+			throw std::runtime_error("View region must lie inside its render target.");
+		}
+	}
+
+	void View::setCamera(const Camera &camera, std::uint32_t layer) {
+		m_cameras[layer] = camera;
+	}
+
+	const Camera &View::getCamera(std::uint32_t layer) const {
+		return m_cameras[layer];
+	}
+
+	RenderTarget &View::getTarget() const {
+		return *m_target;
+	}
+
+	const VkRect2D &View::getRegion() const {
+		return m_region;
+	}
+
+	std::uint32_t View::getLayerCount() const {
+		return m_layerCount;
+	}
+
+	std::uint32_t View::getViewMask() const {
+		return m_layerCount > 1 ? (1u << m_layerCount) - 1 : 0;
+	}
+
+	void ViewBatch::clear() {
+		for (ViewResult &view : views) {
+			view.drawList.clear();
+		}
+
+		visible.clear();
+		transforms.clear();
+	}
+
+	void ViewBatch::add(std::uint64_t viewMask, RenderPacket packet, const glm::mat4 &transform, const glm::vec3 &center, float maxDepth) {
+		packet.transformIndex = static_cast<std::uint32_t>(transforms.size());
+		transforms.push_back(transform);
+
+		for (std::size_t i = 0; i < views.size(); ++i) {
+			if ((viewMask & (std::uint64_t{ 1 } << i)) == 0) {
+				continue;
+			}
+
+			packet.sortKey = DrawList::encodeKey(0, 0, packet.material, packet.model, DrawList::quantizeDepth(glm::length(center - views[i].position), maxDepth));
+			views[i].drawList.add(packet);
+		}
+	}
+
+	void ViewBatch::sort(std::size_t threadCount) {
+		for (ViewResult &view : views) {
+			view.drawList.sort(threadCount);
+		}
+	}
+}
\ No newline at end of file
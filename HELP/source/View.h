@@ -0,0 +1,59 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "DrawList.h"
+#include "BoundingVolumeHierarchy.h"
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace eng {
+	class RenderTarget;
+
+	class View {
+	public:
+		static constexpr std::uint32_t MAX_LAYERS = 6;
+
+		View(RenderTarget &target, const VkRect2D &region, std::uint32_t layerCount = 1);
+
+		void setCamera(const Camera &camera, std::uint32_t layer = 0);
+
+		const Camera &getCamera(std::uint32_t layer = 0) const;
+		RenderTarget &getTarget() const;
+		const VkRect2D &getRegion() const;
+		std::uint32_t getLayerCount() const;
+		std::uint32_t getViewMask() const;
+	private:
+		RenderTarget *m_target;
+		VkRect2D m_region;
+		std::uint32_t m_layerCount;
+		std::array<Camera, MAX_LAYERS> m_cameras{};
+	};
+
+	struct ViewBatch {
+		struct ViewResult {
+			std::array<glm::mat4, View::MAX_LAYERS> projectionViews{};
+			glm::vec3 position{ 0.0f };
+			DrawList drawList;
+		};
+
+		std::vector<ViewResult> views;
+		std::vector<BoundingVolumeHierarchy::QueryResult> visible;
+		std::vector<glm::mat4> transforms;
+
+		void clear();
+		void add(std::uint64_t viewMask, RenderPacket packet, const glm::mat4 &transform, const glm::vec3 &center, float maxDepth);
+		void sort(std::size_t threadCount = 1);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,370 @@
+#include "ViewRenderer.h"
+
+namespace eng {
+	ViewRenderer::ViewRenderer(Device &device, Swapchain &swapchain, BindlessResources &bindlessResources, GeometryPool &geometryPool, std::uint32_t frameCount)
+		: m_device(device), m_swapchain(swapchain), m_bindlessResources(bindlessResources), m_geometryPool(geometryPool), m_frameCount(frameCount) {
+		m_views.reserve(MAX_VIEWS);
+		m_targets.reserve(MAX_VIEWS);
+
+		createUniformBuffer();
+		createDescriptorSetLayout();
+		createPipelineLayout();
+		createDescriptorSet();
+	}
+
+	ViewRenderer::~ViewRenderer() {
+		m_pipelines.clear();
+
+		vkDestroyPipelineLayout(m_device.getDevice(), m_pipelineLayout, VulkanAllocator::get(AllocationCategory::Pipeline));
+		vkDestroyDescriptorPool(m_device.getDevice(), m_descriptorPool, VulkanAllocator::get(AllocationCategory::Descriptor));
+		vkDestroyDescriptorSetLayout(m_device.getDevice(), m_descriptorSetLayout, VulkanAllocator::get(AllocationCategory::Descriptor));
+
+		vkUnmapMemory(m_device.getDevice(), m_uniformBufferMemory);
+		vkDestroyBuffer(m_device.getDevice(), m_uniformBuffer, VulkanAllocator::get(AllocationCategory::Resource));
+		m_device.freeMemory(m_uniformBufferMemory);
+	}
+
+	std::uint32_t ViewRenderer::addView(const View &view) {
+		if (m_views.size() >= MAX_VIEWS || m_frustumCount + view.getLayerCount() > BoundingVolumeHierarchy::MAX_QUERY_FRUSTA) {
+			throw std::runtime_error("Too many views for a single view batch.");
+		}
+
+		RenderTarget &target = view.getTarget();
+		if (view.getLayerCount() != target.getLayerCount()) {
+			throw std::runtime_error("View must cover every layer of its render target.");
+		}
+
+		if (view.getViewMask() != 0 && !m_device.isMultiviewEnabled()) {
+			throw std::runtime_error("Layered views require multiview support.");
+		}
+
+		const std::uint32_t viewIndex = static_cast<std::uint32_t>(m_views.size());
+
+		TargetGroup *group = nullptr;
+		for (TargetGroup &targetGroup : m_targets) {
+			if (targetGroup.target == &target) {
+				group = &targetGroup;
+				break;
+			}
+		}
+
+		if (group == nullptr) {
+			const std::string index = std::to_string(m_targets.size());
+
+			TargetGroup targetGroup{};
+			targetGroup.target = &target;
+			targetGroup.viewMask = view.getViewMask();
+			targetGroup.pipeline = getPipeline(target.getFormat(), targetGroup.viewMask);
+			targetGroup.image = RenderGraph::INVALID_RESOURCE;
+			targetGroup.colorName = "view target " + index;
+			targetGroup.depthName = "view depth " + index;
+			targetGroup.passName = "views " + index;
+
+			m_targets.push_back(std::move(targetGroup));
+			group = &m_targets.back();
+		} else if (group->viewMask != 0 || view.getViewMask() != 0) {
+			throw std::runtime_error("Layered render targets can only hold a single view.");
+		}
+
+		group->views.push_back(viewIndex);
+		m_views.push_back(view);
+		m_frustumCount += view.getLayerCount();
+
+		return viewIndex;
+	}
+
+	View &ViewRenderer::getView(std::uint32_t view) {
+		return m_views[view];
+	}
+
+	std::uint32_t ViewRenderer::getViewCount() const {
+		return static_cast<std::uint32_t>(m_views.size());
+	}
+
+	void ViewRenderer::cull(const BoundingVolumeHierarchy &boundingVolumeHierarchy, ViewBatch &batch) {
+		m_frusta.clear();
+		m_frustumViews.clear();
+
+		batch.views.resize(m_views.size());
+		for (std::uint32_t i = 0; i < m_views.size(); ++i) {
+			const View &view = m_views[i];
+			ViewBatch::ViewResult &result = batch.views[i];
+
+			result.position = view.getCamera().getPosition();
+			for (std::uint32_t layer = 0; layer < view.getLayerCount(); ++layer) {
+				result.projectionViews[layer] = view.getCamera(layer).getProjectionView();
+				m_frusta.push_back(view.getCamera(layer).getFrustum());
+				m_frustumViews.push_back(i);
+			}
+		}
+
+		const std::size_t first = batch.visible.size();
+		boundingVolumeHierarchy.query(m_frusta, batch.visible);
+
+		if (m_frusta.size() == m_views.size()) {
+			return;
+		}
+
+		for (std::size_t i = first; i < batch.visible.size(); ++i) {
+			std::uint64_t viewMask = 0;
+			for (std::size_t frustum = 0; frustum < m_frusta.size(); ++frustum) {
+				if ((batch.visible[i].mask & (std::uint64_t{ 1 } << frustum)) != 0) {
+					viewMask |= std::uint64_t{ 1 } << m_frustumViews[frustum];
+				}
+			}
+
+			batch.visible[i].mask = viewMask;
+		}
+	}
+
+	void ViewRenderer::addPasses(RenderGraph &graph, const ViewBatch &batch, const std::vector<std::shared_ptr<Model>> &models, std::uint32_t frameIndex) {
+		m_batch = &batch;
+		m_models = &models;
+		m_frameIndex = frameIndex;
+		m_statistics = {};
+		m_statistics.viewCount = static_cast<std::uint32_t>(m_views.size());
+
+		updateUniformBuffer(batch, frameIndex);
+
+		VkClearValue colorClearValue{};
+		colorClearValue.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+		VkClearValue depthClearValue{};
+		depthClearValue.depthStencil = { 1.0f, 0 };
+
+		for (TargetGroup &group : m_targets) {
+			RenderTarget &target = *group.target;
+
+			RenderGraph::ResourceHandle colorImage = target.import(graph, group.colorName);
+			group.image = colorImage;
+
+			RenderGraph::ImageDescription depthDescription{};
+			depthDescription.format = m_swapchain.getDepthFormat();
+			depthDescription.extent = target.getExtent();
+			depthDescription.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+			depthDescription.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+			depthDescription.layerCount = target.getLayerCount();
+
+			RenderGraph::ResourceHandle depthImage = graph.createImage(group.depthName, depthDescription);
+
+			graph.addPass(group.passName, RenderGraph::PassType::Graphics)
+				.clear(colorImage, RenderGraph::Access::ColorAttachment, colorClearValue)
+				.clear(depthImage, RenderGraph::Access::DepthAttachment, depthClearValue)
+				.setViewMask(group.viewMask)
+				.setExecute([this, &group](VkCommandBuffer commandBuffer) {
+					render(commandBuffer, group);
+				});
+
+			++m_statistics.passCount;
+		}
+	}
+
+	RenderGraph::ResourceHandle ViewRenderer::getTargetImage(const RenderTarget &target) const {
+		for (const TargetGroup &group : m_targets) {
+			if (group.target == &target) {
+				return group.image;
+			}
+		}
+
+		return RenderGraph::INVALID_RESOURCE;
+	}
+
+	const ViewRenderer::Statistics &ViewRenderer::getStatistics() const {
+		return m_statistics;
+	}
+
+	void ViewRenderer::createUniformBuffer() {
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(m_device.getPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment, 1);
+		m_uniformStride = (sizeof(ViewUbo) + alignment - 1) / alignment * alignment;
+
+		const VkDeviceSize size = m_uniformStride * MAX_VIEWS * m_frameCount;
+
+		m_device.createBuffer(
+			size,
+			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			m_uniformBuffer,
+			m_uniformBufferMemory
+		);
+
+		vkMapMemory(m_device.getDevice(), m_uniformBufferMemory, 0, size, 0, &m_uniformBufferMapped);
+	}
+
+	void ViewRenderer::createDescriptorSetLayout() {
+		VkDescriptorSetLayoutBinding uboLayoutBinding{};
+		uboLayoutBinding.binding = 0;
+		uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		uboLayoutBinding.descriptorCount = 1;
+		uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		uboLayoutBinding.pImmutableSamplers = nullptr;
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+		descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptorSetLayoutCreateInfo.pNext = nullptr;
+		descriptorSetLayoutCreateInfo.bindingCount = 1;
+		descriptorSetLayoutCreateInfo.pBindings = &uboLayoutBinding;
+
+		if (vkCreateDescriptorSetLayout(m_device.getDevice(), &descriptorSetLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create view descriptor set layout.");
+		}
+	}
+
+	void ViewRenderer::createPipelineLayout() {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(PushConstantData);
+
+		std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts{
+			m_descriptorSetLayout,
+			m_bindlessResources.getDescriptorSetLayout()
+		};
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pNext = nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+		if (vkCreatePipelineLayout(m_device.getDevice(), &pipelineLayoutCreateInfo, VulkanAllocator::get(AllocationCategory::Pipeline), &m_pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create view pipeline layout.");
+		}
+	}
+
+	void ViewRenderer::createDescriptorSet() {
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		descriptorPoolSize.descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCreateInfo.pNext = nullptr;
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = 1;
+
+		if (vkCreateDescriptorPool(m_device.getDevice(), &descriptorPoolCreateInfo, VulkanAllocator::get(AllocationCategory::Descriptor), &m_descriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create view descriptor pool.");
+		}
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.pNext = nullptr;
+		descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &m_descriptorSetLayout;
+
+		if (vkAllocateDescriptorSets(m_device.getDevice(), &descriptorSetAllocateInfo, &m_descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate view descriptor set.");
+		}
+
+		VkDescriptorBufferInfo descriptorBufferInfo{};
+		descriptorBufferInfo.buffer = m_uniformBuffer;
+		descriptorBufferInfo.offset = 0;
+		descriptorBufferInfo.range = sizeof(ViewUbo);
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.pNext = nullptr;
+		writeDescriptorSet.dstSet = m_descriptorSet;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.dstArrayElement = 0;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+
+		vkUpdateDescriptorSets(m_device.getDevice(), 1, &writeDescriptorSet, 0, nullptr);
+	}
+
+	Pipeline *ViewRenderer::getPipeline(VkFormat format, std::uint32_t viewMask) {
+		for (const PipelineEntry &entry : m_pipelines) {
+			if (entry.format == format && entry.viewMask == viewMask) {
+				return entry.pipeline.get();
+			}
+		}
+
+		Pipeline::Config config = Pipeline::getDefaultConfig();
+		config.colorFormat = format;
+		config.viewMask = viewMask;
+
+		if (m_geometryPool.isVertexPullingEnabled()) {
+			config.vertexShaderPath = viewMask != 0 ? "resources/shaders/multiview_pulling.vert.spv" : "resources/shaders/simple_pulling.vert.spv";
+			config.modelVertexInput = false;
+		} else if (viewMask != 0) {
+			config.vertexShaderPath = "resources/shaders/multiview.vert.spv";
+		}
+
+		PipelineEntry entry{};
+		entry.format = format;
+		entry.viewMask = viewMask;
+		entry.pipeline = std::make_unique<Pipeline>(m_device, m_swapchain, m_pipelineLayout, config);
+
+		m_pipelines.push_back(std::move(entry));
+		return m_pipelines.back().pipeline.get();
+	}
+
+	void ViewRenderer::updateUniformBuffer(const ViewBatch &batch, std::uint32_t frameIndex) {
+		std::uint8_t *mapped = static_cast<std::uint8_t *>(m_uniformBufferMapped) + m_uniformStride * MAX_VIEWS * frameIndex;
+
+		for (std::size_t i = 0; i < batch.views.size(); ++i) {
+			std::memcpy(mapped + m_uniformStride * i, batch.views[i].projectionViews.data(), sizeof(ViewUbo));
+		}
+	}
+
+	void ViewRenderer::render(VkCommandBuffer commandBuffer, const TargetGroup &group) {
+		DrawRecorder recorder(commandBuffer);
+
+		VkDescriptorSet bindlessDescriptorSet = m_bindlessResources.getDescriptorSet(m_frameIndex);
+
+		for (std::uint32_t viewIndex : group.views) {
+			const VkRect2D &region = m_views[viewIndex].getRegion();
+
+			VkViewport viewport{};
+			viewport.x = static_cast<float>(region.offset.x);
+			viewport.y = static_cast<float>(region.offset.y);
+			viewport.width = static_cast<float>(region.extent.width);
+			viewport.height = static_cast<float>(region.extent.height);
+			viewport.minDepth = 0.0f;
+			viewport.maxDepth = 1.0f;
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+			vkCmdSetScissor(commandBuffer, 0, 1, &region);
+
+			const std::uint32_t dynamicOffset = static_cast<std::uint32_t>(m_uniformStride * (MAX_VIEWS * m_frameIndex + viewIndex));
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSet, 1, &dynamicOffset);
+
+			for (const RenderPacket &packet : m_batch->views[viewIndex].drawList.getPackets()) {
+				group.pipeline->bind(recorder);
+				recorder.bindDescriptorSets(m_pipelineLayout, 1, 1, &bindlessDescriptorSet);
+
+				if (m_geometryPool.isVertexPullingEnabled()) {
+					m_geometryPool.bindIndices(recorder);
+				} else {
+					m_geometryPool.bind(recorder);
+				}
+
+				PushConstantData pushConstantData{};
+				pushConstantData.transform = m_batch->transforms[packet.transformIndex];
+				pushConstantData.materialIndex = packet.material;
+				pushConstantData.vertexAddress = m_geometryPool.getVertexBufferAddress();
+
+				recorder.pushConstants(
+					m_pipelineLayout,
+					VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+					0,
+					sizeof(PushConstantData),
+					&pushConstantData
+				);
+
+				(*m_models)[packet.model]->draw(recorder, packet.lod);
+			}
+		}
+
+		const DrawRecorder::Statistics &statistics = recorder.getStatistics();
+		m_statistics.draws += statistics.draws;
+		m_statistics.pipelineBinds += statistics.pipelineBinds;
+		m_statistics.descriptorSetBinds += statistics.descriptorSetBinds + group.views.size();
+		m_statistics.skippedBinds += statistics.skippedPipelineBinds + statistics.skippedDescriptorSetBinds + statistics.skippedVertexBufferBinds + statistics.skippedIndexBufferBinds + statistics.skippedPushConstantUpdates;
+	}
+}
\ No newline at end of file
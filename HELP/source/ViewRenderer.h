@@ -0,0 +1,127 @@
+#ifndef VIEW_RENDERER_H
+#define VIEW_RENDERER_H
+
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "Device.h"
+#include "Swapchain.h"
+#include "Pipeline.h"
+#include "Model.h"
+#include "GeometryPool.h"
+#include "BindlessResources.h"
+#include "BoundingVolumeHierarchy.h"
+#include "RenderGraph.h"
+#include "RenderTarget.h"
+#include "View.h"
+#include "DrawRecorder.h"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+namespace eng {
+	class ViewRenderer {
+	public:
+		struct Statistics {
+			std::uint32_t viewCount = 0;
+			std::uint32_t passCount = 0;
+			std::uint64_t draws = 0;
+			std::uint64_t pipelineBinds = 0;
+			std::uint64_t descriptorSetBinds = 0;
+			std::uint64_t skippedBinds = 0;
+		};
+
+		ViewRenderer(Device &device, Swapchain &swapchain, BindlessResources &bindlessResources, GeometryPool &geometryPool, std::uint32_t frameCount);
+		~ViewRenderer();
+
+		ViewRenderer(const ViewRenderer &) = delete;
+		ViewRenderer &operator=(const ViewRenderer &) = delete;
+
+		std::uint32_t addView(const View &view);
+		View &getView(std::uint32_t view);
+		std::uint32_t getViewCount() const;
+
+		void cull(const BoundingVolumeHierarchy &boundingVolumeHierarchy, ViewBatch &batch);
+		void addPasses(RenderGraph &graph, const ViewBatch &batch, const std::vector<std::shared_ptr<Model>> &models, std::uint32_t frameIndex);
+		RenderGraph::ResourceHandle getTargetImage(const RenderTarget &target) const;
+
+		const Statistics &getStatistics() const;
+
+		static constexpr std::uint32_t MAX_VIEWS = 64;
+	private:
+		struct ViewUbo {
+			glm::mat4 projectionView[View::MAX_LAYERS];
+		};
+
+		struct PushConstantData {
+			glm::mat4 transform{ 1.0f };
+			std::uint32_t materialIndex = 0;
+			std::uint32_t padding = 0;
+			VkDeviceAddress vertexAddress = 0;
+		};
+
+		struct TargetGroup {
+			RenderTarget *target;
+			std::uint32_t viewMask;
+			Pipeline *pipeline;
+			RenderGraph::ResourceHandle image;
+			std::vector<std::uint32_t> views;
+			std::string colorName;
+			std::string depthName;
+			std::string passName;
+		};
+
+		struct PipelineEntry {
+			VkFormat format;
+			std::uint32_t viewMask;
+			std::unique_ptr<Pipeline> pipeline;
+		};
+
+		void createUniformBuffer();
+		void createDescriptorSetLayout();
+		void createPipelineLayout();
+		void createDescriptorSet();
+
+		Pipeline *getPipeline(VkFormat format, std::uint32_t viewMask);
+		void updateUniformBuffer(const ViewBatch &batch, std::uint32_t frameIndex);
+		void render(VkCommandBuffer commandBuffer, const TargetGroup &group);
+
+		Device &m_device;
+		Swapchain &m_swapchain;
+		BindlessResources &m_bindlessResources;
+		GeometryPool &m_geometryPool;
+		std::uint32_t m_frameCount;
+
+		std::vector<View> m_views;
+		std::vector<TargetGroup> m_targets;
+		std::vector<PipelineEntry> m_pipelines;
+		std::uint32_t m_frustumCount = 0;
+
+		VkBuffer m_uniformBuffer;
+		VkDeviceMemory m_uniformBufferMemory;
+		void *m_uniformBufferMapped;
+		VkDeviceSize m_uniformStride;
+
+		VkDescriptorSetLayout m_descriptorSetLayout;
+		VkPipelineLayout m_pipelineLayout;
+		VkDescriptorPool m_descriptorPool;
+		VkDescriptorSet m_descriptorSet;
+
+		std::vector<Frustum> m_frusta;
+		std::vector<std::uint32_t> m_frustumViews;
+
+		const ViewBatch *m_batch = nullptr;
+		const std::vector<std::shared_ptr<Model>> *m_models = nullptr;
+		std::uint32_t m_frameIndex = 0;
+		Statistics m_statistics{};
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "VulkanAllocator.h"
+
+namespace eng {
+	const VkAllocationCallbacks *VulkanAllocator::get(AllocationCategory category) {
+		static const std::array<VkAllocationCallbacks, AllocationTracker::CATEGORY_COUNT> callbacks = createCallbacks();
+		return &callbacks[static_cast<std::size_t>(category)];
+	}
+
+	std::array<VkAllocationCallbacks, AllocationTracker::CATEGORY_COUNT> VulkanAllocator::createCallbacks() {
+		std::array<VkAllocationCallbacks, AllocationTracker::CATEGORY_COUNT> callbacks{};
+		for (std::size_t i = 0; i < callbacks.size(); ++i) {
+			callbacks[i].pUserData = reinterpret_cast<void *>(i);
+			callbacks[i].pfnAllocation = allocate;
+			callbacks[i].pfnReallocation = reallocate;
+			callbacks[i].pfnFree = free;
+			callbacks[i].pfnInternalAllocation = internalAllocation;
+			callbacks[i].pfnInternalFree = internalFree;
+		}
+
+		return callbacks;
+	}
+
+	VulkanAllocator::Header *VulkanAllocator::getHeader(void *pointer) {
+		return reinterpret_cast<Header *>(static_cast<std::uint8_t *>(pointer) - sizeof(Header));
+	}
+
+	AllocationCategory VulkanAllocator::getCategory(void *userData) {
+		return static_cast<AllocationCategory>(reinterpret_cast<std::uintptr_t>(userData));
+	}
+
+	void *VKAPI_PTR VulkanAllocator::allocate(void *userData, std::size_t size, std::size_t alignment, VkSystemAllocationScope scope) {
+		if (size == 0) {
+			return nullptr;
+		}
+
+		alignment = std::max(alignment, alignof(Header));
+
+		std::uint8_t *memory = static_cast<std::uint8_t *>(std::malloc(size + alignment + sizeof(Header)));
+		if (memory == nullptr) {
+			return nullptr;
+		}
+
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory + sizeof(Header));
+		address = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+		void *pointer = reinterpret_cast<void *>(address);
+		AllocationCategory category = getCategory(userData);
+
+		Header *header = getHeader(pointer);
+		header->memory = memory;
+		header->size = size;
+		header->category = category;
+
+		AllocationTracker::recordAllocation(category, size);
+
+		return pointer;
+	}
+
+	void *VKAPI_PTR VulkanAllocator::reallocate(void *userData, void *original, std::size_t size, std::size_t alignment, VkSystemAllocationScope scope) {
+		if (original == nullptr) {
+			return allocate(userData, size, alignment, scope);
+		}
+
+		if (size == 0) {
+			free(userData, original);
+			return nullptr;
+		}
+
+		void *pointer = allocate(userData, size, alignment, scope);
+		if (pointer == nullptr) {
+			return nullptr;
+		}
+
+		std::memcpy(pointer, original, std::min(size, getHeader(original)->size));
+		free(userData, original);
+
+		return pointer;
+	}
+
+	void VKAPI_PTR VulkanAllocator::free(void *userData, void *pointer) {
+		if (pointer == nullptr) {
+			return;
+		}
+
+		Header *header = getHeader(pointer);
+		AllocationTracker::recordFree(header->category, header->size);
+		std::free(header->memory);
+	}
+
+	void VKAPI_PTR VulkanAllocator::internalAllocation(void *userData, std::size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope) {
+		AllocationTracker::recordAllocation(getCategory(userData), size);
+	}
+
+	void VKAPI_PTR VulkanAllocator::internalFree(void *userData, std::size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope) {
+		AllocationTracker::recordFree(getCategory(userData), size);
+	}
+}
\ No newline at end of file
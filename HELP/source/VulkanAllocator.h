@@ -0,0 +1,38 @@
+#ifndef VULKAN_ALLOCATOR_H
+#define VULKAN_ALLOCATOR_H
+
+#include <vulkan/vulkan.h>
+
+#include "AllocationTracker.h"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace eng {
+	class VulkanAllocator {
+	public:
+		static const VkAllocationCallbacks *get(AllocationCategory category);
+	private:
+		struct Header {
+			void *memory;
+			std::size_t size;
+			AllocationCategory category;
+		};
+
+		static std::array<VkAllocationCallbacks, AllocationTracker::CATEGORY_COUNT> createCallbacks();
+		static Header *getHeader(void *pointer);
+		static AllocationCategory getCategory(void *userData);
+
+		static void *VKAPI_PTR allocate(void *userData, std::size_t size, std::size_t alignment, VkSystemAllocationScope scope);
+		static void *VKAPI_PTR reallocate(void *userData, void *original, std::size_t size, std::size_t alignment, VkSystemAllocationScope scope);
+		static void VKAPI_PTR free(void *userData, void *pointer);
+		static void VKAPI_PTR internalAllocation(void *userData, std::size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+		static void VKAPI_PTR internalFree(void *userData, std::size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -6,9 +6,14 @@ namespace eng {
         createGlfwWindow();
     }
 
+    std::uint32_t Window::s_windowCount = 0;
+
     Window::~Window() {
         glfwDestroyWindow(m_window);
-        glfwTerminate();
+
+        if (--s_windowCount == 0) {
+            glfwTerminate();
+        }
     }
 
     bool Window::shouldClose() {
@@ -20,6 +25,14 @@ namespace eng {
         updateFPS();
     }
 
+    void Window::waitEvents() {
+        if (std::this_thread::get_id() == m_eventThread) {
+            glfwWaitEvents();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
     void Window::pollEvents() {
         glfwPollEvents();
     }
@@ -42,7 +55,7 @@ namespace eng {
     }
 
     void Window::createWindowSurface(const VkInstance &instance, VkSurfaceKHR &surface) {
-        if (glfwCreateWindowSurface(instance, m_window, nullptr, &surface) != VK_SUCCESS) {
+        if (glfwCreateWindowSurface(instance, m_window, VulkanAllocator::get(AllocationCategory::Swapchain), &surface) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create window surface.");
         }
     }
@@ -89,7 +102,7 @@ namespace eng {
             throw std::runtime_error("Failed to create a GLFW window.");
         }
 
-        glfwSwapInterval(0);
+        ++s_windowCount;
 
         glfwSetWindowUserPointer(m_window, this);
         glfwSetFramebufferSizeCallback(m_window, framebufferResizeCallback);
@@ -4,10 +4,14 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include "VulkanAllocator.h"
+
 #include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <chrono>
+#include <atomic>
+#include <thread>
 
 namespace eng {
 	class Window {
@@ -24,6 +28,7 @@ namespace eng {
 		bool shouldClose();
 
 		void update();
+		void waitEvents();
 
 		void createWindowSurface(const VkInstance &instance, VkSurfaceKHR &surface);
 		
@@ -42,10 +47,13 @@ namespace eng {
 		void updateFPS();
 
 		GLFWwindow *m_window;
-		std::uint32_t m_width, m_height;
+		std::atomic<std::uint32_t> m_width, m_height;
 		std::string m_name;
 
-		bool m_framebufferResized = false;
+		std::atomic<bool> m_framebufferResized{ false };
+		std::thread::id m_eventThread = std::this_thread::get_id();
+
+		static std::uint32_t s_windowCount;
 
 		int m_frameCount = 0;
 		std::chrono::high_resolution_clock::time_point m_lastFrameTime = std::chrono::high_resolution_clock::now();